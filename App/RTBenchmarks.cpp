@@ -0,0 +1,465 @@
+#include "RTBenchmarks.h"
+#include "../Core/RTJobSystem.h"
+#include "../Core/RTPoolAllocator.h"
+#include "../SoftwareRHI/RTSoftwareBvh.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+
+namespace {
+
+	using Clock = std::chrono::steady_clock;
+
+	struct BenchmarkOptions {
+		bool		jobs = false;
+		bool		bvh = false;
+		bool		pool = false;
+		uint32_t	maxThreads = std::max<uint32_t>(std::thread::hardware_concurrency(), 1);
+		uint32_t	primitiveCount = 1000000;
+		uint32_t	nodeCount = 4000000;
+		uint32_t	repeatCount = 3;
+	};
+
+	uint32_t ParseCount(std::string const& option, std::string const& value)
+	{
+		size_t parsedLength = 0;
+		unsigned long long number = 0;
+		try
+		{
+			number = std::stoull(value, &parsedLength);
+		}
+		catch (std::exception const&)
+		{
+			parsedLength = 0;
+		}
+		if (parsedLength != value.size() || value[0] == '-' || number < 1 || number > 0xFFFFFFFFull)
+		{
+			throw std::runtime_error("ERROR: " + option + " needs a whole number of at least 1, not '" + value + "'.");
+		}
+		return static_cast<uint32_t>(number);
+	}
+
+	BenchmarkOptions ParseCommandLine(std::vector<std::string> const& arguments)
+	{
+		BenchmarkOptions options;
+
+		for (size_t i = 0; i < arguments.size(); ++i)
+		{
+			std::string const& option = arguments[i];
+			auto NextValue = [&]() -> std::string const&
+				{
+					if (i + 1 >= arguments.size())
+					{
+						throw std::runtime_error("ERROR: " + option + " needs a value.");
+					}
+					return arguments[++i];
+				};
+
+			if (option == "-benchmark")
+			{
+				std::string const& name = NextValue();
+				options.jobs = options.jobs || name == "jobs" || name == "all";
+				options.bvh = options.bvh || name == "bvh" || name == "all";
+				options.pool = options.pool || name == "pool" || name == "all";
+				if (name != "jobs" && name != "bvh" && name != "pool" && name != "all")
+				{
+					throw std::runtime_error("ERROR: Unknown benchmark '" + name + "'.");
+				}
+			}
+			else if (option == "-threads")
+			{
+				options.maxThreads = ParseCount(option, NextValue());
+			}
+			else if (option == "-primitives")
+			{
+				options.primitiveCount = ParseCount(option, NextValue());
+			}
+			else if (option == "-nodes")
+			{
+				options.nodeCount = ParseCount(option, NextValue());
+			}
+			else if (option == "-repeat")
+			{
+				options.repeatCount = ParseCount(option, NextValue());
+			}
+			else
+			{
+				throw std::runtime_error("ERROR: Unknown option '" + option + "'.");
+			}
+		}
+		return options;
+	}
+
+	// 1, 2, 4, ... up to and including the maximum.
+	std::vector<uint32_t> GetThreadCounts(uint32_t maxThreads)
+	{
+		std::vector<uint32_t> counts;
+		for (uint32_t count = 1; count < maxThreads; count *= 2)
+		{
+			counts.push_back(count);
+		}
+		counts.push_back(maxThreads);
+		return counts;
+	}
+
+	uint32_t Hash(uint32_t value)
+	{
+		value ^= value >> 16;
+		value *= 0x7FEB352Du;
+		value ^= value >> 15;
+		value *= 0x846CA68Bu;
+		value ^= value >> 16;
+		return value;
+	}
+
+	// A dependent chain of floating point work the compiler can't remove, as its result is kept.
+	float Work(uint32_t seed, uint32_t iterations)
+	{
+		float x = static_cast<float>(seed & 0xFFFF) * (1.f / 65536.f);
+		for (uint32_t i = 0; i < iterations; ++i)
+		{
+			x = x * 3.7f * (1.f - x) + 1e-7f;
+		}
+		return x;
+	}
+
+	// Runs the benchmark on a job system of every thread count, best of the repeats.
+	void RunScaling(char const* name, BenchmarkOptions const& options, std::function<void(RTJobSystem&)> const& benchmark)
+	{
+		std::printf("%s\n%8s %12s %9s %11s\n", name, "threads", "ms", "speedup", "efficiency");
+
+		double singleThreadMilliseconds = 0.0;
+		for (uint32_t threadCount : GetThreadCounts(options.maxThreads))
+		{
+			RTJobSystem jobSystem(threadCount - 1);
+
+			// The first run warms caches and allocations up and isn't counted.
+			benchmark(jobSystem);
+
+			double best = 0.0;
+			for (uint32_t repeat = 0; repeat < options.repeatCount; ++repeat)
+			{
+				Clock::time_point start = Clock::now();
+				benchmark(jobSystem);
+				double milliseconds = std::chrono::duration<double, std::milli>(Clock::now() - start).count();
+				best = repeat == 0 ? milliseconds : std::min<double>(best, milliseconds);
+			}
+
+			if (threadCount == 1)
+			{
+				singleThreadMilliseconds = best;
+			}
+			double speedup = singleThreadMilliseconds / std::max<double>(best, 1e-9);
+			std::printf("%8u %12.3f %8.2fx %10.1f%%\n", threadCount, best, speedup, 100.0 * speedup / threadCount);
+		}
+		std::printf("\n");
+	}
+
+	void RunJobBenchmarks(BenchmarkOptions const& options)
+	{
+		// Items cost between 16 and 271 iterations, so equal ranges take unequal times.
+		const size_t itemCount = size_t{ 1 } << 20;
+		std::atomic<uint32_t> checksum{ 0 };
+
+		RunScaling("ParallelFor over 1M items of uneven cost", options, [&](RTJobSystem& jobSystem)
+			{
+				jobSystem.ParallelFor(itemCount, 64, [&](size_t begin, size_t end)
+					{
+						float sum = 0.f;
+						for (size_t i = begin; i < end; ++i)
+						{
+							uint32_t hash = Hash(static_cast<uint32_t>(i));
+							sum += Work(hash, 16 + (hash & 0xFF));
+						}
+						checksum.fetch_add(static_cast<uint32_t>(sum), std::memory_order_relaxed);
+					});
+			});
+
+		// Every inner job spawns one child and recurses into the other, waiting for the child at the end.
+		const uint32_t treeDepth = 16;
+		std::function<void(RTJobSystem&, uint32_t, uint32_t)> Fork = [&](RTJobSystem& jobSystem, uint32_t depth, uint32_t seed)
+			{
+				if (depth == 0)
+				{
+					checksum.fetch_add(static_cast<uint32_t>(Work(Hash(seed), 512)), std::memory_order_relaxed);
+					return;
+				}
+				RTJobHandle child = jobSystem.Run([&, depth, seed]() { Fork(jobSystem, depth - 1, seed * 2); });
+				Fork(jobSystem, depth - 1, seed * 2 + 1);
+				jobSystem.Wait(child);
+			};
+
+		RunScaling("Fork-join tree of 64K leaf jobs", options, [&](RTJobSystem& jobSystem)
+			{
+				Fork(jobSystem, treeDepth, 1);
+			});
+
+		std::printf("Checksum %u\n\n", checksum.load());
+	}
+
+	void RunBvhBenchmark(BenchmarkOptions const& options)
+	{
+		// Small random boxes in a unit cube, clustered along a few bands so the SAH has some structure to find.
+		std::vector<RTBoundingBox> bounds(options.primitiveCount);
+		for (uint32_t i = 0; i < options.primitiveCount; ++i)
+		{
+			float centre[3];
+			for (int axis = 0; axis < 3; ++axis)
+			{
+				centre[axis] = static_cast<float>(Hash(i * 3 + axis) & 0xFFFFFF) * (1.f / 16777216.f);
+			}
+			centre[1] = std::floor(centre[1] * 8.f) / 8.f + centre[1] * 0.05f;
+
+			float size = 0.001f + static_cast<float>(Hash(i ^ 0x5BD1E995u) & 0xFFFF) * (0.004f / 65536.f);
+			for (int axis = 0; axis < 3; ++axis)
+			{
+				bounds[i].minimum[axis] = centre[axis] - size;
+				bounds[i].maximum[axis] = centre[axis] + size;
+			}
+		}
+
+		char title[128];
+		std::snprintf(title, sizeof(title), "Binned SAH BVH build over %u boxes", options.primitiveCount);
+
+		RTBvh bvh;
+		RunScaling(title, options, [&](RTJobSystem& jobSystem) { bvh.Build(bounds, 4, jobSystem); });
+		std::printf("%zu nodes\n\n", bvh.GetNodes().size());
+	}
+
+	// A node of a pointer-linked tree, one cache line like a BVH node with its bounds and children.
+	struct PoolBenchmarkNode {
+		float				bounds[6];
+		PoolBenchmarkNode*	children[2];
+		uint32_t			seed;
+		uint32_t			padding[5];
+	};
+
+	struct HeapNodes {
+		PoolBenchmarkNode* Allocate() { return new PoolBenchmarkNode; }
+		void Free(PoolBenchmarkNode* node) { delete node; }
+	};
+
+	struct PoolNodes {
+		RTPoolAllocator&	pool;
+
+		PoolBenchmarkNode* Allocate() { return pool.New<PoolBenchmarkNode>(); }
+		void Free(PoolBenchmarkNode* node) { pool.Delete(node); }
+	};
+
+	// Subtrees of more nodes than this are split between jobs.
+	const uint32_t PoolBenchmarkGrain = 1 << 14;
+
+	// Builds a tree of nodeCount nodes, splitting the remaining nodes evenly between the children.
+	template<typename TNodes>
+	PoolBenchmarkNode* BuildTree(RTJobSystem& jobSystem, TNodes& nodes, uint32_t nodeCount, uint32_t seed)
+	{
+		if (nodeCount == 0)
+		{
+			return nullptr;
+		}
+
+		PoolBenchmarkNode* node = nodes.Allocate();
+		node->seed = seed;
+		for (int i = 0; i < 6; ++i)
+		{
+			node->bounds[i] = static_cast<float>(Hash(seed * 6 + i) & 0xFFFF);
+		}
+
+		uint32_t leftCount = (nodeCount - 1) / 2;
+		uint32_t rightCount = nodeCount - 1 - leftCount;
+		if (nodeCount > PoolBenchmarkGrain)
+		{
+			RTJobHandle left = jobSystem.Run([&, leftCount, seed]() { node->children[0] = BuildTree(jobSystem, nodes, leftCount, seed * 2); });
+			node->children[1] = BuildTree(jobSystem, nodes, rightCount, seed * 2 + 1);
+			jobSystem.Wait(left);
+		}
+		else
+		{
+			node->children[0] = BuildTree(jobSystem, nodes, leftCount, seed * 2);
+			node->children[1] = BuildTree(jobSystem, nodes, rightCount, seed * 2 + 1);
+		}
+		return node;
+	}
+
+	// Visits every node, which is where scattered nodes cost cache and TLB misses.
+	float TraverseTree(RTJobSystem& jobSystem, PoolBenchmarkNode const* node, uint32_t nodeCount)
+	{
+		if (!node)
+		{
+			return 0.f;
+		}
+
+		uint32_t leftCount = (nodeCount - 1) / 2;
+		uint32_t rightCount = nodeCount - 1 - leftCount;
+		float sum = node->bounds[0] + node->bounds[5];
+		if (nodeCount > PoolBenchmarkGrain)
+		{
+			float left = 0.f;
+			RTJobHandle leftJob = jobSystem.Run([&]() { left = TraverseTree(jobSystem, node->children[0], leftCount); });
+			float right = TraverseTree(jobSystem, node->children[1], rightCount);
+			jobSystem.Wait(leftJob);
+			return sum + left + right;
+		}
+		return sum + TraverseTree(jobSystem, node->children[0], leftCount) + TraverseTree(jobSystem, node->children[1], rightCount);
+	}
+
+	template<typename TNodes>
+	void ReleaseTree(RTJobSystem& jobSystem, TNodes& nodes, PoolBenchmarkNode* node, uint32_t nodeCount)
+	{
+		if (!node)
+		{
+			return;
+		}
+
+		uint32_t leftCount = (nodeCount - 1) / 2;
+		uint32_t rightCount = nodeCount - 1 - leftCount;
+		PoolBenchmarkNode* left = node->children[0];
+		PoolBenchmarkNode* right = node->children[1];
+		nodes.Free(node);
+		if (nodeCount > PoolBenchmarkGrain)
+		{
+			RTJobHandle leftJob = jobSystem.Run([&]() { ReleaseTree(jobSystem, nodes, left, leftCount); });
+			ReleaseTree(jobSystem, nodes, right, rightCount);
+			jobSystem.Wait(leftJob);
+		}
+		else
+		{
+			ReleaseTree(jobSystem, nodes, left, leftCount);
+			ReleaseTree(jobSystem, nodes, right, rightCount);
+		}
+	}
+
+	struct PoolBenchmarkTimes {
+		double	build = 0.0;
+		double	traverse = 0.0;
+		double	release = 0.0;
+	};
+
+	// Builds, traverses and releases the tree, best of the repeats for each phase. Release either frees
+	// every node or, given bulkRelease, releases them all at once.
+	template<typename TNodes>
+	PoolBenchmarkTimes TimeTree(RTJobSystem& jobSystem, TNodes& nodes, BenchmarkOptions const& options, std::function<void()> const& bulkRelease, float& checksum)
+	{
+		PoolBenchmarkTimes best;
+		for (uint32_t repeat = 0; repeat <= options.repeatCount; ++repeat)
+		{
+			Clock::time_point start = Clock::now();
+			PoolBenchmarkNode* root = BuildTree(jobSystem, nodes, options.nodeCount, 1);
+			Clock::time_point built = Clock::now();
+			checksum += TraverseTree(jobSystem, root, options.nodeCount);
+			Clock::time_point traversed = Clock::now();
+			if (bulkRelease)
+			{
+				bulkRelease();
+			}
+			else
+			{
+				ReleaseTree(jobSystem, nodes, root, options.nodeCount);
+			}
+			Clock::time_point released = Clock::now();
+
+			// The first run warms caches and allocations up and isn't counted.
+			if (repeat == 0)
+			{
+				continue;
+			}
+
+			PoolBenchmarkTimes times;
+			times.build = std::chrono::duration<double, std::milli>(built - start).count();
+			times.traverse = std::chrono::duration<double, std::milli>(traversed - built).count();
+			times.release = std::chrono::duration<double, std::milli>(released - traversed).count();
+			best.build = repeat == 1 ? times.build : std::min<double>(best.build, times.build);
+			best.traverse = repeat == 1 ? times.traverse : std::min<double>(best.traverse, times.traverse);
+			best.release = repeat == 1 ? times.release : std::min<double>(best.release, times.release);
+		}
+		return best;
+	}
+
+	void RunPoolBenchmark(BenchmarkOptions const& options)
+	{
+		std::printf("Tree of %u %zu byte nodes, built, traversed and released in parallel\n%8s  %-24s %12s %12s %12s\n",
+			options.nodeCount, sizeof(PoolBenchmarkNode), "threads", "allocator", "build ms", "traverse ms", "release ms");
+
+		float checksum = 0.f;
+		std::vector<uint32_t> threadCounts{ 1 };
+		if (options.maxThreads > 1)
+		{
+			threadCounts.push_back(options.maxThreads);
+		}
+
+		for (uint32_t threadCount : threadCounts)
+		{
+			RTJobSystem jobSystem(threadCount - 1);
+			auto Print = [threadCount](char const* allocator, PoolBenchmarkTimes const& times)
+				{
+					std::printf("%8u  %-24s %12.3f %12.3f %12.3f\n", threadCount, allocator, times.build, times.traverse, times.release);
+				};
+
+			HeapNodes heapNodes;
+			Print("operator new", TimeTree(jobSystem, heapNodes, options, nullptr, checksum));
+
+			RTPoolAllocator pool(sizeof(PoolBenchmarkNode));
+			PoolNodes poolNodes{ pool };
+			Print("pool, freeing each node", TimeTree(jobSystem, poolNodes, options, nullptr, checksum));
+			Print("pool, Reset()", TimeTree(jobSystem, poolNodes, options, [&]() { pool.Reset(); }, checksum));
+
+			RTPoolAllocator hugePagePool(sizeof(PoolBenchmarkNode), true);
+			PoolNodes hugePageNodes{ hugePagePool };
+			Print("pool, huge pages", TimeTree(jobSystem, hugePageNodes, options, [&]() { hugePagePool.Reset(); }, checksum));
+
+			if (threadCount == threadCounts.back())
+			{
+				RTPoolStats stats = hugePagePool.GetStats();
+				std::printf("Huge page pool: %zu chunks, %zu of them reserved huge pages\n", stats.chunkCount, stats.hugePageChunkCount);
+			}
+		}
+		std::printf("Checksum %.0f\n\n", checksum);
+	}
+}
+
+bool RTBenchmarks::IsBenchmark(std::vector<std::string> const& arguments)
+{
+	return std::find(arguments.begin(), arguments.end(), "-benchmark") != arguments.end();
+}
+
+std::string RTBenchmarks::GetUsage()
+{
+	return "RTEngine -benchmark jobs|bvh|pool|all [-threads N] [-primitives N] [-nodes N] [-repeat N]\n";
+}
+
+int RTBenchmarks::Run(std::vector<std::string> const& arguments)
+{
+	try
+	{
+		BenchmarkOptions options = ParseCommandLine(arguments);
+		std::printf("Up to %u threads, best of %u runs\n\n", options.maxThreads, options.repeatCount);
+
+		if (options.jobs)
+		{
+			RunJobBenchmarks(options);
+		}
+		if (options.bvh)
+		{
+			RunBvhBenchmark(options);
+		}
+		if (options.pool)
+		{
+			RunPoolBenchmark(options);
+		}
+		std::fflush(stdout);
+		return 0;
+	}
+	catch (std::exception const& e)
+	{
+		std::cerr << e.what() << "\n" << GetUsage();
+		return 1;
+	}
+}
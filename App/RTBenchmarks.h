@@ -0,0 +1,29 @@
+#pragma once
+
+#include <string>
+#include <vector>
+
+/*
+	CPU benchmarks run from the command line, printing their results to the standard output.
+
+		RTEngine.exe -benchmark jobs|bvh|pool|all [-threads N] [-primitives N] [-nodes N] [-repeat N]
+
+	jobs	Scaling of the job system from one thread to N on a synthetic workload: a ParallelFor over
+			items of uneven cost, and a recursive fork-join tree of small jobs.
+	bvh		Scaling of a parallel binned SAH BVH build over random boxes.
+	pool	A pointer-linked tree of cache line sized nodes built, traversed and released on one thread and
+			on N, with nodes from operator new and from RTPoolAllocator, with and without huge pages.
+
+	Each result is the best of the repeats, with its speedup and efficiency relative to one thread.
+*/
+
+namespace RTBenchmarks {
+
+	// True when the arguments, without the program name, ask for a benchmark. Arguments are UTF-8.
+	bool IsBenchmark(std::vector<std::string> const& arguments);
+
+	std::string GetUsage();
+
+	// Returns the process exit code.
+	int Run(std::vector<std::string> const& arguments);
+}
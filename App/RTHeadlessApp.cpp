@@ -0,0 +1,303 @@
+#include "RTHeadlessApp.h"
+#include "../Scene/RTGltfLoader.h"
+#include "../Scene/RTProceduralScene.h"
+#include "../Core/RTTrace.h"
+#include <algorithm>
+#include <exception>
+#include <iostream>
+#include <stdexcept>
+
+namespace {
+
+	// Every primitive of a glTF mesh goes into one Mesh, so the scene's instances keep their mesh indices.
+	void LoadGltfScene(std::filesystem::path const& path, std::vector<Mesh>& meshes, std::vector<MeshInstance>& instances)
+	{
+		std::unique_ptr<RTGltfScene> scene = RTGltfScene::LoadFromFile(path);
+
+		meshes.resize(scene->meshes.size());
+		for (size_t i = 0; i < scene->meshes.size(); ++i)
+		{
+			Mesh& mesh = meshes[i];
+			for (RTGltfPrimitive const& primitive : scene->meshes[i].primitives)
+			{
+				uint32_t baseVertex = static_cast<uint32_t>(mesh.vertices.size());
+				mesh.vertices.insert(mesh.vertices.end(), primitive.vertices.begin(), primitive.vertices.end());
+				for (uint32_t index : primitive.indices)
+				{
+					mesh.indices.push_back(baseVertex + index);
+				}
+			}
+		}
+		instances = scene->instances;
+
+		// Meshes without triangles can't be uploaded, and nothing would be traced against them anyway.
+		std::vector<bool> hasTriangles(meshes.size(), false);
+		std::vector<uint32_t> remapped(meshes.size(), 0);
+		std::vector<Mesh> usedMeshes;
+		for (size_t i = 0; i < meshes.size(); ++i)
+		{
+			hasTriangles[i] = !meshes[i].indices.empty();
+			remapped[i] = static_cast<uint32_t>(usedMeshes.size());
+			if (hasTriangles[i])
+			{
+				usedMeshes.push_back(std::move(meshes[i]));
+			}
+		}
+		instances.erase(std::remove_if(instances.begin(), instances.end(),
+			[&hasTriangles](MeshInstance const& instance) { return !hasTriangles[instance.meshIndex]; }), instances.end());
+		for (MeshInstance& instance : instances)
+		{
+			instance.meshIndex = remapped[instance.meshIndex];
+		}
+		meshes = std::move(usedMeshes);
+
+		if (meshes.empty() || instances.empty())
+		{
+			throw std::runtime_error("ERROR: The scene " + path.string() + " has no triangles to render.");
+		}
+	}
+
+	uint32_t ParseUnsigned(std::string const& option, std::string const& value, uint32_t minimum)
+	{
+		size_t parsedLength = 0;
+		unsigned long long number = 0;
+		try
+		{
+			number = std::stoull(value, &parsedLength);
+		}
+		catch (std::exception const&)
+		{
+			parsedLength = 0;
+		}
+		if (parsedLength != value.size() || value[0] == '-' || number < minimum || number > 0xFFFFFFFFull)
+		{
+			throw std::runtime_error("ERROR: " + option + " needs a whole number of at least " + std::to_string(minimum) + ", not '" + value + "'.");
+		}
+		return static_cast<uint32_t>(number);
+	}
+}
+
+bool RTHeadlessApp::IsHeadless(std::vector<std::string> const& arguments)
+{
+	return std::find(arguments.begin(), arguments.end(), "-headless") != arguments.end();
+}
+
+RTHeadlessOptions RTHeadlessApp::ParseCommandLine(std::vector<std::string> const& arguments)
+{
+	RTHeadlessOptions options;
+
+	for (size_t i = 0; i < arguments.size(); ++i)
+	{
+		std::string const& option = arguments[i];
+		auto NextValue = [&]() -> std::string const&
+			{
+				if (i + 1 >= arguments.size())
+				{
+					throw std::runtime_error("ERROR: " + option + " needs a value.");
+				}
+				return arguments[++i];
+			};
+
+		if (option == "-headless")
+		{
+		}
+		else if (option == "-software")
+		{
+			options.software = true;
+		}
+		else if (option == "-width")
+		{
+			options.width = ParseUnsigned(option, NextValue(), 1);
+		}
+		else if (option == "-height")
+		{
+			options.height = ParseUnsigned(option, NextValue(), 1);
+		}
+		else if (option == "-frames")
+		{
+			options.batch.frameCount = ParseUnsigned(option, NextValue(), 1);
+		}
+		else if (option == "-first")
+		{
+			options.batch.firstFrame = ParseUnsigned(option, NextValue(), 0);
+		}
+		else if (option == "-samples")
+		{
+			options.batch.samplesPerImage = ParseUnsigned(option, NextValue(), 1);
+		}
+		else if (option == "-bounces")
+		{
+			options.pathTracing.enabled = 1;
+			options.pathTracing.maxBounces = ParseUnsigned(option, NextValue(), 0);
+			if (options.pathTracing.maxBounces > MaxPathBounces)
+			{
+				throw std::runtime_error("ERROR: -bounces can't exceed " + std::to_string(MaxPathBounces) + ".");
+			}
+		}
+		else if (option == "-spp")
+		{
+			options.pathTracing.samplesPerPixel = ParseUnsigned(option, NextValue(), 1);
+		}
+		else if (option == "-script")
+		{
+			options.scriptPath = std::filesystem::u8path(NextValue());
+		}
+		else if (option == "-scene")
+		{
+			options.scenePath = std::filesystem::u8path(NextValue());
+		}
+		else if (option == "-procedural")
+		{
+			options.proceduralTriangles = ParseUnsigned(option, NextValue(), 1);
+			options.proceduralInstances = ParseUnsigned(option, NextValue(), 1);
+		}
+		else if (option == "-output")
+		{
+			options.batch.outputDirectory = std::filesystem::u8path(NextValue());
+		}
+		else if (option == "-prefix")
+		{
+			options.batch.fileNamePrefix = NextValue();
+		}
+		else if (option == "-format")
+		{
+			std::string const& format = NextValue();
+			if (format != "png" && format != "ppm")
+			{
+				throw std::runtime_error("ERROR: -format must be png or ppm, not '" + format + "'.");
+			}
+			options.batch.extension = "." + format;
+		}
+		else if (option == "-trace")
+		{
+			options.tracePath = std::filesystem::u8path(NextValue());
+		}
+		else
+		{
+			throw std::runtime_error("ERROR: Unknown option '" + option + "'.");
+		}
+	}
+
+	if (!options.scenePath.empty() && options.proceduralTriangles > 0)
+	{
+		throw std::runtime_error("ERROR: -scene and -procedural can't be combined.");
+	}
+
+	return options;
+}
+
+std::string RTHeadlessApp::GetUsage()
+{
+	return
+		"RTEngine -headless [-software] [-width W] [-height H] [-frames N] [-first F] [-samples S]\n"
+		"                   [-script file.txt] [-scene file.glb | -procedural triangles instances]\n"
+		"                   [-bounces B] [-spp N] [-output directory] [-prefix name] [-format png|ppm] [-trace file.json]\n";
+}
+
+int RTHeadlessApp::Run(RTHeadlessOptions const& options, RTRenderDevice& device)
+{
+	try
+	{
+		if (!options.tracePath.empty())
+		{
+			RTTrace::SetThreadName("Main");
+			RTTrace::SetEnabled(true);
+		}
+
+		std::vector<Mesh> meshes;
+		std::vector<MeshInstance> instances;
+		if (!options.scenePath.empty())
+		{
+			LoadGltfScene(options.scenePath, meshes, instances);
+		}
+		else if (options.proceduralTriangles > 0)
+		{
+			RTProceduralSceneDesc sceneDesc;
+			sceneDesc.targetTriangleCount = options.proceduralTriangles;
+			sceneDesc.instanceCount = options.proceduralInstances;
+			sceneDesc.uniqueMeshCount = std::min<size_t>(options.proceduralInstances, 3);
+
+			RTProceduralScene scene = RTProceduralGeometry::CreateScene(sceneDesc);
+			meshes = std::move(scene.meshes);
+			instances = std::move(scene.instances);
+		}
+		else
+		{
+			// The triangle RTDXInterface renders without a scene mesh
+			Mesh triangle;
+			triangle.vertices = {
+				{ RTVector3D::RTVec3DImpl(0.0f, 0.5f, 0.0f), RTVector3D::RTVec3DImpl(0.0f, 0.0f, -1.0f) },
+				{ RTVector3D::RTVec3DImpl(0.5f, -0.5f, 0.0f), RTVector3D::RTVec3DImpl(0.0f, 0.0f, -1.0f) },
+				{ RTVector3D::RTVec3DImpl(-0.5f, -0.5f, 0.0f), RTVector3D::RTVec3DImpl(0.0f, 0.0f, -1.0f) }
+			};
+			triangle.indices = { 0, 1, 2 };
+			meshes.push_back(std::move(triangle));
+			instances.push_back(MeshInstance{ 0, RTMatrix4D::RTMatrix4DImpl{} });
+		}
+
+		RTBatchScript script;
+		if (!options.scriptPath.empty())
+		{
+			script = RTBatchScript::Load(options.scriptPath);
+		}
+
+		RTFrameRenderer renderer(device, options.width, options.height);
+		renderer.SetScene(meshes, std::move(instances));
+		if (options.batch.samplesPerImage > 1)
+		{
+			renderer.SetAccumulation(options.batch.samplesPerImage);
+		}
+		renderer.SetPathTracing(options.pathTracing);
+
+		std::cout << "Rendering " << options.batch.frameCount << " frames of " << options.width << "x" << options.height
+			<< " with " << options.batch.samplesPerImage * options.pathTracing.samplesPerPixel << " samples per pixel";
+		if (options.pathTracing.enabled)
+		{
+			std::cout << ", path traced with up to " << options.pathTracing.maxBounces << " bounces,";
+		}
+		std::cout << " on the " << device.GetName() << " device to " << options.batch.outputDirectory.string() << "\n";
+
+		RTBatchRenderStats stats = RTBatchRenderer::Render(renderer, script, options.batch);
+
+		std::cout << stats.frameCount << " frames in " << stats.totalSeconds << " s, "
+			<< stats.frameCount / std::max<double>(stats.totalSeconds, 1e-9) << " frames/s. "
+			<< "Waited " << stats.frameWaitSeconds << " s for frames and " << stats.writerWaitSeconds << " s for the writer, "
+			<< "which spent " << stats.writeSeconds << " s writing.\n";
+		std::cout << stats.frameTimes.Format("Frame time");
+		std::cout << "Frame arenas: peak " << stats.frameArenas.peakUsedBytes << " bytes, "
+			<< stats.frameArenas.blockAllocationCount << " heap blocks allocated.\n";
+
+		// Depths after the last one any ray reached are left out.
+		uint64_t rayCount = 0;
+		uint32_t depthCount = 0;
+		for (uint32_t depth = 0; depth < RayCounterCount; ++depth)
+		{
+			rayCount += stats.rayCounts[depth];
+			depthCount = stats.rayCounts[depth] > 0 ? depth + 1 : depthCount;
+		}
+		std::cout << "Rays: " << rayCount << ", " << rayCount / std::max<double>(stats.totalSeconds, 1e-9) / 1e6 << " Mrays/s. By depth:";
+		for (uint32_t depth = 0; depth < depthCount; ++depth)
+		{
+			std::cout << " " << stats.rayCounts[depth];
+		}
+		std::cout << "\n";
+
+		if (!options.tracePath.empty())
+		{
+			RTTrace::SetEnabled(false);
+			RTTrace::WriteChromeTrace(options.tracePath);
+			std::cout << "Trace written to " << options.tracePath.string();
+			if (uint64_t dropped = RTTrace::GetDroppedEventCount())
+			{
+				std::cout << ", " << dropped << " events were dropped";
+			}
+			std::cout << "\n";
+		}
+		return 0;
+	}
+	catch (std::exception const& e)
+	{
+		std::cerr << e.what() << "\n";
+		return 1;
+	}
+}
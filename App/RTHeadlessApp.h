@@ -0,0 +1,60 @@
+#pragma once
+
+#include "../Renderer/RTBatchRenderer.h"
+#include "../RHI/RTRenderDevice.h"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+/*
+	Batch rendering from the command line, without a window: loads or generates a scene, renders the
+	frames of a camera and light script with RTBatchRenderer and writes them as images.
+
+		RTEngine.exe -headless [-software] [-width W] [-height H] [-frames N] [-first F] [-samples S]
+		             [-script file.txt] [-scene file.glb | -procedural triangles instances]
+		             [-bounces B] [-spp N] [-output directory] [-prefix name] [-format png|ppm] [-trace file.json]
+
+	Without a scene the triangle RTDXInterface falls back to is rendered. With more than one sample, every
+	image is progressively accumulated over S frames of jittered samples. -bounces path traces the frames
+	with up to B bounces, and -spp traces N samples of every pixel in each frame. The rays traced at every
+	depth are reported once the batch is done.
+*/
+
+struct RTHeadlessOptions {
+	uint32_t				width = 1280;
+	uint32_t				height = 720;
+	RTBatchRenderDesc		batch;
+
+	// Keyframes of the camera and light, the default scene constants without one
+	std::filesystem::path	scriptPath;
+
+	// A .glb scene, or a procedural scene when proceduralTriangles is non-zero
+	std::filesystem::path	scenePath;
+	size_t					proceduralTriangles = 0;
+	size_t					proceduralInstances = 1;
+
+	// Renders on RTSoftwareRenderDevice rather than the D3D12 device
+	bool					software = false;
+
+	// Lambert shading of the primary hits unless -bounces is given
+	PathTracingConstants	pathTracing;
+
+	// Chrome trace event JSON of the batch's CPU timeline, not traced when empty
+	std::filesystem::path	tracePath;
+};
+
+namespace RTHeadlessApp {
+
+	// True when the arguments, without the program name, ask for headless rendering. Arguments are UTF-8.
+	bool IsHeadless(std::vector<std::string> const& arguments);
+
+	// Throws std::runtime_error on an unknown option or a missing or invalid value.
+	RTHeadlessOptions ParseCommandLine(std::vector<std::string> const& arguments);
+
+	std::string GetUsage();
+
+	// Renders the batch on the device, reporting progress and errors on the standard streams. Returns the process exit code.
+	int Run(RTHeadlessOptions const& options, RTRenderDevice& device);
+}
@@ -14,38 +14,29 @@
 // Helper class for animation and simulation timing.
 #pragma once
 
+#include <chrono>
 #include <cmath>
 #include <cstdint>
-#include <exception>
-#include "profileapi.h"
+#include "../Core/RTFrameTimeHistogram.h"
 
- // Helper class for animation and simulation timing.
+ // Helper class for animation and simulation timing. Timing comes from std::chrono::steady_clock,
+ // so it is portable, and every tick records the real frame time in a histogram.
 class StepTimer
 {
 public:
     StepTimer() noexcept(false) :
+        m_lastTime(Clock::now()),
+        m_maxDelta(std::chrono::duration_cast<Clock::duration>(std::chrono::milliseconds(100))),
         m_elapsedTicks(0),
         m_totalTicks(0),
         m_leftOverTicks(0),
         m_frameCount(0),
         m_framesPerSecond(0),
         m_framesThisSecond(0),
-        m_qpcSecondCounter(0),
+        m_secondCounter(Clock::duration::zero()),
         m_isFixedTimeStep(false),
         m_targetElapsedTicks(TicksPerSecond / 60)
     {
-        if (!QueryPerformanceFrequency(&m_qpcFrequency))
-        {
-            throw std::exception();
-        }
-
-        if (!QueryPerformanceCounter(&m_qpcLastTime))
-        {
-            throw std::exception();
-        }
-
-        // Initialize max delta to 1/10 of a second.
-        m_qpcMaxDelta = static_cast<uint64_t>(m_qpcFrequency.QuadPart / 10);
     }
 
     // Get elapsed time since the previous Update call.
@@ -62,6 +53,10 @@ public:
     // Get the current framerate.
     uint32_t GetFramesPerSecond() const noexcept { return m_framesPerSecond; }
 
+    // Get the distribution of the time between Tick calls, unclamped and including ticks which ran no update.
+    const RTFrameTimeHistogram& GetFrameTimes() const noexcept { return m_frameTimes; }
+    void ClearFrameTimes() { m_frameTimes.Clear(); }
+
     // Set whether to use fixed or variable timestep mode.
     void SetFixedTimeStep(bool isFixedTimestep) noexcept { m_isFixedTimeStep = isFixedTimestep; }
 
@@ -81,15 +76,12 @@ public:
 
     void ResetElapsedTime()
     {
-        if (!QueryPerformanceCounter(&m_qpcLastTime))
-        {
-            throw std::exception();
-        }
+        m_lastTime = Clock::now();
 
         m_leftOverTicks = 0;
         m_framesPerSecond = 0;
         m_framesThisSecond = 0;
-        m_qpcSecondCounter = 0;
+        m_secondCounter = Clock::duration::zero();
     }
 
     // Update timer state, calling the specified Update function the appropriate number of times.
@@ -97,27 +89,21 @@ public:
     void Tick(const TUpdate& update)
     {
         // Query the current time.
-        LARGE_INTEGER currentTime;
+        Clock::time_point currentTime = Clock::now();
+        Clock::duration clockDelta = currentTime - m_lastTime;
 
-        if (!QueryPerformanceCounter(&currentTime))
-        {
-            throw std::exception();
-        }
-
-        uint64_t timeDelta = static_cast<uint64_t>(currentTime.QuadPart - m_qpcLastTime.QuadPart);
-
-        m_qpcLastTime = currentTime;
-        m_qpcSecondCounter += timeDelta;
+        m_lastTime = currentTime;
+        m_secondCounter += clockDelta;
+        m_frameTimes.AddSample(std::chrono::duration<double, std::milli>(clockDelta).count());
 
         // Clamp excessively large time deltas (e.g. after paused in the debugger).
-        if (timeDelta > m_qpcMaxDelta)
+        if (clockDelta > m_maxDelta)
         {
-            timeDelta = m_qpcMaxDelta;
+            clockDelta = m_maxDelta;
         }
 
-        // Convert QPC units into a canonical tick format. This cannot overflow due to the previous clamp.
-        timeDelta *= TicksPerSecond;
-        timeDelta /= static_cast<uint64_t>(m_qpcFrequency.QuadPart);
+        // Convert clock units into a canonical tick format.
+        uint64_t timeDelta = static_cast<uint64_t>(std::chrono::duration_cast<Ticks>(clockDelta).count());
 
         const uint32_t lastFrameCount = m_frameCount;
 
@@ -166,19 +152,21 @@ public:
             m_framesThisSecond++;
         }
 
-        if (m_qpcSecondCounter >= static_cast<uint64_t>(m_qpcFrequency.QuadPart))
+        if (m_secondCounter >= std::chrono::seconds(1))
         {
             m_framesPerSecond = m_framesThisSecond;
             m_framesThisSecond = 0;
-            m_qpcSecondCounter %= static_cast<uint64_t>(m_qpcFrequency.QuadPart);
+            m_secondCounter %= std::chrono::duration_cast<Clock::duration>(std::chrono::seconds(1));
         }
     }
 
 private:
-    // Source timing data uses QPC units.
-    LARGE_INTEGER m_qpcFrequency;
-    LARGE_INTEGER m_qpcLastTime;
-    uint64_t m_qpcMaxDelta;
+    using Clock = std::chrono::steady_clock;
+    using Ticks = std::chrono::duration<int64_t, std::ratio<1, TicksPerSecond>>;
+
+    // Source timing data uses the clock's units.
+    Clock::time_point m_lastTime;
+    Clock::duration m_maxDelta;
 
     // Derived timing data uses a canonical tick format.
     uint64_t m_elapsedTicks;
@@ -189,7 +177,8 @@ private:
     uint32_t m_frameCount;
     uint32_t m_framesPerSecond;
     uint32_t m_framesThisSecond;
-    uint64_t m_qpcSecondCounter;
+    Clock::duration m_secondCounter;
+    RTFrameTimeHistogram m_frameTimes;
 
     // Members for configuring fixed timestep mode.
     bool m_isFixedTimeStep;
@@ -0,0 +1,55 @@
+#include "RTFrameArenas.h"
+#include "RTJobSystem.h"
+#include <stdexcept>
+
+RTFrameArenas::RTFrameArenas(uint32_t frameCount, RTJobSystem& jobSystem, size_t initialCapacity) :
+	jobSystem{ jobSystem },
+	frameCount{ frameCount },
+	threadCount{ jobSystem.GetThreadCount() },
+	currentFrame{ 0 }
+{
+	if (frameCount == 0)
+	{
+		throw std::runtime_error("ERROR: Frame arenas need at least one frame.");
+	}
+
+	arenas.reserve(frameCount * threadCount);
+	for (size_t i = 0; i < frameCount * threadCount; ++i)
+	{
+		arenas.push_back(std::make_unique<RTLinearArena>(initialCapacity));
+	}
+}
+
+void RTFrameArenas::BeginFrame(uint32_t frameIndex)
+{
+	if (frameIndex >= frameCount)
+	{
+		throw std::runtime_error("ERROR: Frame index out of range of the frame arenas.");
+	}
+
+	currentFrame = frameIndex;
+	for (size_t thread = 0; thread < threadCount; ++thread)
+	{
+		GetArena(frameIndex, thread).Reset();
+	}
+}
+
+RTLinearArena& RTFrameArenas::GetArena()
+{
+	return GetArena(currentFrame, jobSystem.GetCurrentThreadIndex());
+}
+
+RTLinearArena& RTFrameArenas::GetArena(uint32_t frameIndex, size_t threadIndex)
+{
+	return *arenas[frameIndex * threadCount + threadIndex];
+}
+
+RTArenaStats RTFrameArenas::GetStats() const
+{
+	RTArenaStats stats;
+	for (std::unique_ptr<RTLinearArena> const& arena : arenas)
+	{
+		stats += arena->GetStats();
+	}
+	return stats;
+}
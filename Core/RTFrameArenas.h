@@ -0,0 +1,54 @@
+#pragma once
+
+#include "RTLinearArena.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+class RTJobSystem;
+
+/*
+	Linear arenas for the transient CPU data of frames in flight, one per frame and thread of a job system.
+	A frame's arenas are reset when its index comes round again, once the caller has waited for the GPU to
+	finish with the frame which last used it, so data recorded for the GPU may live in them until then.
+	Jobs allocate from the arena of the worker they run on, so threads never contend for an arena.
+
+		frame.fence->Wait(frame.fenceValue);
+		frameArenas.BeginFrame(frameIndex);
+		RTInstanceDesc* descs = frameArenas.GetArena().AllocateArray<RTInstanceDesc>(instanceCount);
+*/
+
+class RTFrameArenas {
+
+public:
+	RTFrameArenas(uint32_t frameCount, RTJobSystem& jobSystem, size_t initialCapacity = 64 * 1024);
+
+	RTFrameArenas(RTFrameArenas const&) = delete;
+	RTFrameArenas& operator =(RTFrameArenas const&) = delete;
+
+	// Resets the arenas of the frame index and makes it current. Nothing allocated the last time the index
+	// was current may still be in use.
+	void BeginFrame(uint32_t frameIndex);
+
+	// The calling thread's arena of the current frame. Threads which aren't workers of the job system share
+	// one arena, so of those only the thread which calls BeginFrame() may use it.
+	RTLinearArena& GetArena();
+
+	RTLinearArena& GetArena(uint32_t frameIndex, size_t threadIndex);
+
+	// Summed over every arena, the peak being the sum of each arena's peak.
+	RTArenaStats GetStats() const;
+
+	uint32_t GetFrameCount() const { return frameCount; }
+	uint32_t GetCurrentFrameIndex() const { return currentFrame; }
+
+private:
+	RTJobSystem&								jobSystem;
+	uint32_t									frameCount;
+	size_t										threadCount;
+	uint32_t									currentFrame;
+
+	// threadCount arenas for every frame, allocated apart so threads don't share their cache lines
+	std::vector<std::unique_ptr<RTLinearArena>>	arenas;
+};
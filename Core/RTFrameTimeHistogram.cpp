@@ -0,0 +1,101 @@
+#include "RTFrameTimeHistogram.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+RTFrameTimeHistogram::RTFrameTimeHistogram() :
+	buckets(BucketCount, 0),
+	sampleCount{ 0 },
+	totalMilliseconds{ 0.0 },
+	minimum{ 0.0 },
+	maximum{ 0.0 }
+{
+}
+
+void RTFrameTimeHistogram::AddSample(double milliseconds)
+{
+	milliseconds = std::max<double>(milliseconds, 0.0);
+
+	++buckets[GetBucket(milliseconds)];
+	minimum = sampleCount == 0 ? milliseconds : std::min<double>(minimum, milliseconds);
+	maximum = sampleCount == 0 ? milliseconds : std::max<double>(maximum, milliseconds);
+	totalMilliseconds += milliseconds;
+	++sampleCount;
+}
+
+double RTFrameTimeHistogram::GetPercentile(double percentage) const
+{
+	if (sampleCount == 0)
+	{
+		return 0.0;
+	}
+
+	double fraction = std::min<double>(std::max<double>(percentage, 0.0), 100.0) / 100.0;
+	uint64_t rank = std::max<uint64_t>(static_cast<uint64_t>(std::ceil(fraction * static_cast<double>(sampleCount))), 1);
+
+	// A bucket's upper bound overestimates its samples by at most the bucket's width, and the
+	// exact extremes are tighter bounds for the first and last buckets.
+	uint64_t counted = 0;
+	for (size_t bucket = 0; bucket < BucketCount; ++bucket)
+	{
+		counted += buckets[bucket];
+		if (counted >= rank)
+		{
+			return std::min<double>(std::max<double>(GetBucketUpperBound(bucket), minimum), maximum);
+		}
+	}
+	return maximum;
+}
+
+RTFrameTimeSummary RTFrameTimeHistogram::GetSummary() const
+{
+	RTFrameTimeSummary summary;
+	if (sampleCount == 0)
+	{
+		return summary;
+	}
+
+	summary.p50 = GetPercentile(50.0);
+	summary.p95 = GetPercentile(95.0);
+	summary.p99 = GetPercentile(99.0);
+	summary.minimum = minimum;
+	summary.average = totalMilliseconds / static_cast<double>(sampleCount);
+	summary.maximum = maximum;
+	summary.sampleCount = sampleCount;
+	return summary;
+}
+
+std::string RTFrameTimeHistogram::Format(std::string const& name) const
+{
+	RTFrameTimeSummary summary = GetSummary();
+
+	char line[256];
+	std::snprintf(line, sizeof(line), "%s: p50 %.3f ms, p95 %.3f ms, p99 %.3f ms, max %.3f ms (%llu frames)\n",
+		name.c_str(), summary.p50, summary.p95, summary.p99, summary.maximum, static_cast<unsigned long long>(summary.sampleCount));
+	return line;
+}
+
+void RTFrameTimeHistogram::Clear()
+{
+	std::fill(buckets.begin(), buckets.end(), 0);
+	sampleCount = 0;
+	totalMilliseconds = 0.0;
+	minimum = 0.0;
+	maximum = 0.0;
+}
+
+size_t RTFrameTimeHistogram::GetBucket(double milliseconds)
+{
+	if (milliseconds < MinimumMilliseconds)
+	{
+		return 0;
+	}
+
+	double bucket = std::floor(std::log(milliseconds / MinimumMilliseconds) / std::log(BucketRatio)) + 1.0;
+	return std::min<size_t>(static_cast<size_t>(std::min<double>(bucket, static_cast<double>(BucketCount))), BucketCount - 1);
+}
+
+double RTFrameTimeHistogram::GetBucketUpperBound(size_t bucket)
+{
+	return MinimumMilliseconds * std::pow(BucketRatio, static_cast<double>(bucket));
+}
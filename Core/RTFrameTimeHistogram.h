@@ -0,0 +1,59 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/*
+	Distribution of frame times over a whole run, to see stutter an average frame rate hides.
+	Samples are counted in logarithmically spaced buckets, each 2% wider than the one before, so
+	recording a frame is constant time, memory doesn't grow with the run's length and percentiles
+	are within 2% of the exact value at any frame time. The minimum and maximum are exact.
+*/
+
+// Percentiles of the frame times recorded so far, in milliseconds.
+struct RTFrameTimeSummary {
+	double		p50 = 0.0;
+	double		p95 = 0.0;
+	double		p99 = 0.0;
+	double		minimum = 0.0;
+	double		average = 0.0;
+	double		maximum = 0.0;
+	uint64_t	sampleCount = 0;
+};
+
+class RTFrameTimeHistogram {
+
+public:
+	// The first bucket holds everything below MinimumMilliseconds, the last everything from about 10 s on.
+	static constexpr double MinimumMilliseconds = 0.01;
+	static constexpr double BucketRatio = 1.02;
+	static constexpr size_t BucketCount = 700;
+
+	RTFrameTimeHistogram();
+
+	void AddSample(double milliseconds);
+
+	// Nearest rank percentile for a percentage from 0 to 100, 0 without samples.
+	double GetPercentile(double percentage) const;
+
+	RTFrameTimeSummary GetSummary() const;
+
+	// One line with the percentiles, labelled with the name.
+	std::string Format(std::string const& name) const;
+
+	void Clear();
+
+	uint64_t GetSampleCount() const { return sampleCount; }
+
+private:
+	static size_t GetBucket(double milliseconds);
+	static double GetBucketUpperBound(size_t bucket);
+
+	std::vector<uint64_t>	buckets;
+	uint64_t				sampleCount;
+	double					totalMilliseconds;
+	double					minimum;
+	double					maximum;
+};
@@ -0,0 +1,541 @@
+#include "RTJobSystem.h"
+#include "RTTrace.h"
+#include <algorithm>
+#include <exception>
+#include <stdexcept>
+#include <string>
+
+struct RTJob {
+	std::function<void()>	function;
+
+	// Run instead of the function when set. The arguments are stored in the job itself, so jobs the system
+	// creates in large numbers, such as ParallelFor's splits, never allocate for captures.
+	void					(*rangeFunction)(void* state, size_t begin, size_t end) = nullptr;
+	void*					rangeState = nullptr;
+	size_t					rangeBegin = 0;
+	size_t					rangeEnd = 0;
+
+	// Pool of the job system the job was created by, which it is returned to
+	RTPoolAllocator*		pool = nullptr;
+
+	// Held by handles, by the scheduler from Submit() until the job has run, and by continuation lists
+	std::atomic<uint32_t>	references{ 1 };
+
+	// Dependencies which haven't finished, plus one until the job is submitted
+	std::atomic<uint32_t>	pendingDependencies{ 1 };
+
+	std::atomic<bool>		submitted{ false };
+	std::atomic<bool>		finished{ false };
+	std::exception_ptr		error;
+
+	// Jobs which depend on this one, scheduled once it has finished
+	std::mutex				continuationMutex;
+	std::vector<RTJob*>		continuations;
+
+	// Neighbours in the system's queue of injected jobs
+	RTJob*					injectedPrevious = nullptr;
+	RTJob*					injectedNext = nullptr;
+};
+
+namespace {
+
+	// Ranges are run in chunks of at least this many per thread, so chunks are small enough for lazy
+	// splitting to balance the load and large enough that calling the function per chunk costs nothing.
+	const size_t ChunksPerThread = 32;
+
+	// Failed attempts to find a job before a worker goes to sleep.
+	const uint32_t SpinCount = 64;
+
+	thread_local void* currentWorker = nullptr;
+
+	void AddReference(RTJob* job)
+	{
+		job->references.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void Release(RTJob* job)
+	{
+		if (job->references.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			job->pool->Delete(job);
+		}
+	}
+}
+
+RTJobHandle::RTJobHandle(RTJobHandle const& other) :
+	job{ other.job }
+{
+	if (job)
+	{
+		AddReference(job);
+	}
+}
+
+RTJobHandle::RTJobHandle(RTJobHandle&& other) noexcept :
+	job{ other.job }
+{
+	other.job = nullptr;
+}
+
+RTJobHandle& RTJobHandle::operator =(RTJobHandle other) noexcept
+{
+	std::swap(job, other.job);
+	return *this;
+}
+
+RTJobHandle::~RTJobHandle()
+{
+	if (job)
+	{
+		Release(job);
+	}
+}
+
+bool RTJobHandle::IsFinished() const
+{
+	return job && job->finished.load(std::memory_order_acquire);
+}
+
+struct RTJobSystem::ParallelForState {
+	RTJobSystem*								system;
+	std::function<void(size_t, size_t)> const*	function;
+	size_t										chunkSize;
+	std::atomic<size_t>							remaining;
+
+	std::mutex									errorMutex;
+	std::exception_ptr							error;
+};
+
+RTJobSystem::RTJobSystem(size_t workerCount) :
+	jobPool{ sizeof(RTJob) },
+	injectedHead{ nullptr },
+	injectedTail{ nullptr },
+	injectedCount{ 0 },
+	workEpoch{ 0 },
+	sleepingWorkers{ 0 },
+	stopping{ false }
+{
+	workers.reserve(workerCount);
+	for (size_t i = 0; i < workerCount; ++i)
+	{
+		std::unique_ptr<Worker> worker = std::make_unique<Worker>();
+		worker->system = this;
+		worker->index = i;
+		worker->randomState = 0x9E3779B97F4A7C15ull * (i + 1);
+		workers.push_back(std::move(worker));
+	}
+
+	// Started once every deque exists, as workers steal from all of them.
+	for (std::unique_ptr<Worker>& worker : workers)
+	{
+		Worker* started = worker.get();
+		worker->thread = std::thread([this, started]() { WorkerLoop(*started); });
+	}
+}
+
+RTJobSystem::~RTJobSystem()
+{
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+		stopping.store(true);
+	}
+	wake.notify_all();
+
+	for (std::unique_ptr<Worker>& worker : workers)
+	{
+		worker->thread.join();
+	}
+}
+
+RTJobSystem& RTJobSystem::GetDefault()
+{
+	static RTJobSystem jobSystem(std::max<size_t>(std::thread::hardware_concurrency(), 1) - 1);
+	return jobSystem;
+}
+
+RTJobHandle RTJobSystem::Create(std::function<void()> function)
+{
+	RTJob* job = jobPool.New<RTJob>();
+	job->pool = &jobPool;
+	job->function = std::move(function);
+	return RTJobHandle(job);
+}
+
+void RTJobSystem::AddDependency(RTJobHandle const& job, RTJobHandle const& dependency)
+{
+	if (!job || !dependency)
+	{
+		throw std::runtime_error("ERROR: A dependency needs two jobs.");
+	}
+	if (job.job->submitted.load(std::memory_order_relaxed))
+	{
+		throw std::runtime_error("ERROR: Dependencies must be added before the job is submitted.");
+	}
+
+	std::lock_guard<std::mutex> lock(dependency.job->continuationMutex);
+	if (!dependency.job->finished.load(std::memory_order_relaxed))
+	{
+		job.job->pendingDependencies.fetch_add(1, std::memory_order_relaxed);
+		AddReference(job.job);
+		dependency.job->continuations.push_back(job.job);
+	}
+}
+
+void RTJobSystem::Submit(RTJobHandle const& job)
+{
+	if (!job || job.job->submitted.exchange(true))
+	{
+		throw std::runtime_error("ERROR: A job can only be submitted once.");
+	}
+
+	// The scheduler's reference, released once the job has run.
+	AddReference(job.job);
+	if (job.job->pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+	{
+		Schedule(job.job);
+	}
+}
+
+RTJobHandle RTJobSystem::Run(std::function<void()> function)
+{
+	RTJobHandle job = Create(std::move(function));
+	Submit(job);
+	return job;
+}
+
+RTJobHandle RTJobSystem::Then(RTJobHandle const& job, std::function<void()> function)
+{
+	RTJobHandle continuation = Create(std::move(function));
+	AddDependency(continuation, job);
+	Submit(continuation);
+	return continuation;
+}
+
+void RTJobSystem::Wait(RTJobHandle const& job)
+{
+	if (!job || !job.job->submitted.load(std::memory_order_relaxed))
+	{
+		throw std::runtime_error("ERROR: Waiting for a job which hasn't been submitted would never return.");
+	}
+
+	while (!job.job->finished.load(std::memory_order_acquire))
+	{
+		RunOrYield();
+	}
+
+	if (job.job->error)
+	{
+		std::rethrow_exception(job.job->error);
+	}
+}
+
+void RTJobSystem::ParallelFor(size_t count, size_t minGrain, std::function<void(size_t, size_t)> const& function)
+{
+	if (count == 0)
+	{
+		return;
+	}
+
+	size_t chunkSize = std::max<size_t>(std::max<size_t>(minGrain, 1), count / (GetThreadCount() * ChunksPerThread));
+	if (workers.empty() || count <= chunkSize)
+	{
+		function(0, count);
+		return;
+	}
+
+	ParallelForState state;
+	state.system = this;
+	state.function = &function;
+	state.chunkSize = chunkSize;
+	state.remaining.store(count, std::memory_order_relaxed);
+
+	RunRange(state, 0, count);
+
+	// Every range has run once every item is accounted for, after which no job touches the state.
+	while (state.remaining.load(std::memory_order_acquire) > 0)
+	{
+		RunOrYield();
+	}
+
+	if (state.error)
+	{
+		std::rethrow_exception(state.error);
+	}
+}
+
+void RTJobSystem::RunRange(ParallelForState& state, size_t begin, size_t end)
+{
+	RT_TRACE_ZONE("ParallelFor");
+
+	Worker* worker = GetCurrentWorker();
+	while (begin < end)
+	{
+		// Hands half the range to thieves while nothing else of this thread waits to be stolen.
+		while (end - begin > state.chunkSize && (worker ? worker->deque.IsEmpty() : injectedCount.load(std::memory_order_relaxed) == 0))
+		{
+			size_t middle = begin + (end - begin) / 2;
+
+			RTJob* split = jobPool.New<RTJob>();
+			split->pool = &jobPool;
+			split->rangeFunction = &RunRangeJob;
+			split->rangeState = &state;
+			split->rangeBegin = middle;
+			split->rangeEnd = end;
+			Submit(RTJobHandle(split));
+			end = middle;
+		}
+
+		size_t chunkEnd = std::min<size_t>(begin + state.chunkSize, end);
+		try
+		{
+			(*state.function)(begin, chunkEnd);
+		}
+		catch (...)
+		{
+			std::lock_guard<std::mutex> lock(state.errorMutex);
+			if (!state.error)
+			{
+				state.error = std::current_exception();
+			}
+		}
+
+		size_t done = chunkEnd - begin;
+		begin = chunkEnd;
+		state.remaining.fetch_sub(done, std::memory_order_acq_rel);
+	}
+}
+
+void RTJobSystem::RunRangeJob(void* state, size_t begin, size_t end)
+{
+	ParallelForState& parallelFor = *static_cast<ParallelForState*>(state);
+	parallelFor.system->RunRange(parallelFor, begin, end);
+}
+
+void RTJobSystem::Schedule(RTJob* job)
+{
+	Worker* worker = GetCurrentWorker();
+	if (worker)
+	{
+		worker->deque.Push(job);
+	}
+	else
+	{
+		PushInjected(job);
+	}
+
+	// A sleeping worker either sees the new epoch before it waits or is woken here.
+	workEpoch.fetch_add(1, std::memory_order_seq_cst);
+	if (sleepingWorkers.load(std::memory_order_seq_cst) > 0)
+	{
+		std::lock_guard<std::mutex> lock(sleepMutex);
+		wake.notify_one();
+	}
+}
+
+RTJob* RTJobSystem::FindJob(Worker* self)
+{
+	RTJob* job = nullptr;
+	if (self && self->deque.Pop(job))
+	{
+		return job;
+	}
+
+	// Workers take the oldest injected job, like a steal. A thread outside the system takes the newest,
+	// so when it helps while waiting it runs its own recursive work depth first instead of nesting a
+	// wait inside every job it picks up, which would grow its stack with the number of jobs.
+	if (injectedCount.load(std::memory_order_relaxed) > 0)
+	{
+		job = PopInjected(self != nullptr);
+		if (job)
+		{
+			return job;
+		}
+	}
+
+	if (workers.empty())
+	{
+		return nullptr;
+	}
+
+	// Victims are tried in turn from a random one, so thieves spread over the deques.
+	size_t start = 0;
+	if (self)
+	{
+		self->randomState ^= self->randomState << 13;
+		self->randomState ^= self->randomState >> 7;
+		self->randomState ^= self->randomState << 17;
+		start = static_cast<size_t>(self->randomState % workers.size());
+	}
+	for (size_t i = 0; i < workers.size(); ++i)
+	{
+		Worker& victim = *workers[(start + i) % workers.size()];
+		if (&victim != self && victim.deque.Steal(job))
+		{
+			return job;
+		}
+	}
+	return nullptr;
+}
+
+void RTJobSystem::PushInjected(RTJob* job)
+{
+	std::lock_guard<std::mutex> lock(injectedMutex);
+	job->injectedPrevious = injectedTail;
+	job->injectedNext = nullptr;
+	if (injectedTail)
+	{
+		injectedTail->injectedNext = job;
+	}
+	else
+	{
+		injectedHead = job;
+	}
+	injectedTail = job;
+	injectedCount.fetch_add(1, std::memory_order_relaxed);
+}
+
+RTJob* RTJobSystem::PopInjected(bool oldest)
+{
+	std::lock_guard<std::mutex> lock(injectedMutex);
+	RTJob* job = oldest ? injectedHead : injectedTail;
+	if (!job)
+	{
+		return nullptr;
+	}
+
+	// Jobs are only taken from either end of the queue.
+	if (oldest)
+	{
+		injectedHead = job->injectedNext;
+		if (injectedHead)
+		{
+			injectedHead->injectedPrevious = nullptr;
+		}
+		else
+		{
+			injectedTail = nullptr;
+		}
+	}
+	else
+	{
+		injectedTail = job->injectedPrevious;
+		if (injectedTail)
+		{
+			injectedTail->injectedNext = nullptr;
+		}
+		else
+		{
+			injectedHead = nullptr;
+		}
+	}
+	job->injectedPrevious = nullptr;
+	job->injectedNext = nullptr;
+	injectedCount.fetch_sub(1, std::memory_order_relaxed);
+	return job;
+}
+
+void RTJobSystem::Execute(RTJob* job)
+{
+	try
+	{
+		if (job->rangeFunction)
+		{
+			job->rangeFunction(job->rangeState, job->rangeBegin, job->rangeEnd);
+		}
+		else
+		{
+			job->function();
+		}
+	}
+	catch (...)
+	{
+		job->error = std::current_exception();
+	}
+
+	// Frees whatever the function captured now rather than when the last handle goes.
+	job->function = nullptr;
+	Finish(job);
+}
+
+void RTJobSystem::Finish(RTJob* job)
+{
+	std::vector<RTJob*> continuations;
+	{
+		std::lock_guard<std::mutex> lock(job->continuationMutex);
+		job->finished.store(true, std::memory_order_release);
+		continuations.swap(job->continuations);
+	}
+
+	for (RTJob* continuation : continuations)
+	{
+		if (continuation->pendingDependencies.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			Schedule(continuation);
+		}
+		Release(continuation);
+	}
+
+	Release(job);
+}
+
+void RTJobSystem::RunOrYield()
+{
+	if (RTJob* job = FindJob(GetCurrentWorker()))
+	{
+		Execute(job);
+	}
+	else
+	{
+		std::this_thread::yield();
+	}
+}
+
+void RTJobSystem::WorkerLoop(Worker& worker)
+{
+	currentWorker = &worker;
+	RTTrace::SetThreadName("Job worker " + std::to_string(worker.index + 1));
+
+	uint32_t failedAttempts = 0;
+	while (!stopping.load(std::memory_order_relaxed))
+	{
+		RTJob* job = FindJob(&worker);
+		if (!job && ++failedAttempts > SpinCount)
+		{
+			std::unique_lock<std::mutex> lock(sleepMutex);
+			sleepingWorkers.fetch_add(1, std::memory_order_seq_cst);
+			uint64_t epoch = workEpoch.load(std::memory_order_seq_cst);
+
+			// Work scheduled before the epoch was read is found here, anything later changes the epoch.
+			job = FindJob(&worker);
+			if (!job)
+			{
+				wake.wait(lock, [this, epoch]() { return stopping.load() || workEpoch.load() != epoch; });
+			}
+			sleepingWorkers.fetch_sub(1, std::memory_order_seq_cst);
+		}
+		else if (!job)
+		{
+			std::this_thread::yield();
+		}
+
+		if (job)
+		{
+			Execute(job);
+			failedAttempts = 0;
+		}
+	}
+
+	currentWorker = nullptr;
+}
+
+size_t RTJobSystem::GetCurrentThreadIndex() const
+{
+	Worker* worker = GetCurrentWorker();
+	return worker ? worker->index + 1 : 0;
+}
+
+RTJobSystem::Worker* RTJobSystem::GetCurrentWorker() const
+{
+	Worker* worker = static_cast<Worker*>(currentWorker);
+	return worker && worker->system == this ? worker : nullptr;
+}
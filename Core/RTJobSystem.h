@@ -0,0 +1,148 @@
+#pragma once
+
+#include "RTPoolAllocator.h"
+#include "RTWorkStealingDeque.h"
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+	Work stealing task scheduler for CPU side engine work, such as mesh processing, BVH builds,
+	instance updates and the software ray tracer's tiles.
+	Every worker thread owns a Chase-Lev deque. Jobs a worker spawns go to the bottom of its own deque
+	and it takes its newest job first, which keeps recursive work depth first and cache warm, while idle
+	workers steal the oldest, largest jobs from the top of other deques. Jobs submitted by threads that
+	aren't workers of the system go to a shared queue. A thread waiting for a job runs other jobs
+	meanwhile, so jobs may wait on jobs without tying up a worker, and workers sleep when there is nothing
+	to run.
+
+		RTJobHandle load = jobs.Run([&]() { LoadMeshes(); });
+		RTJobHandle build = jobs.Then(load, [&]() { BuildBvhs(); });
+		jobs.Wait(build);
+*/
+
+struct RTJob;
+
+// Shared reference to a job, which is freed once it has run and no handle refers to it.
+class RTJobHandle {
+
+public:
+	RTJobHandle() = default;
+	RTJobHandle(RTJobHandle const& other);
+	RTJobHandle(RTJobHandle&& other) noexcept;
+	RTJobHandle& operator =(RTJobHandle other) noexcept;
+	~RTJobHandle();
+
+	bool IsFinished() const;
+
+	explicit operator bool() const { return job != nullptr; }
+
+private:
+	friend class RTJobSystem;
+
+	// Takes over a reference the caller holds.
+	explicit RTJobHandle(RTJob* job) : job{ job } {}
+
+	RTJob*	job = nullptr;
+};
+
+class RTJobSystem {
+
+public:
+	// Starts workerCount threads. The threads which wait on jobs help run them, so zero workers
+	// runs every job on the waiting thread.
+	explicit RTJobSystem(size_t workerCount);
+
+	// Every submitted job must have finished, and no handle may outlive the system, as jobs are
+	// allocated from its pool.
+	~RTJobSystem();
+
+	RTJobSystem(RTJobSystem const&) = delete;
+	RTJobSystem& operator =(RTJobSystem const&) = delete;
+
+	// Shared by the engine, with a worker for every hardware thread but the calling one.
+	static RTJobSystem& GetDefault();
+
+	// The job runs once it has been submitted and every dependency added to it has finished.
+	RTJobHandle Create(std::function<void()> function);
+
+	// Must be called before the job is submitted.
+	void AddDependency(RTJobHandle const& job, RTJobHandle const& dependency);
+
+	void Submit(RTJobHandle const& job);
+
+	// Creates and submits a job.
+	RTJobHandle Run(std::function<void()> function);
+
+	// Creates and submits a continuation, a job which runs after the given one has finished, even if it threw.
+	RTJobHandle Then(RTJobHandle const& job, std::function<void()> function);
+
+	// Runs other jobs until the job has finished, then rethrows the exception it threw, if any.
+	void Wait(RTJobHandle const& job);
+
+	// Calls function(begin, end) on disjoint ranges covering [0, count) and returns once all have run.
+	// Ranges are split lazily: a thread keeps splitting its range in half, giving one half to thieves,
+	// only while its own deque is empty, so the number of jobs follows the actual imbalance instead of a
+	// fixed chunk count. Ranges smaller than minGrain aren't split. Rethrows the first exception thrown.
+	// The range of a split is stored in its pooled job, so splitting doesn't allocate once the pool is warm.
+	void ParallelFor(size_t count, size_t minGrain, std::function<void(size_t, size_t)> const& function);
+
+	size_t GetWorkerCount() const { return workers.size(); }
+
+	// Workers and the calling thread.
+	size_t GetThreadCount() const { return workers.size() + 1; }
+
+	// Index below GetThreadCount() of the calling thread, for per-thread data: one more than the worker's
+	// index on a worker of this system, and 0 on any other thread.
+	size_t GetCurrentThreadIndex() const;
+
+private:
+	struct Worker {
+		RTJobSystem*					system = nullptr;
+		size_t							index = 0;
+		RTWorkStealingDeque<RTJob*>		deque;
+		uint64_t						randomState = 0;
+		std::thread						thread;
+	};
+
+	struct ParallelForState;
+
+	// Runs a ParallelFor range, the function of the jobs which split ranges.
+	static void RunRangeJob(void* state, size_t begin, size_t end);
+
+	void Schedule(RTJob* job);
+	void PushInjected(RTJob* job);
+	RTJob* PopInjected(bool oldest);
+	RTJob* FindJob(Worker* self);
+	void Execute(RTJob* job);
+	void Finish(RTJob* job);
+	void RunOrYield();
+	void RunRange(ParallelForState& state, size_t begin, size_t end);
+	void WorkerLoop(Worker& worker);
+	Worker* GetCurrentWorker() const;
+
+	// Jobs are allocated and freed on every thread, from thread-local free lists.
+	RTPoolAllocator							jobPool;
+
+	std::vector<std::unique_ptr<Worker>>	workers;
+
+	// Jobs submitted by threads which aren't workers of this system, linked through the jobs themselves so
+	// queueing one never allocates
+	std::mutex								injectedMutex;
+	RTJob*									injectedHead;
+	RTJob*									injectedTail;
+	std::atomic<size_t>						injectedCount;
+
+	// Idle workers sleep until the work epoch changes
+	std::mutex								sleepMutex;
+	std::condition_variable					wake;
+	std::atomic<uint64_t>					workEpoch;
+	std::atomic<uint32_t>					sleepingWorkers;
+	std::atomic<bool>						stopping;
+};
@@ -0,0 +1,82 @@
+#include "RTLinearArena.h"
+#include <algorithm>
+#include <stdexcept>
+
+RTArenaStats& RTArenaStats::operator +=(RTArenaStats const& other)
+{
+	usedBytes += other.usedBytes;
+	allocationCount += other.allocationCount;
+	peakUsedBytes += other.peakUsedBytes;
+	capacityBytes += other.capacityBytes;
+	blockAllocationCount += other.blockAllocationCount;
+	return *this;
+}
+
+RTLinearArena::RTLinearArena(size_t initialCapacity) :
+	currentBlock{ 0 },
+	offset{ 0 },
+	initialCapacity{ std::max<size_t>(initialCapacity, 1) }
+{
+}
+
+void* RTLinearArena::Allocate(size_t size, size_t alignment)
+{
+	if (alignment == 0 || (alignment & (alignment - 1)) != 0)
+	{
+		throw std::runtime_error("ERROR: Arena alignment must be a power of two.");
+	}
+
+	// Later blocks are only reached when the current one is full, as a frame fills them in order.
+	while (currentBlock < blocks.size())
+	{
+		Block& block = blocks[currentBlock];
+		uintptr_t base = reinterpret_cast<uintptr_t>(block.memory.get());
+		size_t alignedOffset = static_cast<size_t>(((base + offset + alignment - 1) & ~uintptr_t{ alignment - 1 }) - base);
+		if (alignedOffset <= block.size && size <= block.size - alignedOffset)
+		{
+			stats.usedBytes += alignedOffset + size - offset;
+			stats.peakUsedBytes = std::max<size_t>(stats.peakUsedBytes, stats.usedBytes);
+			++stats.allocationCount;
+			offset = alignedOffset + size;
+			return block.memory.get() + alignedOffset;
+		}
+
+		// The rest of a full block counts as used, it is wasted until the reset.
+		stats.usedBytes += block.size - offset;
+		++currentBlock;
+		offset = 0;
+	}
+
+	if (size > std::numeric_limits<size_t>::max() - alignment)
+	{
+		throw std::bad_alloc();
+	}
+	AddBlock(size + alignment - 1);
+	return Allocate(size, alignment);
+}
+
+void RTLinearArena::Reset()
+{
+	// A frame which spilled into several blocks gets them merged, so the next one of its size fits in one.
+	if (blocks.size() > 1)
+	{
+		size_t totalSize = stats.capacityBytes;
+		blocks.clear();
+		stats.capacityBytes = 0;
+		AddBlock(totalSize);
+	}
+
+	currentBlock = 0;
+	offset = 0;
+	stats.usedBytes = 0;
+	stats.allocationCount = 0;
+}
+
+void RTLinearArena::AddBlock(size_t minimumSize)
+{
+	// Blocks at least double, so a frame needs few of them however large it is.
+	size_t size = std::max<size_t>(minimumSize, blocks.empty() ? initialCapacity : blocks.back().size * 2);
+	blocks.push_back(Block{ std::unique_ptr<uint8_t[]>(new uint8_t[size]), size });
+	stats.capacityBytes += size;
+	++stats.blockAllocationCount;
+}
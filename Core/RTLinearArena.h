@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+/*
+	Bump allocator for transient CPU data, such as the instance lists and recorded commands of a frame.
+	Allocating moves an offset through a block of memory and nothing is freed on its own: Reset() releases
+	everything at once. A frame which doesn't fit chains further blocks, and the next Reset() replaces them
+	with one block as large as all of them, so once the arena has seen its largest frame it makes no
+	further heap allocations. An arena belongs to one thread at a time.
+
+		RTArenaVector<RTInstanceDesc> descs{ RTArenaAllocator<RTInstanceDesc>(arena) };
+		descs.reserve(instanceCount);
+*/
+
+struct RTArenaStats {
+	// Since the last reset, alignment padding included
+	size_t	usedBytes = 0;
+	size_t	allocationCount = 0;
+
+	// Over the arena's lifetime
+	size_t	peakUsedBytes = 0;
+	size_t	capacityBytes = 0;
+	size_t	blockAllocationCount = 0;
+
+	RTArenaStats& operator +=(RTArenaStats const& other);
+};
+
+class RTLinearArena {
+
+public:
+	// The first block is allocated on first use, so arenas which are never used cost nothing.
+	explicit RTLinearArena(size_t initialCapacity = 64 * 1024);
+
+	RTLinearArena(RTLinearArena const&) = delete;
+	RTLinearArena& operator =(RTLinearArena const&) = delete;
+
+	// Returns size bytes aligned to alignment, which must be a power of two. Throws std::bad_alloc on failure.
+	void* Allocate(size_t size, size_t alignment = alignof(std::max_align_t));
+
+	// Uninitialised storage for count objects.
+	template<typename T>
+	T* AllocateArray(size_t count)
+	{
+		if (count > std::numeric_limits<size_t>::max() / sizeof(T))
+		{
+			throw std::bad_alloc();
+		}
+		return static_cast<T*>(Allocate(sizeof(T) * count, alignof(T)));
+	}
+
+	// Constructs an object in the arena. It is never destroyed, only released by Reset().
+	template<typename T, typename... TArgs>
+	T* Create(TArgs&&... args)
+	{
+		static_assert(std::is_trivially_destructible<T>::value, "The arena never destroys what it holds.");
+		return new (AllocateArray<T>(1)) T(std::forward<TArgs>(args)...);
+	}
+
+	// Releases every allocation at once. Nothing allocated before may be used afterwards.
+	void Reset();
+
+	RTArenaStats const& GetStats() const { return stats; }
+
+private:
+	struct Block {
+		std::unique_ptr<uint8_t[]>	memory;
+		size_t						size;
+	};
+
+	void AddBlock(size_t minimumSize);
+
+	std::vector<Block>	blocks;
+	size_t				currentBlock;
+	size_t				offset;
+	size_t				initialCapacity;
+	RTArenaStats		stats;
+};
+
+// Standard library allocator over an arena, whose deallocate() does nothing. Containers which grow leave
+// their old storage behind until the arena is reset, so they should reserve what they need up front.
+template<typename T>
+class RTArenaAllocator {
+
+public:
+	using value_type = T;
+
+	explicit RTArenaAllocator(RTLinearArena& arena) noexcept : arena{ &arena } {}
+
+	template<typename U>
+	RTArenaAllocator(RTArenaAllocator<U> const& other) noexcept : arena{ other.GetArena() } {}
+
+	T* allocate(size_t count) { return arena->AllocateArray<T>(count); }
+	void deallocate(T*, size_t) noexcept {}
+
+	RTLinearArena* GetArena() const noexcept { return arena; }
+
+	template<typename U>
+	bool operator ==(RTArenaAllocator<U> const& other) const noexcept { return arena == other.GetArena(); }
+
+	template<typename U>
+	bool operator !=(RTArenaAllocator<U> const& other) const noexcept { return arena != other.GetArena(); }
+
+private:
+	RTLinearArena*	arena;
+};
+
+template<typename T>
+using RTArenaVector = std::vector<T, RTArenaAllocator<T>>;
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "RTJobSystem.h"
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+/*
+	Simple fork-join helpers for data parallel CPU work, such as mesh processing before upload.
+	Work is split into contiguous ranges run by the default RTJobSystem, and the caller helps run them
+	until all ranges are done, so the helpers may be nested and called from jobs.
+*/
+
+namespace RTParallel {
+
+	// Returns the number of threads used for parallel work, at least one.
+	inline size_t GetThreadCount()
+	{
+		return RTJobSystem::GetDefault().GetThreadCount();
+	}
+
+	// Calls func(begin, end) on disjoint sub-ranges of [0, count). Ranges smaller than minGrain aren't split further.
+	template<typename TFunc>
+	void ParallelFor(size_t count, size_t minGrain, TFunc const& func)
+	{
+		RTJobSystem::GetDefault().ParallelFor(count, minGrain, std::cref(func));
+	}
+
+	// Sorts sub-ranges in parallel and then merges them pairwise.
+	template<typename TIterator, typename TCompare>
+	void ParallelSort(TIterator first, TIterator last, TCompare const& compare, size_t minGrain = 16384)
+	{
+		size_t count = static_cast<size_t>(last - first);
+		size_t chunkCount = std::min(GetThreadCount(), std::max<size_t>(count / std::max<size_t>(minGrain, 1), 1));
+
+		if (chunkCount <= 1)
+		{
+			std::sort(first, last, compare);
+			return;
+		}
+
+		std::vector<size_t> bounds(chunkCount + 1);
+		for (size_t i = 0; i <= chunkCount; ++i)
+		{
+			bounds[i] = count * i / chunkCount;
+		}
+
+		ParallelFor(chunkCount, 1, [&](size_t begin, size_t end)
+			{
+				for (size_t chunk = begin; chunk < end; ++chunk)
+				{
+					std::sort(first + bounds[chunk], first + bounds[chunk + 1], compare);
+				}
+			});
+
+		// Each round halves the number of sorted runs.
+		for (size_t width = 1; width < chunkCount; width *= 2)
+		{
+			size_t mergeCount = (chunkCount + 2 * width - 1) / (2 * width);
+			ParallelFor(mergeCount, 1, [&](size_t begin, size_t end)
+				{
+					for (size_t merge = begin; merge < end; ++merge)
+					{
+						size_t low = merge * 2 * width;
+						size_t middle = std::min(low + width, chunkCount);
+						size_t high = std::min(low + 2 * width, chunkCount);
+						if (middle < high)
+						{
+							std::inplace_merge(first + bounds[low], first + bounds[middle], first + bounds[high], compare);
+						}
+					}
+				});
+		}
+	}
+}
@@ -0,0 +1,349 @@
+#include "RTPoolAllocator.h"
+#include <algorithm>
+#include <atomic>
+#include <unordered_map>
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace {
+
+	// Blocks a thread takes from the shared list at a time, and keeps when it gives blocks back.
+	const size_t BatchSize = 64;
+
+	std::atomic<uint64_t> nextPoolId{ 1 };
+
+	// Pools which exist, so a thread which exits only hands its free lists back to those.
+	struct LivePools {
+		std::mutex										mutex;
+		std::unordered_map<uint64_t, RTPoolAllocator*>	pools;
+	};
+
+	// Leaked, as threads may exit after static destruction.
+	LivePools& GetLivePools()
+	{
+		static LivePools* livePools = new LivePools;
+		return *livePools;
+	}
+
+	uint8_t* AllocateChunkMemory(size_t size, bool hugePages, bool& usedHugePages)
+	{
+		usedHugePages = false;
+
+#ifdef _WIN32
+		// Large pages need a privilege users don't have by default, so Windows always uses normal pages.
+		(void)hugePages;
+		void* memory = VirtualAlloc(nullptr, size, MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+		if (!memory)
+		{
+			throw std::bad_alloc();
+		}
+		return static_cast<uint8_t*>(memory);
+#else
+#ifdef MAP_HUGETLB
+		// Reserved huge pages only exist when the administrator has set some aside.
+		if (hugePages)
+		{
+			void* memory = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+			if (memory != MAP_FAILED)
+			{
+				usedHugePages = true;
+				return static_cast<uint8_t*>(memory);
+			}
+		}
+#endif
+
+		// Transparent huge pages need the range aligned to the huge page size, so the mapping is made larger and trimmed.
+		size_t padding = hugePages ? RTPoolAllocator::ChunkSize : 0;
+		void* mapping = mmap(nullptr, size + padding, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+		if (mapping == MAP_FAILED)
+		{
+			throw std::bad_alloc();
+		}
+
+		uint8_t* memory = static_cast<uint8_t*>(mapping);
+		if (padding > 0)
+		{
+			uintptr_t address = reinterpret_cast<uintptr_t>(mapping);
+			size_t head = static_cast<size_t>(((address + padding - 1) & ~uintptr_t{ padding - 1 }) - address);
+			if (head > 0)
+			{
+				munmap(memory, head);
+			}
+			if (padding - head > 0)
+			{
+				munmap(memory + head + size, padding - head);
+			}
+			memory += head;
+#ifdef MADV_HUGEPAGE
+			madvise(memory, size, MADV_HUGEPAGE);
+#endif
+		}
+		return memory;
+#endif
+	}
+
+	void FreeChunkMemory(uint8_t* memory, size_t size)
+	{
+#ifdef _WIN32
+		(void)size;
+		VirtualFree(memory, 0, MEM_RELEASE);
+#else
+		munmap(memory, size);
+#endif
+	}
+}
+
+// Free lists of every pool the thread has used, handed back to the pools when the thread exits.
+struct RTPoolThreadCaches {
+	struct Entry {
+		uint64_t						poolId;
+		RTPoolAllocator::ThreadCache*	cache;
+	};
+
+	~RTPoolThreadCaches()
+	{
+		LivePools& livePools = GetLivePools();
+		std::lock_guard<std::mutex> lock(livePools.mutex);
+		for (Entry const& entry : entries)
+		{
+			auto pool = livePools.pools.find(entry.poolId);
+			if (pool != livePools.pools.end())
+			{
+				pool->second->ReturnThreadCache(entry.cache);
+			}
+		}
+	}
+
+	std::vector<Entry>	entries;
+};
+
+namespace {
+
+	thread_local RTPoolThreadCaches threadCaches;
+}
+
+RTPoolAllocator::RTPoolAllocator(size_t blockSize, bool hugePages) :
+	blockSize{ (std::max<size_t>(blockSize, sizeof(FreeBlock)) + CacheLineSize - 1) & ~(CacheLineSize - 1) },
+	hugePages{ hugePages },
+	id{ nextPoolId.fetch_add(1, std::memory_order_relaxed) },
+	freeBlocks{ nullptr },
+	currentChunk{ 0 },
+	carveOffset{ 0 },
+	carvedBlockCount{ 0 }
+{
+	LivePools& livePools = GetLivePools();
+	std::lock_guard<std::mutex> lock(livePools.mutex);
+	livePools.pools[id] = this;
+}
+
+RTPoolAllocator::~RTPoolAllocator()
+{
+	{
+		LivePools& livePools = GetLivePools();
+		std::lock_guard<std::mutex> lock(livePools.mutex);
+		livePools.pools.erase(id);
+	}
+
+	for (Chunk const& chunk : chunks)
+	{
+		FreeChunkMemory(chunk.memory, chunk.size);
+	}
+}
+
+void* RTPoolAllocator::Allocate()
+{
+	ThreadCache& cache = GetThreadCache();
+	if (!cache.head)
+	{
+		Refill(cache);
+	}
+
+	FreeBlock* block = cache.head;
+	cache.head = block->next;
+	--cache.count;
+	return block;
+}
+
+void RTPoolAllocator::Free(void* block)
+{
+	if (!block)
+	{
+		return;
+	}
+
+	ThreadCache& cache = GetThreadCache();
+	FreeBlock* freed = static_cast<FreeBlock*>(block);
+	freed->next = cache.head;
+	cache.head = freed;
+
+	// A thread which frees more than it allocates, such as a consumer of jobs, passes the surplus on.
+	if (++cache.count >= 2 * BatchSize)
+	{
+		Flush(cache, BatchSize);
+	}
+}
+
+void RTPoolAllocator::Reset()
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	freeBlocks = nullptr;
+	currentChunk = 0;
+	carveOffset = 0;
+	carvedBlockCount = 0;
+	for (std::unique_ptr<ThreadCache> const& cache : ownedThreadCaches)
+	{
+		cache->head = nullptr;
+		cache->count = 0;
+	}
+}
+
+RTPoolStats RTPoolAllocator::GetStats() const
+{
+	std::lock_guard<std::mutex> lock(mutex);
+	RTPoolStats stats;
+	stats.blockSize = blockSize;
+	stats.chunkCount = chunks.size();
+	stats.hugePageChunkCount = static_cast<size_t>(std::count_if(chunks.begin(), chunks.end(), [](Chunk const& chunk) { return chunk.hugePages; }));
+	stats.carvedBlockCount = carvedBlockCount;
+	return stats;
+}
+
+RTPoolAllocator::ThreadCache& RTPoolAllocator::GetThreadCache()
+{
+	for (RTPoolThreadCaches::Entry const& entry : threadCaches.entries)
+	{
+		if (entry.poolId == id)
+		{
+			return *entry.cache;
+		}
+	}
+
+	// The thread's first use of the pool takes over the free list of a thread which has exited, if there is one.
+	ThreadCache* cache = nullptr;
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (!unusedThreadCaches.empty())
+		{
+			cache = unusedThreadCaches.back();
+			unusedThreadCaches.pop_back();
+		}
+		else
+		{
+			ownedThreadCaches.push_back(std::make_unique<ThreadCache>());
+			cache = ownedThreadCaches.back().get();
+		}
+	}
+
+	// Entries of pools which no longer exist are dropped, so threads which outlive many pools don't collect them.
+	{
+		LivePools& livePools = GetLivePools();
+		std::lock_guard<std::mutex> lock(livePools.mutex);
+		std::vector<RTPoolThreadCaches::Entry>& entries = threadCaches.entries;
+		entries.erase(std::remove_if(entries.begin(), entries.end(),
+			[&livePools](RTPoolThreadCaches::Entry const& entry) { return livePools.pools.count(entry.poolId) == 0; }), entries.end());
+	}
+
+	threadCaches.entries.push_back(RTPoolThreadCaches::Entry{ id, cache });
+	return *cache;
+}
+
+void RTPoolAllocator::Refill(ThreadCache& cache)
+{
+	std::lock_guard<std::mutex> lock(mutex);
+
+	while (cache.count < BatchSize && freeBlocks)
+	{
+		FreeBlock* block = freeBlocks;
+		freeBlocks = block->next;
+		block->next = cache.head;
+		cache.head = block;
+		++cache.count;
+	}
+
+	// Then blocks which have never been used, from the chunk being carved up.
+	while (cache.count < BatchSize)
+	{
+		if (currentChunk == chunks.size())
+		{
+			AddChunk();
+		}
+
+		Chunk const& chunk = chunks[currentChunk];
+		if (chunk.size - carveOffset < blockSize)
+		{
+			++currentChunk;
+			carveOffset = 0;
+			continue;
+		}
+
+		FreeBlock* block = reinterpret_cast<FreeBlock*>(chunk.memory + carveOffset);
+		carveOffset += blockSize;
+		++carvedBlockCount;
+
+		block->next = cache.head;
+		cache.head = block;
+		++cache.count;
+	}
+}
+
+void RTPoolAllocator::Flush(ThreadCache& cache, size_t keepCount)
+{
+	if (cache.count <= keepCount)
+	{
+		return;
+	}
+
+	// The blocks after the first keepCount are moved to the shared list.
+	FreeBlock* first = cache.head;
+	if (keepCount > 0)
+	{
+		FreeBlock* last = cache.head;
+		for (size_t i = 1; i < keepCount; ++i)
+		{
+			last = last->next;
+		}
+		first = last->next;
+		last->next = nullptr;
+	}
+	else
+	{
+		cache.head = nullptr;
+	}
+	cache.count = keepCount;
+
+	FreeBlock* tail = first;
+	while (tail->next)
+	{
+		tail = tail->next;
+	}
+
+	std::lock_guard<std::mutex> lock(mutex);
+	tail->next = freeBlocks;
+	freeBlocks = first;
+}
+
+void RTPoolAllocator::ReturnThreadCache(ThreadCache* cache)
+{
+	Flush(*cache, 0);
+
+	std::lock_guard<std::mutex> lock(mutex);
+	unusedThreadCaches.push_back(cache);
+}
+
+void RTPoolAllocator::AddChunk()
+{
+	size_t size = (std::max<size_t>(blockSize, ChunkSize) + ChunkSize - 1) & ~(ChunkSize - 1);
+	bool usedHugePages = false;
+	uint8_t* memory = AllocateChunkMemory(size, hugePages, usedHugePages);
+	chunks.push_back(Chunk{ memory, size, usedHugePages });
+}
@@ -0,0 +1,130 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <utility>
+#include <vector>
+
+/*
+	Pool of fixed size blocks for objects allocated and freed in large numbers, such as jobs and tree nodes.
+	Blocks are a whole number of cache lines and cache line aligned, so objects used by different threads
+	never share a line. They are carved from large chunks of memory taken from the OS, optionally backed by
+	huge pages on Linux, which keeps millions of nodes within few TLB entries.
+	Every thread keeps a free list of its own, so allocating and freeing takes no lock. A thread only visits
+	the shared list to take or give back a batch of blocks when its own list runs empty or grows too long.
+	Reset() releases every block at once, which is how a tree of nodes is freed without visiting it.
+
+		RTPoolAllocator nodePool(sizeof(Node));
+		Node* node = nodePool.New<Node>();
+		nodePool.Delete(node);
+*/
+
+struct RTPoolStats {
+	size_t	blockSize = 0;
+	size_t	chunkCount = 0;
+	size_t	hugePageChunkCount = 0;
+
+	// Blocks carved from the chunks so far, whether in use or free
+	size_t	carvedBlockCount = 0;
+};
+
+class RTPoolAllocator {
+
+public:
+	static constexpr size_t CacheLineSize = 64;
+
+	// Chunks are one huge page, 2 MiB, unless a single block is larger.
+	static constexpr size_t ChunkSize = size_t{ 2 } << 20;
+
+	// blockSize is rounded up to a whole number of cache lines. Huge pages are only used on Linux, where
+	// reserved huge pages are tried first and transparent huge pages otherwise.
+	explicit RTPoolAllocator(size_t blockSize, bool hugePages = false);
+
+	// Returns the chunks to the OS. Blocks still in use are freed with them.
+	~RTPoolAllocator();
+
+	RTPoolAllocator(RTPoolAllocator const&) = delete;
+	RTPoolAllocator& operator =(RTPoolAllocator const&) = delete;
+
+	// Never returns null. Throws std::bad_alloc when the OS is out of memory.
+	void* Allocate();
+
+	// Any thread may free a block, whichever allocated it.
+	void Free(void* block);
+
+	template<typename T, typename... TArgs>
+	T* New(TArgs&&... args)
+	{
+		static_assert(alignof(T) <= CacheLineSize, "Blocks are only cache line aligned.");
+		void* block = Allocate();
+		try
+		{
+			return new (block) T(std::forward<TArgs>(args)...);
+		}
+		catch (...)
+		{
+			Free(block);
+			throw;
+		}
+	}
+
+	template<typename T>
+	void Delete(T* object)
+	{
+		if (object)
+		{
+			object->~T();
+			Free(object);
+		}
+	}
+
+	// Makes every block free again at once, keeping the chunks for the blocks allocated next. Objects in the
+	// blocks aren't destroyed, and no other thread may use the pool meanwhile.
+	void Reset();
+
+	size_t GetBlockSize() const { return blockSize; }
+
+	RTPoolStats GetStats() const;
+
+private:
+	struct FreeBlock {
+		FreeBlock*	next;
+	};
+
+	// A thread's free list. Owned by the pool and handed to another thread once its thread exits.
+	struct ThreadCache {
+		FreeBlock*	head = nullptr;
+		size_t		count = 0;
+	};
+
+	struct Chunk {
+		uint8_t*	memory;
+		size_t		size;
+		bool		hugePages;
+	};
+
+	friend struct RTPoolThreadCaches;
+
+	ThreadCache& GetThreadCache();
+	void Refill(ThreadCache& cache);
+	void Flush(ThreadCache& cache, size_t keepCount);
+	void ReturnThreadCache(ThreadCache* cache);
+	void AddChunk();
+
+	size_t							blockSize;
+	bool							hugePages;
+	uint64_t						id;
+
+	// Everything below is guarded by the mutex
+	mutable std::mutex				mutex;
+	FreeBlock*						freeBlocks;
+	std::vector<Chunk>				chunks;
+	size_t							currentChunk;
+	size_t							carveOffset;
+	size_t							carvedBlockCount;
+	std::vector<std::unique_ptr<ThreadCache>>	ownedThreadCaches;
+	std::vector<ThreadCache*>		unusedThreadCaches;
+};
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <chrono>
+#include <string>
+#include <utility>
+
+/*
+	Measures the CPU time of a scope within a frame, from construction to destruction, and adds it in
+	milliseconds to a sink with AddSample(std::string const&, double), such as RTTimingStats or
+	RTGpuProfiler, so CPU and GPU scopes end up in the same statistics.
+
+		{
+			RTScopedTimer timer(stats, "Update (CPU)");
+			...
+		}
+*/
+
+template<typename Sink>
+class RTScopedTimer {
+
+public:
+	RTScopedTimer(Sink& sink, std::string scope) :
+		sink{ sink },
+		scope{ std::move(scope) },
+		start{ std::chrono::steady_clock::now() }
+	{
+	}
+
+	~RTScopedTimer()
+	{
+		sink.AddSample(scope, GetElapsedMilliseconds());
+	}
+
+	RTScopedTimer(RTScopedTimer const&) = delete;
+	RTScopedTimer& operator =(RTScopedTimer const&) = delete;
+
+	double GetElapsedMilliseconds() const
+	{
+		return std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - start).count();
+	}
+
+private:
+	Sink&									sink;
+	std::string								scope;
+	std::chrono::steady_clock::time_point	start;
+};
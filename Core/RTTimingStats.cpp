@@ -0,0 +1,88 @@
+#include "RTTimingStats.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <stdexcept>
+
+RTTimingStats::RTTimingStats(size_t windowSize) :
+	windowSize{ windowSize }
+{
+	if (windowSize == 0)
+	{
+		throw std::runtime_error("ERROR: Timing statistics window size must not be zero.");
+	}
+}
+
+void RTTimingStats::AddSample(std::string const& scope, double milliseconds)
+{
+	auto found = windows.find(scope);
+	if (found == windows.end())
+	{
+		found = windows.emplace(scope, Window{}).first;
+		found->second.samples.reserve(windowSize);
+		scopeOrder.push_back(scope);
+	}
+
+	Window& window = found->second;
+	if (window.samples.size() < windowSize)
+	{
+		window.samples.push_back(milliseconds);
+	}
+	else
+	{
+		window.samples[window.next] = milliseconds;
+	}
+	window.next = (window.next + 1) % windowSize;
+}
+
+RTTimingSummary RTTimingStats::GetSummary(std::string const& scope) const
+{
+	RTTimingSummary summary;
+
+	auto found = windows.find(scope);
+	if (found == windows.end() || found->second.samples.empty())
+	{
+		return summary;
+	}
+
+	// The window is small, so sorting a copy is cheaper than keeping an order statistic up to date per sample.
+	std::vector<double> sorted = found->second.samples;
+	std::sort(sorted.begin(), sorted.end());
+
+	double total = 0.0;
+	for (double sample : sorted)
+	{
+		total += sample;
+	}
+
+	// Nearest rank percentile, the smallest sample which at least 99% of the samples don't exceed.
+	size_t rank = static_cast<size_t>(std::ceil(0.99 * static_cast<double>(sorted.size())));
+
+	summary.sampleCount = sorted.size();
+	summary.minimum = sorted.front();
+	summary.maximum = sorted.back();
+	summary.average = total / static_cast<double>(sorted.size());
+	summary.p99 = sorted[std::max<size_t>(rank, 1) - 1];
+	return summary;
+}
+
+std::string RTTimingStats::Format() const
+{
+	std::string text;
+	for (std::string const& scope : scopeOrder)
+	{
+		RTTimingSummary summary = GetSummary(scope);
+
+		char line[256];
+		std::snprintf(line, sizeof(line), "%s: min %.3f ms, avg %.3f ms, p99 %.3f ms (%zu samples)\n",
+			scope.c_str(), summary.minimum, summary.average, summary.p99, summary.sampleCount);
+		text += line;
+	}
+	return text;
+}
+
+void RTTimingStats::Clear()
+{
+	windows.clear();
+	scopeOrder.clear();
+}
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/*
+	Rolling statistics of named timing scopes, independent of where the timings come from.
+	Each scope keeps its most recent samples in a fixed size window, so the summaries follow changes
+	in the workload instead of averaging over the whole run. Samples are in milliseconds and can come
+	from GPU timestamps, CPU timers or, in tests, be made up.
+*/
+
+// Summary of the samples in one scope's window.
+struct RTTimingSummary {
+	double minimum = 0.0;
+	double average = 0.0;
+	double p99 = 0.0;
+	double maximum = 0.0;
+	size_t sampleCount = 0;
+};
+
+class RTTimingStats {
+
+public:
+	explicit RTTimingStats(size_t windowSize = 240);
+
+	// Adds a sample to the scope, replacing its oldest sample once the window is full.
+	void AddSample(std::string const& scope, double milliseconds);
+
+	// Returns an empty summary for a scope without samples.
+	RTTimingSummary GetSummary(std::string const& scope) const;
+
+	// Scopes in the order their first sample was added.
+	std::vector<std::string> const& GetScopes() const { return scopeOrder; }
+
+	// One line per scope with its minimum, average and 99th percentile.
+	std::string Format() const;
+
+	void Clear();
+
+	size_t GetWindowSize() const { return windowSize; }
+
+private:
+	struct Window {
+		std::vector<double>	samples;
+		size_t				next = 0;
+	};
+
+	std::unordered_map<std::string, Window>	windows;
+	std::vector<std::string>				scopeOrder;
+	size_t									windowSize;
+};
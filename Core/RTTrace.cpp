@@ -0,0 +1,283 @@
+#include "RTTrace.h"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+	enum class EventType : uint8_t {
+		Zone,
+		Counter
+	};
+
+	struct Event {
+		char const*	name;
+		uint64_t	start;
+		uint64_t	end;
+		double		value;
+		EventType	type;
+	};
+
+	// Blocks are allocated as a thread's buffer fills, so threads which record little cost little.
+	const size_t EventsPerBlock = 16384;
+	const size_t BlocksPerThread = (RTTrace::MaxEventsPerThread + EventsPerBlock - 1) / EventsPerBlock;
+
+	struct Block {
+		Event	events[EventsPerBlock];
+	};
+
+	// Written by its thread only. Readers see the first count events, which are never written again until Clear().
+	struct ThreadBuffer {
+		uint32_t				threadId = 0;
+		std::string				name;
+		std::atomic<size_t>		count{ 0 };
+		std::atomic<uint64_t>	dropped{ 0 };
+		std::atomic<Block*>		blocks[BlocksPerThread] = {};
+
+		~ThreadBuffer()
+		{
+			for (std::atomic<Block*>& block : blocks)
+			{
+				delete block.load();
+			}
+		}
+	};
+
+	struct Registry {
+		std::mutex									mutex;
+		std::vector<std::unique_ptr<ThreadBuffer>>	buffers;
+		std::vector<ThreadBuffer*>					freeBuffers;
+		std::chrono::steady_clock::time_point		epoch = std::chrono::steady_clock::now();
+	};
+
+	// Never destroyed, so threads which outlive static destruction can still record.
+	Registry& GetRegistry()
+	{
+		static Registry* registry = new Registry;
+		return *registry;
+	}
+
+	// Hands the thread's buffer on to the next new thread when the thread exits, so threads which come and
+	// go, such as the workers of the job systems the benchmarks create per thread count, reuse a few buffers
+	// instead of adding one each. Their events keep the buffer's thread id, which is fine as the threads'
+	// lifetimes don't overlap.
+	struct ThreadBufferOwner {
+		ThreadBuffer*	buffer = nullptr;
+
+		~ThreadBufferOwner()
+		{
+			if (buffer)
+			{
+				Registry& registry = GetRegistry();
+				std::lock_guard<std::mutex> lock(registry.mutex);
+				registry.freeBuffers.push_back(buffer);
+			}
+		}
+	};
+
+	ThreadBuffer& GetThreadBuffer()
+	{
+		thread_local ThreadBufferOwner owner;
+		if (!owner.buffer)
+		{
+			Registry& registry = GetRegistry();
+			std::lock_guard<std::mutex> lock(registry.mutex);
+
+			if (!registry.freeBuffers.empty())
+			{
+				owner.buffer = registry.freeBuffers.back();
+				registry.freeBuffers.pop_back();
+			}
+			else
+			{
+				std::unique_ptr<ThreadBuffer> buffer = std::make_unique<ThreadBuffer>();
+				buffer->threadId = static_cast<uint32_t>(registry.buffers.size() + 1);
+				buffer->name = "Thread " + std::to_string(buffer->threadId);
+				owner.buffer = buffer.get();
+				registry.buffers.push_back(std::move(buffer));
+			}
+		}
+		return *owner.buffer;
+	}
+
+	void Append(Event const& event)
+	{
+		ThreadBuffer& buffer = GetThreadBuffer();
+
+		size_t index = buffer.count.load(std::memory_order_relaxed);
+		if (index >= RTTrace::MaxEventsPerThread)
+		{
+			buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+			return;
+		}
+
+		std::atomic<Block*>& blockSlot = buffer.blocks[index / EventsPerBlock];
+		Block* block = blockSlot.load(std::memory_order_relaxed);
+		if (!block)
+		{
+			block = new Block;
+			blockSlot.store(block, std::memory_order_release);
+		}
+
+		block->events[index % EventsPerBlock] = event;
+		buffer.count.store(index + 1, std::memory_order_release);
+	}
+
+	void AppendJsonString(std::string& json, char const* text)
+	{
+		json += '"';
+		for (char const* c = text; *c; ++c)
+		{
+			if (*c == '"' || *c == '\\')
+			{
+				json += '\\';
+				json += *c;
+			}
+			else if (static_cast<unsigned char>(*c) < 0x20)
+			{
+				char escaped[8];
+				std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned int>(static_cast<unsigned char>(*c)));
+				json += escaped;
+			}
+			else
+			{
+				json += *c;
+			}
+		}
+		json += '"';
+	}
+
+	// Trace event timestamps are in microseconds.
+	void AppendMicroseconds(std::string& json, uint64_t nanoseconds)
+	{
+		char number[32];
+		std::snprintf(number, sizeof(number), "%llu.%03u", static_cast<unsigned long long>(nanoseconds / 1000), static_cast<unsigned int>(nanoseconds % 1000));
+		json += number;
+	}
+}
+
+void RTTrace::SetEnabled(bool enable)
+{
+	// Starts the clock and registers the thread before the first event rather than inside it.
+	GetRegistry();
+	GetThreadBuffer();
+	Detail::enabled.store(enable, std::memory_order_relaxed);
+}
+
+uint64_t RTTrace::Now()
+{
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - GetRegistry().epoch).count());
+}
+
+void RTTrace::SetThreadName(std::string const& name)
+{
+	ThreadBuffer& buffer = GetThreadBuffer();
+
+	std::lock_guard<std::mutex> lock(GetRegistry().mutex);
+	buffer.name = name;
+}
+
+void RTTrace::RecordZone(char const* name, uint64_t startNanoseconds, uint64_t endNanoseconds)
+{
+	Append(Event{ name, startNanoseconds, endNanoseconds, 0.0, EventType::Zone });
+}
+
+void RTTrace::RecordCounter(char const* name, double value)
+{
+	uint64_t now = Now();
+	Append(Event{ name, now, now, value, EventType::Counter });
+}
+
+std::string RTTrace::GetChromeTraceJson()
+{
+	Registry& registry = GetRegistry();
+	std::lock_guard<std::mutex> lock(registry.mutex);
+
+	std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+	bool first = true;
+	auto BeginEvent = [&]()
+		{
+			json += first ? "\n{" : ",\n{";
+			first = false;
+		};
+
+	for (std::unique_ptr<ThreadBuffer> const& buffer : registry.buffers)
+	{
+		std::string threadId = std::to_string(buffer->threadId);
+
+		BeginEvent();
+		json += "\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" + threadId + ",\"args\":{\"name\":";
+		AppendJsonString(json, buffer->name.c_str());
+		json += "}}";
+
+		size_t count = buffer->count.load(std::memory_order_acquire);
+		for (size_t i = 0; i < count; ++i)
+		{
+			Event const& event = buffer->blocks[i / EventsPerBlock].load(std::memory_order_acquire)->events[i % EventsPerBlock];
+
+			BeginEvent();
+			json += "\"name\":";
+			AppendJsonString(json, event.name);
+			if (event.type == EventType::Zone)
+			{
+				json += ",\"ph\":\"X\",\"ts\":";
+				AppendMicroseconds(json, event.start);
+				json += ",\"dur\":";
+				AppendMicroseconds(json, event.end - event.start);
+				json += ",\"pid\":1,\"tid\":" + threadId + "}";
+			}
+			else
+			{
+				char value[64];
+				std::snprintf(value, sizeof(value), "%.17g", event.value);
+				json += ",\"ph\":\"C\",\"ts\":";
+				AppendMicroseconds(json, event.start);
+				json += ",\"pid\":1,\"tid\":" + threadId + ",\"args\":{\"value\":" + value + "}}";
+			}
+		}
+	}
+
+	json += "\n]}\n";
+	return json;
+}
+
+void RTTrace::WriteChromeTrace(std::filesystem::path const& path)
+{
+	std::string json = GetChromeTraceJson();
+
+	std::ofstream file(path, std::ios::binary | std::ios::trunc);
+	file.write(json.data(), static_cast<std::streamsize>(json.size()));
+	if (!file)
+	{
+		throw std::runtime_error("ERROR: Couldn't write the trace " + path.string());
+	}
+}
+
+void RTTrace::Clear()
+{
+	Registry& registry = GetRegistry();
+	std::lock_guard<std::mutex> lock(registry.mutex);
+
+	for (std::unique_ptr<ThreadBuffer> const& buffer : registry.buffers)
+	{
+		buffer->count.store(0, std::memory_order_relaxed);
+		buffer->dropped.store(0, std::memory_order_relaxed);
+	}
+}
+
+uint64_t RTTrace::GetDroppedEventCount()
+{
+	Registry& registry = GetRegistry();
+	std::lock_guard<std::mutex> lock(registry.mutex);
+
+	uint64_t dropped = 0;
+	for (std::unique_ptr<ThreadBuffer> const& buffer : registry.buffers)
+	{
+		dropped += buffer->dropped.load(std::memory_order_relaxed);
+	}
+	return dropped;
+}
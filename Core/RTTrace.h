@@ -0,0 +1,109 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+/*
+	CPU timeline tracing, exported as Chrome trace event JSON for chrome://tracing or Perfetto.
+	Each thread appends its events to a buffer of its own without locks: the thread is the buffer's only
+	writer, and publishes each event by advancing the buffer's count with a release store, so the trace
+	can be written at any time while other threads keep recording. Buffers are registered once per
+	thread, which is the only point that takes a lock, and are kept for the life of the process.
+	The threads which record are the main thread, the persistent workers of RTJobSystem, the software
+	device's queue thread and the batch renderer's image writer, each named with SetThreadName().
+
+		RT_TRACE_ZONE("DoRayTracing");
+		RT_TRACE_COUNTER("Instances", instanceCount);
+
+	Zone and counter names are stored as pointers, so they must outlive the trace, as string literals do.
+	With RT_TRACE_ENABLED defined as 0 the macros compile to nothing. Compiled in but disabled, which is
+	the default at runtime, a zone or counter costs one relaxed load and a branch.
+*/
+
+#ifndef RT_TRACE_ENABLED
+#define RT_TRACE_ENABLED 1
+#endif
+
+namespace RTTrace {
+
+	// Events a thread can hold. Once its buffer is full further events are dropped and counted.
+	const size_t MaxEventsPerThread = 1 << 20;
+
+	namespace Detail {
+		inline std::atomic<bool> enabled{ false };
+	}
+
+	inline bool IsEnabled()
+	{
+		return Detail::enabled.load(std::memory_order_relaxed);
+	}
+
+	void SetEnabled(bool enable);
+
+	// Nanoseconds on the trace's clock, std::chrono::steady_clock measured from the first trace call.
+	uint64_t Now();
+
+	// Names the calling thread in the trace.
+	void SetThreadName(std::string const& name);
+
+	void RecordZone(char const* name, uint64_t startNanoseconds, uint64_t endNanoseconds);
+	void RecordCounter(char const* name, double value);
+
+	// Chrome trace event JSON of every event recorded since the last Clear().
+	std::string GetChromeTraceJson();
+
+	// Throws std::runtime_error if the file can't be written.
+	void WriteChromeTrace(std::filesystem::path const& path);
+
+	// Discards the recorded events, keeping the buffers' memory for new ones.
+	// No thread may record while the events are cleared.
+	void Clear();
+
+	// Events dropped because a thread's buffer was full.
+	uint64_t GetDroppedEventCount();
+}
+
+// Records the time from construction to destruction as a zone, if tracing was enabled at construction.
+class RTTraceZone {
+
+public:
+	explicit RTTraceZone(char const* name) :
+		name{ name },
+		start{ 0 },
+		active{ RTTrace::IsEnabled() }
+	{
+		if (active)
+		{
+			start = RTTrace::Now();
+		}
+	}
+
+	~RTTraceZone()
+	{
+		if (active)
+		{
+			RTTrace::RecordZone(name, start, RTTrace::Now());
+		}
+	}
+
+	RTTraceZone(RTTraceZone const&) = delete;
+	RTTraceZone& operator =(RTTraceZone const&) = delete;
+
+private:
+	char const*	name;
+	uint64_t	start;
+	bool		active;
+};
+
+#define RT_TRACE_CONCAT_INNER(a, b) a##b
+#define RT_TRACE_CONCAT(a, b) RT_TRACE_CONCAT_INNER(a, b)
+
+#if RT_TRACE_ENABLED
+#define RT_TRACE_ZONE(name) RTTraceZone RT_TRACE_CONCAT(rtTraceZone, __LINE__)(name)
+#define RT_TRACE_COUNTER(name, value) do { if (RTTrace::IsEnabled()) { RTTrace::RecordCounter((name), static_cast<double>(value)); } } while (false)
+#else
+#define RT_TRACE_ZONE(name) do { } while (false)
+#define RT_TRACE_COUNTER(name, value) do { } while (false)
+#endif
@@ -0,0 +1,144 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <vector>
+
+/*
+	Chase-Lev work stealing deque, with the memory orderings of Le, Pop, Cohen and Zappa Nardelli,
+	"Correct and Efficient Work-Stealing for Weak Memory Models" (PPoPP 2013).
+	The owning thread pushes and pops at the bottom without locks or read-modify-writes, except when
+	it competes with thieves for the last element. Any other thread steals from the top.
+	The ring grows when full. Retired rings are kept until the deque is destroyed, as a thief may
+	still be reading one, so memory is only ever as large as the largest the deque has been twice over.
+*/
+
+template<typename T>
+class RTWorkStealingDeque {
+
+	static_assert(std::is_trivially_copyable<T>::value, "Elements are read and written atomically.");
+
+public:
+	explicit RTWorkStealingDeque(size_t initialCapacity = 256) :
+		top{ 0 },
+		bottom{ 0 }
+	{
+		size_t capacity = 1;
+		while (capacity < initialCapacity)
+		{
+			capacity *= 2;
+		}
+		rings.push_back(std::make_unique<Ring>(capacity));
+		ring.store(rings.back().get(), std::memory_order_relaxed);
+	}
+
+	RTWorkStealingDeque(RTWorkStealingDeque const&) = delete;
+	RTWorkStealingDeque& operator =(RTWorkStealingDeque const&) = delete;
+
+	// Owner only.
+	void Push(T item)
+	{
+		int64_t b = bottom.load(std::memory_order_relaxed);
+		int64_t t = top.load(std::memory_order_acquire);
+		Ring* r = ring.load(std::memory_order_relaxed);
+		if (b - t > static_cast<int64_t>(r->mask))
+		{
+			r = Grow(r, t, b);
+		}
+		r->Store(b, item);
+
+		// Publishes the item to thieves, which read bottom with acquire.
+		bottom.store(b + 1, std::memory_order_release);
+	}
+
+	// Owner only. Takes the most recently pushed item, false when the deque is empty.
+	bool Pop(T& item)
+	{
+		int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+		Ring* r = ring.load(std::memory_order_relaxed);
+		bottom.store(b, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t t = top.load(std::memory_order_relaxed);
+
+		if (t > b)
+		{
+			bottom.store(b + 1, std::memory_order_relaxed);
+			return false;
+		}
+
+		item = r->Load(b);
+		if (t == b)
+		{
+			// The last item, which a thief may be taking at the same time.
+			bool won = top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed);
+			bottom.store(b + 1, std::memory_order_relaxed);
+			return won;
+		}
+		return true;
+	}
+
+	// Any thread. Takes the oldest item, false when the deque is empty or another thread took it first.
+	bool Steal(T& item)
+	{
+		int64_t t = top.load(std::memory_order_acquire);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		int64_t b = bottom.load(std::memory_order_acquire);
+		if (t >= b)
+		{
+			return false;
+		}
+
+		Ring* r = ring.load(std::memory_order_acquire);
+		T stolen = r->Load(t);
+		if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+		{
+			return false;
+		}
+		item = stolen;
+		return true;
+	}
+
+	// A snapshot, exact only on the owning thread while nothing is stolen.
+	bool IsEmpty() const
+	{
+		return bottom.load(std::memory_order_relaxed) <= top.load(std::memory_order_relaxed);
+	}
+
+private:
+	struct Ring {
+		explicit Ring(size_t capacity) :
+			mask{ capacity - 1 },
+			items{ new std::atomic<T>[capacity] }
+		{
+		}
+
+		T Load(int64_t index) const { return items[static_cast<size_t>(index) & mask].load(std::memory_order_relaxed); }
+		void Store(int64_t index, T item) { items[static_cast<size_t>(index) & mask].store(item, std::memory_order_relaxed); }
+
+		size_t							mask;
+		std::unique_ptr<std::atomic<T>[]>	items;
+	};
+
+	Ring* Grow(Ring* old, int64_t t, int64_t b)
+	{
+		rings.push_back(std::make_unique<Ring>((old->mask + 1) * 2));
+		Ring* grown = rings.back().get();
+		for (int64_t i = t; i < b; ++i)
+		{
+			grown->Store(i, old->Load(i));
+		}
+		ring.store(grown, std::memory_order_release);
+		return grown;
+	}
+
+	// Apart, so the owner's bottom and the thieves' top don't share a cache line.
+	alignas(64) std::atomic<int64_t>	top;
+	alignas(64) std::atomic<int64_t>	bottom;
+	alignas(64) std::atomic<Ring*>		ring;
+
+	// Written by the owner only, every ring the deque has used.
+	std::vector<std::unique_ptr<Ring>>	rings;
+};
@@ -0,0 +1,159 @@
+#include "RTAccelerationStructureBuilder.h"
+#include "RTBlasCompactor.h"
+#include "HrException.h"
+#include "d3dx12.h"
+#include "../RHI/RTBuildPlanner.h"
+
+namespace {
+
+	UINT64 AlignUp(UINT64 size, UINT64 alignment)
+	{
+		return (size + alignment - 1) & ~(alignment - 1);
+	}
+}
+
+RTAccelerationStructureBuilder::RTAccelerationStructureBuilder(ID3D12Device5* device, UINT64 scratchPoolSize, UINT64 heapSize) :
+	device{ device },
+	scratchPoolSize{ scratchPoolSize },
+	heapSize{ heapSize },
+	lastBatchCount{ 0 }
+{
+}
+
+UINT RTAccelerationStructureBuilder::AddBottomLevel(std::vector<D3D12_RAYTRACING_GEOMETRY_DESC> geometries, D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAGS flags)
+{
+	pendingBuilds.push_back(PendingBuild{ std::move(geometries), flags });
+	return static_cast<UINT>(pendingBuilds.size() - 1);
+}
+
+std::vector<D3D12_GPU_VIRTUAL_ADDRESS_RANGE> RTAccelerationStructureBuilder::Build(ID3D12GraphicsCommandList4* commandList, RTBlasCompactor* compactor)
+{
+	std::vector<D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_INPUTS> inputs(pendingBuilds.size());
+	std::vector<RTBuildSizes> sizes(pendingBuilds.size());
+
+	for (size_t i = 0; i < pendingBuilds.size(); ++i)
+	{
+		inputs[i].Type = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL;
+		inputs[i].DescsLayout = D3D12_ELEMENTS_LAYOUT_ARRAY;
+		inputs[i].NumDescs = static_cast<UINT>(pendingBuilds[i].geometries.size());
+		inputs[i].pGeometryDescs = pendingBuilds[i].geometries.data();
+		inputs[i].Flags = pendingBuilds[i].flags;
+
+		D3D12_RAYTRACING_ACCELERATION_STRUCTURE_PREBUILD_INFO prebuildInfo = {};
+		device->GetRaytracingAccelerationStructurePrebuildInfo(&inputs[i], &prebuildInfo);
+		sizes[i] = RTBuildSizes{ prebuildInfo.ResultDataMaxSizeInBytes, prebuildInfo.ScratchDataSizeInBytes };
+	}
+
+	// Acceleration structures only need 256 byte alignment inside the buffer they are suballocated from.
+	RTBuildPlan plan = RTBuildPlanner::Plan(
+		sizes,
+		scratchPoolSize,
+		heapSize,
+		D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BYTE_ALIGNMENT,
+		D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BYTE_ALIGNMENT);
+
+	size_t firstHeap = resultHeaps.size();
+	for (UINT64 size : plan.heapSizes)
+	{
+		// Heaps are sized in whole 64KB pages, the buffer placed at the start of each one covers all of it.
+		UINT64 heapBytes = AlignUp(size, D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT);
+		resultHeaps.push_back(CreateHeap(heapBytes, L"AccelerationStructureHeap"));
+
+		Microsoft::WRL::ComPtr<ID3D12Resource> resultBuffer;
+		CD3DX12_RESOURCE_DESC resultDesc = CD3DX12_RESOURCE_DESC::Buffer(heapBytes, D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+		ThrowIfFailed(device->CreatePlacedResource(
+			resultHeaps.back().Get(),
+			0,
+			&resultDesc,
+			D3D12_RESOURCE_STATE_RAYTRACING_ACCELERATION_STRUCTURE,
+			nullptr,
+			IID_PPV_ARGS(&resultBuffer)),
+			L"Failed to place BLAS buffer");
+		resultBuffer->SetName(L"BottomLevelAccelerationStructures");
+		resultBuffers.push_back(std::move(resultBuffer));
+	}
+
+	std::vector<D3D12_GPU_VIRTUAL_ADDRESS_RANGE> results(pendingBuilds.size());
+	for (size_t i = 0; i < pendingBuilds.size(); ++i)
+	{
+		RTResultPlacement const& placement = plan.resultPlacements[i];
+		results[i].StartAddress = resultBuffers[firstHeap + placement.heapIndex]->GetGPUVirtualAddress() + placement.offset;
+		results[i].SizeInBytes = sizes[i].resultSize;
+	}
+
+	// The scratch pool is kept between calls while it is large enough.
+	if (plan.scratchPoolSize > 0 && (!scratchBuffer || scratchBuffer->GetDesc().Width < plan.scratchPoolSize))
+	{
+		scratchBuffer.Reset();
+		scratchHeap = CreateHeap(plan.scratchPoolSize, L"AccelerationStructureScratchHeap");
+
+		CD3DX12_RESOURCE_DESC scratchDesc = CD3DX12_RESOURCE_DESC::Buffer(plan.scratchPoolSize, D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+		ThrowIfFailed(device->CreatePlacedResource(
+			scratchHeap.Get(),
+			0,
+			&scratchDesc,
+			D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+			nullptr,
+			IID_PPV_ARGS(&scratchBuffer)),
+			L"Failed to place acceleration structure scratch pool");
+		scratchBuffer->SetName(L"AccelerationStructureScratchPool");
+	}
+
+	for (size_t batch = 0; batch < plan.batches.size(); ++batch)
+	{
+		// The builds of a batch use disjoint scratch memory, only reusing the pool has to wait for the previous batch.
+		if (batch > 0)
+		{
+			CD3DX12_RESOURCE_BARRIER scratchBarrier = CD3DX12_RESOURCE_BARRIER::UAV(scratchBuffer.Get());
+			commandList->ResourceBarrier(1, &scratchBarrier);
+		}
+
+		RTBuildBatch const& buildBatch = plan.batches[batch];
+		for (size_t i = 0; i < buildBatch.builds.size(); ++i)
+		{
+			UINT build = buildBatch.builds[i];
+
+			D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_DESC buildDesc = {};
+			buildDesc.Inputs = inputs[build];
+			buildDesc.ScratchAccelerationStructureData = scratchBuffer->GetGPUVirtualAddress() + buildBatch.scratchOffsets[i];
+			buildDesc.DestAccelerationStructureData = results[build].StartAddress;
+
+			if (compactor)
+			{
+				D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_DESC postbuildInfoDesc = compactor->GetPostbuildInfoDesc(build);
+				commandList->BuildRaytracingAccelerationStructure(&buildDesc, 1, &postbuildInfoDesc);
+			}
+			else
+			{
+				commandList->BuildRaytracingAccelerationStructure(&buildDesc, 0, nullptr);
+			}
+		}
+	}
+
+	// Work recorded after the builds, such as a TLAS build, reads the finished results.
+	if (!plan.batches.empty())
+	{
+		CD3DX12_RESOURCE_BARRIER resultBarrier = CD3DX12_RESOURCE_BARRIER::UAV(nullptr);
+		commandList->ResourceBarrier(1, &resultBarrier);
+	}
+
+	lastBatchCount = plan.batches.size();
+	pendingBuilds.clear();
+	return results;
+}
+
+void RTAccelerationStructureBuilder::ReleaseScratch()
+{
+	scratchBuffer.Reset();
+	scratchHeap.Reset();
+}
+
+Microsoft::WRL::ComPtr<ID3D12Heap> RTAccelerationStructureBuilder::CreateHeap(UINT64 size, LPCWSTR name)
+{
+	Microsoft::WRL::ComPtr<ID3D12Heap> heap;
+	CD3DX12_HEAP_DESC heapDesc(size, D3D12_HEAP_TYPE_DEFAULT, D3D12_DEFAULT_RESOURCE_PLACEMENT_ALIGNMENT, D3D12_HEAP_FLAG_ALLOW_ONLY_BUFFERS);
+	ThrowIfFailed(device->CreateHeap(&heapDesc, IID_PPV_ARGS(&heap)),
+		L"Failed to create acceleration structure heap");
+	heap->SetName(name);
+	return heap;
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <wrl.h>
+#include <d3d12.h>
+#include <vector>
+
+/*
+	Builds many bottom level acceleration structures together, planned by RTBuildPlanner.
+	The builds share one scratch pool instead of each keeping a scratch buffer of its own, and are
+	recorded in batches which fit in the pool side by side. The only barriers are one on the scratch
+	pool between batches and one on the results after the last batch. Each result heap holds a single
+	placed buffer the results are suballocated from at the 256 byte acceleration structure alignment,
+	rather than each result taking a 64KB aligned resource of its own. The builder owns the buffers,
+	so it must outlive the structures.
+*/
+
+class RTBlasCompactor;
+
+class RTAccelerationStructureBuilder {
+
+public:
+	RTAccelerationStructureBuilder(ID3D12Device5* device, UINT64 scratchPoolSize = 32 * 1024 * 1024, UINT64 heapSize = 64 * 1024 * 1024);
+
+	RTAccelerationStructureBuilder(RTAccelerationStructureBuilder const&) = delete;
+	RTAccelerationStructureBuilder& operator =(RTAccelerationStructureBuilder const&) = delete;
+
+	// Queues a bottom level build and returns its index. The buffers the geometry references must stay alive until the build has executed.
+	UINT AddBottomLevel(std::vector<D3D12_RAYTRACING_GEOMETRY_DESC> geometries, D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAGS flags);
+
+	// Places the results and records every queued build, returning the address ranges of the structures in the order they were added.
+	// With a compactor, build i writes its compacted size to the compactor's postbuild info i.
+	// The scratch pool is shared, so the builds of an earlier call must have completed.
+	std::vector<D3D12_GPU_VIRTUAL_ADDRESS_RANGE> Build(ID3D12GraphicsCommandList4* commandList, RTBlasCompactor* compactor = nullptr);
+
+	// Releases the scratch pool, once the recorded builds have completed.
+	void ReleaseScratch();
+
+	// Number of batches, and so of scratch pool reuses, in the last Build().
+	size_t GetLastBatchCount() const { return lastBatchCount; }
+
+private:
+	struct PendingBuild {
+		std::vector<D3D12_RAYTRACING_GEOMETRY_DESC>				geometries;
+		D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAGS		flags;
+	};
+
+	Microsoft::WRL::ComPtr<ID3D12Heap> CreateHeap(UINT64 size, LPCWSTR name);
+
+	Microsoft::WRL::ComPtr<ID3D12Device5>				device;
+	UINT64												scratchPoolSize;
+	UINT64												heapSize;
+
+	std::vector<PendingBuild>							pendingBuilds;
+
+	// Scratch pool, placed in a heap of its own
+	Microsoft::WRL::ComPtr<ID3D12Heap>					scratchHeap;
+	Microsoft::WRL::ComPtr<ID3D12Resource>				scratchBuffer;
+
+	// Heaps the results are placed in, each covered by one buffer the results are suballocated from
+	std::vector<Microsoft::WRL::ComPtr<ID3D12Heap>>		resultHeaps;
+	std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>>	resultBuffers;
+
+	size_t												lastBatchCount;
+};
@@ -0,0 +1,130 @@
+#include "RTBlasCompactor.h"
+#include "HrException.h"
+#include "d3dx12.h"
+#include <algorithm>
+
+namespace {
+
+	constexpr UINT64 PostbuildInfoSize = sizeof(D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_COMPACTED_SIZE_DESC);
+
+	UINT64 AlignUp(UINT64 size, UINT64 alignment)
+	{
+		return (size + alignment - 1) & ~(alignment - 1);
+	}
+}
+
+RTBlasCompactor::RTBlasCompactor(ID3D12Device5* device, UINT accelerationStructureCount) :
+	device{ device },
+	accelerationStructureCount{ accelerationStructureCount },
+	originalSizeInBytes{ 0 },
+	compactedSizeInBytes{ 0 }
+{
+	UINT64 bufferSize = PostbuildInfoSize * std::max<UINT>(accelerationStructureCount, 1);
+
+	// The builds write their postbuild info through a UAV, so the sizes land in default heap memory first.
+	CD3DX12_HEAP_PROPERTIES defaultHeapProperties(D3D12_HEAP_TYPE_DEFAULT);
+	CD3DX12_RESOURCE_DESC postbuildInfoDesc = CD3DX12_RESOURCE_DESC::Buffer(bufferSize, D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+	ThrowIfFailed(device->CreateCommittedResource(
+		&defaultHeapProperties,
+		D3D12_HEAP_FLAG_NONE,
+		&postbuildInfoDesc,
+		D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+		nullptr,
+		IID_PPV_ARGS(&postbuildInfoBuffer)),
+		L"Failed to create postbuild info buffer");
+	postbuildInfoBuffer->SetName(L"BlasPostbuildInfo");
+
+	CD3DX12_HEAP_PROPERTIES readbackHeapProperties(D3D12_HEAP_TYPE_READBACK);
+	CD3DX12_RESOURCE_DESC readbackDesc = CD3DX12_RESOURCE_DESC::Buffer(bufferSize);
+	ThrowIfFailed(device->CreateCommittedResource(
+		&readbackHeapProperties,
+		D3D12_HEAP_FLAG_NONE,
+		&readbackDesc,
+		D3D12_RESOURCE_STATE_COPY_DEST,
+		nullptr,
+		IID_PPV_ARGS(&readbackBuffer)),
+		L"Failed to create postbuild info readback buffer");
+	readbackBuffer->SetName(L"BlasPostbuildInfoReadback");
+}
+
+D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_DESC RTBlasCompactor::GetPostbuildInfoDesc(UINT index) const
+{
+	D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_DESC postbuildInfoDesc = {};
+	postbuildInfoDesc.InfoType = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_COMPACTED_SIZE;
+	postbuildInfoDesc.DestBuffer = postbuildInfoBuffer->GetGPUVirtualAddress() + index * PostbuildInfoSize;
+	return postbuildInfoDesc;
+}
+
+void RTBlasCompactor::RecordSizeReadback(ID3D12GraphicsCommandList4* commandList)
+{
+	// The postbuild info is written as part of the builds, which have to finish before it is copied.
+	D3D12_RESOURCE_BARRIER barriers[] = {
+		CD3DX12_RESOURCE_BARRIER::UAV(nullptr),
+		CD3DX12_RESOURCE_BARRIER::Transition(postbuildInfoBuffer.Get(), D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COPY_SOURCE)
+	};
+	commandList->ResourceBarrier(ARRAYSIZE(barriers), barriers);
+
+	commandList->CopyBufferRegion(readbackBuffer.Get(), 0, postbuildInfoBuffer.Get(), 0, PostbuildInfoSize * accelerationStructureCount);
+
+	CD3DX12_RESOURCE_BARRIER toUnorderedAccess = CD3DX12_RESOURCE_BARRIER::Transition(postbuildInfoBuffer.Get(), D3D12_RESOURCE_STATE_COPY_SOURCE, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+	commandList->ResourceBarrier(1, &toUnorderedAccess);
+}
+
+Microsoft::WRL::ComPtr<ID3D12Resource> RTBlasCompactor::RecordCompaction(ID3D12GraphicsCommandList4* commandList, std::vector<D3D12_GPU_VIRTUAL_ADDRESS_RANGE>& accelerationStructures)
+{
+	ThrowIfFalse(accelerationStructures.size() == accelerationStructureCount, L"Acceleration structure count doesn't match the compactor");
+
+	D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_COMPACTED_SIZE_DESC* compactedSizes;
+	CD3DX12_RANGE readRange(0, static_cast<SIZE_T>(PostbuildInfoSize * accelerationStructureCount));
+	ThrowIfFailed(readbackBuffer->Map(0, &readRange, reinterpret_cast<void**>(&compactedSizes)),
+		L"Failed to map postbuild info readback buffer");
+
+	// The compacted copies are packed at the acceleration structure alignment into a single buffer.
+	std::vector<UINT64> compactedOffsets(accelerationStructureCount);
+	UINT64 compactedBufferSize = 0;
+	for (UINT i = 0; i < accelerationStructureCount; ++i)
+	{
+		compactedOffsets[i] = compactedBufferSize;
+		compactedBufferSize += AlignUp(compactedSizes[i].CompactedSizeInBytes, D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BYTE_ALIGNMENT);
+	}
+
+	CD3DX12_HEAP_PROPERTIES defaultHeapProperties(D3D12_HEAP_TYPE_DEFAULT);
+	CD3DX12_RESOURCE_DESC compactedDesc = CD3DX12_RESOURCE_DESC::Buffer(std::max<UINT64>(compactedBufferSize, D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BYTE_ALIGNMENT), D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+	Microsoft::WRL::ComPtr<ID3D12Resource> compactedBuffer;
+	ThrowIfFailed(device->CreateCommittedResource(
+		&defaultHeapProperties,
+		D3D12_HEAP_FLAG_NONE,
+		&compactedDesc,
+		D3D12_RESOURCE_STATE_RAYTRACING_ACCELERATION_STRUCTURE,
+		nullptr,
+		IID_PPV_ARGS(&compactedBuffer)),
+		L"Failed to create compacted BLAS buffer");
+	compactedBuffer->SetName(L"CompactedBottomLevelAccelerationStructures");
+
+	for (UINT i = 0; i < accelerationStructureCount; ++i)
+	{
+		D3D12_GPU_VIRTUAL_ADDRESS_RANGE& accelerationStructure = accelerationStructures[i];
+		D3D12_GPU_VIRTUAL_ADDRESS_RANGE compacted = {
+			compactedBuffer->GetGPUVirtualAddress() + compactedOffsets[i],
+			compactedSizes[i].CompactedSizeInBytes
+		};
+
+		commandList->CopyRaytracingAccelerationStructure(
+			compacted.StartAddress,
+			accelerationStructure.StartAddress,
+			D3D12_RAYTRACING_ACCELERATION_STRUCTURE_COPY_MODE_COMPACT);
+
+		originalSizeInBytes += accelerationStructure.SizeInBytes;
+		accelerationStructure = compacted;
+	}
+	compactedSizeInBytes += compactedBufferSize;
+
+	CD3DX12_RANGE writeRange(0, 0);
+	readbackBuffer->Unmap(0, &writeRange);
+
+	// Later builds which reference the compacted structures, such as the TLAS, must see the finished copies.
+	CD3DX12_RESOURCE_BARRIER uavBarrier = CD3DX12_RESOURCE_BARRIER::UAV(nullptr);
+	commandList->ResourceBarrier(1, &uavBarrier);
+
+	return compactedBuffer;
+}
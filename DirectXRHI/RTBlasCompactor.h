@@ -0,0 +1,48 @@
+#pragma once
+
+#include <wrl.h>
+#include <d3d12.h>
+#include <vector>
+
+/*
+	Compacts bottom level acceleration structures once they have been built. Builds are sized for the
+	worst case reported by the prebuild info, the compacted copy only takes the memory the driver
+	actually used, which is typically 30 to 50 percent less.
+	A single compactor handles any number of acceleration structures with one readback and one batch
+	of copies:
+		1. Build every acceleration structure with ALLOW_COMPACTION, passing GetPostbuildInfoDesc(i).
+		2. Record RecordSizeReadback() after the builds, then execute and wait for the command list.
+		3. Record RecordCompaction(), which swaps every entry for its compacted copy, then execute and wait.
+		4. Release the memory of the originals, such as the RTAccelerationStructureBuilder they were built by.
+	The compacted copies are suballocated from one buffer, which RecordCompaction() hands to the caller.
+*/
+
+class RTBlasCompactor {
+
+public:
+	RTBlasCompactor(ID3D12Device5* device, UINT accelerationStructureCount);
+
+	RTBlasCompactor(RTBlasCompactor const&) = delete;
+	RTBlasCompactor& operator =(RTBlasCompactor const&) = delete;
+
+	// Postbuild info which makes the build of acceleration structure index write its compacted size.
+	D3D12_RAYTRACING_ACCELERATION_STRUCTURE_POSTBUILD_INFO_DESC GetPostbuildInfoDesc(UINT index) const;
+
+	// Copies the compacted sizes written by the builds to CPU readable memory.
+	void RecordSizeReadback(ID3D12GraphicsCommandList4* commandList);
+
+	// Creates one buffer holding every compacted acceleration structure and records the compacting copies.
+	// The entries are replaced by the compacted address ranges, and the returned buffer must outlive them.
+	Microsoft::WRL::ComPtr<ID3D12Resource> RecordCompaction(ID3D12GraphicsCommandList4* commandList, std::vector<D3D12_GPU_VIRTUAL_ADDRESS_RANGE>& accelerationStructures);
+
+	UINT64 GetOriginalSizeInBytes() const { return originalSizeInBytes; }
+	UINT64 GetCompactedSizeInBytes() const { return compactedSizeInBytes; }
+
+private:
+	Microsoft::WRL::ComPtr<ID3D12Device5>				device;
+	Microsoft::WRL::ComPtr<ID3D12Resource>				postbuildInfoBuffer;
+	Microsoft::WRL::ComPtr<ID3D12Resource>				readbackBuffer;
+	UINT												accelerationStructureCount;
+	UINT64												originalSizeInBytes;
+	UINT64												compactedSizeInBytes;
+};
@@ -0,0 +1,85 @@
+#include "RTComputeQueue.h"
+#include "HrException.h"
+
+RTComputeQueue::RTComputeQueue(ID3D12Device* device, UINT frameCount) :
+	commandAllocators(frameCount),
+	fenceEvent{ nullptr },
+	fenceValue{ 0 },
+	allocatorFenceValues(frameCount, 0),
+	recordingFrameIndex{ frameCount }
+{
+	D3D12_COMMAND_QUEUE_DESC queueDesc = {};
+	queueDesc.Type = D3D12_COMMAND_LIST_TYPE_COMPUTE;
+	queueDesc.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
+	ThrowIfFailed(device->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(&commandQueue)),
+		L"Failed to create compute command queue");
+	commandQueue->SetName(L"ComputeQueue");
+
+	for (Microsoft::WRL::ComPtr<ID3D12CommandAllocator>& commandAllocator : commandAllocators)
+	{
+		ThrowIfFailed(device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_COMPUTE, IID_PPV_ARGS(&commandAllocator)));
+	}
+
+	ThrowIfFailed(device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_COMPUTE, commandAllocators[0].Get(), nullptr, IID_PPV_ARGS(&commandList)));
+	ThrowIfFailed(commandList->Close());
+
+	ThrowIfFailed(device->CreateFence(fenceValue, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&fence)));
+	fenceEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+	ThrowIfFalse(fenceEvent != nullptr, L"CreateEvent failed.\n");
+}
+
+RTComputeQueue::~RTComputeQueue()
+{
+	// The queue must not be released while it still executes, but a destructor can't throw.
+	if (fenceEvent)
+	{
+		if (fence->GetCompletedValue() < fenceValue && SUCCEEDED(fence->SetEventOnCompletion(fenceValue, fenceEvent)))
+		{
+			WaitForSingleObjectEx(fenceEvent, INFINITE, FALSE);
+		}
+		CloseHandle(fenceEvent);
+	}
+}
+
+ID3D12GraphicsCommandList4* RTComputeQueue::Begin(UINT frameIndex)
+{
+	if (frameIndex != recordingFrameIndex)
+	{
+		WaitForFenceValue(allocatorFenceValues[frameIndex]);
+		ThrowIfFailed(commandAllocators[frameIndex]->Reset());
+		recordingFrameIndex = frameIndex;
+	}
+
+	ThrowIfFailed(commandList->Reset(commandAllocators[frameIndex].Get(), nullptr));
+	return commandList.Get();
+}
+
+UINT64 RTComputeQueue::Submit()
+{
+	ThrowIfFailed(commandList->Close());
+	ID3D12CommandList* commandLists[] = { commandList.Get() };
+	commandQueue->ExecuteCommandLists(ARRAYSIZE(commandLists), commandLists);
+
+	ThrowIfFailed(commandQueue->Signal(fence.Get(), ++fenceValue));
+	allocatorFenceValues[recordingFrameIndex] = fenceValue;
+	return fenceValue;
+}
+
+void RTComputeQueue::MakeQueueWait(ID3D12CommandQueue* queue, UINT64 value) const
+{
+	ThrowIfFailed(queue->Wait(fence.Get(), value));
+}
+
+void RTComputeQueue::WaitForIdle()
+{
+	WaitForFenceValue(fenceValue);
+}
+
+void RTComputeQueue::WaitForFenceValue(UINT64 value)
+{
+	if (fence->GetCompletedValue() < value)
+	{
+		ThrowIfFailed(fence->SetEventOnCompletion(value, fenceEvent));
+		WaitForSingleObjectEx(fenceEvent, INFINITE, FALSE);
+	}
+}
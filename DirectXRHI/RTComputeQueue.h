@@ -0,0 +1,52 @@
+#pragma once
+
+#include <wrl.h>
+#include <d3d12.h>
+#include <vector>
+
+/*
+	Compute command queue for acceleration structure builds and refits, which then run alongside the
+	ray tracing of the previous frame on the direct queue instead of serialising with it.
+	Each frame in flight records into its own command allocator. Submissions signal the queue's fence,
+	and MakeQueueWait() hands the finished work over to another queue without blocking the CPU.
+*/
+
+class RTComputeQueue {
+
+public:
+	RTComputeQueue(ID3D12Device* device, UINT frameCount);
+	~RTComputeQueue();
+
+	RTComputeQueue(RTComputeQueue const&) = delete;
+	RTComputeQueue& operator =(RTComputeQueue const&) = delete;
+
+	// Opens the command list for recording. The allocator of frameIndex is reset on the first call of a frame,
+	// which waits for the submissions it recorded frameCount frames ago.
+	ID3D12GraphicsCommandList4* Begin(UINT frameIndex);
+
+	// Closes and executes the command list, returning the fence value signalled when it has completed.
+	UINT64 Submit();
+
+	// Makes queue wait on the GPU until the submission which returned value has completed.
+	void MakeQueueWait(ID3D12CommandQueue* queue, UINT64 value) const;
+
+	// Blocks the CPU until every submission has completed.
+	void WaitForIdle();
+
+	ID3D12CommandQueue* GetCommandQueue() const { return commandQueue.Get(); }
+
+private:
+	void WaitForFenceValue(UINT64 value);
+
+	Microsoft::WRL::ComPtr<ID3D12CommandQueue>					commandQueue;
+	std::vector<Microsoft::WRL::ComPtr<ID3D12CommandAllocator>>	commandAllocators;
+	Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList4>			commandList;
+
+	Microsoft::WRL::ComPtr<ID3D12Fence>							fence;
+	HANDLE														fenceEvent;
+	UINT64														fenceValue;
+
+	// Fence value of the last submission recorded with each allocator
+	std::vector<UINT64>											allocatorFenceValues;
+	UINT														recordingFrameIndex;
+};
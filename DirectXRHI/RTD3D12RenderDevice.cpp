@@ -0,0 +1,735 @@
+#include "RTD3D12RenderDevice.h"
+#include "RTUploadBatch.h"
+#include "RTTopLevelAccelerationStructure.h"
+#include "RTShaderTableBuilder.h"
+#include "HrException.h"
+#include "d3dx12.h"
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+namespace {
+
+	UINT64 AlignUp(UINT64 size, UINT64 alignment)
+	{
+		return (size + alignment - 1) & ~(alignment - 1);
+	}
+
+	// Raw view of a ray counter buffer, which RayGen.hlsl adds to as a RWByteAddressBuffer.
+	D3D12_UNORDERED_ACCESS_VIEW_DESC GetRayCounterViewDesc(UINT64 size)
+	{
+		D3D12_UNORDERED_ACCESS_VIEW_DESC viewDesc = {};
+		viewDesc.Format = DXGI_FORMAT_R32_TYPELESS;
+		viewDesc.ViewDimension = D3D12_UAV_DIMENSION_BUFFER;
+		viewDesc.Buffer.NumElements = static_cast<UINT>(size / sizeof(uint32_t));
+		viewDesc.Buffer.Flags = D3D12_BUFFER_UAV_FLAG_RAW;
+		return viewDesc;
+	}
+
+	template <typename T, typename TBase>
+	T* Cast(TBase* object, wchar_t const* message)
+	{
+		T* result = dynamic_cast<T*>(object);
+		ThrowIfFalse(result != nullptr, message);
+		return result;
+	}
+
+	// Ray counter buffers stay in the unordered access state between commands, with their raw UAV in a CPU only
+	// heap like the views of textures.
+	class D3D12Buffer : public RTBuffer {
+
+	public:
+		D3D12Buffer(Microsoft::WRL::ComPtr<ID3D12Resource> resource, RTBufferDesc const& desc) :
+			resource{ std::move(resource) },
+			usage{ desc.usage },
+			size{ desc.size }
+		{
+		}
+
+		uint64_t GetSize() const override { return size; }
+
+		void const* Map() override
+		{
+			ThrowIfFalse(usage == RTBufferUsage::Readback, L"Only readback buffers can be mapped.\n");
+
+			void* data = nullptr;
+			CD3DX12_RANGE readRange(0, static_cast<SIZE_T>(size));
+			ThrowIfFailed(resource->Map(0, &readRange, &data));
+			return data;
+		}
+
+		void Unmap() override
+		{
+			// Nothing was written by the CPU.
+			CD3DX12_RANGE writeRange(0, 0);
+			resource->Unmap(0, &writeRange);
+		}
+
+		Microsoft::WRL::ComPtr<ID3D12Resource>			resource;
+		Microsoft::WRL::ComPtr<ID3D12DescriptorHeap>	descriptorHeap;
+		RTBufferUsage									usage;
+		uint64_t										size;
+	};
+
+	// Textures stay in the unordered access state between commands. Their UAV is in a CPU only heap of its own,
+	// and copied into the shader visible heap of every dispatch which uses the texture.
+	class D3D12Texture : public RTTexture {
+
+	public:
+		uint32_t GetWidth() const override { return width; }
+		uint32_t GetHeight() const override { return height; }
+
+		Microsoft::WRL::ComPtr<ID3D12Resource>			resource;
+		Microsoft::WRL::ComPtr<ID3D12DescriptorHeap>	descriptorHeap;
+		DXGI_FORMAT										format = DXGI_FORMAT_UNKNOWN;
+		uint32_t										width = 0;
+		uint32_t										height = 0;
+	};
+
+	// The result and scratch buffers are sized when the structure is created, the build only records.
+	class D3D12BottomLevel : public RTAccelerationStructure {
+
+	public:
+		D3D12_RAYTRACING_GEOMETRY_DESC			geometryDesc = {};
+		Microsoft::WRL::ComPtr<ID3D12Resource>	result;
+		Microsoft::WRL::ComPtr<ID3D12Resource>	scratch;
+		UINT									indexSizeInBytes = 0;
+	};
+
+	// One version of the structure, which the frames in flight of RTFrameRenderer each have their own of.
+	// The hit group arguments of every instance are kept for the shader tables of dispatches against it.
+	class D3D12TopLevel : public RTAccelerationStructure {
+
+	public:
+		explicit D3D12TopLevel(ID3D12Device5* device) :
+			structure{ device, 1 }
+		{
+		}
+
+		RTTopLevelAccelerationStructure				structure;
+		std::vector<D3D12_RAYTRACING_INSTANCE_DESC>	instanceDescs;
+		std::vector<HitGroupLocalArguments>			hitGroupArguments;
+	};
+
+	class D3D12Fence : public RTFence {
+
+	public:
+		D3D12Fence(ID3D12Device* device, uint64_t initialValue) :
+			fenceEvent{ nullptr }
+		{
+			ThrowIfFailed(device->CreateFence(initialValue, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&fence)));
+			fenceEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+			ThrowIfFalse(fenceEvent != nullptr, L"CreateEvent failed.\n");
+		}
+
+		~D3D12Fence() override
+		{
+			CloseHandle(fenceEvent);
+		}
+
+		uint64_t GetCompletedValue() const override { return fence->GetCompletedValue(); }
+
+		void Wait(uint64_t value) override
+		{
+			if (fence->GetCompletedValue() < value)
+			{
+				ThrowIfFailed(fence->SetEventOnCompletion(value, fenceEvent));
+				WaitForSingleObjectEx(fenceEvent, INFINITE, FALSE);
+			}
+		}
+
+		Microsoft::WRL::ComPtr<ID3D12Fence>	fence;
+		HANDLE								fenceEvent;
+	};
+
+	class D3D12CommandList : public RTCommandList {
+
+	public:
+		D3D12CommandList(ID3D12Device5* device, RTRayTracingPipeline const& pipeline) :
+			device{ device },
+			pipeline{ pipeline },
+			dispatchCount{ 0 },
+			closed{ false }
+		{
+			ThrowIfFailed(device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&commandAllocator)));
+			ThrowIfFailed(device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, commandAllocator.Get(), nullptr, IID_PPV_ARGS(&commandList)));
+		}
+
+		~D3D12CommandList() override
+		{
+			for (ConstantBuffer& constants : constantBuffers)
+			{
+				constants.resource->Unmap(0, nullptr);
+			}
+		}
+
+		void Reset() override
+		{
+			ThrowIfFailed(commandAllocator->Reset());
+			ThrowIfFailed(commandList->Reset(commandAllocator.Get(), nullptr));
+			dispatchCount = 0;
+			closed = false;
+		}
+
+		void BuildBottomLevel(RTAccelerationStructure& bottomLevel) override
+		{
+			D3D12BottomLevel* d3dBottomLevel = Cast<D3D12BottomLevel>(&bottomLevel, L"BuildBottomLevel() expects a bottom level structure of the D3D12 device.\n");
+			RecordingList();
+
+			D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_DESC buildDesc = {};
+			buildDesc.Inputs.Type = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL;
+			buildDesc.Inputs.DescsLayout = D3D12_ELEMENTS_LAYOUT_ARRAY;
+			buildDesc.Inputs.Flags = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_PREFER_FAST_TRACE;
+			buildDesc.Inputs.NumDescs = 1;
+			buildDesc.Inputs.pGeometryDescs = &d3dBottomLevel->geometryDesc;
+			buildDesc.DestAccelerationStructureData = d3dBottomLevel->result->GetGPUVirtualAddress();
+			buildDesc.ScratchAccelerationStructureData = d3dBottomLevel->scratch->GetGPUVirtualAddress();
+			commandList->BuildRaytracingAccelerationStructure(&buildDesc, 0, nullptr);
+
+			// Top level builds recorded later read the finished structure.
+			CD3DX12_RESOURCE_BARRIER resultBarrier = CD3DX12_RESOURCE_BARRIER::UAV(d3dBottomLevel->result.Get());
+			commandList->ResourceBarrier(1, &resultBarrier);
+		}
+
+		void BuildTopLevel(RTAccelerationStructure& topLevel, RTInstanceDesc const* instances, size_t instanceCount) override
+		{
+			D3D12TopLevel* d3dTopLevel = Cast<D3D12TopLevel>(&topLevel, L"BuildTopLevel() expects a top level structure of the D3D12 device.\n");
+			RecordingList();
+
+			// Every instance has its own hit group record, the one at its instance index.
+			d3dTopLevel->instanceDescs.resize(instanceCount);
+			d3dTopLevel->hitGroupArguments.resize(instanceCount);
+			for (size_t i = 0; i < instanceCount; ++i)
+			{
+				RTInstanceDesc const& instance = instances[i];
+				D3D12BottomLevel const* bottomLevel = Cast<D3D12BottomLevel const>(instance.bottomLevel, L"Instances must reference bottom level structures of the D3D12 device.\n");
+
+				D3D12_RAYTRACING_INSTANCE_DESC& instanceDesc = d3dTopLevel->instanceDescs[i];
+				instanceDesc = {};
+				std::memcpy(instanceDesc.Transform, instance.transform, sizeof(instanceDesc.Transform));
+				instanceDesc.InstanceID = static_cast<UINT>(i) & 0xFFFFFF;
+				instanceDesc.InstanceMask = 1;
+				instanceDesc.InstanceContributionToHitGroupIndex = static_cast<UINT>(i);
+				instanceDesc.Flags = D3D12_RAYTRACING_INSTANCE_FLAG_NONE;
+				instanceDesc.AccelerationStructure = bottomLevel->result->GetGPUVirtualAddress();
+
+				HitGroupLocalArguments& arguments = d3dTopLevel->hitGroupArguments[i];
+				arguments = {};
+				std::memcpy(arguments.colour, instance.colour, sizeof(arguments.colour));
+				arguments.indexSizeInBytes = bottomLevel->indexSizeInBytes;
+				arguments.vertexBuffer = bottomLevel->geometryDesc.Triangles.VertexBuffer.StartAddress;
+				arguments.indexBuffer = bottomLevel->geometryDesc.Triangles.IndexBuffer;
+			}
+
+			d3dTopLevel->structure.Build(commandList.Get(), 0, d3dTopLevel->instanceDescs);
+		}
+
+		void DispatchRays(RTDispatchRaysDesc const& desc) override
+		{
+			D3D12TopLevel const* topLevel = Cast<D3D12TopLevel const>(desc.topLevel, L"DispatchRays() expects a top level structure of the D3D12 device.\n");
+			D3D12Texture* output = Cast<D3D12Texture>(desc.output, L"DispatchRays() expects an output texture of the D3D12 device.\n");
+			ThrowIfFalse(output->format == DXGI_FORMAT_R8G8B8A8_UNORM, L"DispatchRays() expects an output texture.\n");
+			D3D12Texture* accumulation = nullptr;
+			if (desc.accumulationConstants.sampleCount > 0)
+			{
+				accumulation = Cast<D3D12Texture>(desc.accumulation, L"Accumulating dispatches need an accumulation texture of the D3D12 device.\n");
+				ThrowIfFalse(accumulation->format == DXGI_FORMAT_R32G32B32A32_FLOAT && accumulation->width == output->width && accumulation->height == output->height,
+					L"The accumulation texture must be an accumulation texture of the size of the output.\n");
+			}
+			ThrowIfFalse(desc.pathTracingConstants.maxBounces <= MaxPathBounces && desc.pathTracingConstants.samplesPerPixel > 0,
+				L"Dispatches trace at least one sample and at most MaxPathBounces bounces.\n");
+			D3D12Buffer* rayCounters = nullptr;
+			if (desc.rayCounters)
+			{
+				rayCounters = Cast<D3D12Buffer>(desc.rayCounters, L"DispatchRays() expects a ray counter buffer of the D3D12 device.\n");
+				ThrowIfFalse(rayCounters->usage == RTBufferUsage::RayCounters, L"DispatchRays() expects a ray counter buffer.\n");
+			}
+			RecordingList();
+
+			// Shader tables, constants and descriptors are kept across Reset(), one set for each dispatch of the list.
+			size_t dispatchIndex = dispatchCount++;
+			if (dispatchIndex == shaderTables.size())
+			{
+				shaderTables.push_back(std::make_unique<RTShaderTableBuilder>(device.Get(), 1));
+				constantBuffers.push_back(CreateConstantBuffer());
+				descriptorHeaps.push_back(CreateDescriptorHeap());
+			}
+			RTShaderTableBuilder& shaderTable = *shaderTables[dispatchIndex];
+			ConstantBuffer& constants = constantBuffers[dispatchIndex];
+			ID3D12DescriptorHeap* descriptorHeap = descriptorHeaps[dispatchIndex].Get();
+
+			// A table without records has no stride, so an empty scene still gets one unused hit group record.
+			UINT hitGroupRecordCount = std::max<UINT>(static_cast<UINT>(topLevel->hitGroupArguments.size()), 1);
+			shaderTable.Reset(
+				RTShaderTableDesc{ 1, 0 },
+				RTShaderTableDesc{ 1, 0 },
+				RTShaderTableDesc{ hitGroupRecordCount, sizeof(HitGroupLocalArguments) });
+			shaderTable.SetRecord(RTShaderTableType::RayGen, 0, pipeline.GetRayGenShaderIdentifier());
+			shaderTable.SetRecord(RTShaderTableType::Miss, 0, pipeline.GetMissShaderIdentifier());
+			for (UINT i = 0; i < hitGroupRecordCount; ++i)
+			{
+				HitGroupLocalArguments arguments = i < topLevel->hitGroupArguments.size() ? topLevel->hitGroupArguments[i] : HitGroupLocalArguments{};
+				shaderTable.SetRecord(RTShaderTableType::HitGroup, i, pipeline.GetHitGroupShaderIdentifier(), &arguments, sizeof(arguments));
+			}
+			shaderTable.Update(0);
+
+			std::memcpy(constants.mappedData, &desc.sceneConstants, sizeof(SceneConstantBuffer));
+
+			// The output, accumulation and ray counter views, u0 to u2. Without accumulation, u1 is a null view the shader
+			// never reads, and without ray counters, u2 is a null view which discards the counts.
+			UINT descriptorSize = device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+			CD3DX12_CPU_DESCRIPTOR_HANDLE outputView(descriptorHeap->GetCPUDescriptorHandleForHeapStart());
+			CD3DX12_CPU_DESCRIPTOR_HANDLE accumulationView(outputView, 1, descriptorSize);
+			CD3DX12_CPU_DESCRIPTOR_HANDLE rayCounterView(outputView, 2, descriptorSize);
+			device->CopyDescriptorsSimple(1, outputView, output->descriptorHeap->GetCPUDescriptorHandleForHeapStart(), D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+			if (accumulation)
+			{
+				device->CopyDescriptorsSimple(1, accumulationView, accumulation->descriptorHeap->GetCPUDescriptorHandleForHeapStart(), D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+			}
+			else
+			{
+				D3D12_UNORDERED_ACCESS_VIEW_DESC nullViewDesc = {};
+				nullViewDesc.Format = DXGI_FORMAT_R32G32B32A32_FLOAT;
+				nullViewDesc.ViewDimension = D3D12_UAV_DIMENSION_TEXTURE2D;
+				device->CreateUnorderedAccessView(nullptr, nullptr, &nullViewDesc, accumulationView);
+			}
+			if (rayCounters)
+			{
+				device->CopyDescriptorsSimple(1, rayCounterView, rayCounters->descriptorHeap->GetCPUDescriptorHandleForHeapStart(), D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+			}
+			else
+			{
+				D3D12_UNORDERED_ACCESS_VIEW_DESC nullViewDesc = GetRayCounterViewDesc(RayCounterCount * sizeof(uint32_t));
+				device->CreateUnorderedAccessView(nullptr, nullptr, &nullViewDesc, rayCounterView);
+			}
+
+			commandList->SetComputeRootSignature(pipeline.GetGlobalRootSignature());
+
+			ID3D12DescriptorHeap* descriptorHeaps[] = { descriptorHeap };
+			commandList->SetDescriptorHeaps(ARRAYSIZE(descriptorHeaps), descriptorHeaps);
+			commandList->SetComputeRootDescriptorTable(GlobalRootSignatureParams::OutputViewSlot, descriptorHeap->GetGPUDescriptorHandleForHeapStart());
+			commandList->SetComputeRootConstantBufferView(GlobalRootSignatureParams::ConstantBufferSlot, constants.resource->GetGPUVirtualAddress());
+			commandList->SetComputeRootShaderResourceView(GlobalRootSignatureParams::AccelerationStructureSlot, topLevel->structure.GetGPUVirtualAddress(0));
+			commandList->SetComputeRoot32BitConstants(GlobalRootSignatureParams::AccumulationConstantsSlot, sizeof(AccumulationConstants) / sizeof(UINT), &desc.accumulationConstants, 0);
+			commandList->SetComputeRoot32BitConstants(GlobalRootSignatureParams::PathTracingConstantsSlot, sizeof(PathTracingConstants) / sizeof(UINT), &desc.pathTracingConstants, 0);
+
+			// The dispatch adds to the counters, so they start from zero, once the clear has finished.
+			if (rayCounters)
+			{
+				UINT const zeros[4] = {};
+				CD3DX12_GPU_DESCRIPTOR_HANDLE rayCounterGpuView(descriptorHeap->GetGPUDescriptorHandleForHeapStart(), 2, descriptorSize);
+				commandList->ClearUnorderedAccessViewUint(rayCounterGpuView, rayCounters->descriptorHeap->GetCPUDescriptorHandleForHeapStart(), rayCounters->resource.Get(), zeros, 0, nullptr);
+				CD3DX12_RESOURCE_BARRIER clearBarrier = CD3DX12_RESOURCE_BARRIER::UAV(rayCounters->resource.Get());
+				commandList->ResourceBarrier(1, &clearBarrier);
+			}
+
+			D3D12_DISPATCH_RAYS_DESC dispatchDesc = {};
+			shaderTable.FillDispatchDesc(0, dispatchDesc);
+			dispatchDesc.Width = output->width;
+			dispatchDesc.Height = output->height;
+			dispatchDesc.Depth = 1;
+
+			commandList->SetPipelineState1(pipeline.GetStateObject());
+			commandList->DispatchRays(&dispatchDesc);
+
+			// Commands recorded later see the finished output, accumulation and counts.
+			CD3DX12_RESOURCE_BARRIER outputBarriers[3] = { CD3DX12_RESOURCE_BARRIER::UAV(output->resource.Get()) };
+			UINT outputBarrierCount = 1;
+			if (accumulation)
+			{
+				outputBarriers[outputBarrierCount++] = CD3DX12_RESOURCE_BARRIER::UAV(accumulation->resource.Get());
+			}
+			if (rayCounters)
+			{
+				outputBarriers[outputBarrierCount++] = CD3DX12_RESOURCE_BARRIER::UAV(rayCounters->resource.Get());
+			}
+			commandList->ResourceBarrier(outputBarrierCount, outputBarriers);
+		}
+
+		void CopyToReadback(RTTexture const& texture, RTBuffer& readback) override
+		{
+			D3D12Texture const* source = Cast<D3D12Texture const>(&texture, L"CopyToReadback() expects a texture of the D3D12 device.\n");
+			D3D12Buffer* destination = Cast<D3D12Buffer>(&readback, L"CopyToReadback() expects a buffer of the D3D12 device.\n");
+			ThrowIfFalse(source->format == DXGI_FORMAT_R8G8B8A8_UNORM, L"Only output textures can be copied to a readback buffer.\n");
+
+			UINT64 rowPitch = AlignUp(UINT64{ source->width } * 4, D3D12_TEXTURE_DATA_PITCH_ALIGNMENT);
+			ThrowIfFalse(destination->usage == RTBufferUsage::Readback && destination->size >= rowPitch * source->height,
+				L"CopyToReadback() needs a readback buffer large enough for the texture.\n");
+			RecordingList();
+
+			D3D12_PLACED_SUBRESOURCE_FOOTPRINT footprint = {};
+			footprint.Footprint.Format = DXGI_FORMAT_R8G8B8A8_UNORM;
+			footprint.Footprint.Width = source->width;
+			footprint.Footprint.Height = source->height;
+			footprint.Footprint.Depth = 1;
+			footprint.Footprint.RowPitch = static_cast<UINT>(rowPitch);
+
+			CD3DX12_TEXTURE_COPY_LOCATION destinationLocation(destination->resource.Get(), footprint);
+			CD3DX12_TEXTURE_COPY_LOCATION sourceLocation(source->resource.Get(), 0);
+
+			D3D12_RESOURCE_BARRIER preCopyBarrier = CD3DX12_RESOURCE_BARRIER::Transition(source->resource.Get(), D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COPY_SOURCE);
+			commandList->ResourceBarrier(1, &preCopyBarrier);
+			commandList->CopyTextureRegion(&destinationLocation, 0, 0, 0, &sourceLocation, nullptr);
+			D3D12_RESOURCE_BARRIER postCopyBarrier = CD3DX12_RESOURCE_BARRIER::Transition(source->resource.Get(), D3D12_RESOURCE_STATE_COPY_SOURCE, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+			commandList->ResourceBarrier(1, &postCopyBarrier);
+		}
+
+		void CopyToReadback(RTBuffer const& buffer, RTBuffer& readback) override
+		{
+			D3D12Buffer const* source = Cast<D3D12Buffer const>(&buffer, L"CopyToReadback() expects a buffer of the D3D12 device.\n");
+			D3D12Buffer* destination = Cast<D3D12Buffer>(&readback, L"CopyToReadback() expects a buffer of the D3D12 device.\n");
+			ThrowIfFalse(source->usage == RTBufferUsage::RayCounters, L"Only ray counter buffers can be copied to a readback buffer.\n");
+			ThrowIfFalse(destination->usage == RTBufferUsage::Readback && destination->size >= source->size,
+				L"CopyToReadback() needs a readback buffer large enough for the buffer.\n");
+			RecordingList();
+
+			D3D12_RESOURCE_BARRIER preCopyBarrier = CD3DX12_RESOURCE_BARRIER::Transition(source->resource.Get(), D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COPY_SOURCE);
+			commandList->ResourceBarrier(1, &preCopyBarrier);
+			commandList->CopyBufferRegion(destination->resource.Get(), 0, source->resource.Get(), 0, source->size);
+			D3D12_RESOURCE_BARRIER postCopyBarrier = CD3DX12_RESOURCE_BARRIER::Transition(source->resource.Get(), D3D12_RESOURCE_STATE_COPY_SOURCE, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
+			commandList->ResourceBarrier(1, &postCopyBarrier);
+		}
+
+		// Closes the list on its first submission, later submissions execute it again as it is.
+		ID3D12CommandList* Close()
+		{
+			if (!closed)
+			{
+				ThrowIfFailed(commandList->Close());
+				closed = true;
+			}
+			return commandList.Get();
+		}
+
+	private:
+		struct ConstantBuffer {
+			Microsoft::WRL::ComPtr<ID3D12Resource>	resource;
+			uint8_t*								mappedData = nullptr;
+		};
+
+		void RecordingList() const
+		{
+			ThrowIfFalse(!closed, L"A submitted command list has to be reset before recording.\n");
+		}
+
+		ConstantBuffer CreateConstantBuffer()
+		{
+			ConstantBuffer constants;
+
+			CD3DX12_HEAP_PROPERTIES uploadHeapProperties(D3D12_HEAP_TYPE_UPLOAD);
+			CD3DX12_RESOURCE_DESC bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(AlignUp(sizeof(SceneConstantBuffer), D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT));
+			ThrowIfFailed(device->CreateCommittedResource(
+				&uploadHeapProperties,
+				D3D12_HEAP_FLAG_NONE,
+				&bufferDesc,
+				D3D12_RESOURCE_STATE_GENERIC_READ,
+				nullptr,
+				IID_PPV_ARGS(&constants.resource)),
+				L"Failed to create the scene constant buffer");
+
+			// Persistently mapped, the CPU never reads it.
+			CD3DX12_RANGE readRange(0, 0);
+			ThrowIfFailed(constants.resource->Map(0, &readRange, reinterpret_cast<void**>(&constants.mappedData)));
+			return constants;
+		}
+
+		// Shader visible heap of a dispatch's output, accumulation and ray counter views.
+		Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> CreateDescriptorHeap()
+		{
+			D3D12_DESCRIPTOR_HEAP_DESC heapDesc = {};
+			heapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+			heapDesc.NumDescriptors = 3;
+			heapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
+
+			Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> descriptorHeap;
+			ThrowIfFailed(device->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&descriptorHeap)));
+			return descriptorHeap;
+		}
+
+		Microsoft::WRL::ComPtr<ID3D12Device5>				device;
+		RTRayTracingPipeline const&							pipeline;
+		Microsoft::WRL::ComPtr<ID3D12CommandAllocator>		commandAllocator;
+		Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList4>	commandList;
+
+		std::vector<std::unique_ptr<RTShaderTableBuilder>>	shaderTables;
+		std::vector<ConstantBuffer>							constantBuffers;
+		std::vector<Microsoft::WRL::ComPtr<ID3D12DescriptorHeap>>	descriptorHeaps;
+		size_t												dispatchCount;
+		bool												closed;
+	};
+}
+
+RTD3D12RenderDevice::RTD3D12RenderDevice(std::filesystem::path pipelineCachePath) :
+	idleEvent{ nullptr },
+	idleFenceValue{ 0 }
+{
+	CreateDevice();
+
+	D3D12_COMMAND_QUEUE_DESC queueDesc = {};
+	queueDesc.Flags = D3D12_COMMAND_QUEUE_FLAG_NONE;
+	queueDesc.Type = D3D12_COMMAND_LIST_TYPE_DIRECT;
+	ThrowIfFailed(device->CreateCommandQueue(&queueDesc, IID_PPV_ARGS(&commandQueue)));
+	commandQueue->SetName(L"RenderDeviceQueue");
+
+	ThrowIfFailed(device->CreateFence(idleFenceValue, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&idleFence)));
+	idleEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+	ThrowIfFalse(idleEvent != nullptr, L"CreateEvent failed.\n");
+
+	pipeline = std::make_unique<RTRayTracingPipeline>(device.Get(), adapter.Get(), std::move(pipelineCachePath));
+}
+
+RTD3D12RenderDevice::~RTD3D12RenderDevice()
+{
+	// Resources created by the device may still be in use by its queue.
+	if (idleEvent)
+	{
+		WaitForIdle();
+		CloseHandle(idleEvent);
+	}
+}
+
+void RTD3D12RenderDevice::CreateDevice()
+{
+	Microsoft::WRL::ComPtr<IDXGIFactory4> dxgiFactory;
+	ThrowIfFailed(CreateDXGIFactory1(IID_PPV_ARGS(&dxgiFactory)));
+
+	// The first hardware adapter whose device supports DirectX Raytracing.
+	Microsoft::WRL::ComPtr<IDXGIAdapter1> candidate;
+	for (UINT adapterID = 0; DXGI_ERROR_NOT_FOUND != dxgiFactory->EnumAdapters1(adapterID, &candidate); ++adapterID)
+	{
+		DXGI_ADAPTER_DESC1 adapterDesc;
+		ThrowIfFailed(candidate->GetDesc1(&adapterDesc));
+		if (adapterDesc.Flags & DXGI_ADAPTER_FLAG_SOFTWARE)
+		{
+			continue;
+		}
+
+		Microsoft::WRL::ComPtr<ID3D12Device5> candidateDevice;
+		if (FAILED(D3D12CreateDevice(candidate.Get(), D3D_FEATURE_LEVEL_11_0, IID_PPV_ARGS(&candidateDevice))))
+		{
+			continue;
+		}
+
+		D3D12_FEATURE_DATA_D3D12_OPTIONS5 options5 = {};
+		if (SUCCEEDED(candidateDevice->CheckFeatureSupport(D3D12_FEATURE_D3D12_OPTIONS5, &options5, sizeof(options5))) &&
+			options5.RaytracingTier >= D3D12_RAYTRACING_TIER_1_0)
+		{
+			adapter = candidate;
+			device = candidateDevice;
+			return;
+		}
+	}
+
+	ThrowIfFalse(false, L"No adapter supports DirectX Raytracing.\n");
+}
+
+std::unique_ptr<RTBuffer> RTD3D12RenderDevice::CreateBuffer(RTBufferDesc const& desc, void const* initialData)
+{
+	ThrowIfFalse(desc.size > 0, L"Buffers can't be empty.\n");
+
+	Microsoft::WRL::ComPtr<ID3D12Resource> resource;
+	if (desc.usage == RTBufferUsage::Readback)
+	{
+		CD3DX12_HEAP_PROPERTIES readbackHeapProperties(D3D12_HEAP_TYPE_READBACK);
+		CD3DX12_RESOURCE_DESC bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(desc.size);
+		ThrowIfFailed(device->CreateCommittedResource(
+			&readbackHeapProperties,
+			D3D12_HEAP_FLAG_NONE,
+			&bufferDesc,
+			D3D12_RESOURCE_STATE_COPY_DEST,
+			nullptr,
+			IID_PPV_ARGS(&resource)),
+			L"Failed to create a readback buffer");
+		resource->SetName(L"ReadbackBuffer");
+	}
+	else if (desc.usage == RTBufferUsage::RayCounters)
+	{
+		// Only dispatches write the counters, clearing them first, so the buffer needs no contents.
+		ThrowIfFalse(desc.size >= RayCounterCount * sizeof(uint32_t) && desc.size % sizeof(uint32_t) == 0,
+			L"Ray counter buffers need a 32 bit counter for every depth.\n");
+		CD3DX12_HEAP_PROPERTIES defaultHeapProperties(D3D12_HEAP_TYPE_DEFAULT);
+		CD3DX12_RESOURCE_DESC bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(desc.size, D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+		ThrowIfFailed(device->CreateCommittedResource(
+			&defaultHeapProperties,
+			D3D12_HEAP_FLAG_NONE,
+			&bufferDesc,
+			D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+			nullptr,
+			IID_PPV_ARGS(&resource)),
+			L"Failed to create a ray counter buffer");
+		resource->SetName(L"RayCounters");
+	}
+	else
+	{
+		// Geometry is copied into default heap memory, in the state for both shader reads and acceleration structure builds.
+		std::vector<uint8_t> zeros;
+		if (!initialData)
+		{
+			zeros.resize(static_cast<size_t>(desc.size), 0);
+			initialData = zeros.data();
+		}
+
+		RTUploadBatch uploadBatch(device.Get(), commandQueue.Get());
+		resource = uploadBatch.CreateBuffer(initialData, desc.size, D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE, L"GeometryBuffer");
+		uploadBatch.Submit();
+	}
+
+	auto buffer = std::make_unique<D3D12Buffer>(std::move(resource), desc);
+	if (desc.usage == RTBufferUsage::RayCounters)
+	{
+		// CPU only, the view is copied into the shader visible heap of each dispatch, and clears need it here too.
+		D3D12_DESCRIPTOR_HEAP_DESC heapDesc = {};
+		heapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+		heapDesc.NumDescriptors = 1;
+		heapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
+		ThrowIfFailed(device->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&buffer->descriptorHeap)));
+
+		D3D12_UNORDERED_ACCESS_VIEW_DESC viewDesc = GetRayCounterViewDesc(desc.size);
+		device->CreateUnorderedAccessView(buffer->resource.Get(), nullptr, &viewDesc, buffer->descriptorHeap->GetCPUDescriptorHandleForHeapStart());
+	}
+	return buffer;
+}
+
+std::unique_ptr<RTTexture> RTD3D12RenderDevice::CreateOutputTexture(uint32_t width, uint32_t height)
+{
+	return CreateTexture(width, height, DXGI_FORMAT_R8G8B8A8_UNORM, L"RaytracingOutput");
+}
+
+std::unique_ptr<RTTexture> RTD3D12RenderDevice::CreateAccumulationTexture(uint32_t width, uint32_t height)
+{
+	return CreateTexture(width, height, DXGI_FORMAT_R32G32B32A32_FLOAT, L"RaytracingAccumulation");
+}
+
+std::unique_ptr<RTTexture> RTD3D12RenderDevice::CreateTexture(uint32_t width, uint32_t height, DXGI_FORMAT format, wchar_t const* name)
+{
+	auto texture = std::make_unique<D3D12Texture>();
+	texture->format = format;
+	texture->width = width;
+	texture->height = height;
+
+	CD3DX12_HEAP_PROPERTIES defaultHeapProperties(D3D12_HEAP_TYPE_DEFAULT);
+	CD3DX12_RESOURCE_DESC textureDesc = CD3DX12_RESOURCE_DESC::Tex2D(format, width, height, 1, 1, 1, 0, D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+	ThrowIfFailed(device->CreateCommittedResource(
+		&defaultHeapProperties,
+		D3D12_HEAP_FLAG_NONE,
+		&textureDesc,
+		D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+		nullptr,
+		IID_PPV_ARGS(&texture->resource)),
+		L"Failed to create raytracing output resource");
+	texture->resource->SetName(name);
+
+	// CPU only, the view is copied into the shader visible heap of each dispatch.
+	D3D12_DESCRIPTOR_HEAP_DESC heapDesc = {};
+	heapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
+	heapDesc.NumDescriptors = 1;
+	heapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
+	ThrowIfFailed(device->CreateDescriptorHeap(&heapDesc, IID_PPV_ARGS(&texture->descriptorHeap)));
+
+	D3D12_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
+	uavDesc.ViewDimension = D3D12_UAV_DIMENSION_TEXTURE2D;
+	device->CreateUnorderedAccessView(texture->resource.Get(), nullptr, &uavDesc, texture->descriptorHeap->GetCPUDescriptorHandleForHeapStart());
+
+	return texture;
+}
+
+std::unique_ptr<RTAccelerationStructure> RTD3D12RenderDevice::CreateBottomLevel(RTGeometryDesc const& geometry)
+{
+	D3D12Buffer const* vertexBuffer = Cast<D3D12Buffer const>(geometry.vertexBuffer, L"Bottom level geometry must be in buffers of the D3D12 device.\n");
+	D3D12Buffer const* indexBuffer = Cast<D3D12Buffer const>(geometry.indexBuffer, L"Bottom level geometry must be in buffers of the D3D12 device.\n");
+	ThrowIfFalse(geometry.indexSizeInBytes == sizeof(uint16_t) || geometry.indexSizeInBytes == sizeof(uint32_t), L"Indices must be 16 or 32 bits.\n");
+	ThrowIfFalse(vertexBuffer->size >= uint64_t{ geometry.vertexCount } * sizeof(Vertex) &&
+		indexBuffer->size >= uint64_t{ geometry.indexCount } * geometry.indexSizeInBytes,
+		L"Bottom level geometry is larger than its buffers.\n");
+
+	auto bottomLevel = std::make_unique<D3D12BottomLevel>();
+	bottomLevel->indexSizeInBytes = geometry.indexSizeInBytes;
+
+	D3D12_RAYTRACING_GEOMETRY_DESC& geometryDesc = bottomLevel->geometryDesc;
+	geometryDesc.Type = D3D12_RAYTRACING_GEOMETRY_TYPE_TRIANGLES;
+	geometryDesc.Triangles.IndexBuffer = indexBuffer->resource->GetGPUVirtualAddress();
+	geometryDesc.Triangles.IndexCount = geometry.indexCount;
+	geometryDesc.Triangles.IndexFormat = geometry.indexSizeInBytes == sizeof(uint16_t) ? DXGI_FORMAT_R16_UINT : DXGI_FORMAT_R32_UINT;
+	geometryDesc.Triangles.VertexFormat = DXGI_FORMAT_R32G32B32_FLOAT;
+	geometryDesc.Triangles.VertexCount = geometry.vertexCount;
+	geometryDesc.Triangles.VertexBuffer.StartAddress = vertexBuffer->resource->GetGPUVirtualAddress();
+	geometryDesc.Triangles.VertexBuffer.StrideInBytes = sizeof(Vertex);
+	geometryDesc.Flags = D3D12_RAYTRACING_GEOMETRY_FLAG_OPAQUE;
+
+	D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_INPUTS inputs = {};
+	inputs.Type = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL;
+	inputs.DescsLayout = D3D12_ELEMENTS_LAYOUT_ARRAY;
+	inputs.Flags = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_PREFER_FAST_TRACE;
+	inputs.NumDescs = 1;
+	inputs.pGeometryDescs = &geometryDesc;
+
+	D3D12_RAYTRACING_ACCELERATION_STRUCTURE_PREBUILD_INFO prebuildInfo = {};
+	device->GetRaytracingAccelerationStructurePrebuildInfo(&inputs, &prebuildInfo);
+	ThrowIfFalse(prebuildInfo.ResultDataMaxSizeInBytes > 0, L"Invalid bottom level prebuild info.\n");
+
+	CD3DX12_HEAP_PROPERTIES defaultHeapProperties(D3D12_HEAP_TYPE_DEFAULT);
+	CD3DX12_RESOURCE_DESC resultDesc = CD3DX12_RESOURCE_DESC::Buffer(prebuildInfo.ResultDataMaxSizeInBytes, D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+	ThrowIfFailed(device->CreateCommittedResource(
+		&defaultHeapProperties,
+		D3D12_HEAP_FLAG_NONE,
+		&resultDesc,
+		D3D12_RESOURCE_STATE_RAYTRACING_ACCELERATION_STRUCTURE,
+		nullptr,
+		IID_PPV_ARGS(&bottomLevel->result)),
+		L"Failed to create BLAS buffer");
+	bottomLevel->result->SetName(L"BottomLevelAccelerationStructure");
+
+	CD3DX12_RESOURCE_DESC scratchDesc = CD3DX12_RESOURCE_DESC::Buffer(std::max<UINT64>(prebuildInfo.ScratchDataSizeInBytes, 1), D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+	ThrowIfFailed(device->CreateCommittedResource(
+		&defaultHeapProperties,
+		D3D12_HEAP_FLAG_NONE,
+		&scratchDesc,
+		D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+		nullptr,
+		IID_PPV_ARGS(&bottomLevel->scratch)),
+		L"Failed to create BLAS scratch buffer");
+	bottomLevel->scratch->SetName(L"BottomLevelAccelerationStructureScratch");
+
+	return bottomLevel;
+}
+
+std::unique_ptr<RTAccelerationStructure> RTD3D12RenderDevice::CreateTopLevel()
+{
+	return std::make_unique<D3D12TopLevel>(device.Get());
+}
+
+std::unique_ptr<RTCommandList> RTD3D12RenderDevice::CreateCommandList()
+{
+	return std::make_unique<D3D12CommandList>(device.Get(), *pipeline);
+}
+
+std::unique_ptr<RTFence> RTD3D12RenderDevice::CreateFence(uint64_t initialValue)
+{
+	return std::make_unique<D3D12Fence>(device.Get(), initialValue);
+}
+
+void RTD3D12RenderDevice::Submit(RTCommandList& commandList, RTFence& fence, uint64_t signalValue)
+{
+	D3D12CommandList* d3dCommandList = Cast<D3D12CommandList>(&commandList, L"Submit() expects a command list of the D3D12 device.\n");
+	D3D12Fence* d3dFence = Cast<D3D12Fence>(&fence, L"Submit() expects a fence of the D3D12 device.\n");
+
+	ID3D12CommandList* commandLists[] = { d3dCommandList->Close() };
+	commandQueue->ExecuteCommandLists(ARRAYSIZE(commandLists), commandLists);
+	ThrowIfFailed(commandQueue->Signal(d3dFence->fence.Get(), signalValue));
+}
+
+void RTD3D12RenderDevice::WaitForIdle()
+{
+	// The queue executes in order, so a signal after everything submitted so far is reached once all of it has completed.
+	ThrowIfFailed(commandQueue->Signal(idleFence.Get(), ++idleFenceValue));
+	if (idleFence->GetCompletedValue() < idleFenceValue)
+	{
+		ThrowIfFailed(idleFence->SetEventOnCompletion(idleFenceValue, idleEvent));
+		WaitForSingleObjectEx(idleEvent, INFINITE, FALSE);
+	}
+}
+
+uint32_t RTD3D12RenderDevice::GetReadbackRowPitch(uint32_t width) const
+{
+	return static_cast<uint32_t>(AlignUp(UINT64{ width } * 4, D3D12_TEXTURE_DATA_PITCH_ALIGNMENT));
+}
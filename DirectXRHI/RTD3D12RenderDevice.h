@@ -0,0 +1,62 @@
+#pragma once
+
+#include <wrl.h>
+#include <d3d12.h>
+#include <dxgi1_6.h>
+#include <filesystem>
+#include <memory>
+#include "RTRayTracingPipeline.h"
+#include "../RHI/RTRenderDevice.h"
+
+/*
+	D3D12 backend of RTRenderDevice. It creates its own device on the first adapter with DirectX Raytracing
+	support, with a direct queue and no swap chain, so it renders headless next to or instead of the windowed
+	RTDXInterface, sharing its pipeline through RTRayTracingPipeline.
+	Command lists map onto D3D12 command lists. Each one owns the shader tables, scene constants and view
+	descriptors of the dispatches it records, so lists in flight never overwrite each other's, and fences
+	are D3D12 fences.
+*/
+
+class RTD3D12RenderDevice : public RTRenderDevice {
+
+public:
+	// Throws when no adapter supports DirectX Raytracing. An empty cache path disables the pipeline cache.
+	explicit RTD3D12RenderDevice(std::filesystem::path pipelineCachePath = L"RTEngine.pipelinecache");
+	~RTD3D12RenderDevice() override;
+
+	RTD3D12RenderDevice(RTD3D12RenderDevice const&) = delete;
+	RTD3D12RenderDevice& operator =(RTD3D12RenderDevice const&) = delete;
+
+	char const* GetName() const override { return "Direct3D 12"; }
+
+	std::unique_ptr<RTBuffer> CreateBuffer(RTBufferDesc const& desc, void const* initialData = nullptr) override;
+	std::unique_ptr<RTTexture> CreateOutputTexture(uint32_t width, uint32_t height) override;
+	std::unique_ptr<RTTexture> CreateAccumulationTexture(uint32_t width, uint32_t height) override;
+	std::unique_ptr<RTAccelerationStructure> CreateBottomLevel(RTGeometryDesc const& geometry) override;
+	std::unique_ptr<RTAccelerationStructure> CreateTopLevel() override;
+	std::unique_ptr<RTCommandList> CreateCommandList() override;
+	std::unique_ptr<RTFence> CreateFence(uint64_t initialValue = 0) override;
+
+	void Submit(RTCommandList& commandList, RTFence& fence, uint64_t signalValue) override;
+	void WaitForIdle() override;
+
+	// Texture copies place rows on D3D12_TEXTURE_DATA_PITCH_ALIGNMENT boundaries.
+	uint32_t GetReadbackRowPitch(uint32_t width) const override;
+
+	ID3D12Device5* GetD3DDevice() const { return device.Get(); }
+	ID3D12CommandQueue* GetCommandQueue() const { return commandQueue.Get(); }
+
+private:
+	void CreateDevice();
+	std::unique_ptr<RTTexture> CreateTexture(uint32_t width, uint32_t height, DXGI_FORMAT format, wchar_t const* name);
+
+	Microsoft::WRL::ComPtr<IDXGIAdapter1>				adapter;
+	Microsoft::WRL::ComPtr<ID3D12Device5>				device;
+	Microsoft::WRL::ComPtr<ID3D12CommandQueue>			commandQueue;
+	std::unique_ptr<RTRayTracingPipeline>				pipeline;
+
+	// Signalled behind the submissions by WaitForIdle()
+	Microsoft::WRL::ComPtr<ID3D12Fence>					idleFence;
+	HANDLE												idleEvent;
+	UINT64												idleFenceValue;
+};
@@ -1,23 +1,41 @@
 #include "RTDXInterface.h"
 #include "RTDeviceResources.h"
+#include "RTUploadRingBuffer.h"
+#include "RTDescriptorHeap.h"
+#include "RTUploadBatch.h"
+#include "RTBlasCompactor.h"
+#include "RTTopLevelAccelerationStructure.h"
+#include "RTAccelerationStructureBuilder.h"
+#include "RTComputeQueue.h"
+#include "RTShaderTableBuilder.h"
 #include "RTWinApp.h"
 #include "HrException.h"
-#include "../Shaders/CompiledShaders/RayGen.hlsl.h"
-#include "../Shaders/CompiledShaders/Hit.hlsl.h"
-#include "../Shaders/CompiledShaders/Miss.hlsl.h"
-
-const wchar_t* RTDXInterface::c_rayGenShaderName = L"RayGen";
-const wchar_t* RTDXInterface::c_closestHitShaderName = L"ClosestHit";
-const wchar_t* RTDXInterface::c_missShaderName = L"Miss";
-const wchar_t* RTDXInterface::c_hitGroupName = L"HitGroup";
-
+#include "../Core/RTScopedTimer.h"
+#include "../Core/RTTrace.h"
+#include "../Core/RTParallel.h"
+#include <algorithm>
+#include <chrono>
+#include <cstring>
 
 RTDXInterface::RTDXInterface(UINT viewportWidth, UINT viewportHeight, std::wstring windowName) :
 	width { viewportWidth },
 	height { viewportHeight },
 	aspectRatio { static_cast<float>(viewportWidth) / static_cast<float>(viewportHeight) },
 	windowBounds { 0, 0, static_cast<long>(viewportWidth), static_cast<long>(viewportHeight) },
-	windowTitle { windowName }
+	pipelineCachePath { L"RTEngine.pipelinecache" },
+	tracePath { L"RTEngine.trace.json" },
+	windowTitle { windowName },
+	accumulationSampleCount { 0 },
+	accumulatedSampleCount { 0 },
+	accumulatedScene {},
+	indexFormat { DXGI_FORMAT_R32_UINT },
+	indexSizeInBytes { sizeof(UINT) },
+	indexCount { 0 },
+	vertexCount { 0 },
+	compactAccelerationStructures { true },
+	sceneInstances { MeshInstance{ 0, RTMatrix4D::RTMatrix4DImpl{} } },
+	animateInstances { false },
+	asyncAccelerationStructureBuilds { true }
 {
 	timer.SetFixedTimeStep(true);
 	timer.SetTargetElapsedSeconds(1.0 / 60.0); 
@@ -36,8 +54,6 @@ void RTDXInterface::OnInit()
 	
 		// Initialise the scene
 		{
-			rtObject.colour = RTVector4D::RTVec4DImpl(1.f, 1.f, 1.f, 1.f);
-
 			for (int i = 0; i < frameCount; i++)
 			{
 				rtScene[i].projectionToWorld = RTMatrix4D::RTMatrix4DImpl();
@@ -62,24 +78,50 @@ void RTDXInterface::CreateDeviceDependentResources()
 	// Query the instanciated device object and assign the raytracing device and command list, if ray tracing is supported.
 	CreateRaytracingInterfaces(); 
 
-	// Create the global root signature used by the shaders. 
-	CreateGlobalRootSignature(); 
-
-	// Create a raytracing pipeline state object which defines the binding of shaders, state and resources to be used during raytracing. 
-	CreateRaytracingPipelineStateObject();
+	// Create the root signatures and the state object, from the pipeline cache where possible. 
+	CreateRaytracingPipeline();
 
 	// Allocate GPU memory for the descriptor resources. 
 	CreateDescriptorHeap(); 
 
+	// Create the ring buffer which holds the constant data written every frame.
+	CreateUploadRingBuffer();
+
+	// Create the queue the acceleration structures are built on, when they are built asynchronously.
+	CreateComputeQueue();
+
+	// Create the profiler which times the scopes of every frame.
+	CreateGpuProfiler();
+
 	// Build the geometry. 
 	BuildGeometry();
 
 	// Build raytracing acceleration structures from the generated geometry. 
-	BuildAccelerationStructures(); 
+	// The command list is closed after device creation, so it is reset for the builds, 
+	// which have to complete before the scratch buffers can be released or the first frame traced.
+	deviceResources->ResetCommandList();
+	BuildBottomLevelAccelerationStructures(); 
+	deviceResources->ExecuteCommandList();
+	deviceResources->WaitForGpu();
+	accelerationStructureBuilder->ReleaseScratch();
+
+	// Compaction needs the compacted sizes read back from the finished builds, 
+	// and the TLAS has to reference the compacted copies, so it runs in between.
+	if (compactAccelerationStructures)
+	{
+		CompactBottomLevelAccelerationStructures();
+	}
 
 	// Build shader tables, which define shaders an their local root arguments. 
+	// The instances of the TLAS reference their hit group records, so the records are assigned first.
 	BuildShaderTables();
 
+	deviceResources->ResetCommandList();
+	UpdateInstances(0.f);
+	BuildTopLevelAccelerationStructure();
+	deviceResources->ExecuteCommandList();
+	deviceResources->WaitForGpu();
+
 	// Create an output texture to store the raytracing result to. 
 	CreateRaytracingOutputResource();
 }
@@ -93,131 +135,96 @@ void RTDXInterface::CreateRaytracingInterfaces()
 	ThrowIfFailed(commandList->QueryInterface(IID_PPV_ARGS(&raytracingCommanList)), L"Couldn't get DirectX Raytracing interface for the command list.\n");
 }
 
-void RTDXInterface::CreateGlobalRootSignature()
+void RTDXInterface::CreateRaytracingPipeline()
 {
-	// Global root parameters, which are shared between all shaders.
-	//	- Unordered Access View (UAV) descriptor for the ray tracing output, stored as texture.
-	//  - Constant Buffer View (CBC) desriptor for the scene transform data (MVP matrix). 
-	//  - Shader Resource View (SRV) descritors for the
-	//		- Acceleration structure
-	//		- Vertex buffer
-	//		- Index buffer
-
-	CD3DX12_ROOT_PARAMETER rootParameters[GlobalRootSignatureParams::Count];
-
-	// Output view slot
-	// The ray tracing result stored as a UAV resource is bound to :register (u0, space0)
-	rootParameters[GlobalRootSignatureParams::OutputViewSlot].InitAsUnorderedAccessView(0);
-
-	// Constant buffer slot
-	// The constant buffer stored as CBV resource is bound to :register (b0, space0)
-	rootParameters[GlobalRootSignatureParams::ConstantBufferSlot].InitAsConstantBufferView(0);
-
-	// Acceleration structure slot
-	// The acceleration structure stored as SRV resource is bound to :register (t0, space0)
-	rootParameters[GlobalRootSignatureParams::AccelerationStructureSlot].InitAsShaderResourceView(0);
-
-	// Vertex & Index buffer slot
-	// The SRVs are bound to :register (t1, space0) and :register (t2, space0)
-	CD3DX12_DESCRIPTOR_RANGE VertexBufferDescriptor;
-	VertexBufferDescriptor.Init(D3D12_DESCRIPTOR_RANGE_TYPE_SRV, 2, 1);
-	rootParameters[GlobalRootSignatureParams::VertexBufferSlot].InitAsDescriptorTable(1, &VertexBufferDescriptor);
-
-	// Create the global root signature with the list of descriptor tables as parameters. 
-	CD3DX12_ROOT_SIGNATURE_DESC globalRootSignatureDesc(GlobalRootSignatureParams::Count, rootParameters);
-
-	// Serialise and create the global root signature
-	Microsoft::WRL::ComPtr<ID3D12Device> device = deviceResources->GetD3DDevice();
-	Microsoft::WRL::ComPtr<ID3DBlob> serialisedRootSignature; 
-	Microsoft::WRL::ComPtr<ID3DBlob> errorMessage; 
+	// Loads the root signatures of earlier runs, if the shaders, the pipeline configuration and the driver are unchanged, 
+	// and stores whatever had to be created from scratch for the next run.
+	auto pipelineStart = std::chrono::steady_clock::now();
+	raytracingPipeline = std::make_unique<RTRayTracingPipeline>(raytracingDevice.Get(), deviceResources->GetAdapter(), pipelineCachePath);
+
+	std::chrono::duration<double, std::milli> pipelineTime = std::chrono::steady_clock::now() - pipelineStart;
+	wchar_t message[128];
+	swprintf_s(message, L"Pipeline created in %.2f ms, %ls\n", pipelineTime.count(), 
+		raytracingPipeline->WasPipelineCacheUpdated() ? L"pipeline cache updated" : L"all root signatures from the pipeline cache");
+	OutputDebugStringW(message);
+}
 
-	ThrowIfFailed(D3D12SerializeRootSignature(&globalRootSignatureDesc, D3D_ROOT_SIGNATURE_VERSION_1, &serialisedRootSignature, &errorMessage),
-		errorMessage ? static_cast<wchar_t*>(errorMessage->GetBufferPointer()) : nullptr);
+void RTDXInterface::CreateDescriptorHeap()
+{
+	auto device = deviceResources->GetD3DDevice();
 
-	ThrowIfFailed(device->CreateRootSignature(1, serialisedRootSignature->GetBufferPointer(), serialisedRootSignature->GetBufferSize(), 
-		IID_PPV_ARGS(&raytracingGlobalRootSignature)));
+	// Persistent descriptors hold the geometry SRVs and the raytracing output UAV, 
+	// the transient region is for views which are rewritten every frame.
+	descriptorHeap = std::make_unique<RTDescriptorHeap>(
+		device.Get(),
+		D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV,
+		transientDescriptorCount,
+		persistentDescriptorCount,
+		L"DescriptorHeap");
 }
 
-void RTDXInterface::CreateRaytracingPipelineStateObject()
+void RTDXInterface::CreateUploadRingBuffer()
 {
-	// A state object represents a variable amount of configuration state, 
-	// including shaders, that an application manages as a single unit and 
-	// which is given to a driver atomically to process (e.g. compile/optimize)
-    // however it sees fit. A state object is created via CreateStateObject() on a D3D12 device.
-
-	// The Pipeline State Object here is built using six subobjects:
-	// - DXIL library
-    // - Triangle hit group
-    // - Shader config
-    // - Global root signature
-    // - Pipeline config
-
-	CD3DX12_STATE_OBJECT_DESC raytracingPipeline{ D3D12_STATE_OBJECT_TYPE_RAYTRACING_PIPELINE };
-
-	// DXIL libraries 
-	D3D12_SHADER_BYTECODE rayGenDXIL = CD3DX12_SHADER_BYTECODE((void*)g_pRayGen, ARRAYSIZE(g_pRayGen));
-	D3D12_SHADER_BYTECODE closestHitDXIL = CD3DX12_SHADER_BYTECODE((void*)g_pHit, ARRAYSIZE(g_pHit));
-	D3D12_SHADER_BYTECODE missDXIL = CD3DX12_SHADER_BYTECODE((void*)g_pMiss, ARRAYSIZE(g_pMiss));
-
-	// Raygen library
-	auto rayGenLib = raytracingPipeline.CreateSubobject<CD3DX12_DXIL_LIBRARY_SUBOBJECT>();
-	rayGenLib->SetDXILLibrary(&rayGenDXIL);
-	rayGenLib->DefineExport(c_rayGenShaderName);
-
-	// Closest hit library
-	auto closestHitLib = raytracingPipeline.CreateSubobject<CD3DX12_DXIL_LIBRARY_SUBOBJECT>();
-	closestHitLib->SetDXILLibrary(&closestHitDXIL);
-	closestHitLib->DefineExport(c_closestHitShaderName);
-
-	// Miss library 
-	auto missLib = raytracingPipeline.CreateSubobject<CD3DX12_DXIL_LIBRARY_SUBOBJECT>();
-	missLib->SetDXILLibrary(&missDXIL);
-	missLib->DefineExport(c_missShaderName);
-
-	// Triangle hit group 
-	auto hitGroup = raytracingPipeline.CreateSubobject<CD3DX12_HIT_GROUP_SUBOBJECT>();
-	hitGroup->SetClosestHitShaderImport(c_closestHitShaderName);
-	hitGroup->SetHitGroupExport(c_hitGroupName);
-	hitGroup->SetHitGroupType(D3D12_HIT_GROUP_TYPE_TRIANGLES);
-
-	// Shader config
-	auto shaderConfig = raytracingPipeline.CreateSubobject<CD3DX12_RAYTRACING_SHADER_CONFIG_SUBOBJECT>();
-	
-	UINT rayPayloadSize = sizeof(RTVector4D::RTVec4DImpl);
-	UINT attributeSize = sizeof(RTVector2D::RTVec2DImpl);
-	shaderConfig->Config(rayPayloadSize, attributeSize);
+	auto device = deviceResources->GetD3DDevice();
+
+	uploadRingBuffer = std::make_unique<RTUploadRingBuffer>(device.Get(), uploadRingBufferSize, L"UploadRingBuffer");
+}
 
-	// Global root signature
-	auto globalRootSignature = raytracingPipeline.CreateSubobject<CD3DX12_GLOBAL_ROOT_SIGNATURE_SUBOBJECT>();
-	globalRootSignature->SetRootSignature(raytracingGlobalRootSignature.Get());
+void RTDXInterface::CreateComputeQueue()
+{
+	if (!asyncAccelerationStructureBuilds)
+	{
+		return;
+	}
 
-	// Pipeline config
-	auto pipelineConfig = raytracingPipeline.CreateSubobject<CD3DX12_RAYTRACING_PIPELINE_CONFIG_SUBOBJECT>();
-	
-	// Use primary rays only
-	UINT maxRecursionDepth = 1; 
-	pipelineConfig->Config(maxRecursionDepth);
+	auto device = deviceResources->GetD3DDevice();
 
-	// Create the state object 
-	ThrowIfFailed(raytracingDevice->CreateStateObject(raytracingPipeline, IID_PPV_ARGS(&raytracingStateObject)), L"Couldn't create a DirectX Raytracing state object.\n");
+	computeQueue = std::make_unique<RTComputeQueue>(device.Get(), frameCount);
+	buildTimer = std::make_unique<RTQueueTimer>(device.Get(), computeQueue->GetCommandQueue(), frameCount);
+	rayTracingTimer = std::make_unique<RTQueueTimer>(device.Get(), deviceResources->GetCommandQueue(), frameCount);
 }
 
-void RTDXInterface::CreateDescriptorHeap()
+void RTDXInterface::CreateGpuProfiler()
 {
 	auto device = deviceResources->GetD3DDevice();
 
-	D3D12_DESCRIPTOR_HEAP_DESC descriptorHeapDesc = {};
+	gpuProfiler = std::make_unique<RTGpuProfiler>(device.Get(), deviceResources->GetCommandQueue(), frameCount);
+}
 
-	// Allocate a heap for 3 descriptors: 
-	// 2 - vertex and index buffer SRVs
-	// 1 - raytracing output texture UAV
-	descriptorHeapDesc.NumDescriptors = 3; 
-	descriptorHeapDesc.Type = D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV;
-	descriptorHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
-	descriptorHeapDesc.NodeMask = 0;
-	device->CreateDescriptorHeap(&descriptorHeapDesc, IID_PPV_ARGS(&descriptorHeap));
-	
-	descriptorSize = device->GetDescriptorHandleIncrementSize(D3D12_DESCRIPTOR_HEAP_TYPE_CBV_SRV_UAV);
+RTDXInterface::IndexBufferData RTDXInterface::PackIndices(std::vector<uint32_t> const& indices, UINT numVertices)
+{
+	IndexBufferData data;
+
+	// R16_UINT can address vertices 0 to 65535.
+	if (numVertices <= 0x10000)
+	{
+		data.format = DXGI_FORMAT_R16_UINT;
+		data.indexSizeInBytes = sizeof(uint16_t);
+	}
+	else
+	{
+		data.format = DXGI_FORMAT_R32_UINT;
+		data.indexSizeInBytes = sizeof(uint32_t);
+	}
+
+	// Pad to a whole number of 32 bit words, the hit shader reads 16 bit indices in 32 bit pairs.
+	size_t byteSize = indices.size() * data.indexSizeInBytes;
+	data.bytes.resize(Align(static_cast<UINT>(byteSize), sizeof(uint32_t)), 0);
+
+	if (data.format == DXGI_FORMAT_R16_UINT)
+	{
+		uint16_t* packed = reinterpret_cast<uint16_t*>(data.bytes.data());
+		for (size_t i = 0; i < indices.size(); ++i)
+		{
+			packed[i] = static_cast<uint16_t>(indices[i]);
+		}
+	}
+	else
+	{
+		memcpy(data.bytes.data(), indices.data(), byteSize);
+	}
+
+	return data;
 }
 
 void RTDXInterface::BuildGeometry()
@@ -225,317 +232,266 @@ void RTDXInterface::BuildGeometry()
 	auto device = deviceResources->GetD3DDevice();
 	auto commandList = deviceResources->GetCommandList();
 
-	// Simple triangle
-	// TODO pass geometry to function 
-	constexpr int numVertices = 3;
-	
-	Vertex triangleVertices[numVertices] = {
-		// Position                                Normal
-		{ RTVector3D::RTVec3DImpl(0.0f, 0.5f, 0.0f), RTVector3D::RTVec3DImpl(0.0f, 0.0f, -1.0f) },
-		{ RTVector3D::RTVec3DImpl(0.5f, -0.5f, 0.0f), RTVector3D::RTVec3DImpl(0.0f, 0.0f, -1.0f) },
-		{ RTVector3D::RTVec3DImpl(-0.5f, -0.5f, 0.0f), RTVector3D::RTVec3DImpl(0.0f, 0.0f, -1.0f) }
-	};
+	// Fall back to a simple triangle if no geometry was provided with SetSceneMesh()
+	if (sceneMesh.vertices.empty() || sceneMesh.indices.empty())
+	{
+		sceneMesh.vertices = {
+			// Position                                Normal
+			{ RTVector3D::RTVec3DImpl(0.0f, 0.5f, 0.0f), RTVector3D::RTVec3DImpl(0.0f, 0.0f, -1.0f) },
+			{ RTVector3D::RTVec3DImpl(0.5f, -0.5f, 0.0f), RTVector3D::RTVec3DImpl(0.0f, 0.0f, -1.0f) },
+			{ RTVector3D::RTVec3DImpl(-0.5f, -0.5f, 0.0f), RTVector3D::RTVec3DImpl(0.0f, 0.0f, -1.0f) }
+		};
 
-	std::vector<UINT> triangleIndices = { 0, 1, 2 };
-	UINT numIndices = static_cast<UINT>(triangleIndices.size());
+		sceneMesh.indices = { 0, 1, 2 };
+	}
 
+	const UINT numVertices = static_cast<UINT>(sceneMesh.vertices.size());
+	const UINT numIndices = static_cast<UINT>(sceneMesh.indices.size());
 	const UINT vertexBufferSize = numVertices * sizeof(Vertex);
 
+	// Geometry lives in default heap memory and is copied there through a staging buffer. 
+	// The buffers end in the state required both for shader reads and as acceleration structure build inputs.
+	RTUploadBatch uploadBatch(device.Get(), deviceResources->GetCommandQueue());
+
 	// Upload the vertex buffer to the GPU
 	{
-		CD3DX12_HEAP_PROPERTIES heapProperty = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
-		CD3DX12_RESOURCE_DESC bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(vertexBufferSize);
-		ThrowIfFailed(device->CreateCommittedResource(
-			&heapProperty,
-			D3D12_HEAP_FLAG_NONE,
-			&bufferDesc,
-			D3D12_RESOURCE_STATE_GENERIC_READ,
-			nullptr,
-			IID_PPV_ARGS(&vertexBuffer.resource)),
-			L"Failed to create vertex buffer resource");
-
-		// Copy the triangle data to the vertex buffer
-		UINT8* pVertexDataBegin;
-		CD3DX12_RANGE readRange(0, 0);
-		ThrowIfFailed(vertexBuffer.resource->Map(0, &readRange, reinterpret_cast<void**>(&pVertexDataBegin)),
-			L"Failed to map vertex buffer");
-		memcpy(pVertexDataBegin, triangleVertices, vertexBufferSize);
-		vertexBuffer.resource->Unmap(0, nullptr);
-
-		// Create the SRV
-		D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
-		srvDesc.Format = DXGI_FORMAT_UNKNOWN;
-		srvDesc.ViewDimension = D3D12_SRV_DIMENSION_BUFFER;
-		srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-		srvDesc.Buffer.NumElements = numVertices;
-		srvDesc.Buffer.StructureByteStride = sizeof(Vertex);
-		srvDesc.Buffer.Flags = D3D12_BUFFER_SRV_FLAG_NONE;
-
-		// Allocate descriptor handles
-		vertexBuffer.cpuDescriptorHandle = CD3DX12_CPU_DESCRIPTOR_HANDLE(descriptorHeap->GetCPUDescriptorHandleForHeapStart(), descriptorsAllocated, descriptorSize);
-		vertexBuffer.gpuDescriptorHandle = CD3DX12_GPU_DESCRIPTOR_HANDLE(descriptorHeap->GetGPUDescriptorHandleForHeapStart(), descriptorsAllocated, descriptorSize);
-		descriptorsAllocated++;
-
-		device->CreateShaderResourceView(vertexBuffer.resource.Get(), &srvDesc, vertexBuffer.cpuDescriptorHandle);
+		vertexBuffer.resource = uploadBatch.CreateBuffer(
+			sceneMesh.vertices.data(), 
+			vertexBufferSize, 
+			D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE, 
+			L"VertexBuffer");
 	}
 
-	// Create index buffer
-	const UINT indexBufferSize = numIndices * sizeof(UINT);
+	// Pack the indices as 16 bit values whenever every vertex can be addressed with them, halving the index memory.
+	IndexBufferData indexData = PackIndices(sceneMesh.indices, numVertices);
+	indexFormat = indexData.format;
+	indexSizeInBytes = indexData.indexSizeInBytes;
+	indexCount = numIndices;
+	vertexCount = numVertices;
+
+	const UINT indexBufferSize = static_cast<UINT>(indexData.bytes.size());
 
 	// Upload the index buffer to the GPU
 	{
-		CD3DX12_HEAP_PROPERTIES heapProperty = CD3DX12_HEAP_PROPERTIES(D3D12_HEAP_TYPE_UPLOAD);
-		CD3DX12_RESOURCE_DESC bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(indexBufferSize);
-		ThrowIfFailed(device->CreateCommittedResource(
-			&heapProperty,
-			D3D12_HEAP_FLAG_NONE,
-			&bufferDesc,
-			D3D12_RESOURCE_STATE_GENERIC_READ,
-			nullptr,
-			IID_PPV_ARGS(&indexBuffer.resource)),
-			L"Failed to create index buffer resource");
-
-		// Copy the triangle data to the index buffer
-		UINT8* pIndexDataBegin;
-		CD3DX12_RANGE readRange(0, 0);
-		ThrowIfFailed(indexBuffer.resource->Map(0, &readRange, reinterpret_cast<void**>(&pIndexDataBegin)),
-			L"Failed to map index buffer");
-		memcpy(pIndexDataBegin, triangleIndices.data(), indexBufferSize);
-		indexBuffer.resource->Unmap(0, nullptr);
-
-		// Create the SRV
-		D3D12_SHADER_RESOURCE_VIEW_DESC srvDesc = {};
-		srvDesc.Format = DXGI_FORMAT_R32_TYPELESS;
-		srvDesc.ViewDimension = D3D12_SRV_DIMENSION_BUFFER;
-		srvDesc.Shader4ComponentMapping = D3D12_DEFAULT_SHADER_4_COMPONENT_MAPPING;
-		srvDesc.Buffer.NumElements = numIndices;
-		srvDesc.Buffer.StructureByteStride = 0;
-		srvDesc.Buffer.Flags = D3D12_BUFFER_SRV_FLAG_RAW;
-		srvDesc.Buffer.FirstElement = 0;
-
-		// Allocate descriptor handles
-		indexBuffer.cpuDescriptorHandle = CD3DX12_CPU_DESCRIPTOR_HANDLE(descriptorHeap->GetCPUDescriptorHandleForHeapStart(), descriptorsAllocated, descriptorSize);
-		indexBuffer.gpuDescriptorHandle = CD3DX12_GPU_DESCRIPTOR_HANDLE(descriptorHeap->GetGPUDescriptorHandleForHeapStart(), descriptorsAllocated, descriptorSize);
-		descriptorsAllocated++;
-
-		device->CreateShaderResourceView(indexBuffer.resource.Get(), &srvDesc, indexBuffer.cpuDescriptorHandle);
+		indexBuffer.resource = uploadBatch.CreateBuffer(
+			indexData.bytes.data(), 
+			indexBufferSize, 
+			D3D12_RESOURCE_STATE_NON_PIXEL_SHADER_RESOURCE, 
+			L"IndexBuffer");
 	}
+
+	// Both buffers are copied in a single submission.
+	uploadBatch.Submit();
 }
 
-void RTDXInterface::BuildAccelerationStructures()
+void RTDXInterface::BuildBottomLevelAccelerationStructures()
 {
-	auto device = deviceResources->GetD3DDevice();
-	auto commandList = deviceResources->GetCommandList();
+	RT_TRACE_ZONE("BuildBottomLevelAccelerationStructures");
 
-	// 1. Create the Bottom Level Acceleration Structure (BLAS)
+	// Create the Bottom Level Acceleration Structure (BLAS)
 	// This stores the triangle mesh data
 	D3D12_RAYTRACING_GEOMETRY_DESC geometryDesc = {};
 	geometryDesc.Type = D3D12_RAYTRACING_GEOMETRY_TYPE_TRIANGLES;
 	geometryDesc.Triangles.IndexBuffer = indexBuffer.resource->GetGPUVirtualAddress();
-	geometryDesc.Triangles.IndexCount = 3; // Single triangle
-	geometryDesc.Triangles.IndexFormat = DXGI_FORMAT_R32_UINT;
+	geometryDesc.Triangles.IndexCount = indexCount;
+	geometryDesc.Triangles.IndexFormat = indexFormat;
 	geometryDesc.Triangles.VertexFormat = DXGI_FORMAT_R32G32B32_FLOAT;
-	geometryDesc.Triangles.VertexCount = 3;
+	geometryDesc.Triangles.VertexCount = vertexCount;
 	geometryDesc.Triangles.VertexBuffer.StartAddress = vertexBuffer.resource->GetGPUVirtualAddress();
 	geometryDesc.Triangles.VertexBuffer.StrideInBytes = sizeof(Vertex);
 	geometryDesc.Flags = D3D12_RAYTRACING_GEOMETRY_FLAG_OPAQUE;
 
-	// Get required sizes for acceleration structure buffers
 	D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAGS buildFlags = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_PREFER_FAST_TRACE;
-	
-	D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_INPUTS bottomLevelInputs = {};
-	bottomLevelInputs.Type = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_TYPE_BOTTOM_LEVEL;
-	bottomLevelInputs.DescsLayout = D3D12_ELEMENTS_LAYOUT_ARRAY;
-	bottomLevelInputs.NumDescs = 1;
-	bottomLevelInputs.pGeometryDescs = &geometryDesc;
-	bottomLevelInputs.Flags = buildFlags;
-
-	D3D12_RAYTRACING_ACCELERATION_STRUCTURE_PREBUILD_INFO bottomLevelPrebuildInfo = {};
-	raytracingDevice->GetRaytracingAccelerationStructurePrebuildInfo(&bottomLevelInputs, &bottomLevelPrebuildInfo);
-
-	// Create BLAS scratch buffer
-	CD3DX12_HEAP_PROPERTIES defaultHeapProperties(D3D12_HEAP_TYPE_DEFAULT);
-	CD3DX12_RESOURCE_DESC scratchBufferDesc = CD3DX12_RESOURCE_DESC::Buffer(
-		bottomLevelPrebuildInfo.ScratchDataSizeInBytes,
-		D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS
-	);
-	
-	ThrowIfFailed(device->CreateCommittedResource(
-		&defaultHeapProperties,
-		D3D12_HEAP_FLAG_NONE,
-		&scratchBufferDesc,
-		D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
-		nullptr,
-		IID_PPV_ARGS(&bottomLevelAccelerationStructureScratch)),
-		L"Failed to create BLAS scratch buffer");
+	if (compactAccelerationStructures)
+	{
+		buildFlags |= D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_ALLOW_COMPACTION;
+	}
 
-	// Create BLAS buffer
-	CD3DX12_RESOURCE_DESC blasBufferDesc = CD3DX12_RESOURCE_DESC::Buffer(
-		bottomLevelPrebuildInfo.ResultDataMaxSizeInBytes,
-		D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS
-	);
+	// Every mesh is queued on the builder, which records the builds in batches sharing one scratch pool.
+	accelerationStructureBuilder = std::make_unique<RTAccelerationStructureBuilder>(raytracingDevice.Get());
+	accelerationStructureBuilder->AddBottomLevel({ geometryDesc }, buildFlags);
 
-	ThrowIfFailed(device->CreateCommittedResource(
-		&defaultHeapProperties,
-		D3D12_HEAP_FLAG_NONE,
-		&blasBufferDesc,
-		D3D12_RESOURCE_STATE_RAYTRACING_ACCELERATION_STRUCTURE,
-		nullptr,
-		IID_PPV_ARGS(&bottomLevelAccelerationStructure)),
-		L"Failed to create BLAS buffer");
+	if (compactAccelerationStructures)
+	{
+		// The builds write their compacted sizes, which are read back once the command list has executed.
+		blasCompactor = std::make_unique<RTBlasCompactor>(raytracingDevice.Get(), 1);
+		bottomLevelAccelerationStructures = accelerationStructureBuilder->Build(raytracingCommanList.Get(), blasCompactor.get());
+		blasCompactor->RecordSizeReadback(raytracingCommanList.Get());
+	}
+	else
+	{
+		bottomLevelAccelerationStructures = accelerationStructureBuilder->Build(raytracingCommanList.Get());
+	}
+}
 
-	// 2. Create the Top Level Acceleration Structure (TLAS)
-	// This references the BLAS and defines its transformation in the scene
-	
-	// Create instance descriptor
-	D3D12_RAYTRACING_INSTANCE_DESC instanceDesc = {};
-
-	// Identity matrix for transformation
-	instanceDesc.Transform[0][0] = 1.0f;
-	instanceDesc.Transform[1][1] = 1.0f;
-	instanceDesc.Transform[2][2] = 1.0f;
-	instanceDesc.InstanceID = 0;
-	instanceDesc.InstanceMask = 1;
-	instanceDesc.InstanceContributionToHitGroupIndex = 0;
-	instanceDesc.Flags = D3D12_RAYTRACING_INSTANCE_FLAG_NONE;
-	// Refer to the bottom level acceleration structure
-	instanceDesc.AccelerationStructure = bottomLevelAccelerationStructure->GetGPUVirtualAddress();
-
-	// Create instance descriptors buffer
-	CD3DX12_HEAP_PROPERTIES uploadHeapProperties(D3D12_HEAP_TYPE_UPLOAD);
-	CD3DX12_RESOURCE_DESC instanceDescsBufferDesc = CD3DX12_RESOURCE_DESC::Buffer(sizeof(D3D12_RAYTRACING_INSTANCE_DESC));
+void RTDXInterface::CompactBottomLevelAccelerationStructures()
+{
+	RT_TRACE_ZONE("CompactBottomLevelAccelerationStructures");
 
-	ThrowIfFailed(device->CreateCommittedResource(
-		&uploadHeapProperties,
-		D3D12_HEAP_FLAG_NONE,
-		&instanceDescsBufferDesc,
-		D3D12_RESOURCE_STATE_GENERIC_READ,
-		nullptr,
-		IID_PPV_ARGS(&instanceDescs)),
-		L"Failed to create instance descriptors buffer");
-
-	// Copy instance descriptor to the buffer
-	D3D12_RAYTRACING_INSTANCE_DESC* mappedData;
-	CD3DX12_RANGE readRange(0, 0);
-	ThrowIfFailed(instanceDescs->Map(0, &readRange, reinterpret_cast<void**>(&mappedData)),
-		L"Failed to map instance descriptors buffer");
-	memcpy(mappedData, &instanceDesc, sizeof(D3D12_RAYTRACING_INSTANCE_DESC));
-	instanceDescs->Unmap(0, nullptr);
-
-	// Get required sizes for the top level acceleration structure buffers
-	D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_INPUTS topLevelInputs = {};
-	topLevelInputs.Type = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL;
-	topLevelInputs.DescsLayout = D3D12_ELEMENTS_LAYOUT_ARRAY;
-	topLevelInputs.NumDescs = 1;
-	topLevelInputs.InstanceDescs = instanceDescs->GetGPUVirtualAddress();
-	topLevelInputs.Flags = buildFlags;
-
-	D3D12_RAYTRACING_ACCELERATION_STRUCTURE_PREBUILD_INFO topLevelPrebuildInfo = {};
-	raytracingDevice->GetRaytracingAccelerationStructurePrebuildInfo(&topLevelInputs, &topLevelPrebuildInfo);
-
-	// Create TLAS scratch buffer
-	CD3DX12_RESOURCE_DESC topLevelScratchBufferDesc = CD3DX12_RESOURCE_DESC::Buffer(
-		topLevelPrebuildInfo.ScratchDataSizeInBytes,
-		D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS
-	);
+	deviceResources->ResetCommandList();
+	compactedBottomLevelBuffer = blasCompactor->RecordCompaction(raytracingCommanList.Get(), bottomLevelAccelerationStructures);
+	deviceResources->ExecuteCommandList();
+	deviceResources->WaitForGpu();
 
-	ThrowIfFailed(device->CreateCommittedResource(
-		&defaultHeapProperties,
-		D3D12_HEAP_FLAG_NONE,
-		&topLevelScratchBufferDesc,
-		D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
-		nullptr,
-		IID_PPV_ARGS(&topLevelAccelerationStructureScratch)),
-		L"Failed to create TLAS scratch buffer");
+	// The builder's buffers only held the uncompacted structures.
+	accelerationStructureBuilder.reset();
 
-	// Create TLAS buffer
-	CD3DX12_RESOURCE_DESC topLevelBufferDesc = CD3DX12_RESOURCE_DESC::Buffer(
-		topLevelPrebuildInfo.ResultDataMaxSizeInBytes,
-		D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS
-	);
+	wchar_t message[128];
+	swprintf_s(message, L"BLAS compaction: %llu bytes reduced to %llu bytes\n", blasCompactor->GetOriginalSizeInBytes(), blasCompactor->GetCompactedSizeInBytes());
+	OutputDebugStringW(message);
 
-	ThrowIfFailed(device->CreateCommittedResource(
-		&defaultHeapProperties,
-		D3D12_HEAP_FLAG_NONE,
-		&topLevelBufferDesc,
-		D3D12_RESOURCE_STATE_RAYTRACING_ACCELERATION_STRUCTURE,
-		nullptr,
-		IID_PPV_ARGS(&topLevelAccelerationStructure)),
-		L"Failed to create TLAS buffer");
+	blasCompactor.reset();
+}
 
-	// 3. Build the acceleration structures
-	D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_DESC bottomLevelBuildDesc = {};
-	bottomLevelBuildDesc.Inputs = bottomLevelInputs;
-	bottomLevelBuildDesc.ScratchAccelerationStructureData = bottomLevelAccelerationStructureScratch->GetGPUVirtualAddress();
-	bottomLevelBuildDesc.DestAccelerationStructureData = bottomLevelAccelerationStructure->GetGPUVirtualAddress();
+void RTDXInterface::BuildTopLevelAccelerationStructure()
+{
+	RT_TRACE_ZONE("BuildTopLevelAccelerationStructure");
 
-	D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_DESC topLevelBuildDesc = {};
-	topLevelBuildDesc.Inputs = topLevelInputs;
-	topLevelBuildDesc.ScratchAccelerationStructureData = topLevelAccelerationStructureScratch->GetGPUVirtualAddress();
-	topLevelBuildDesc.DestAccelerationStructureData = topLevelAccelerationStructure->GetGPUVirtualAddress();
+	// Create the Top Level Acceleration Structure (TLAS)
+	// This references the BLASes and places their instances in the scene. 
+	// It is rebuilt when the number of instances changes, and refitted in place otherwise.
+	if (!topLevelAccelerationStructure)
+	{
+		topLevelAccelerationStructure = std::make_unique<RTTopLevelAccelerationStructure>(raytracingDevice.Get(), frameCount);
+	}
 
-	// Build both acceleration structures
-	raytracingCommanList->BuildRaytracingAccelerationStructure(&bottomLevelBuildDesc, 0, nullptr);
+	UINT frameIndex = deviceResources->GetCurrentFrameIndex();
+	if (!asyncAccelerationStructureBuilds)
+	{
+		gpuProfiler->BeginScope(raytracingCommanList.Get(), "AS build");
+		topLevelAccelerationStructure->Build(raytracingCommanList.Get(), frameIndex, instanceDescs);
+		gpuProfiler->EndScope(raytracingCommanList.Get());
+		return;
+	}
 
-	// Wait for BLAS build to complete before TLAS build
-	CD3DX12_RESOURCE_BARRIER uavBarrier = CD3DX12_RESOURCE_BARRIER::UAV(bottomLevelAccelerationStructure.Get());
-	raytracingCommanList->ResourceBarrier(1, &uavBarrier);
+	// The build writes this frame's version of the TLAS, so it can run on the compute queue while 
+	// the direct queue still traces the previous frame against its own version.
+	ID3D12GraphicsCommandList4* computeCommandList = computeQueue->Begin(frameIndex);
+	buildTimer->Begin(computeCommandList, frameIndex);
+	topLevelAccelerationStructure->Build(computeCommandList, frameIndex, instanceDescs);
+	buildTimer->End(computeCommandList, frameIndex);
+	UINT64 buildFenceValue = computeQueue->Submit();
 
-	raytracingCommanList->BuildRaytracingAccelerationStructure(&topLevelBuildDesc, 0, nullptr);
+	// The direct queue waits for the build on the GPU before it executes this frame's commands.
+	computeQueue->MakeQueueWait(deviceResources->GetCommandQueue(), buildFenceValue);
 }
 
-void RTDXInterface::BuildShaderTables()
+void RTDXInterface::UpdateInstances(float totalTime)
 {
-	auto device = deviceResources->GetD3DDevice();
+	RT_TRACE_ZONE("UpdateInstances");
+	RT_TRACE_COUNTER("Instances", sceneInstances.size());
 
-	void* rayGenShaderIdentifier = nullptr;
-	void* missShaderIdentifier = nullptr; 
-	void* hitGroupShaderIdentifier = nullptr; 
+	instanceDescs.resize(sceneInstances.size());
 
-	auto GetShaderIdentifiers = [&](auto* stateObjectProperties)
+	// Instances are independent, so large scenes update them on every core.
+	RTParallel::ParallelFor(sceneInstances.size(), 1024, [&](size_t begin, size_t end)
 		{
-			rayGenShaderIdentifier = stateObjectProperties->GetShaderIdentifier(c_rayGenShaderName);
-			missShaderIdentifier = stateObjectProperties->GetShaderIdentifier(c_missShaderName);
-			hitGroupShaderIdentifier = stateObjectProperties->GetShaderIdentifier(c_hitGroupName);
-		};
+			for (size_t i = begin; i < end; ++i)
+			{
+				MeshInstance const& instance = sceneInstances[i];
+				ThrowIfFalse(instance.meshIndex < bottomLevelAccelerationStructures.size(), L"Instance references a mesh which has not been uploaded");
+
+				RTMatrix4D::RTMatrix4DImpl transform = instance.transform;
+				if (animateInstances)
+				{
+					// Each instance spins at its own rate, so the refit sees independent motion.
+					float angle = totalTime * (0.5f + 0.25f * static_cast<float>(i % 5));
+					float c = cosf(angle);
+					float s = sinf(angle);
+					transform = transform * RTMatrix4D::RTMatrix4DImpl{
+						c, 0.f, s, 0.f,
+						0.f, 1.f, 0.f, 0.f,
+						-s, 0.f, c, 0.f,
+						0.f, 0.f, 0.f, 1.f };
+				}
+
+				D3D12_RAYTRACING_INSTANCE_DESC& instanceDesc = instanceDescs[i];
+				instanceDesc = {};
+
+				// The instance transform is the top three rows of the row major matrix.
+				for (int row = 0; row < 3; ++row)
+				{
+					for (int column = 0; column < 4; ++column)
+					{
+						instanceDesc.Transform[row][column] = transform.n[row][column];
+					}
+				}
+				instanceDesc.InstanceID = static_cast<UINT>(i) & 0xFFFFFF;
+				instanceDesc.InstanceMask = 1;
+				instanceDesc.InstanceContributionToHitGroupIndex = instanceHitGroupOffsets[i];
+				instanceDesc.Flags = D3D12_RAYTRACING_INSTANCE_FLAG_NONE;
+				instanceDesc.AccelerationStructure = bottomLevelAccelerationStructures[instance.meshIndex].StartAddress;
+			}
+		});
+}
 
-	// Get shader identifiers
-	UINT shaderIdentifierSize;
-	{
-		Microsoft::WRL::ComPtr<ID3D12StateObjectProperties> stateObjectProperties;
-		ThrowIfFailed(raytracingStateObject.As(&stateObjectProperties));
-		GetShaderIdentifiers(stateObjectProperties.Get());
-		shaderIdentifierSize = D3D12_SHADER_IDENTIFIER_SIZE_IN_BYTES;
-	}
-	
-	// Ray gen shader table 
+void RTDXInterface::BuildShaderTables()
+{
+	if (!shaderTableBuilder)
 	{
-		UINT numShaderRecords = 1; 
-		UINT shaderRecordSize = shaderIdentifierSize;
-		ShaderTable rayGenShaderTable(device, numShaderRecords, shaderRecordSize, L"RayGenShaderTable");
-		rayGenShaderTable.push_back(ShaderRecord(rayGenShaderIdentifier, shaderIdentifierSize));
-		m_rayGenShaderTable = rayGenShaderTable.GetResource();
+		shaderTableBuilder = std::make_unique<RTShaderTableBuilder>(deviceResources->GetD3DDevice().Get(), frameCount);
 	}
 
-	// Miss shader table 
+	// Shader identifiers
+	void const* rayGenShaderIdentifier = raytracingPipeline->GetRayGenShaderIdentifier();
+	void const* missShaderIdentifier = raytracingPipeline->GetMissShaderIdentifier();
+	void const* hitGroupShaderIdentifier = raytracingPipeline->GetHitGroupShaderIdentifier();
+
+	// Every bottom level acceleration structure holds a single geometry and there is a single ray type, 
+	// so each instance gets one hit group record.
+	std::vector<uint32_t> instanceGeometryCounts(sceneInstances.size(), 1);
+	uint32_t hitGroupRecordCount = 0;
+	instanceHitGroupOffsets = RTShaderTablePlanner::AssignHitGroupOffsets(instanceGeometryCounts, 1, hitGroupRecordCount);
+
+	shaderTableBuilder->Reset(
+		RTShaderTableDesc{ 1, 0 }, 
+		RTShaderTableDesc{ 1, 0 }, 
+		RTShaderTableDesc{ hitGroupRecordCount, sizeof(HitGroupLocalArguments) });
+
+	// Ray gen and miss records 
+	shaderTableBuilder->SetRecord(RTShaderTableType::RayGen, 0, rayGenShaderIdentifier);
+	shaderTableBuilder->SetRecord(RTShaderTableType::Miss, 0, missShaderIdentifier);
+
+	// Hit group records, with the constants and geometry of each instance 
+	for (size_t i = 0; i < sceneInstances.size(); ++i)
 	{
-		UINT numShaderRecords = 1; 
-		UINT shaderRecordSize = shaderIdentifierSize;
-		ShaderTable missShaderTable(device, numShaderRecords, shaderRecordSize, L"MissShaderTable");
-		missShaderTable.push_back(ShaderRecord(missShaderIdentifier, shaderIdentifierSize));
-		m_missShaderTable = missShaderTable.GetResource();
+		MeshInstance const& instance = sceneInstances[i];
+
+		// Only mesh 0 is uploaded, UpdateInstances() rejects instances of any other mesh.
+		HitGroupLocalArguments arguments = {};
+		arguments.colour[0] = instance.colour.x;
+		arguments.colour[1] = instance.colour.y;
+		arguments.colour[2] = instance.colour.z;
+		arguments.colour[3] = instance.colour.w;
+		arguments.indexSizeInBytes = indexSizeInBytes;
+		arguments.vertexBuffer = vertexBuffer.resource->GetGPUVirtualAddress();
+		arguments.indexBuffer = indexBuffer.resource->GetGPUVirtualAddress();
+
+		shaderTableBuilder->SetRecord(RTShaderTableType::HitGroup, instanceHitGroupOffsets[i], hitGroupShaderIdentifier, &arguments, sizeof(arguments));
 	}
+}
+
+void RTDXInterface::SetInstanceColour(size_t instanceIndex, RTVector4D::RTVec4DImpl const& colour)
+{
+	ThrowIfFalse(instanceIndex < sceneInstances.size(), L"Instance index out of range");
+	sceneInstances[instanceIndex].colour = colour;
+	accumulatedSampleCount = 0;
 
-	// Hit group shader table 
+	// Before OnInit() the records are set when the shader tables are first built.
+	if (shaderTableBuilder)
 	{
-		UINT numShaderRecords = 1;
-		UINT shaderRecordSize = shaderIdentifierSize;
-		ShaderTable hitGroupShaderTable(device, numShaderRecords, shaderRecordSize, L"HitGroupShaderTable");
-		hitGroupShaderTable.push_back(ShaderRecord(hitGroupShaderIdentifier, shaderIdentifierSize));
-		m_hitGroupShaderTable = hitGroupShaderTable.GetResource();
+		BuildShaderTables();
 	}
 }
 
+void RTDXInterface::SetPathTracing(PathTracingConstants const& constants)
+{
+	ThrowIfFalse(constants.maxBounces <= MaxPathBounces, L"Paths can't take more than MaxPathBounces bounces");
+	ThrowIfFalse(constants.samplesPerPixel > 0, L"Every pixel needs a sample");
+	pathTracingConstants = constants;
+	accumulatedSampleCount = 0;
+}
+
 void RTDXInterface::CreateRaytracingOutputResource()
 {
 	auto device = deviceResources->GetD3DDevice();
@@ -556,6 +512,15 @@ void RTDXInterface::CreateRaytracingOutputResource()
 
 	CD3DX12_HEAP_PROPERTIES defaultHeapProperties(D3D12_HEAP_TYPE_DEFAULT);
 
+	// The output and accumulation are only written and read by the GPU on the direct queue, so one version serves every frame. 
+	// When they are recreated, earlier frames may still be writing the old textures and their descriptors.
+	if (raytracingOutput)
+	{
+		deviceResources->DeferRelease(std::move(raytracingOutput));
+		deviceResources->DeferRelease(std::move(raytracingAccumulation));
+		descriptorHeap->FreePersistent(raytracingOutputDescriptor, deviceResources->GetCurrentFenceValue());
+	}
+
 	ThrowIfFailed(device->CreateCommittedResource(
 		&defaultHeapProperties,
 		D3D12_HEAP_FLAG_NONE,
@@ -565,27 +530,42 @@ void RTDXInterface::CreateRaytracingOutputResource()
 		IID_PPV_ARGS(&raytracingOutput)),
 		L"Failed to create raytracing output resource");
 
-	// Create the UAV for raytracing output
+	// The running mean needs more precision than the output, which the samples would band in
+	resDesc.Format = DXGI_FORMAT_R32G32B32A32_FLOAT;
+	ThrowIfFailed(device->CreateCommittedResource(
+		&defaultHeapProperties,
+		D3D12_HEAP_FLAG_NONE,
+		&resDesc,
+		D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+		nullptr,
+		IID_PPV_ARGS(&raytracingAccumulation)),
+		L"Failed to create raytracing accumulation resource");
+	accumulatedSampleCount = 0;
+
+	// Create the UAVs for raytracing output and accumulation
 	D3D12_UNORDERED_ACCESS_VIEW_DESC uavDesc = {};
 	uavDesc.ViewDimension = D3D12_UAV_DIMENSION_TEXTURE2D;
 
-	// Allocate descriptor handles
-	raytracingOutputResourceUAVDescriptorHeapIndex = descriptorsAllocated++;
-	CD3DX12_CPU_DESCRIPTOR_HANDLE uavDescriptorHandle(
-		descriptorHeap->GetCPUDescriptorHandleForHeapStart(),
-		raytracingOutputResourceUAVDescriptorHeapIndex,
-		descriptorSize);
-	raytracingOutputResourceUAVGpuDescriptor = CD3DX12_GPU_DESCRIPTOR_HANDLE(
-		descriptorHeap->GetGPUDescriptorHandleForHeapStart(),
-		raytracingOutputResourceUAVDescriptorHeapIndex,
-		descriptorSize);
-
-	// Create the UAV
-	device->CreateUnorderedAccessView(raytracingOutput.Get(), nullptr, &uavDesc, uavDescriptorHandle);
+	// The ray counters are a null view, which discards the counts
+	D3D12_UNORDERED_ACCESS_VIEW_DESC rayCounterDesc = {};
+	rayCounterDesc.Format = DXGI_FORMAT_R32_TYPELESS;
+	rayCounterDesc.ViewDimension = D3D12_UAV_DIMENSION_BUFFER;
+	rayCounterDesc.Buffer.NumElements = RayCounterCount;
+	rayCounterDesc.Buffer.Flags = D3D12_BUFFER_UAV_FLAG_RAW;
+
+	// Allocate the descriptors and create the UAVs
+	raytracingOutputDescriptor = descriptorHeap->AllocatePersistent(3);
+	device->CreateUnorderedAccessView(raytracingOutput.Get(), nullptr, &uavDesc, descriptorHeap->GetCpuHandle(raytracingOutputDescriptor.offset));
+	device->CreateUnorderedAccessView(raytracingAccumulation.Get(), nullptr, &uavDesc, descriptorHeap->GetCpuHandle(raytracingOutputDescriptor.offset + 1));
+	device->CreateUnorderedAccessView(nullptr, nullptr, &rayCounterDesc, descriptorHeap->GetCpuHandle(raytracingOutputDescriptor.offset + 2));
+	descriptorHeap->CopyToShaderVisible(raytracingOutputDescriptor);
 }
 
 void RTDXInterface::OnUpdate()
 {
+	RT_TRACE_ZONE("OnUpdate");
+	RTScopedTimer updateTimer(*gpuProfiler, "Update (CPU)");
+
 	// Update timer
 	timer.Tick([&]()
 	{
@@ -619,11 +599,22 @@ void RTDXInterface::OnUpdate()
 			1.0f
 		);
 		
+		// 3. Move the instances, the TLAS is refitted with the new transforms when the frame is rendered
+		UpdateInstances(totalTime);
+		
 		// For debug/performance tracking
 		static int fpsCounter = 0;
 		fpsCounter++;
 		if (fpsCounter >= 60) {
 			OutputDebugStringW((L"FPS: " + std::to_wstring(timer.GetFramesPerSecond()) + L"\n").c_str());
+			OutputDebugStringA(timer.GetFrameTimes().Format("Frame time").c_str());
+			OutputDebugStringA(gpuProfiler->GetStats().Format().c_str());
+			if (computeQueue)
+			{
+				OutputDebugStringW((L"AS build: " + std::to_wstring(accelerationStructureTiming.buildMilliseconds) + 
+					L" ms, ray tracing: " + std::to_wstring(accelerationStructureTiming.rayTracingMilliseconds) + 
+					L" ms, overlap: " + std::to_wstring(accelerationStructureTiming.overlapMilliseconds) + L" ms\n").c_str());
+			}
 			fpsCounter = 0;
 		}
 	});
@@ -631,23 +622,15 @@ void RTDXInterface::OnUpdate()
 
 void RTDXInterface::DoRayTracing()
 {
-	auto device = deviceResources->GetD3DDevice();
+	RT_TRACE_ZONE("DoRayTracing");
+
 	auto commandList = deviceResources->GetCommandList();
 	auto frameIndex = deviceResources->GetCurrentFrameIndex();
 
 	auto DispatchRays = [&](auto* commandList, auto* stateObject, auto* dispatchDesc)
 		{
-			// Each shader table has only one shader record, the stride is the same
-			dispatchDesc->RayGenerationShaderRecord.StartAddress = m_rayGenShaderTable->GetGPUVirtualAddress();
-			dispatchDesc->RayGenerationShaderRecord.SizeInBytes = m_rayGenShaderTable->GetDesc().Width;
-
-			dispatchDesc->MissShaderTable.StartAddress = m_missShaderTable->GetGPUVirtualAddress();
-			dispatchDesc->MissShaderTable.SizeInBytes = m_missShaderTable->GetDesc().Width;
-			dispatchDesc->MissShaderTable.StrideInBytes = dispatchDesc->MissShaderTable.SizeInBytes;
-
-			dispatchDesc->HitGroupTable.StartAddress = m_hitGroupShaderTable->GetGPUVirtualAddress();
-			dispatchDesc->HitGroupTable.SizeInBytes = m_hitGroupShaderTable->GetDesc().Width;
-			dispatchDesc->HitGroupTable.StrideInBytes = dispatchDesc->HitGroupTable.SizeInBytes;
+			// The tables share one buffer per frame, each with the stride of its largest record
+			shaderTableBuilder->FillDispatchDesc(frameIndex, *dispatchDesc);
 
 			dispatchDesc->Width = width;
 			dispatchDesc->Height = height;
@@ -659,93 +642,192 @@ void RTDXInterface::DoRayTracing()
 
 	auto SetCommonPipelineState = [&](auto* descriptorSetCommandList)
 		{
-			descriptorSetCommandList->SetDescriptorHeaps(1, descriptorHeap.GetAddressOf());
+			// The heap and the GPU handles are queried every frame, as they change when the heap grows
+			ID3D12DescriptorHeap* descriptorHeaps[] = { descriptorHeap->GetHeap() };
+			descriptorSetCommandList->SetDescriptorHeaps(ARRAYSIZE(descriptorHeaps), descriptorHeaps);
 
-			// Set raytracing output UAV
+			// Set raytracing output, accumulation and ray counter UAVs
 			descriptorSetCommandList->SetComputeRootDescriptorTable(
 				GlobalRootSignatureParams::OutputViewSlot, 
-				raytracingOutputResourceUAVGpuDescriptor);
-
-			// Set index and vertex buffer descriptor tables
-			descriptorSetCommandList->SetComputeRootDescriptorTable(
-				GlobalRootSignatureParams::VertexBufferSlot,
-				vertexBuffer.gpuDescriptorHandle);
+				descriptorHeap->GetGpuHandle(raytracingOutputDescriptor.offset));
 		};
 
-	commandList->SetComputeRootSignature(raytracingGlobalRootSignature.Get());
+	commandList->SetComputeRootSignature(raytracingPipeline->GetGlobalRootSignature());
 
 	// Copy the updated scene constant buffer to GPU
 	{
-		// Create a constant buffer for the scene data
-		CD3DX12_HEAP_PROPERTIES uploadHeapProperties(D3D12_HEAP_TYPE_UPLOAD);
-		
-		// Calculate size needed for the constant buffer (must be aligned to 256 bytes)
-		UINT constantBufferSize = (sizeof(SceneConstantBuffer) + 255) & ~255;
-		
-		// Create the constant buffer resource
-		Microsoft::WRL::ComPtr<ID3D12Resource> sceneConstantBuffer;
-		CD3DX12_RESOURCE_DESC constantBufferDesc = CD3DX12_RESOURCE_DESC::Buffer(constantBufferSize);
-		
-		ThrowIfFailed(device->CreateCommittedResource(
-			&uploadHeapProperties,
-			D3D12_HEAP_FLAG_NONE,
-			&constantBufferDesc,
-			D3D12_RESOURCE_STATE_GENERIC_READ,
-			nullptr,
-			IID_PPV_ARGS(&sceneConstantBuffer)),
-			L"Failed to create scene constant buffer");
-		
-		// Copy the scene data to the constant buffer
-		UINT8* pSceneDataBegin;
-		CD3DX12_RANGE readRange(0, 0);
-		ThrowIfFailed(sceneConstantBuffer->Map(0, &readRange, reinterpret_cast<void**>(&pSceneDataBegin)),
-			L"Failed to map scene constant buffer");
-		memcpy(pSceneDataBegin, &rtScene[frameIndex], sizeof(SceneConstantBuffer));
-		sceneConstantBuffer->Unmap(0, nullptr);
-		
-		// Set the constant buffer
+		RTUploadRingBuffer::Allocation sceneConstants = uploadRingBuffer->Upload(rtScene[frameIndex]);
+
 		commandList->SetComputeRootConstantBufferView(
 			GlobalRootSignatureParams::ConstantBufferSlot,
-			sceneConstantBuffer->GetGPUVirtualAddress());
+			sceneConstants.gpuAddress);
+	}
+
+	// Samples of another view or scene would blend into the image, so any change restarts the mean
+	{
+		AccumulationConstants accumulationConstants;
+		if (accumulationSampleCount > 0)
+		{
+			bool sceneChanged = std::memcmp(&rtScene[frameIndex], &accumulatedScene, sizeof(SceneConstantBuffer)) != 0 ||
+				instanceDescs.size() != accumulatedInstanceDescs.size() ||
+				(!instanceDescs.empty() && std::memcmp(instanceDescs.data(), accumulatedInstanceDescs.data(), instanceDescs.size() * sizeof(D3D12_RAYTRACING_INSTANCE_DESC)) != 0);
+			if (sceneChanged)
+			{
+				accumulatedSampleCount = 0;
+				accumulatedScene = rtScene[frameIndex];
+				accumulatedInstanceDescs = instanceDescs;
+			}
+
+			accumulationConstants.sampleIndex = accumulatedSampleCount;
+			accumulationConstants.sampleCount = accumulationSampleCount;
+			accumulatedSampleCount = std::min<UINT>(accumulatedSampleCount + 1, accumulationSampleCount);
+		}
+
+		commandList->SetComputeRoot32BitConstants(
+			GlobalRootSignatureParams::AccumulationConstantsSlot,
+			sizeof(AccumulationConstants) / sizeof(UINT), &accumulationConstants, 0);
 	}
 
+	commandList->SetComputeRoot32BitConstants(
+		GlobalRootSignatureParams::PathTracingConstantsSlot,
+		sizeof(PathTracingConstants) / sizeof(UINT), &pathTracingConstants, 0);
+
 	D3D12_DISPATCH_RAYS_DESC dispatchDesc = {};
 	SetCommonPipelineState(commandList);
 	
 	// Set the acceleration structure
 	commandList->SetComputeRootShaderResourceView(
 		GlobalRootSignatureParams::AccelerationStructureSlot, 
-		topLevelAccelerationStructure->GetGPUVirtualAddress());
+		topLevelAccelerationStructure->GetGPUVirtualAddress(frameIndex));
 	
-	DispatchRays(raytracingCommanList.Get(), raytracingStateObject.Get(), &dispatchDesc);
+	DispatchRays(raytracingCommanList.Get(), raytracingPipeline->GetStateObject(), &dispatchDesc);
+}
+
+void RTDXInterface::UpdateAccelerationStructureTiming()
+{
+	if (!buildTimer || !rayTracingTimer)
+	{
+		return;
+	}
+
+	// Prepare() waited for the frame which last used this frame index, so its timestamps are ready. 
+	// Its build could only overlap with the ray tracing of the frame before it.
+	auto frameIndex = deviceResources->GetCurrentFrameIndex();
+	RTQueueInterval buildInterval;
+	RTQueueInterval rayTracingInterval;
+	if (buildTimer->GetInterval(frameIndex, buildInterval) && rayTracingTimer->GetInterval(frameIndex, rayTracingInterval))
+	{
+		double overlap = std::min<double>(buildInterval.end, previousRayTracingInterval.end) - std::max<double>(buildInterval.start, previousRayTracingInterval.start);
+
+		accelerationStructureTiming.buildMilliseconds = buildInterval.Duration() * 1000.0;
+		accelerationStructureTiming.rayTracingMilliseconds = rayTracingInterval.Duration() * 1000.0;
+		accelerationStructureTiming.overlapMilliseconds = std::max<double>(overlap, 0.0) * 1000.0;
+		previousRayTracingInterval = rayTracingInterval;
+
+		// The build ran on the compute queue, outside of the profiler's command lists.
+		gpuProfiler->AddSample("AS build", accelerationStructureTiming.buildMilliseconds);
+	}
 }
 
 void RTDXInterface::OnRender()
 {
+	RT_TRACE_ZONE("OnRender");
+
 	deviceResources->Prepare(); 
+
+	// Recycle the constant data and descriptors of frames the GPU has finished with.
+	UINT64 completedFenceValue = deviceResources->GetCompletedFenceValue();
+	uploadRingBuffer->BeginFrame(completedFenceValue);
+	descriptorHeap->BeginFrame(completedFenceValue);
 	
 	auto commandList = deviceResources->GetCommandList();
 	auto renderTarget = deviceResources->GetRenderTarget();
+	auto frameIndex = deviceResources->GetCurrentFrameIndex();
+
+	// Prepare() waited for the frame which last used this frame index, so its timestamps are ready.
+	gpuProfiler->BeginFrame(frameIndex);
+	UpdateAccelerationStructureTiming();
+
+	BuildTopLevelAccelerationStructure();
 
+	// Copies the shader records changed since this frame index was last rendered.
+	shaderTableBuilder->Update(frameIndex);
+
+	if (rayTracingTimer)
+	{
+		rayTracingTimer->Begin(commandList, frameIndex);
+	}
+	gpuProfiler->BeginScope(commandList, "DispatchRays");
 	DoRayTracing();
+	gpuProfiler->EndScope(commandList);
+	if (rayTracingTimer)
+	{
+		rayTracingTimer->End(commandList, frameIndex);
+	}
 	
 	// Copy raytracing output to the render target
+	gpuProfiler->BeginScope(commandList, "Copy to back buffer");
 	D3D12_RESOURCE_BARRIER preCopyBarriers[2];
 	preCopyBarriers[0] = CD3DX12_RESOURCE_BARRIER::Transition(renderTarget, D3D12_RESOURCE_STATE_RENDER_TARGET, D3D12_RESOURCE_STATE_COPY_DEST);
 	preCopyBarriers[1] = CD3DX12_RESOURCE_BARRIER::Transition(raytracingOutput.Get(), D3D12_RESOURCE_STATE_UNORDERED_ACCESS, D3D12_RESOURCE_STATE_COPY_SOURCE);
 	commandList->ResourceBarrier(ARRAYSIZE(preCopyBarriers), preCopyBarriers);
 
 	commandList->CopyResource(renderTarget, raytracingOutput.Get());
+	gpuProfiler->EndScope(commandList);
 
+	// The GPU side of presenting is the transition of the back buffer, the CPU side is timed around Present() below.
+	gpuProfiler->BeginScope(commandList, "Present");
 	D3D12_RESOURCE_BARRIER postCopyBarriers[2];
 	postCopyBarriers[0] = CD3DX12_RESOURCE_BARRIER::Transition(renderTarget, D3D12_RESOURCE_STATE_COPY_DEST, D3D12_RESOURCE_STATE_PRESENT);
 	postCopyBarriers[1] = CD3DX12_RESOURCE_BARRIER::Transition(raytracingOutput.Get(), D3D12_RESOURCE_STATE_COPY_SOURCE, D3D12_RESOURCE_STATE_UNORDERED_ACCESS);
 	commandList->ResourceBarrier(ARRAYSIZE(postCopyBarriers), postCopyBarriers);
+	gpuProfiler->EndScope(commandList);
+	gpuProfiler->EndFrame(commandList);
 	
+	// Present() signals the current fence value once this frame's commands have executed.
+	UINT64 frameFenceValue = deviceResources->GetCurrentFenceValue();
+	uploadRingBuffer->EndFrame(frameFenceValue);
+	descriptorHeap->EndFrame(frameFenceValue);
+
+	// Includes the submission and any wait for a free frame, which is where a GPU bound frame shows up on the CPU.
+	RTScopedTimer presentTimer(*gpuProfiler, "Present (CPU)");
 	deviceResources->Present(D3D12_RESOURCE_STATE_PRESENT);
 }
 
-RTDXInterface::~RTDXInterface()
+void RTDXInterface::OnKeyDown(UINT8 key)
 {
+	if (key == VK_F8)
+	{
+		// Every trace starts empty, events of the previous one were written already or aren't wanted.
+		bool enable = !RTTrace::IsEnabled();
+		if (enable)
+		{
+			RTTrace::Clear();
+			RTTrace::SetThreadName("Main");
+		}
+		RTTrace::SetEnabled(enable);
+		OutputDebugStringW(enable ? L"Tracing started\n" : L"Tracing stopped\n");
+	}
+	else if (key == VK_F9)
+	{
+		try
+		{
+			RTTrace::WriteChromeTrace(tracePath);
+			OutputDebugStringW((L"Trace written to " + tracePath.wstring() + L"\n").c_str());
+		}
+		catch (std::exception const& e)
+		{
+			OutputDebugStringA(e.what());
+			OutputDebugStringW(L"\n");
+		}
+	}
+}
 
+RTDXInterface::~RTDXInterface()
+{
+	// Resources owned by the interface are released before the device resources, so wait for the GPU here.
+	if (deviceResources)
+	{
+		deviceResources->WaitForGpu();
+	}
 }
@@ -2,9 +2,15 @@
 
 #include <wrl.h>
 #include <d3d12.h>
+#include <filesystem>
 #include <memory>
 #include <string>
+#include <vector>
 #include "RTHelper.h"
+#include "RTQueueTimer.h"
+#include "RTGpuProfiler.h"
+#include "RTRayTracingPipeline.h"
+#include "../RHI/RTDescriptorAllocator.h"
 #include "../Scene/RTScene.h"
 #include "../App/StepTimer.h"
 
@@ -14,14 +20,6 @@
 	Source: https://github.com/microsoft/DirectX-Graphics-Samples/tree/master/Samples/Desktop/D3D12Raytracing/
 */
 
-enum GlobalRootSignatureParams {
-	OutputViewSlot = 0, 
-	ConstantBufferSlot,
-	AccelerationStructureSlot,
-	VertexBufferSlot,
-	Count
-};
-
 struct Rect {
 	long left;
 	long top;
@@ -29,6 +27,14 @@ struct Rect {
 	long bottom;
 };
 
+// GPU time of the acceleration structure builds on the compute queue, and how much of it overlapped
+// with the previous frame's ray tracing on the direct queue.
+struct AccelerationStructureTiming {
+	double buildMilliseconds = 0.0;
+	double rayTracingMilliseconds = 0.0;
+	double overlapMilliseconds = 0.0;
+};
+
 class RTDXInterface {
 
 	using UINT = unsigned int;
@@ -42,6 +48,9 @@ public:
 	virtual void OnInit(); 
 	virtual void OnUpdate(); 
 	virtual void OnRender(); 
+
+	// F8 starts and stops tracing the CPU timeline, F9 writes the trace recorded so far to the trace path.
+	virtual void OnKeyDown(UINT8 key);
 	
 	// Returns the timer for frame count and elapsed time tracking
 	StepTimer& GetTimer() { return timer; }
@@ -50,14 +59,65 @@ public:
 	void CreateDeviceDependentResources();
 
 	void CreateRaytracingInterfaces(); 
-	void CreateGlobalRootSignature();
-	void CreateRaytracingPipelineStateObject();
+	void CreateRaytracingPipeline();
 	void CreateDescriptorHeap();
+	void CreateUploadRingBuffer();
+	void CreateComputeQueue();
+	void CreateGpuProfiler();
 	void BuildGeometry();
-	void BuildAccelerationStructures();
+	void BuildBottomLevelAccelerationStructures();
+	void CompactBottomLevelAccelerationStructures();
+	void BuildTopLevelAccelerationStructure();
+	void UpdateInstances(float totalTime);
+
+	// Sets every shader record, one hit group record per instance. Called again after the records change, 
+	// only the records whose contents differ are copied into the frames' shader tables.
 	void BuildShaderTables();
 	void CreateRaytracingOutputResource();
 	void DoRayTracing();
+	void UpdateAccelerationStructureTiming();
+
+	// Replaces the geometry uploaded by BuildGeometry(), for example a mesh from RTProceduralGeometry. 
+	// Must be called before OnInit().
+	void SetSceneMesh(Mesh mesh) { sceneMesh = std::move(mesh); }
+
+	// Enables compaction of the bottom level acceleration structures after they are built, on by default. 
+	// Must be called before OnInit().
+	void SetAccelerationStructureCompaction(bool enable) { compactAccelerationStructures = enable; }
+
+	// Replaces the single identity instance of the scene mesh. Every instance must reference mesh 0 until multiple meshes are uploaded. 
+	// Must be called before OnInit().
+	void SetSceneInstances(std::vector<MeshInstance> instances) { sceneInstances = std::move(instances); }
+
+	// Changes the colour of one instance, which only rewrites its hit group record.
+	void SetInstanceColour(size_t instanceIndex, RTVector4D::RTVec4DImpl const& colour);
+
+	// Spins every instance around its vertical axis, refitting the top level acceleration structure every frame.
+	void SetInstanceAnimation(bool enable) { animateInstances = enable; }
+
+	// Adds a jittered sample per frame to the running mean of the frames before it, until sampleCount samples have been taken. 
+	// The mean restarts whenever the scene constants or instances change. 0, the default, traces one sample at every pixel centre.
+	void SetProgressiveAccumulation(UINT sampleCount) { accumulationSampleCount = sampleCount; accumulatedSampleCount = 0; }
+
+	// Path traces the scene instead of shading the primary hits directly, see PathTracingConstants. Restarts the accumulation.
+	void SetPathTracing(PathTracingConstants const& constants);
+
+	// Builds the acceleration structures on a compute queue, overlapping with the previous frame's ray tracing, on by default. 
+	// Must be called before OnInit().
+	void SetAsyncAccelerationStructureBuilds(bool enable) { asyncAccelerationStructureBuilds = enable; }
+
+	// File the pipeline creation results are cached in between runs, an empty path disables the cache. 
+	// Must be called before OnInit().
+	void SetPipelineCachePath(std::filesystem::path path) { pipelineCachePath = std::move(path); }
+
+	// File the Chrome trace event JSON is written to when F9 is pressed.
+	void SetTracePath(std::filesystem::path path) { tracePath = std::move(path); }
+
+	// Timing of the last frame to complete, only measured with asynchronous builds.
+	AccelerationStructureTiming const& GetAccelerationStructureTiming() const { return accelerationStructureTiming; }
+
+	// Rolling statistics of the acceleration structure build, ray dispatch, copy to the back buffer and present.
+	RTTimingStats const& GetFrameTimingStats() const { return gpuProfiler->GetStats(); }
 
 	// Accessors. 
 	UINT GetViewportWidth() const { return width; }
@@ -77,54 +137,103 @@ protected:
 	std::unique_ptr<class RTDeviceResources>			deviceResources;
 	Microsoft::WRL::ComPtr<ID3D12Device5>				raytracingDevice;
 	Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList4>	raytracingCommanList;
-	Microsoft::WRL::ComPtr<ID3D12StateObject>			raytracingStateObject;
 
-	// Root signatures
-	Microsoft::WRL::ComPtr<ID3D12RootSignature>			raytracingGlobalRootSignature;
+	// Root signatures and state object, shared with the D3D12 render device
+	std::unique_ptr<RTRayTracingPipeline>				raytracingPipeline;
+	std::filesystem::path								pipelineCachePath;
+	std::filesystem::path								tracePath;
 
 private:
 
+	// Index data packed into the smallest format which can address every vertex of a mesh.
+	struct IndexBufferData {
+		DXGI_FORMAT				format;
+		UINT					indexSizeInBytes;
+		std::vector<uint8_t>	bytes;
+	};
+
+	static IndexBufferData PackIndices(std::vector<uint32_t> const& indices, UINT numVertices);
+
 	// Frame count, must match the size of the back buffer
 	static const UINT									frameCount = 3;
 
+	// Size of the upload ring buffer, enough for the constant data of every frame in flight
+	static const UINT									uploadRingBufferSize = 64 * 1024;
+
+	// Initial descriptor heap regions, the persistent region grows when it fills up
+	static const UINT									transientDescriptorCount = 1024;
+	static const UINT									persistentDescriptorCount = 1024;
+
 	std::wstring										windowTitle;
 
 	// Shader tables 
-	static const wchar_t*								c_rayGenShaderName; 
-	static const wchar_t*								c_closestHitShaderName; 
-	static const wchar_t*								c_missShaderName;
-	static const wchar_t*								c_hitGroupName;
+	// Each frame in flight has its own copy of the tables, brought up to date when the frame is rendered, 
+	// while earlier frames still dispatch rays with theirs.
+	std::unique_ptr<class RTShaderTableBuilder>			shaderTableBuilder;
 
-	Microsoft::WRL::ComPtr<ID3D12Resource>				m_rayGenShaderTable; 
-	Microsoft::WRL::ComPtr<ID3D12Resource>				m_missShaderTable; 
-	Microsoft::WRL::ComPtr<ID3D12Resource>				m_hitGroupShaderTable;
+	// First hit group record of every instance, its InstanceContributionToHitGroupIndex
+	std::vector<uint32_t>								instanceHitGroupOffsets;
 
 	// Descriptors 
-	Microsoft::WRL::ComPtr<ID3D12DescriptorHeap>		descriptorHeap;
-	UINT												descriptorsAllocated;
-	UINT												descriptorSize;
+	std::unique_ptr<class RTDescriptorHeap>				descriptorHeap;
 
 	// Raytracing output 
 	Microsoft::WRL::ComPtr<ID3D12Resource>				raytracingOutput;
-	D3D12_GPU_DESCRIPTOR_HANDLE							raytracingOutputResourceUAVGpuDescriptor;
-	UINT												raytracingOutputResourceUAVDescriptorHeapIndex;
+	RTDescriptorRange									raytracingOutputDescriptor;
+
+	// Progressive accumulation, its UAV follows the output's so both form one descriptor table. 
+	// The scene constants and instances its samples were taken with restart the mean when they change.
+	Microsoft::WRL::ComPtr<ID3D12Resource>				raytracingAccumulation;
+	UINT												accumulationSampleCount;
+	UINT												accumulatedSampleCount;
+	SceneConstantBuffer									accumulatedScene;
+	std::vector<D3D12_RAYTRACING_INSTANCE_DESC>			accumulatedInstanceDescs;
+
+	// Integrator, the ray counters of the shaders are a null view, as the window doesn't report them
+	PathTracingConstants								pathTracingConstants;
+
+	// Per-frame constant data, suballocated from a persistently mapped upload buffer
+	std::unique_ptr<class RTUploadRingBuffer>			uploadRingBuffer;
 
 	// Raytracing scene 
 	SceneConstantBuffer									rtScene[frameCount]; 
-	ObjectConstantBuffer								rtObject; 
 
 	// Geometry reference
+	Mesh												sceneMesh;
 	D3DBuffer											indexBuffer;
 	D3DBuffer											vertexBuffer;
+	DXGI_FORMAT											indexFormat;
+	UINT												indexSizeInBytes;
+	UINT												indexCount;
+	UINT												vertexCount;
 	
-	// Acceleration structures
-	Microsoft::WRL::ComPtr<ID3D12Resource>				bottomLevelAccelerationStructure;
-	Microsoft::WRL::ComPtr<ID3D12Resource>				topLevelAccelerationStructure;
-	
-	// GPU buffers to hold acceleration structure build data
-	Microsoft::WRL::ComPtr<ID3D12Resource>				bottomLevelAccelerationStructureScratch;
-	Microsoft::WRL::ComPtr<ID3D12Resource>				topLevelAccelerationStructureScratch;
-	Microsoft::WRL::ComPtr<ID3D12Resource>				instanceDescs;
+	// Batched BLAS builds, owning the buffers the structures are suballocated from, so it is declared before them
+	std::unique_ptr<class RTAccelerationStructureBuilder>	accelerationStructureBuilder;
+
+	// Acceleration structures. The bottom level ones live in the builder's buffers, or in the compacted buffer once compacted.
+	Microsoft::WRL::ComPtr<ID3D12Resource>				compactedBottomLevelBuffer;
+	std::vector<D3D12_GPU_VIRTUAL_ADDRESS_RANGE>		bottomLevelAccelerationStructures;
+	std::unique_ptr<class RTTopLevelAccelerationStructure>	topLevelAccelerationStructure;
+
+	// Compaction of the bottom level acceleration structures, alive between the build and the compacting copy
+	std::unique_ptr<class RTBlasCompactor>				blasCompactor;
+	bool												compactAccelerationStructures;
+
+	// Scene instances and the instance descriptions written to the TLAS, refreshed by OnUpdate()
+	std::vector<MeshInstance>							sceneInstances;
+	std::vector<D3D12_RAYTRACING_INSTANCE_DESC>			instanceDescs;
+	bool												animateInstances;
+
+	// Queue the acceleration structures are built on, and the timing of its work against the direct queue's
+	std::unique_ptr<class RTComputeQueue>				computeQueue;
+	std::unique_ptr<RTQueueTimer>						buildTimer;
+	std::unique_ptr<RTQueueTimer>						rayTracingTimer;
+	RTQueueInterval										previousRayTracingInterval;
+	AccelerationStructureTiming							accelerationStructureTiming;
+	bool												asyncAccelerationStructureBuilds;
+
+	// Timestamps of the named scopes of every frame on the direct queue
+	std::unique_ptr<RTGpuProfiler>						gpuProfiler;
 	
 	// Timer for animation and time-based effects
 	StepTimer 											timer;
@@ -0,0 +1,110 @@
+#include "RTDescriptorHeap.h"
+#include "HrException.h"
+#include "d3dx12.h"
+#include <algorithm>
+
+RTDescriptorHeap::RTDescriptorHeap(ID3D12Device* device, D3D12_DESCRIPTOR_HEAP_TYPE type, UINT transientCount, UINT persistentCount, LPCWSTR name) :
+	device{ device },
+	type{ type },
+	descriptorSize{ device->GetDescriptorHandleIncrementSize(type) },
+	name{ name },
+	allocator{ transientCount, persistentCount }
+{
+	CreateHeaps(allocator.GetCapacity());
+}
+
+void RTDescriptorHeap::CreateHeaps(UINT count)
+{
+	D3D12_DESCRIPTOR_HEAP_DESC descriptorHeapDesc = {};
+	descriptorHeapDesc.NumDescriptors = count;
+	descriptorHeapDesc.Type = type;
+	descriptorHeapDesc.NodeMask = 0;
+
+	descriptorHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_SHADER_VISIBLE;
+	ThrowIfFailed(device->CreateDescriptorHeap(&descriptorHeapDesc, IID_PPV_ARGS(&shaderVisibleHeap)),
+		L"Failed to create shader visible descriptor heap");
+	shaderVisibleHeap->SetName(name.c_str());
+
+	descriptorHeapDesc.Flags = D3D12_DESCRIPTOR_HEAP_FLAG_NONE;
+	ThrowIfFailed(device->CreateDescriptorHeap(&descriptorHeapDesc, IID_PPV_ARGS(&stagingHeap)),
+		L"Failed to create staging descriptor heap");
+}
+
+void RTDescriptorHeap::BeginFrame(UINT64 completedFenceValue)
+{
+	allocator.ReleaseCompletedFrames(completedFenceValue);
+
+	retiredHeaps.Collect(completedFenceValue);
+}
+
+void RTDescriptorHeap::EndFrame(UINT64 fenceValue)
+{
+	allocator.FinishFrame(fenceValue);
+
+	for (auto& heap : heapsRetiredThisFrame)
+	{
+		retiredHeaps.Retire(std::move(heap), fenceValue);
+	}
+	heapsRetiredThisFrame.clear();
+}
+
+RTDescriptorRange RTDescriptorHeap::AllocatePersistent(UINT count)
+{
+	RTDescriptorRange range = allocator.AllocatePersistent(count);
+	if (!range.IsValid())
+	{
+		Grow(count);
+		range = allocator.AllocatePersistent(count);
+	}
+	return range;
+}
+
+RTDescriptorRange RTDescriptorHeap::AllocateTransient(UINT count)
+{
+	RTDescriptorRange range = allocator.AllocateTransient(count);
+	ThrowIfFalse(range.IsValid(), L"Transient descriptor region is full");
+	return range;
+}
+
+void RTDescriptorHeap::FreePersistent(RTDescriptorRange range, UINT64 fenceValue)
+{
+	allocator.FreePersistent(range, fenceValue);
+}
+
+void RTDescriptorHeap::CopyToShaderVisible(RTDescriptorRange range)
+{
+	device->CopyDescriptorsSimple(range.count,
+		CD3DX12_CPU_DESCRIPTOR_HANDLE(shaderVisibleHeap->GetCPUDescriptorHandleForHeapStart(), range.offset, descriptorSize),
+		GetCpuHandle(range.offset),
+		type);
+}
+
+D3D12_CPU_DESCRIPTOR_HANDLE RTDescriptorHeap::GetCpuHandle(UINT index) const
+{
+	return CD3DX12_CPU_DESCRIPTOR_HANDLE(stagingHeap->GetCPUDescriptorHandleForHeapStart(), index, descriptorSize);
+}
+
+D3D12_GPU_DESCRIPTOR_HANDLE RTDescriptorHeap::GetGpuHandle(UINT index) const
+{
+	return CD3DX12_GPU_DESCRIPTOR_HANDLE(shaderVisibleHeap->GetGPUDescriptorHandleForHeapStart(), index, descriptorSize);
+}
+
+void RTDescriptorHeap::Grow(UINT minimumPersistentCount)
+{
+	// Doubling keeps the number of reallocations logarithmic in the number of descriptors.
+	UINT oldCount = allocator.GetCapacity();
+	UINT persistentCount = std::max<UINT>(allocator.GetPersistentCapacity() * 2, allocator.GetPersistentCapacity() + minimumPersistentCount);
+	allocator.GrowPersistent(persistentCount);
+
+	Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> oldShaderVisibleHeap = shaderVisibleHeap;
+	Microsoft::WRL::ComPtr<ID3D12DescriptorHeap> oldStagingHeap = stagingHeap;
+	CreateHeaps(allocator.GetCapacity());
+
+	// Indices are unchanged, so the old contents copy over as a single block. The transient region is
+	// included because the frame being recorded may already have written descriptors there.
+	device->CopyDescriptorsSimple(oldCount, stagingHeap->GetCPUDescriptorHandleForHeapStart(), oldStagingHeap->GetCPUDescriptorHandleForHeapStart(), type);
+	device->CopyDescriptorsSimple(oldCount, shaderVisibleHeap->GetCPUDescriptorHandleForHeapStart(), stagingHeap->GetCPUDescriptorHandleForHeapStart(), type);
+
+	// Command lists recorded this frame may still reference the old heap.
+	heapsRetiredThisFrame.push_back(std::move(oldShaderVisibleHeap));
+}
@@ -0,0 +1,69 @@
+#pragma once
+
+#include <wrl.h>
+#include <d3d12.h>
+#include <string>
+#include <vector>
+#include "../RHI/RTDescriptorAllocator.h"
+#include "../RHI/RTFrameVersioning.h"
+
+/*
+	Shader visible descriptor heap with persistent and per-frame regions, see RTDescriptorAllocator.
+	Descriptors are written into a CPU only staging heap through GetCpuHandle() and published to the
+	shader visible heap with CopyToShaderVisible(), because shader visible heaps are slow for the CPU
+	to read. The staging copy is what allows the heap to grow: when the persistent region is full, a
+	larger pair of heaps replaces the current one and the old shader visible heap is kept alive until
+	the frames which may reference it have completed.
+	Growing changes the GPU handles, so descriptors are stored by index and GetHeap() and GetGpuHandle()
+	are queried again when binding.
+*/
+
+class RTDescriptorHeap {
+
+public:
+	RTDescriptorHeap(ID3D12Device* device, D3D12_DESCRIPTOR_HEAP_TYPE type, UINT transientCount, UINT persistentCount, LPCWSTR name);
+
+	RTDescriptorHeap(RTDescriptorHeap const&) = delete;
+	RTDescriptorHeap& operator =(RTDescriptorHeap const&) = delete;
+
+	// Recycles the transient descriptors and deferred frees of completed frames. Call once per frame before allocating.
+	void BeginFrame(UINT64 completedFenceValue);
+
+	// Marks the transient descriptors and heaps retired since BeginFrame() as in use until the fence reaches fenceValue.
+	void EndFrame(UINT64 fenceValue);
+
+	// Allocates descriptors which stay valid until freed, growing the heap if needed.
+	RTDescriptorRange AllocatePersistent(UINT count);
+
+	// Allocates descriptors for the current frame only. Throws if the transient region is full.
+	RTDescriptorRange AllocateTransient(UINT count);
+
+	// Returns persistent descriptors once the frame being recorded, with the given fence value, has completed.
+	void FreePersistent(RTDescriptorRange range, UINT64 fenceValue);
+
+	// Copies the descriptors of a range from the staging heap to the shader visible heap.
+	void CopyToShaderVisible(RTDescriptorRange range);
+
+	// Handle in the staging heap, used to create views.
+	D3D12_CPU_DESCRIPTOR_HANDLE GetCpuHandle(UINT index) const;
+
+	// Handle in the shader visible heap, used to bind descriptor tables.
+	D3D12_GPU_DESCRIPTOR_HANDLE GetGpuHandle(UINT index) const;
+
+	ID3D12DescriptorHeap* GetHeap() const { return shaderVisibleHeap.Get(); }
+	UINT GetDescriptorSize() const { return descriptorSize; }
+
+private:
+	void CreateHeaps(UINT count);
+	void Grow(UINT minimumPersistentCount);
+
+	Microsoft::WRL::ComPtr<ID3D12Device>						device;
+	Microsoft::WRL::ComPtr<ID3D12DescriptorHeap>				shaderVisibleHeap;
+	Microsoft::WRL::ComPtr<ID3D12DescriptorHeap>				stagingHeap;
+	RTDeferredReleaseQueue<Microsoft::WRL::ComPtr<ID3D12DescriptorHeap>>	retiredHeaps;
+	std::vector<Microsoft::WRL::ComPtr<ID3D12DescriptorHeap>>	heapsRetiredThisFrame;
+	D3D12_DESCRIPTOR_HEAP_TYPE									type;
+	UINT														descriptorSize;
+	std::wstring												name;
+	RTDescriptorAllocator										allocator;
+};
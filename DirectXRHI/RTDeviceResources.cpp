@@ -434,11 +434,16 @@ void RTDeviceResources::ResizeWindowSizeDependentResources()
 	}
 }
 
-void RTDeviceResources::Prepare(D3D12_RESOURCE_STATES beforeState)
+void RTDeviceResources::ResetCommandList()
 {
 	// Reset command list and allocator. 
 	ThrowIfFailed(commandAllocators[backBufferIndex]->Reset());
 	ThrowIfFailed(commandList->Reset(commandAllocators[backBufferIndex].Get(), nullptr));
+}
+
+void RTDeviceResources::Prepare(D3D12_RESOURCE_STATES beforeState)
+{
+	ResetCommandList();
 
 	if (beforeState != D3D12_RESOURCE_STATE_RENDER_TARGET)
 	{
@@ -514,6 +519,11 @@ void RTDeviceResources::ExecuteCommandList()
 	commandQueue->ExecuteCommandLists((UINT)std::size(commandLists), commandLists);
 }
 
+void RTDeviceResources::DeferRelease(Microsoft::WRL::ComPtr<ID3D12Pageable> object)
+{
+	deferredReleases.Retire(std::move(object), fenceValues[backBufferIndex]);
+}
+
 void RTDeviceResources::WaitForGpu() noexcept
 {
 	if (commandQueue && fence && fenceEvent.IsValid())
@@ -530,6 +540,9 @@ void RTDeviceResources::WaitForGpu() noexcept
 
 				// Increment the fence value for the current frame. 
 				fenceValues[backBufferIndex]++;
+
+				// Nothing is in use by the GPU anymore.
+				deferredReleases.Flush();
 			}
 		}
 	}
@@ -551,6 +564,9 @@ void RTDeviceResources::MoveToNextFrame()
 		WaitForSingleObjectEx(fenceEvent.Get(), INFINITE, false);
 	}
 
+	// Release the objects retired by the frames which have completed.
+	deferredReleases.Collect(fence->GetCompletedValue());
+
 	// Set the fence value for the next frame. 
 	fenceValues[backBufferIndex] = currentFenceValue + 1;
 }
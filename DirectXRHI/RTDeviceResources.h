@@ -4,6 +4,7 @@
 #include <d3d12.h>
 #include <dxgi1_6.h>
 #include <string>
+#include "../RHI/RTFrameVersioning.h"
 
 /*
 	Wrapper for managing memory resources on a DirectX12 compatible GPU. 
@@ -47,9 +48,16 @@ public:
 	// Present the contents of the swap chain. 
 	void Present(D3D12_RESOURCE_STATES beforeState = D3D12_RESOURCE_STATE_RENDER_TARGET);
 
+	// Reset the command list for recording outside of the frame loop, for example during initialisation.
+	void ResetCommandList();
+
 	// Send the command list to the GPU for processing.
 	void ExecuteCommandList();
 
+	// Keeps an object which commands of the current frame may use alive until the frame has completed on the GPU.
+	// Replaced resources are handed over here, rather than released while an earlier frame could still read them.
+	void DeferRelease(Microsoft::WRL::ComPtr<ID3D12Pageable> object);
+
 	// Wait for any pending work on the GPU to complete. 
 	void WaitForGpu() noexcept;
 
@@ -62,10 +70,16 @@ public:
 	// Private member accessors. 
 	
 	ID3D12GraphicsCommandList*				GetCommandList() const { return commandList.Get(); }
+	ID3D12CommandQueue*						GetCommandQueue() const { return commandQueue.Get(); }
 	ID3D12Resource*							GetRenderTarget() const { return renderTargets[backBufferIndex].Get(); }
 	Microsoft::WRL::ComPtr<ID3D12Device>	GetD3DDevice() const { return d3dDevice; }
+	IDXGIAdapter1*							GetAdapter() const { return d3dAdapter.Get(); }
 	UINT									GetCurrentFrameIndex() const { return backBufferIndex; }
 
+	// Fence value the GPU signals once the commands recorded for the current frame have executed.
+	UINT64									GetCurrentFenceValue() const { return fenceValues[backBufferIndex]; }
+	UINT64									GetCompletedFenceValue() const { return fence->GetCompletedValue(); }
+
 	struct CD3DX12_CPU_DESCRIPTOR_HANDLE	GetRenderTargetView() const; 
 
 private: 
@@ -88,6 +102,9 @@ private:
 	Microsoft::WRL::Wrappers::Event						fenceEvent;
 	UINT64												fenceValues[MAX_BACK_BUFFER_COUNT];
 
+	// Objects retired by DeferRelease(), released as their frames complete
+	RTDeferredReleaseQueue<Microsoft::WRL::ComPtr<ID3D12Pageable>>	deferredReleases;
+
 	// Direct3D rendering objects. 
 	Microsoft::WRL::ComPtr<ID3D12DescriptorHeap>		rtvDescriptorHeap;
 	Microsoft::WRL::ComPtr<ID3D12DescriptorHeap>		dsvDescriptorHeap;
@@ -0,0 +1,136 @@
+#include "RTGpuProfiler.h"
+#include "HrException.h"
+#include "d3dx12.h"
+
+RTGpuProfiler::RTGpuProfiler(ID3D12Device* device, ID3D12CommandQueue* commandQueue, UINT frameCount, UINT maxScopesPerFrame) :
+	timestampFrequency{ 0 },
+	queriesPerFrame{ 2 * maxScopesPerFrame },
+	frames(frameCount),
+	recordingFrameIndex{ 0 },
+	recording{ false }
+{
+	ThrowIfFailed(commandQueue->GetTimestampFrequency(&timestampFrequency),
+		L"Failed to get the queue timestamp frequency");
+
+	// Each scope takes two timestamps, its start and its end.
+	D3D12_QUERY_HEAP_DESC queryHeapDesc = {};
+	queryHeapDesc.Type = D3D12_QUERY_HEAP_TYPE_TIMESTAMP;
+	queryHeapDesc.Count = queriesPerFrame * frameCount;
+	ThrowIfFailed(device->CreateQueryHeap(&queryHeapDesc, IID_PPV_ARGS(&queryHeap)),
+		L"Failed to create profiler query heap");
+	queryHeap->SetName(L"ProfilerTimestamps");
+
+	CD3DX12_HEAP_PROPERTIES readbackHeapProperties(D3D12_HEAP_TYPE_READBACK);
+	CD3DX12_RESOURCE_DESC readbackDesc = CD3DX12_RESOURCE_DESC::Buffer(queryHeapDesc.Count * sizeof(UINT64));
+	ThrowIfFailed(device->CreateCommittedResource(
+		&readbackHeapProperties,
+		D3D12_HEAP_FLAG_NONE,
+		&readbackDesc,
+		D3D12_RESOURCE_STATE_COPY_DEST,
+		nullptr,
+		IID_PPV_ARGS(&readbackBuffer)),
+		L"Failed to create profiler readback buffer");
+	readbackBuffer->SetName(L"ProfilerTimestampReadback");
+}
+
+void RTGpuProfiler::BeginFrame(UINT frameIndex)
+{
+	ReadFrame(frameIndex);
+
+	FrameRecord& frame = frames[frameIndex];
+	frame.scopes.clear();
+	frame.queryCount = 0;
+	frame.resolved = false;
+
+	openScopes.clear();
+	recordingFrameIndex = frameIndex;
+	recording = true;
+}
+
+void RTGpuProfiler::BeginScope(ID3D12GraphicsCommandList* commandList, char const* name)
+{
+	if (!recording)
+	{
+		return;
+	}
+
+	FrameRecord& frame = frames[recordingFrameIndex];
+	ThrowIfFalse(frame.queryCount + 2 <= queriesPerFrame, L"Too many profiler scopes in one frame");
+
+	// Both queries are reserved up front, so nested scopes never share one.
+	UINT beginQuery = recordingFrameIndex * queriesPerFrame + frame.queryCount;
+	frame.scopes.push_back(Scope{ name, beginQuery, beginQuery + 1 });
+	frame.queryCount += 2;
+	openScopes.push_back(frame.scopes.size() - 1);
+
+	commandList->EndQuery(queryHeap.Get(), D3D12_QUERY_TYPE_TIMESTAMP, beginQuery);
+}
+
+void RTGpuProfiler::EndScope(ID3D12GraphicsCommandList* commandList)
+{
+	if (!recording)
+	{
+		return;
+	}
+
+	ThrowIfFalse(!openScopes.empty(), L"Profiler scope ended without being begun");
+
+	Scope const& scope = frames[recordingFrameIndex].scopes[openScopes.back()];
+	openScopes.pop_back();
+
+	commandList->EndQuery(queryHeap.Get(), D3D12_QUERY_TYPE_TIMESTAMP, scope.endQuery);
+}
+
+void RTGpuProfiler::EndFrame(ID3D12GraphicsCommandList* commandList)
+{
+	if (!recording)
+	{
+		return;
+	}
+
+	ThrowIfFalse(openScopes.empty(), L"Profiler scope still open at the end of the frame");
+	recording = false;
+
+	FrameRecord& frame = frames[recordingFrameIndex];
+	if (frame.queryCount == 0)
+	{
+		return;
+	}
+
+	UINT firstQuery = recordingFrameIndex * queriesPerFrame;
+	commandList->ResolveQueryData(queryHeap.Get(), D3D12_QUERY_TYPE_TIMESTAMP, firstQuery, frame.queryCount,
+		readbackBuffer.Get(), firstQuery * sizeof(UINT64));
+	frame.resolved = true;
+}
+
+void RTGpuProfiler::ReadFrame(UINT frameIndex)
+{
+	FrameRecord const& frame = frames[frameIndex];
+	if (!frame.resolved)
+	{
+		return;
+	}
+
+	// Only the frame's own range is read, the other ranges may still be written by the GPU.
+	UINT firstQuery = frameIndex * queriesPerFrame;
+	UINT64* timestamps;
+	CD3DX12_RANGE readRange(firstQuery * sizeof(UINT64), (firstQuery + frame.queryCount) * sizeof(UINT64));
+	ThrowIfFailed(readbackBuffer->Map(0, &readRange, reinterpret_cast<void**>(&timestamps)),
+		L"Failed to map profiler readback buffer");
+
+	double ticksPerMillisecond = static_cast<double>(timestampFrequency) / 1000.0;
+	for (Scope const& scope : frame.scopes)
+	{
+		UINT64 begin = timestamps[scope.beginQuery];
+		UINT64 end = timestamps[scope.endQuery];
+
+		// A disjoint timestamp pair, for example after a GPU clock change, is dropped rather than recorded as a huge duration.
+		if (end >= begin)
+		{
+			stats.AddSample(scope.name, static_cast<double>(end - begin) / ticksPerMillisecond);
+		}
+	}
+
+	CD3DX12_RANGE writeRange(0, 0);
+	readbackBuffer->Unmap(0, &writeRange);
+}
@@ -0,0 +1,68 @@
+#pragma once
+
+#include <wrl.h>
+#include <d3d12.h>
+#include <string>
+#include <vector>
+#include "../Core/RTTimingStats.h"
+
+/*
+	Measures the GPU time of named scopes of one queue's command lists with timestamp queries.
+	Each frame in flight has its own range of queries and of the readback buffer they are resolved into,
+	so a frame's timestamps are read once the frame using the same index has completed, without waiting
+	on the GPU. The durations feed rolling statistics, which also take samples measured elsewhere,
+	such as work on another queue or on the CPU.
+*/
+
+class RTGpuProfiler {
+
+public:
+	RTGpuProfiler(ID3D12Device* device, ID3D12CommandQueue* commandQueue, UINT frameCount, UINT maxScopesPerFrame = 16);
+
+	RTGpuProfiler(RTGpuProfiler const&) = delete;
+	RTGpuProfiler& operator =(RTGpuProfiler const&) = delete;
+
+	// Adds the scopes last recorded for frameIndex to the statistics and starts recording its new ones.
+	// The frame which last used frameIndex must have completed on the GPU.
+	void BeginFrame(UINT frameIndex);
+
+	// Bracket a named scope on a command list executed by the profiler's queue. Scopes may nest.
+	// Outside of BeginFrame() and EndFrame() nothing is recorded.
+	void BeginScope(ID3D12GraphicsCommandList* commandList, char const* name);
+	void EndScope(ID3D12GraphicsCommandList* commandList);
+
+	// Resolves the frame's timestamps into its readback range, after its last scope has ended.
+	void EndFrame(ID3D12GraphicsCommandList* commandList);
+
+	// Adds a duration measured elsewhere to the statistics.
+	void AddSample(std::string const& scope, double milliseconds) { stats.AddSample(scope, milliseconds); }
+
+	RTTimingStats const& GetStats() const { return stats; }
+
+private:
+	struct Scope {
+		std::string	name;
+		UINT		beginQuery;
+		UINT		endQuery;
+	};
+
+	struct FrameRecord {
+		std::vector<Scope>	scopes;
+		UINT				queryCount = 0;
+		bool				resolved = false;
+	};
+
+	void ReadFrame(UINT frameIndex);
+
+	Microsoft::WRL::ComPtr<ID3D12QueryHeap>		queryHeap;
+	Microsoft::WRL::ComPtr<ID3D12Resource>		readbackBuffer;
+	UINT64										timestampFrequency;
+	UINT										queriesPerFrame;
+
+	std::vector<FrameRecord>					frames;
+	std::vector<size_t>							openScopes;
+	UINT										recordingFrameIndex;
+	bool										recording;
+
+	RTTimingStats								stats;
+};
@@ -0,0 +1,75 @@
+#include "RTQueueTimer.h"
+#include "HrException.h"
+#include "d3dx12.h"
+
+RTQueueTimer::RTQueueTimer(ID3D12Device* device, ID3D12CommandQueue* commandQueue, UINT frameCount) :
+	commandQueue{ commandQueue },
+	timestampFrequency{ 0 },
+	recorded(frameCount, false)
+{
+	ThrowIfFailed(commandQueue->GetTimestampFrequency(&timestampFrequency),
+		L"Failed to get the queue timestamp frequency");
+
+	// Two timestamps per frame in flight, the start and the end of the span.
+	D3D12_QUERY_HEAP_DESC queryHeapDesc = {};
+	queryHeapDesc.Type = D3D12_QUERY_HEAP_TYPE_TIMESTAMP;
+	queryHeapDesc.Count = 2 * frameCount;
+	ThrowIfFailed(device->CreateQueryHeap(&queryHeapDesc, IID_PPV_ARGS(&queryHeap)),
+		L"Failed to create timestamp query heap");
+
+	CD3DX12_HEAP_PROPERTIES readbackHeapProperties(D3D12_HEAP_TYPE_READBACK);
+	CD3DX12_RESOURCE_DESC readbackDesc = CD3DX12_RESOURCE_DESC::Buffer(queryHeapDesc.Count * sizeof(UINT64));
+	ThrowIfFailed(device->CreateCommittedResource(
+		&readbackHeapProperties,
+		D3D12_HEAP_FLAG_NONE,
+		&readbackDesc,
+		D3D12_RESOURCE_STATE_COPY_DEST,
+		nullptr,
+		IID_PPV_ARGS(&readbackBuffer)),
+		L"Failed to create timestamp readback buffer");
+	readbackBuffer->SetName(L"QueueTimestampReadback");
+}
+
+void RTQueueTimer::Begin(ID3D12GraphicsCommandList* commandList, UINT frameIndex)
+{
+	commandList->EndQuery(queryHeap.Get(), D3D12_QUERY_TYPE_TIMESTAMP, 2 * frameIndex);
+}
+
+void RTQueueTimer::End(ID3D12GraphicsCommandList* commandList, UINT frameIndex)
+{
+	commandList->EndQuery(queryHeap.Get(), D3D12_QUERY_TYPE_TIMESTAMP, 2 * frameIndex + 1);
+	commandList->ResolveQueryData(queryHeap.Get(), D3D12_QUERY_TYPE_TIMESTAMP, 2 * frameIndex, 2, readbackBuffer.Get(), 2 * frameIndex * sizeof(UINT64));
+	recorded[frameIndex] = true;
+}
+
+bool RTQueueTimer::GetInterval(UINT frameIndex, RTQueueInterval& interval) const
+{
+	if (!recorded[frameIndex])
+	{
+		return false;
+	}
+
+	UINT64* timestamps;
+	CD3DX12_RANGE readRange(2 * frameIndex * sizeof(UINT64), (2 * frameIndex + 2) * sizeof(UINT64));
+	ThrowIfFailed(readbackBuffer->Map(0, &readRange, reinterpret_cast<void**>(&timestamps)),
+		L"Failed to map timestamp readback buffer");
+	UINT64 start = timestamps[2 * frameIndex];
+	UINT64 end = timestamps[2 * frameIndex + 1];
+	CD3DX12_RANGE writeRange(0, 0);
+	readbackBuffer->Unmap(0, &writeRange);
+
+	// The calibration samples the GPU and CPU clocks together, which maps the GPU ticks onto the CPU timeline.
+	UINT64 gpuCalibration;
+	UINT64 cpuCalibration;
+	ThrowIfFailed(commandQueue->GetClockCalibration(&gpuCalibration, &cpuCalibration),
+		L"Failed to calibrate the queue clock");
+
+	LARGE_INTEGER cpuFrequency;
+	QueryPerformanceFrequency(&cpuFrequency);
+
+	double cpuSeconds = static_cast<double>(cpuCalibration) / static_cast<double>(cpuFrequency.QuadPart);
+	double gpuFrequency = static_cast<double>(timestampFrequency);
+	interval.start = cpuSeconds + (static_cast<double>(start) - static_cast<double>(gpuCalibration)) / gpuFrequency;
+	interval.end = cpuSeconds + (static_cast<double>(end) - static_cast<double>(gpuCalibration)) / gpuFrequency;
+	return true;
+}
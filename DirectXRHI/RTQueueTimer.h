@@ -0,0 +1,43 @@
+#pragma once
+
+#include <wrl.h>
+#include <d3d12.h>
+#include <vector>
+
+/*
+	Measures when a span of one command queue's work ran on the GPU, once per frame in flight.
+	Timestamps are converted to seconds on the CPU's performance counter timeline through the queue's
+	clock calibration, so intervals measured on different queues can be compared to see how much
+	of their work overlapped.
+*/
+
+// Start and end of a span of GPU work, in seconds on the CPU's performance counter timeline.
+struct RTQueueInterval {
+	double start = 0.0;
+	double end = 0.0;
+
+	double Duration() const { return end - start; }
+};
+
+class RTQueueTimer {
+
+public:
+	RTQueueTimer(ID3D12Device* device, ID3D12CommandQueue* commandQueue, UINT frameCount);
+
+	RTQueueTimer(RTQueueTimer const&) = delete;
+	RTQueueTimer& operator =(RTQueueTimer const&) = delete;
+
+	// Record the start and end of the span measured for frameIndex, on command lists executed by the timer's queue.
+	void Begin(ID3D12GraphicsCommandList* commandList, UINT frameIndex);
+	void End(ID3D12GraphicsCommandList* commandList, UINT frameIndex);
+
+	// Reads the span last recorded for frameIndex, which must have completed on the GPU. Returns false if nothing was recorded.
+	bool GetInterval(UINT frameIndex, RTQueueInterval& interval) const;
+
+private:
+	Microsoft::WRL::ComPtr<ID3D12CommandQueue>	commandQueue;
+	Microsoft::WRL::ComPtr<ID3D12QueryHeap>		queryHeap;
+	Microsoft::WRL::ComPtr<ID3D12Resource>		readbackBuffer;
+	UINT64										timestampFrequency;
+	std::vector<bool>							recorded;
+};
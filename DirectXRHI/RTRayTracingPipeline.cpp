@@ -0,0 +1,300 @@
+#include "RTRayTracingPipeline.h"
+#include "HrException.h"
+#include "d3dx12.h"
+#include "../Shaders/CompiledShaders/RayGen.hlsl.h"
+#include "../Shaders/CompiledShaders/Hit.hlsl.h"
+#include "../Shaders/CompiledShaders/Miss.hlsl.h"
+#include "../Math/RTMath.h"
+#include "../Scene/RTScene.h"
+
+const wchar_t* RTRayTracingPipeline::c_rayGenShaderName = L"RayGen";
+const wchar_t* RTRayTracingPipeline::c_closestHitShaderName = L"ClosestHit";
+const wchar_t* RTRayTracingPipeline::c_missShaderName = L"Miss";
+const wchar_t* RTRayTracingPipeline::c_hitGroupName = L"HitGroup";
+
+namespace {
+
+	// Shader configuration of the pipeline, which is also part of the pipeline cache key.
+	// The payload is HitInfo of Common.hlsl, a colour and distance and a packed normal.
+	const UINT c_rayPayloadSize = sizeof(RTVector4D::RTVec4DImpl) + sizeof(UINT);
+	const UINT c_attributeSize = sizeof(RTVector2D::RTVec2DImpl);
+	const UINT c_maxRecursionDepth = 1;
+
+	RTPipelineCacheKey& AddWideString(RTPipelineCacheKey& key, wchar_t const* text)
+	{
+		return key.Add(text, wcslen(text) * sizeof(wchar_t));
+	}
+
+	// Adds everything a serialised root signature is made from.
+	void AddRootSignatureDesc(RTPipelineCacheKey& key, D3D12_ROOT_SIGNATURE_DESC const& desc)
+	{
+		key.AddValue(desc.NumParameters).AddValue(desc.NumStaticSamplers).AddValue(desc.Flags);
+
+		for (UINT i = 0; i < desc.NumParameters; ++i)
+		{
+			D3D12_ROOT_PARAMETER const& parameter = desc.pParameters[i];
+			key.AddValue(parameter.ParameterType).AddValue(parameter.ShaderVisibility);
+
+			switch (parameter.ParameterType)
+			{
+			case D3D12_ROOT_PARAMETER_TYPE_DESCRIPTOR_TABLE:
+				key.Add(parameter.DescriptorTable.pDescriptorRanges, parameter.DescriptorTable.NumDescriptorRanges * sizeof(D3D12_DESCRIPTOR_RANGE));
+				break;
+			case D3D12_ROOT_PARAMETER_TYPE_32BIT_CONSTANTS:
+				key.AddValue(parameter.Constants);
+				break;
+			default:
+				key.AddValue(parameter.Descriptor);
+				break;
+			}
+		}
+
+		key.Add(desc.pStaticSamplers, desc.NumStaticSamplers * sizeof(D3D12_STATIC_SAMPLER_DESC));
+	}
+}
+
+RTRayTracingPipeline::RTRayTracingPipeline(ID3D12Device5* device, IDXGIAdapter1* adapter, std::filesystem::path cachePath) :
+	device{ device },
+	rayGenShaderIdentifier{ nullptr },
+	missShaderIdentifier{ nullptr },
+	hitGroupShaderIdentifier{ nullptr },
+	pipelineCachePath{ std::move(cachePath) },
+	pipelineCacheChanged{ false }
+{
+	// Load the root signatures of earlier runs, if the shaders, the pipeline configuration and the driver are unchanged.
+	LoadPipelineCache(adapter);
+
+	// Create the global root signature used by the shaders.
+	CreateGlobalRootSignature();
+
+	// Create the local root signature of the hit group, whose arguments are stored in the shader records.
+	CreateLocalRootSignature();
+
+	// Create a raytracing pipeline state object which defines the binding of shaders, state and resources to be used during raytracing.
+	CreateStateObject();
+
+	// Store whatever had to be created from scratch for the next run.
+	SavePipelineCache();
+
+	// The identifiers point into the state object, so they stay valid for as long as it does.
+	Microsoft::WRL::ComPtr<ID3D12StateObjectProperties> stateObjectProperties;
+	ThrowIfFailed(stateObject.As(&stateObjectProperties));
+	rayGenShaderIdentifier = stateObjectProperties->GetShaderIdentifier(c_rayGenShaderName);
+	missShaderIdentifier = stateObjectProperties->GetShaderIdentifier(c_missShaderName);
+	hitGroupShaderIdentifier = stateObjectProperties->GetShaderIdentifier(c_hitGroupName);
+}
+
+void RTRayTracingPipeline::LoadPipelineCache(IDXGIAdapter1* adapter)
+{
+	// Everything the pipeline is created from goes into the key, so a cache written for other shaders,
+	// another configuration or another driver is never used.
+	RTPipelineCacheKey key;
+
+	// Shader bytecode and the names exported from it
+	key.Add(g_pRayGen, sizeof(g_pRayGen)).Add(g_pHit, sizeof(g_pHit)).Add(g_pMiss, sizeof(g_pMiss));
+	AddWideString(key, c_rayGenShaderName);
+	AddWideString(key, c_closestHitShaderName);
+	AddWideString(key, c_missShaderName);
+	AddWideString(key, c_hitGroupName);
+
+	// Subobject configuration, the root signatures are keyed by their own entries
+	key.AddValue(c_rayPayloadSize).AddValue(c_attributeSize).AddValue(c_maxRecursionDepth);
+
+	// Adapter identity
+	DXGI_ADAPTER_DESC1 adapterDesc = {};
+	ThrowIfFailed(adapter->GetDesc1(&adapterDesc));
+	key.AddValue(adapterDesc.VendorId).AddValue(adapterDesc.DeviceId).AddValue(adapterDesc.SubSysId).AddValue(adapterDesc.Revision);
+
+	// The user mode driver version is only reported through the DXGI device interface check. Without it a driver
+	// update couldn't be told apart from the driver which wrote the cache, so the cache file isn't used at all.
+	LARGE_INTEGER driverVersion = {};
+	if (FAILED(adapter->CheckInterfaceSupport(__uuidof(IDXGIDevice), &driverVersion)))
+	{
+		OutputDebugStringW(L"The driver version is unknown, the pipeline cache is disabled\n");
+		pipelineCachePath.clear();
+	}
+
+	pipelineCache.Reset(key.GetHash(), static_cast<uint64_t>(driverVersion.QuadPart));
+	pipelineCacheChanged = false;
+	if (!pipelineCachePath.empty())
+	{
+		pipelineCache.Load(pipelineCachePath);
+	}
+}
+
+void RTRayTracingPipeline::SavePipelineCache()
+{
+	if (pipelineCachePath.empty() || !pipelineCacheChanged)
+	{
+		return;
+	}
+
+	// A cache which can't be written only costs the next run its warm start.
+	if (!pipelineCache.Save(pipelineCachePath))
+	{
+		OutputDebugStringW((L"Failed to write the pipeline cache " + pipelineCachePath.wstring() + L"\n").c_str());
+	}
+}
+
+void RTRayTracingPipeline::CreateRootSignature(D3D12_ROOT_SIGNATURE_DESC const& desc, char const* cacheName, Microsoft::WRL::ComPtr<ID3D12RootSignature>& rootSignature)
+{
+	// The entry is named after the description, so a changed root signature never picks up a stale blob.
+	RTPipelineCacheKey descKey;
+	AddRootSignatureDesc(descKey, desc);
+	std::string entryName = std::string(cacheName) + "." + std::to_string(descKey.GetHash());
+
+	// A cached blob the device rejects is replaced, as if it had never been cached.
+	std::vector<uint8_t> const* cachedBlob = pipelineCache.FindBlob(entryName);
+	if (cachedBlob && SUCCEEDED(device->CreateRootSignature(1, cachedBlob->data(), cachedBlob->size(), IID_PPV_ARGS(&rootSignature))))
+	{
+		return;
+	}
+
+	// Serialise and create the root signature
+	Microsoft::WRL::ComPtr<ID3DBlob> serialisedRootSignature;
+	Microsoft::WRL::ComPtr<ID3DBlob> errorMessage;
+
+	ThrowIfFailed(D3D12SerializeRootSignature(&desc, D3D_ROOT_SIGNATURE_VERSION_1, &serialisedRootSignature, &errorMessage),
+		errorMessage ? static_cast<wchar_t*>(errorMessage->GetBufferPointer()) : nullptr);
+
+	ThrowIfFailed(device->CreateRootSignature(1, serialisedRootSignature->GetBufferPointer(), serialisedRootSignature->GetBufferSize(),
+		IID_PPV_ARGS(&rootSignature)));
+
+	uint8_t const* serialisedBytes = static_cast<uint8_t const*>(serialisedRootSignature->GetBufferPointer());
+	pipelineCache.SetBlob(entryName, std::vector<uint8_t>(serialisedBytes, serialisedBytes + serialisedRootSignature->GetBufferSize()));
+	pipelineCacheChanged = true;
+}
+
+void RTRayTracingPipeline::CreateGlobalRootSignature()
+{
+	// Global root parameters, which are shared between all shaders.
+	//	- Unordered Access View (UAV) descriptors for the ray tracing output and the accumulation texture.
+	//  - Constant Buffer View (CBC) desriptor for the scene transform data (MVP matrix).
+	//  - Shader Resource View (SRV) descritor for the acceleration structure
+	//  - Root constants for progressive accumulation
+	//  - Root constants for the integrator
+	// The geometry of each object is bound by the local root signature instead.
+
+	CD3DX12_ROOT_PARAMETER rootParameters[GlobalRootSignatureParams::Count];
+
+	// Output view slot
+	// The ray tracing result, the accumulation texture and the ray counters stored as UAV resources are bound to :register (u0, space0) to :register (u2, space0)
+	// Texture UAVs can't be root descriptors, so the output is bound through a descriptor table
+	CD3DX12_DESCRIPTOR_RANGE OutputViewDescriptor;
+	OutputViewDescriptor.Init(D3D12_DESCRIPTOR_RANGE_TYPE_UAV, 3, 0);
+	rootParameters[GlobalRootSignatureParams::OutputViewSlot].InitAsDescriptorTable(1, &OutputViewDescriptor);
+
+	// Constant buffer slot
+	// The constant buffer stored as CBV resource is bound to :register (b0, space0)
+	rootParameters[GlobalRootSignatureParams::ConstantBufferSlot].InitAsConstantBufferView(0);
+
+	// Acceleration structure slot
+	// The acceleration structure stored as SRV resource is bound to :register (t0, space0)
+	rootParameters[GlobalRootSignatureParams::AccelerationStructureSlot].InitAsShaderResourceView(0);
+
+	// Accumulation constants slot
+	// The sample index and count are bound to :register (b2, space0)
+	rootParameters[GlobalRootSignatureParams::AccumulationConstantsSlot].InitAsConstants(sizeof(AccumulationConstants) / sizeof(UINT), 2);
+
+	// Path tracing constants slot
+	// The integrator, bounce limit and samples per pixel are bound to :register (b3, space0)
+	rootParameters[GlobalRootSignatureParams::PathTracingConstantsSlot].InitAsConstants(sizeof(PathTracingConstants) / sizeof(UINT), 3);
+
+	// Create the global root signature with the list of descriptor tables as parameters.
+	CD3DX12_ROOT_SIGNATURE_DESC globalRootSignatureDesc(GlobalRootSignatureParams::Count, rootParameters);
+	CreateRootSignature(globalRootSignatureDesc, "GlobalRootSignature", globalRootSignature);
+}
+
+void RTRayTracingPipeline::CreateLocalRootSignature()
+{
+	// Local root parameters of the hit group, which differ from one hit group record to the next.
+	//	- Root constants for the object colour and the index size of its geometry
+	//	- Root Shader Resource Views (SRV) for the vertex and index buffers of its geometry
+	// Root descriptors need no descriptor heap entries, so every record can reference its own buffers.
+
+	CD3DX12_ROOT_PARAMETER rootParameters[LocalRootSignatureParams::Count];
+
+	// Object constants slot
+	// The constants are bound to :register (b1, space0)
+	UINT objectConstantCount = offsetof(HitGroupLocalArguments, padding) / sizeof(UINT);
+	rootParameters[LocalRootSignatureParams::ObjectConstantsSlot].InitAsConstants(objectConstantCount, 1);
+
+	// Vertex & Index buffer slots
+	// The SRVs are bound to :register (t1, space0) and :register (t2, space0)
+	rootParameters[LocalRootSignatureParams::VertexBufferSlot].InitAsShaderResourceView(1);
+	rootParameters[LocalRootSignatureParams::IndexBufferSlot].InitAsShaderResourceView(2);
+
+	CD3DX12_ROOT_SIGNATURE_DESC localRootSignatureDesc(LocalRootSignatureParams::Count, rootParameters);
+	localRootSignatureDesc.Flags = D3D12_ROOT_SIGNATURE_FLAG_LOCAL_ROOT_SIGNATURE;
+	CreateRootSignature(localRootSignatureDesc, "LocalRootSignature", localRootSignature);
+}
+
+void RTRayTracingPipeline::CreateStateObject()
+{
+	// A state object represents a variable amount of configuration state,
+	// including shaders, that an application manages as a single unit and
+	// which is given to a driver atomically to process (e.g. compile/optimize)
+    // however it sees fit. A state object is created via CreateStateObject() on a D3D12 device.
+
+	// The Pipeline State Object here is built using these subobjects:
+	// - DXIL library
+    // - Triangle hit group
+    // - Shader config
+    // - Local root signature and its association with the hit group
+    // - Global root signature
+    // - Pipeline config
+
+	CD3DX12_STATE_OBJECT_DESC raytracingPipeline{ D3D12_STATE_OBJECT_TYPE_RAYTRACING_PIPELINE };
+
+	// DXIL libraries
+	D3D12_SHADER_BYTECODE rayGenDXIL = CD3DX12_SHADER_BYTECODE((void*)g_pRayGen, ARRAYSIZE(g_pRayGen));
+	D3D12_SHADER_BYTECODE closestHitDXIL = CD3DX12_SHADER_BYTECODE((void*)g_pHit, ARRAYSIZE(g_pHit));
+	D3D12_SHADER_BYTECODE missDXIL = CD3DX12_SHADER_BYTECODE((void*)g_pMiss, ARRAYSIZE(g_pMiss));
+
+	// Raygen library
+	auto rayGenLib = raytracingPipeline.CreateSubobject<CD3DX12_DXIL_LIBRARY_SUBOBJECT>();
+	rayGenLib->SetDXILLibrary(&rayGenDXIL);
+	rayGenLib->DefineExport(c_rayGenShaderName);
+
+	// Closest hit library
+	auto closestHitLib = raytracingPipeline.CreateSubobject<CD3DX12_DXIL_LIBRARY_SUBOBJECT>();
+	closestHitLib->SetDXILLibrary(&closestHitDXIL);
+	closestHitLib->DefineExport(c_closestHitShaderName);
+
+	// Miss library
+	auto missLib = raytracingPipeline.CreateSubobject<CD3DX12_DXIL_LIBRARY_SUBOBJECT>();
+	missLib->SetDXILLibrary(&missDXIL);
+	missLib->DefineExport(c_missShaderName);
+
+	// Triangle hit group
+	auto hitGroup = raytracingPipeline.CreateSubobject<CD3DX12_HIT_GROUP_SUBOBJECT>();
+	hitGroup->SetClosestHitShaderImport(c_closestHitShaderName);
+	hitGroup->SetHitGroupExport(c_hitGroupName);
+	hitGroup->SetHitGroupType(D3D12_HIT_GROUP_TYPE_TRIANGLES);
+
+	// Shader config
+	auto shaderConfig = raytracingPipeline.CreateSubobject<CD3DX12_RAYTRACING_SHADER_CONFIG_SUBOBJECT>();
+
+	shaderConfig->Config(c_rayPayloadSize, c_attributeSize);
+
+	// Local root signature of the hit group
+	auto localRootSignatureSubobject = raytracingPipeline.CreateSubobject<CD3DX12_LOCAL_ROOT_SIGNATURE_SUBOBJECT>();
+	localRootSignatureSubobject->SetRootSignature(localRootSignature.Get());
+
+	auto localRootSignatureAssociation = raytracingPipeline.CreateSubobject<CD3DX12_SUBOBJECT_TO_EXPORTS_ASSOCIATION_SUBOBJECT>();
+	localRootSignatureAssociation->SetSubobjectToAssociate(*localRootSignatureSubobject);
+	localRootSignatureAssociation->AddExport(c_hitGroupName);
+
+	// Global root signature
+	auto globalRootSignatureSubobject = raytracingPipeline.CreateSubobject<CD3DX12_GLOBAL_ROOT_SIGNATURE_SUBOBJECT>();
+	globalRootSignatureSubobject->SetRootSignature(globalRootSignature.Get());
+
+	// Pipeline config
+	auto pipelineConfig = raytracingPipeline.CreateSubobject<CD3DX12_RAYTRACING_PIPELINE_CONFIG_SUBOBJECT>();
+
+	// Every ray, bounces and shadow rays included, is traced by the ray generation shader, so there is no recursion
+	pipelineConfig->Config(c_maxRecursionDepth);
+
+	// Create the state object
+	ThrowIfFailed(device->CreateStateObject(raytracingPipeline, IID_PPV_ARGS(&stateObject)), L"Couldn't create a DirectX Raytracing state object.\n");
+}
@@ -0,0 +1,99 @@
+#pragma once
+
+#include <wrl.h>
+#include <d3d12.h>
+#include <dxgi1_6.h>
+#include <filesystem>
+#include <string>
+#include "../RHI/RTPipelineCache.h"
+
+/*
+	The engine's DXR pipeline: the global root signature, the hit group's local root signature and the
+	state object linking the RayGen, ClosestHit and Miss shaders, shared by RTDXInterface and the D3D12
+	render device. The root signatures go through the on-disk pipeline cache, keyed on the shaders, the
+	pipeline configuration and the adapter, and discarded when the driver version changes. D3D12 can't
+	serialise a raytracing state object, so CreateStateObject() runs every launch, and is given the same
+	DXIL and root signatures as before so that the driver's own shader cache serves it.
+*/
+
+// The output view slot is a table of three UAVs, the output, the accumulation texture and the ray counters.
+enum GlobalRootSignatureParams {
+	OutputViewSlot = 0,
+	ConstantBufferSlot,
+	AccelerationStructureSlot,
+	AccumulationConstantsSlot,
+	PathTracingConstantsSlot,
+	Count
+};
+
+// Parameters of the hit group's local root signature, whose arguments are stored in each hit group record.
+namespace LocalRootSignatureParams {
+	enum Value {
+		ObjectConstantsSlot = 0,
+		VertexBufferSlot,
+		IndexBufferSlot,
+		Count
+	};
+}
+
+// Local root arguments of a hit group record, in the order of LocalRootSignatureParams.
+// Root constants take 4 bytes each and root descriptors start on an 8 byte boundary, hence the padding.
+struct HitGroupLocalArguments {
+	float						colour[4];
+	UINT						indexSizeInBytes;
+	UINT						padding;
+	D3D12_GPU_VIRTUAL_ADDRESS	vertexBuffer;
+	D3D12_GPU_VIRTUAL_ADDRESS	indexBuffer;
+};
+
+static_assert(sizeof(HitGroupLocalArguments) == 40, "Hit group local arguments must match the local root signature.");
+
+class RTRayTracingPipeline {
+
+public:
+	// Creates the pipeline for the device, loading and updating the cache file unless cachePath is empty.
+	RTRayTracingPipeline(ID3D12Device5* device, IDXGIAdapter1* adapter, std::filesystem::path cachePath);
+
+	RTRayTracingPipeline(RTRayTracingPipeline const&) = delete;
+	RTRayTracingPipeline& operator =(RTRayTracingPipeline const&) = delete;
+
+	ID3D12RootSignature* GetGlobalRootSignature() const { return globalRootSignature.Get(); }
+	ID3D12StateObject* GetStateObject() const { return stateObject.Get(); }
+
+	// Shader identifiers of the shader records, valid for the lifetime of the pipeline.
+	void const* GetRayGenShaderIdentifier() const { return rayGenShaderIdentifier; }
+	void const* GetMissShaderIdentifier() const { return missShaderIdentifier; }
+	void const* GetHitGroupShaderIdentifier() const { return hitGroupShaderIdentifier; }
+
+	// True when something had to be created from scratch and was written to the cache.
+	bool WasPipelineCacheUpdated() const { return pipelineCacheChanged; }
+
+	static const wchar_t*								c_rayGenShaderName;
+	static const wchar_t*								c_closestHitShaderName;
+	static const wchar_t*								c_missShaderName;
+	static const wchar_t*								c_hitGroupName;
+
+private:
+	void LoadPipelineCache(IDXGIAdapter1* adapter);
+	void SavePipelineCache();
+	void CreateRootSignature(D3D12_ROOT_SIGNATURE_DESC const& desc, char const* cacheName, Microsoft::WRL::ComPtr<ID3D12RootSignature>& rootSignature);
+	void CreateGlobalRootSignature();
+	void CreateLocalRootSignature();
+	void CreateStateObject();
+
+	Microsoft::WRL::ComPtr<ID3D12Device5>				device;
+	Microsoft::WRL::ComPtr<ID3D12StateObject>			stateObject;
+
+	// Root signatures
+	Microsoft::WRL::ComPtr<ID3D12RootSignature>			globalRootSignature;
+	Microsoft::WRL::ComPtr<ID3D12RootSignature>			localRootSignature;
+
+	void*												rayGenShaderIdentifier;
+	void*												missShaderIdentifier;
+	void*												hitGroupShaderIdentifier;
+
+	// Pipeline creation results of earlier runs, keyed on the shaders, the pipeline configuration and the driver
+	RTPipelineCache										pipelineCache;
+	std::filesystem::path								pipelineCachePath;
+	bool												pipelineCacheChanged;
+};
@@ -0,0 +1,97 @@
+#include "RTShaderTableBuilder.h"
+#include "HrException.h"
+#include "d3dx12.h"
+#include <cstring>
+
+static_assert(RTShaderIdentifierSize == D3D12_SHADER_IDENTIFIER_SIZE_IN_BYTES, "Shader identifier size doesn't match D3D12.");
+static_assert(RTShaderRecordAlignment == D3D12_RAYTRACING_SHADER_RECORD_BYTE_ALIGNMENT, "Shader record alignment doesn't match D3D12.");
+static_assert(RTShaderTableAlignment == D3D12_RAYTRACING_SHADER_TABLE_BYTE_ALIGNMENT, "Shader table alignment doesn't match D3D12.");
+
+RTShaderTableBuilder::RTShaderTableBuilder(ID3D12Device* device, UINT frameCount) :
+	device{ device },
+	image{ std::make_unique<RTShaderTableImage>(RTShaderTableLayout{}, frameCount) },
+	buffers{ frameCount },
+	lastUpdateSize{ 0 }
+{
+}
+
+void RTShaderTableBuilder::Reset(RTShaderTableDesc const& rayGen, RTShaderTableDesc const& miss, RTShaderTableDesc const& hitGroup)
+{
+	RTShaderTableLayout layout = RTShaderTablePlanner::Plan(rayGen, miss, hitGroup);
+	if (layout == image->GetLayout())
+	{
+		return;
+	}
+
+	image = std::make_unique<RTShaderTableImage>(layout, buffers.GetFrameCount());
+	buffers.Invalidate();
+}
+
+void RTShaderTableBuilder::SetRecord(RTShaderTableType type, UINT index, void const* shaderIdentifier, void const* localArguments, UINT localArgumentsSize)
+{
+	ThrowIfFalse(shaderIdentifier != nullptr, L"Shader record without a shader identifier");
+	image->SetRecord(type, index, shaderIdentifier, localArguments, localArgumentsSize);
+}
+
+void RTShaderTableBuilder::Update(UINT frameIndex)
+{
+	FrameBuffer& buffer = buffers[frameIndex];
+	UINT64 size = image->GetLayout().totalSize;
+
+	// The frame which last used this buffer has completed, so a stale one is replaced directly.
+	if (buffers.IsStale(frameIndex))
+	{
+		buffer = FrameBuffer{};
+		if (size > 0)
+		{
+			CD3DX12_HEAP_PROPERTIES uploadHeapProperties(D3D12_HEAP_TYPE_UPLOAD);
+			CD3DX12_RESOURCE_DESC bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(size);
+			ThrowIfFailed(device->CreateCommittedResource(
+				&uploadHeapProperties,
+				D3D12_HEAP_FLAG_NONE,
+				&bufferDesc,
+				D3D12_RESOURCE_STATE_GENERIC_READ,
+				nullptr,
+				IID_PPV_ARGS(&buffer.resource)),
+				L"Failed to create shader table buffer");
+			buffer.resource->SetName(L"ShaderTables");
+
+			// The buffer stays mapped for its lifetime, the CPU only ever writes to it.
+			CD3DX12_RANGE readRange(0, 0);
+			ThrowIfFailed(buffer.resource->Map(0, &readRange, reinterpret_cast<void**>(&buffer.mappedData)),
+				L"Failed to map shader table buffer");
+		}
+
+		image->InvalidateFrame(frameIndex);
+		buffers.MarkUpdated(frameIndex);
+	}
+
+	uint8_t* mappedData = buffer.mappedData;
+	lastUpdateSize = image->Flush(frameIndex, [mappedData](uint64_t offset, uint8_t const* data, uint64_t byteCount)
+		{
+			std::memcpy(mappedData + offset, data, static_cast<size_t>(byteCount));
+		});
+}
+
+void RTShaderTableBuilder::FillDispatchDesc(UINT frameIndex, D3D12_DISPATCH_RAYS_DESC& dispatchDesc) const
+{
+	FrameBuffer const& buffer = buffers[frameIndex];
+	ThrowIfFalse(buffer.resource != nullptr && !buffers.IsStale(frameIndex), L"Shader tables used before they were updated for the frame");
+
+	RTShaderTableLayout const& layout = image->GetLayout();
+	D3D12_GPU_VIRTUAL_ADDRESS baseAddress = buffer.resource->GetGPUVirtualAddress();
+
+	RTShaderTableRange const& rayGen = layout[RTShaderTableType::RayGen];
+	dispatchDesc.RayGenerationShaderRecord.StartAddress = baseAddress + rayGen.offset;
+	dispatchDesc.RayGenerationShaderRecord.SizeInBytes = rayGen.GetSize();
+
+	RTShaderTableRange const& miss = layout[RTShaderTableType::Miss];
+	dispatchDesc.MissShaderTable.StartAddress = baseAddress + miss.offset;
+	dispatchDesc.MissShaderTable.SizeInBytes = miss.GetSize();
+	dispatchDesc.MissShaderTable.StrideInBytes = miss.stride;
+
+	RTShaderTableRange const& hitGroup = layout[RTShaderTableType::HitGroup];
+	dispatchDesc.HitGroupTable.StartAddress = baseAddress + hitGroup.offset;
+	dispatchDesc.HitGroupTable.SizeInBytes = hitGroup.GetSize();
+	dispatchDesc.HitGroupTable.StrideInBytes = hitGroup.stride;
+}
@@ -0,0 +1,53 @@
+#pragma once
+
+#include <wrl.h>
+#include <d3d12.h>
+#include <memory>
+#include "../RHI/RTShaderTableLayout.h"
+#include "../RHI/RTFrameVersioning.h"
+
+/*
+	Shader tables of a ray tracing pipeline with any number of records and local root arguments.
+	All three tables live in one persistently mapped upload buffer per frame in flight. Records are set
+	on the CPU copy, and each frame's buffer is brought up to date when its frame comes round, copying only
+	the records which changed since, so moving one object's constants doesn't rewrite the whole table.
+*/
+
+class RTShaderTableBuilder {
+
+public:
+	RTShaderTableBuilder(ID3D12Device* device, UINT frameCount);
+
+	RTShaderTableBuilder(RTShaderTableBuilder const&) = delete;
+	RTShaderTableBuilder& operator =(RTShaderTableBuilder const&) = delete;
+
+	// Lays out the tables for the given record counts and local root argument sizes. The records are kept
+	// if the layout is unchanged, otherwise every record has to be set again and every buffer is replaced.
+	void Reset(RTShaderTableDesc const& rayGen, RTShaderTableDesc const& miss, RTShaderTableDesc const& hitGroup);
+
+	void SetRecord(RTShaderTableType type, UINT index, void const* shaderIdentifier, void const* localArguments = nullptr, UINT localArgumentsSize = 0);
+
+	// Brings the buffer of frameIndex up to date. The frame which last used frameIndex must have completed.
+	void Update(UINT frameIndex);
+
+	// Fills the shader table ranges of a dispatch with the buffer of frameIndex.
+	void FillDispatchDesc(UINT frameIndex, D3D12_DISPATCH_RAYS_DESC& dispatchDesc) const;
+
+	RTShaderTableLayout const& GetLayout() const { return image->GetLayout(); }
+
+	// Bytes copied into the frame's buffer by the last Update().
+	UINT64 GetLastUpdateSize() const { return lastUpdateSize; }
+
+private:
+	struct FrameBuffer {
+		Microsoft::WRL::ComPtr<ID3D12Resource>	resource;
+		uint8_t*								mappedData = nullptr;
+	};
+
+	Microsoft::WRL::ComPtr<ID3D12Device>	device;
+	std::unique_ptr<RTShaderTableImage>		image;
+
+	// A new layout invalidates every buffer, each one is replaced once its frame comes round.
+	RTFrameVersioned<FrameBuffer>			buffers;
+	UINT64									lastUpdateSize;
+};
@@ -0,0 +1,169 @@
+#include "RTTopLevelAccelerationStructure.h"
+#include "HrException.h"
+#include "d3dx12.h"
+#include <algorithm>
+#include <cstring>
+
+RTTopLevelAccelerationStructure::RTTopLevelAccelerationStructure(ID3D12Device5* device, UINT frameCount) :
+	device{ device },
+	accelerationStructures(frameCount),
+	resultSize{ 0 },
+	instanceBuffers(frameCount),
+	mappedInstances(frameCount, nullptr),
+	buildCount{ 0 },
+	frameCount{ frameCount },
+	builtInstanceCount{ 0 },
+	builtFrameIndex{ 0 },
+	rebuildRequired{ true },
+	lastBuildWasUpdate{ false }
+{
+}
+
+void RTTopLevelAccelerationStructure::Build(ID3D12GraphicsCommandList4* commandList, UINT frameIndex, std::vector<D3D12_RAYTRACING_INSTANCE_DESC> const& instances)
+{
+	// The frame which last used this slot has completed, and with it every build before it.
+	++buildCount;
+	if (buildCount > frameCount)
+	{
+		retired.Collect(buildCount - frameCount);
+	}
+
+	UINT instanceCount = static_cast<UINT>(instances.size());
+	CreateInstanceBuffer(instanceCount, frameIndex);
+	if (instanceCount > 0)
+	{
+		memcpy(mappedInstances[frameIndex], instances.data(), instanceCount * sizeof(D3D12_RAYTRACING_INSTANCE_DESC));
+	}
+
+	// An update may move, replace or mask instances, but the number of instances has to stay the same.
+	bool update = !rebuildRequired && instanceCount == builtInstanceCount;
+
+	D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_INPUTS inputs = {};
+	inputs.Type = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_TYPE_TOP_LEVEL;
+	inputs.DescsLayout = D3D12_ELEMENTS_LAYOUT_ARRAY;
+	inputs.NumDescs = instanceCount;
+	inputs.InstanceDescs = instanceBuffers[frameIndex]->GetGPUVirtualAddress();
+	inputs.Flags = D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_PREFER_FAST_TRACE | D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_ALLOW_UPDATE;
+
+	if (!update)
+	{
+		D3D12_RAYTRACING_ACCELERATION_STRUCTURE_PREBUILD_INFO prebuildInfo = {};
+		device->GetRaytracingAccelerationStructurePrebuildInfo(&inputs, &prebuildInfo);
+
+		// Updates use the same scratch buffer, so it is sized for whichever needs more.
+		resultSize = prebuildInfo.ResultDataMaxSizeInBytes;
+		CreateScratch(std::max<UINT64>(prebuildInfo.ScratchDataSizeInBytes, prebuildInfo.UpdateScratchDataSizeInBytes));
+	}
+	CreateAccelerationStructure(frameIndex);
+
+	D3D12_BUILD_RAYTRACING_ACCELERATION_STRUCTURE_DESC buildDesc = {};
+	buildDesc.DestAccelerationStructureData = accelerationStructures[frameIndex]->GetGPUVirtualAddress();
+	buildDesc.ScratchAccelerationStructureData = scratch->GetGPUVirtualAddress();
+	if (update)
+	{
+		// Refit the previous frame's structure into this frame's, which earlier frames may still be reading.
+		inputs.Flags |= D3D12_RAYTRACING_ACCELERATION_STRUCTURE_BUILD_FLAG_PERFORM_UPDATE;
+		buildDesc.SourceAccelerationStructureData = accelerationStructures[builtFrameIndex]->GetGPUVirtualAddress();
+	}
+	buildDesc.Inputs = inputs;
+
+	commandList->BuildRaytracingAccelerationStructure(&buildDesc, 0, nullptr);
+
+	// Rays traced later in the frame must see the finished structure, and the next build reuses the scratch buffer.
+	D3D12_RESOURCE_BARRIER uavBarriers[] = {
+		CD3DX12_RESOURCE_BARRIER::UAV(accelerationStructures[frameIndex].Get()),
+		CD3DX12_RESOURCE_BARRIER::UAV(scratch.Get())
+	};
+	commandList->ResourceBarrier(ARRAYSIZE(uavBarriers), uavBarriers);
+
+	builtInstanceCount = instanceCount;
+	builtFrameIndex = frameIndex;
+	rebuildRequired = false;
+	lastBuildWasUpdate = update;
+}
+
+void RTTopLevelAccelerationStructure::CreateScratch(UINT64 size)
+{
+	if (scratch && scratch->GetDesc().Width >= size)
+	{
+		return;
+	}
+
+	// Builds of earlier frames may still be using the current scratch buffer, so it is retired rather than released.
+	if (scratch)
+	{
+		retired.Retire(std::move(scratch), buildCount);
+	}
+
+	CD3DX12_HEAP_PROPERTIES defaultHeapProperties(D3D12_HEAP_TYPE_DEFAULT);
+	CD3DX12_RESOURCE_DESC scratchDesc = CD3DX12_RESOURCE_DESC::Buffer(size, D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+	ThrowIfFailed(device->CreateCommittedResource(
+		&defaultHeapProperties,
+		D3D12_HEAP_FLAG_NONE,
+		&scratchDesc,
+		D3D12_RESOURCE_STATE_UNORDERED_ACCESS,
+		nullptr,
+		IID_PPV_ARGS(&scratch)),
+		L"Failed to create TLAS scratch buffer");
+	scratch->SetName(L"TopLevelAccelerationStructureScratch");
+}
+
+void RTTopLevelAccelerationStructure::CreateAccelerationStructure(UINT frameIndex)
+{
+	Microsoft::WRL::ComPtr<ID3D12Resource>& accelerationStructure = accelerationStructures[frameIndex];
+	if (accelerationStructure && accelerationStructure->GetDesc().Width >= resultSize)
+	{
+		return;
+	}
+
+	// Only this frame slot traces against the structure, and its last frame has completed, so it can be released straight away.
+	accelerationStructure.Reset();
+
+	CD3DX12_HEAP_PROPERTIES defaultHeapProperties(D3D12_HEAP_TYPE_DEFAULT);
+	CD3DX12_RESOURCE_DESC bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(resultSize, D3D12_RESOURCE_FLAG_ALLOW_UNORDERED_ACCESS);
+	ThrowIfFailed(device->CreateCommittedResource(
+		&defaultHeapProperties,
+		D3D12_HEAP_FLAG_NONE,
+		&bufferDesc,
+		D3D12_RESOURCE_STATE_RAYTRACING_ACCELERATION_STRUCTURE,
+		nullptr,
+		IID_PPV_ARGS(&accelerationStructure)),
+		L"Failed to create TLAS buffer");
+	accelerationStructure->SetName(L"TopLevelAccelerationStructure");
+}
+
+void RTTopLevelAccelerationStructure::CreateInstanceBuffer(UINT instanceCount, UINT frameIndex)
+{
+	Microsoft::WRL::ComPtr<ID3D12Resource>& instanceBuffer = instanceBuffers[frameIndex];
+	UINT64 requiredSize = std::max<UINT64>(instanceCount, 1) * sizeof(D3D12_RAYTRACING_INSTANCE_DESC);
+	if (instanceBuffer && instanceBuffer->GetDesc().Width >= requiredSize)
+	{
+		return;
+	}
+
+	// Only this frame slot reads the buffer, and its last frame has completed, so it can be released straight away.
+	// The capacity doubles so a slowly growing scene doesn't reallocate every frame.
+	UINT64 size = requiredSize;
+	if (instanceBuffer)
+	{
+		size = std::max<UINT64>(size, instanceBuffer->GetDesc().Width * 2);
+		instanceBuffer->Unmap(0, nullptr);
+		instanceBuffer.Reset();
+	}
+
+	CD3DX12_HEAP_PROPERTIES uploadHeapProperties(D3D12_HEAP_TYPE_UPLOAD);
+	CD3DX12_RESOURCE_DESC bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(size);
+	ThrowIfFailed(device->CreateCommittedResource(
+		&uploadHeapProperties,
+		D3D12_HEAP_FLAG_NONE,
+		&bufferDesc,
+		D3D12_RESOURCE_STATE_GENERIC_READ,
+		nullptr,
+		IID_PPV_ARGS(&instanceBuffer)),
+		L"Failed to create instance descriptors buffer");
+	instanceBuffer->SetName(L"InstanceDescs");
+
+	CD3DX12_RANGE readRange(0, 0);
+	ThrowIfFailed(instanceBuffer->Map(0, &readRange, reinterpret_cast<void**>(&mappedInstances[frameIndex])),
+		L"Failed to map instance descriptors buffer");
+}
@@ -0,0 +1,67 @@
+#pragma once
+
+#include <wrl.h>
+#include <d3d12.h>
+#include <vector>
+#include "../RHI/RTFrameVersioning.h"
+
+/*
+	Top level acceleration structure which is rebuilt or updated every frame from a list of instances.
+	The instance descriptions and the structure itself are versioned per frame in flight, so neither
+	the CPU nor a build on another queue overwrites data an earlier frame is still tracing against.
+	When the instance count is unchanged the previous frame's structure is refitted into the current
+	one with PERFORM_UPDATE, which is much cheaper than a rebuild and keeps moving rigid objects at
+	frame rate. A change in the instance count, or ForceRebuild(), builds from scratch.
+	Buffers replaced when the scene grows are kept until their frame slot comes round again.
+*/
+
+class RTTopLevelAccelerationStructure {
+
+public:
+	RTTopLevelAccelerationStructure(ID3D12Device5* device, UINT frameCount);
+
+	RTTopLevelAccelerationStructure(RTTopLevelAccelerationStructure const&) = delete;
+	RTTopLevelAccelerationStructure& operator =(RTTopLevelAccelerationStructure const&) = delete;
+
+	// Writes the instances to the buffer of frameIndex and records an update, or a rebuild when the instance count changed.
+	// Must be called once per frame, after the frame of the previous use of frameIndex has completed on the GPU.
+	// The command list may belong to any queue which supports acceleration structure builds, but all builds must use the same one.
+	void Build(ID3D12GraphicsCommandList4* commandList, UINT frameIndex, std::vector<D3D12_RAYTRACING_INSTANCE_DESC> const& instances);
+
+	// Makes the next Build() a full rebuild, for example after the bottom level structures were replaced.
+	// Many updates over large motions degrade the trace performance, which a rebuild restores.
+	void ForceRebuild() { rebuildRequired = true; }
+
+	// Structure built for frameIndex, to trace against in that frame.
+	D3D12_GPU_VIRTUAL_ADDRESS GetGPUVirtualAddress(UINT frameIndex) const { return accelerationStructures[frameIndex]->GetGPUVirtualAddress(); }
+
+	// True when the last Build() refitted the structure rather than rebuilding it.
+	bool WasLastBuildUpdate() const { return lastBuildWasUpdate; }
+
+private:
+	void CreateScratch(UINT64 size);
+	void CreateAccelerationStructure(UINT frameIndex);
+	void CreateInstanceBuffer(UINT instanceCount, UINT frameIndex);
+
+	Microsoft::WRL::ComPtr<ID3D12Device5>								device;
+	Microsoft::WRL::ComPtr<ID3D12Resource>								scratch;
+
+	// One structure per frame in flight, each sized for the last rebuild
+	std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>>					accelerationStructures;
+	UINT64																resultSize;
+
+	// One persistently mapped instance buffer per frame in flight
+	std::vector<Microsoft::WRL::ComPtr<ID3D12Resource>>					instanceBuffers;
+	std::vector<D3D12_RAYTRACING_INSTANCE_DESC*>						mappedInstances;
+
+	// Resources replaced by a build, released once the frame of that build has completed. 
+	// Builds are counted rather than fenced, as every frame slot has completed when it is next built.
+	RTDeferredReleaseQueue<Microsoft::WRL::ComPtr<ID3D12Resource>>		retired;
+	UINT64																buildCount;
+	UINT																frameCount;
+
+	UINT																builtInstanceCount;
+	UINT																builtFrameIndex;
+	bool																rebuildRequired;
+	bool																lastBuildWasUpdate;
+};
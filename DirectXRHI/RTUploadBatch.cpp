@@ -0,0 +1,181 @@
+#include "RTUploadBatch.h"
+#include "HrException.h"
+#include "d3dx12.h"
+#include "../RHI/RTStagingPlanner.h"
+#include <algorithm>
+#include <cstring>
+#include <unordered_map>
+
+namespace {
+
+	// Staging offsets are kept 16 byte aligned so the copies into the mapped buffer stay aligned too.
+	constexpr UINT64 StagingAlignment = 16;
+}
+
+RTUploadBatch::RTUploadBatch(ID3D12Device* device, ID3D12CommandQueue* commandQueue, UINT64 stagingCapacity) :
+	device{ device },
+	commandQueue{ commandQueue },
+	fenceEvent{ nullptr },
+	fenceValue{ 0 },
+	mappedStaging{ nullptr },
+	stagingCapacity{ stagingCapacity },
+	lastSubmissionCount{ 0 }
+{
+	ThrowIfFailed(device->CreateCommandAllocator(D3D12_COMMAND_LIST_TYPE_DIRECT, IID_PPV_ARGS(&commandAllocator)));
+	ThrowIfFailed(device->CreateCommandList(0, D3D12_COMMAND_LIST_TYPE_DIRECT, commandAllocator.Get(), nullptr, IID_PPV_ARGS(&commandList)));
+	ThrowIfFailed(commandList->Close());
+
+	ThrowIfFailed(device->CreateFence(fenceValue, D3D12_FENCE_FLAG_NONE, IID_PPV_ARGS(&fence)));
+	fenceEvent = CreateEvent(nullptr, FALSE, FALSE, nullptr);
+	ThrowIfFalse(fenceEvent != nullptr, L"CreateEvent failed.\n");
+}
+
+RTUploadBatch::~RTUploadBatch()
+{
+	if (stagingBuffer)
+	{
+		stagingBuffer->Unmap(0, nullptr);
+	}
+	if (fenceEvent)
+	{
+		CloseHandle(fenceEvent);
+	}
+}
+
+Microsoft::WRL::ComPtr<ID3D12Resource> RTUploadBatch::CreateBuffer(void const* data, UINT64 size, D3D12_RESOURCE_STATES finalState, LPCWSTR name)
+{
+	Microsoft::WRL::ComPtr<ID3D12Resource> buffer;
+
+	CD3DX12_HEAP_PROPERTIES defaultHeapProperties(D3D12_HEAP_TYPE_DEFAULT);
+	CD3DX12_RESOURCE_DESC bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(size);
+	ThrowIfFailed(device->CreateCommittedResource(
+		&defaultHeapProperties,
+		D3D12_HEAP_FLAG_NONE,
+		&bufferDesc,
+		D3D12_RESOURCE_STATE_COPY_DEST,
+		nullptr,
+		IID_PPV_ARGS(&buffer)),
+		L"Failed to create default heap buffer");
+	buffer->SetName(name);
+
+	Upload(buffer.Get(), 0, data, size, finalState);
+	return buffer;
+}
+
+void RTUploadBatch::Upload(ID3D12Resource* destination, UINT64 destinationOffset, void const* data, UINT64 size, D3D12_RESOURCE_STATES finalState)
+{
+	pendingUploads.push_back(PendingUpload{ destination, destinationOffset, static_cast<UINT8 const*>(data), size, finalState });
+}
+
+void RTUploadBatch::Submit()
+{
+	// A buffer may receive several uploads, it is transitioned once after the last of them.
+	std::vector<uint64_t> uploadSizes;
+	std::unordered_map<ID3D12Resource*, size_t> lastUploadOf;
+	uploadSizes.reserve(pendingUploads.size());
+	for (size_t i = 0; i < pendingUploads.size(); ++i)
+	{
+		uploadSizes.push_back(pendingUploads[i].size);
+		lastUploadOf[pendingUploads[i].destination] = i;
+	}
+
+	// The staging buffer only grows as large as the uploads need, up to the capacity given on construction.
+	UINT64 stagingSize = 0;
+	for (uint64_t size : uploadSizes)
+	{
+		stagingSize += (size + StagingAlignment - 1) & ~(StagingAlignment - 1);
+	}
+	stagingSize = std::min<UINT64>(stagingSize, stagingCapacity);
+	if (stagingSize == 0)
+	{
+		pendingUploads.clear();
+		lastSubmissionCount = 0;
+		return;
+	}
+	CreateStagingBuffer(stagingSize);
+
+	std::vector<RTStagingBatch> batches = RTStagingPlanner::Plan(uploadSizes, stagingSize, StagingAlignment);
+
+	for (size_t batch = 0; batch < batches.size(); ++batch)
+	{
+		ThrowIfFailed(commandAllocator->Reset());
+		ThrowIfFailed(commandList->Reset(commandAllocator.Get(), nullptr));
+
+		std::vector<D3D12_RESOURCE_BARRIER> barriers;
+		for (RTStagingCopy const& copy : batches[batch].copies)
+		{
+			PendingUpload const& upload = pendingUploads[copy.uploadIndex];
+			memcpy(mappedStaging + copy.stagingOffset, upload.data + copy.sourceOffset, copy.size);
+
+			commandList->CopyBufferRegion(
+				upload.destination,
+				upload.destinationOffset + copy.sourceOffset,
+				stagingBuffer.Get(),
+				copy.stagingOffset,
+				copy.size);
+
+			// Pieces are planned in upload order, so this is the last copy into the destination.
+			bool isLastCopy = copy.sourceOffset + copy.size == upload.size && lastUploadOf[upload.destination] == copy.uploadIndex;
+			if (isLastCopy && upload.finalState != D3D12_RESOURCE_STATE_COPY_DEST)
+			{
+				barriers.push_back(CD3DX12_RESOURCE_BARRIER::Transition(upload.destination, D3D12_RESOURCE_STATE_COPY_DEST, upload.finalState));
+			}
+		}
+
+		// All transitions of a batch are issued together, after its copies.
+		if (!barriers.empty())
+		{
+			commandList->ResourceBarrier(static_cast<UINT>(barriers.size()), barriers.data());
+		}
+
+		ExecuteAndWait();
+	}
+
+	lastSubmissionCount = batches.size();
+	pendingUploads.clear();
+}
+
+void RTUploadBatch::CreateStagingBuffer(UINT64 size)
+{
+	if (stagingBuffer && stagingBuffer->GetDesc().Width >= size)
+	{
+		return;
+	}
+
+	if (stagingBuffer)
+	{
+		stagingBuffer->Unmap(0, nullptr);
+		stagingBuffer.Reset();
+	}
+
+	CD3DX12_HEAP_PROPERTIES uploadHeapProperties(D3D12_HEAP_TYPE_UPLOAD);
+	CD3DX12_RESOURCE_DESC stagingDesc = CD3DX12_RESOURCE_DESC::Buffer(size);
+	ThrowIfFailed(device->CreateCommittedResource(
+		&uploadHeapProperties,
+		D3D12_HEAP_FLAG_NONE,
+		&stagingDesc,
+		D3D12_RESOURCE_STATE_GENERIC_READ,
+		nullptr,
+		IID_PPV_ARGS(&stagingBuffer)),
+		L"Failed to create staging buffer");
+	stagingBuffer->SetName(L"StagingBuffer");
+
+	CD3DX12_RANGE readRange(0, 0);
+	ThrowIfFailed(stagingBuffer->Map(0, &readRange, reinterpret_cast<void**>(&mappedStaging)),
+		L"Failed to map staging buffer");
+}
+
+void RTUploadBatch::ExecuteAndWait()
+{
+	ThrowIfFailed(commandList->Close());
+	ID3D12CommandList* commandLists[] = { commandList.Get() };
+	commandQueue->ExecuteCommandLists(ARRAYSIZE(commandLists), commandLists);
+
+	// The staging buffer is reused by the next batch, so it has to be consumed first.
+	ThrowIfFailed(commandQueue->Signal(fence.Get(), ++fenceValue));
+	if (fence->GetCompletedValue() < fenceValue)
+	{
+		ThrowIfFailed(fence->SetEventOnCompletion(fenceValue, fenceEvent));
+		WaitForSingleObjectEx(fenceEvent, INFINITE, FALSE);
+	}
+}
@@ -0,0 +1,64 @@
+#pragma once
+
+#include <wrl.h>
+#include <d3d12.h>
+#include <vector>
+
+/*
+	Batches uploads of data into default heap buffers, which the GPU reads at full speed, unlike upload
+	heap memory which is read over the PCIe bus. Queued uploads are packed through a single staging
+	buffer by RTStagingPlanner, so many small meshes share one command list submission, and each
+	destination is transitioned to its final state after its last copy.
+	The batch records on its own command list, so it can be used while the frame command list is closed.
+*/
+
+class RTUploadBatch {
+
+public:
+	// The staging buffer is created on the first Submit(), sized for the queued uploads but no larger than stagingCapacity.
+	RTUploadBatch(ID3D12Device* device, ID3D12CommandQueue* commandQueue, UINT64 stagingCapacity = 16 * 1024 * 1024);
+	~RTUploadBatch();
+
+	RTUploadBatch(RTUploadBatch const&) = delete;
+	RTUploadBatch& operator =(RTUploadBatch const&) = delete;
+
+	// Creates a default heap buffer in the copy destination state and queues an upload of its contents.
+	Microsoft::WRL::ComPtr<ID3D12Resource> CreateBuffer(void const* data, UINT64 size, D3D12_RESOURCE_STATES finalState, LPCWSTR name);
+
+	// Queues a copy into a buffer which is in the copy destination state. The data must stay valid until Submit() returns.
+	// When a buffer receives several uploads, the final state of the last one queued is used.
+	void Upload(ID3D12Resource* destination, UINT64 destinationOffset, void const* data, UINT64 size, D3D12_RESOURCE_STATES finalState);
+
+	// Copies every queued upload, one submission per staging batch, and waits for the GPU to finish.
+	void Submit();
+
+	// Number of command list submissions made by the last Submit().
+	size_t GetLastSubmissionCount() const { return lastSubmissionCount; }
+
+private:
+	struct PendingUpload {
+		ID3D12Resource*			destination;
+		UINT64					destinationOffset;
+		UINT8 const*			data;
+		UINT64					size;
+		D3D12_RESOURCE_STATES	finalState;
+	};
+
+	void CreateStagingBuffer(UINT64 size);
+	void ExecuteAndWait();
+
+	Microsoft::WRL::ComPtr<ID3D12Device>				device;
+	Microsoft::WRL::ComPtr<ID3D12CommandQueue>			commandQueue;
+	Microsoft::WRL::ComPtr<ID3D12CommandAllocator>		commandAllocator;
+	Microsoft::WRL::ComPtr<ID3D12GraphicsCommandList>	commandList;
+	Microsoft::WRL::ComPtr<ID3D12Fence>					fence;
+	HANDLE												fenceEvent;
+	UINT64												fenceValue;
+
+	Microsoft::WRL::ComPtr<ID3D12Resource>				stagingBuffer;
+	UINT8*												mappedStaging;
+	UINT64												stagingCapacity;
+
+	std::vector<PendingUpload>							pendingUploads;
+	size_t												lastSubmissionCount;
+};
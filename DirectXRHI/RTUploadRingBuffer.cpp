@@ -0,0 +1,55 @@
+#include "RTUploadRingBuffer.h"
+#include "HrException.h"
+#include "d3dx12.h"
+
+RTUploadRingBuffer::RTUploadRingBuffer(ID3D12Device* device, UINT64 capacity, LPCWSTR name) :
+	mappedData{ nullptr },
+	gpuBaseAddress{ 0 },
+	allocator{ capacity }
+{
+	CD3DX12_HEAP_PROPERTIES uploadHeapProperties(D3D12_HEAP_TYPE_UPLOAD);
+	CD3DX12_RESOURCE_DESC bufferDesc = CD3DX12_RESOURCE_DESC::Buffer(capacity);
+
+	ThrowIfFailed(device->CreateCommittedResource(
+		&uploadHeapProperties,
+		D3D12_HEAP_FLAG_NONE,
+		&bufferDesc,
+		D3D12_RESOURCE_STATE_GENERIC_READ,
+		nullptr,
+		IID_PPV_ARGS(&buffer)),
+		L"Failed to create upload ring buffer");
+	buffer->SetName(name);
+
+	// Upload heaps may stay mapped for the lifetime of the resource, the CPU never reads from it.
+	CD3DX12_RANGE readRange(0, 0);
+	ThrowIfFailed(buffer->Map(0, &readRange, reinterpret_cast<void**>(&mappedData)),
+		L"Failed to map upload ring buffer");
+
+	gpuBaseAddress = buffer->GetGPUVirtualAddress();
+}
+
+RTUploadRingBuffer::~RTUploadRingBuffer()
+{
+	if (buffer)
+	{
+		buffer->Unmap(0, nullptr);
+	}
+}
+
+void RTUploadRingBuffer::BeginFrame(UINT64 completedFenceValue)
+{
+	allocator.ReleaseCompletedFrames(completedFenceValue);
+}
+
+void RTUploadRingBuffer::EndFrame(UINT64 fenceValue)
+{
+	allocator.FinishFrame(fenceValue);
+}
+
+RTUploadRingBuffer::Allocation RTUploadRingBuffer::Allocate(UINT64 size, UINT64 alignment)
+{
+	UINT64 offset = allocator.Allocate(size, alignment);
+	ThrowIfFalse(offset != RTRingAllocator::InvalidOffset, L"Upload ring buffer is full");
+
+	return Allocation{ mappedData + offset, gpuBaseAddress + offset, offset };
+}
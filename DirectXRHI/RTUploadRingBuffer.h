@@ -0,0 +1,54 @@
+#pragma once
+
+#include <wrl.h>
+#include <d3d12.h>
+#include <cstring>
+#include "../RHI/RTRingAllocator.h"
+
+/*
+	Persistently mapped upload heap buffer for data written by the CPU every frame, such as constant buffers.
+	Suballocations come from an RTRingAllocator and are recycled once the frame which used them has
+	completed on the GPU, so no resource is created or mapped while rendering.
+*/
+
+class RTUploadRingBuffer {
+
+public:
+	struct Allocation {
+		void*						cpuAddress;
+		D3D12_GPU_VIRTUAL_ADDRESS	gpuAddress;
+		UINT64						offset;
+	};
+
+	RTUploadRingBuffer(ID3D12Device* device, UINT64 capacity, LPCWSTR name);
+	~RTUploadRingBuffer();
+
+	RTUploadRingBuffer(RTUploadRingBuffer const&) = delete;
+	RTUploadRingBuffer& operator =(RTUploadRingBuffer const&) = delete;
+
+	// Releases the space of frames which the GPU has finished with. Call before the first allocation of a frame.
+	void BeginFrame(UINT64 completedFenceValue);
+
+	// Marks every allocation made since BeginFrame() as in use until the fence reaches fenceValue.
+	void EndFrame(UINT64 fenceValue);
+
+	// Throws if the ring is full, in which case the capacity is too small for the frames in flight.
+	Allocation Allocate(UINT64 size, UINT64 alignment = D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT);
+
+	// Allocates space for the data and copies it in.
+	template<typename T>
+	Allocation Upload(T const& data, UINT64 alignment = D3D12_CONSTANT_BUFFER_DATA_PLACEMENT_ALIGNMENT)
+	{
+		Allocation allocation = Allocate(sizeof(T), alignment);
+		memcpy(allocation.cpuAddress, &data, sizeof(T));
+		return allocation;
+	}
+
+	ID3D12Resource* GetResource() const { return buffer.Get(); }
+
+private:
+	Microsoft::WRL::ComPtr<ID3D12Resource>	buffer;
+	UINT8*									mappedData;
+	D3D12_GPU_VIRTUAL_ADDRESS				gpuBaseAddress;
+	RTRingAllocator							allocator;
+};
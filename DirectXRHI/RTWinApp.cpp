@@ -94,6 +94,13 @@ LRESULT CALLBACK RTWinApp::WindowProc(HWND ehwnd, UINT message, WPARAM wParam, L
 			}
 			return 0; 
 
+		case WM_KEYDOWN:
+			if (rtInterface)
+			{
+				rtInterface->OnKeyDown(static_cast<UINT8>(wParam));
+			}
+			return 0;
+
 		case WM_DESTROY:
 			PostQuitMessage(0);
 			return 0;
@@ -1,8 +1,94 @@
 #include "DirectXRHI/RTDXInterface.h"
 #include "DirectXRHI/RTWinApp.h"
+#include "DirectXRHI/RTD3D12RenderDevice.h"
+#include "SoftwareRHI/RTSoftwareRenderDevice.h"
+#include "App/RTHeadlessApp.h"
+#include "App/RTBenchmarks.h"
+#include <shellapi.h>
+#include <cstdio>
+#include <iostream>
+
+namespace {
+
+    // Splits the command line, without the program name, into UTF-8 arguments.
+    std::vector<std::string> GetArguments(PWSTR commandLine)
+    {
+        std::vector<std::string> arguments;
+        if (!commandLine || !*commandLine)
+        {
+            return arguments;
+        }
+
+        int argumentCount = 0;
+        LPWSTR* wideArguments = CommandLineToArgvW(commandLine, &argumentCount);
+        for (int i = 0; wideArguments && i < argumentCount; ++i)
+        {
+            int size = WideCharToMultiByte(CP_UTF8, 0, wideArguments[i], -1, nullptr, 0, nullptr, nullptr);
+            std::string argument(size > 0 ? size - 1 : 0, '\0');
+            if (size > 1)
+            {
+                WideCharToMultiByte(CP_UTF8, 0, wideArguments[i], -1, &argument[0], size, nullptr, nullptr);
+            }
+            arguments.push_back(std::move(argument));
+        }
+        LocalFree(wideArguments);
+        return arguments;
+    }
+
+    // The application is a Windows subsystem program, so output only shows when it is started
+    // from a console, whose streams are borrowed.
+    void AttachParentConsole()
+    {
+        if (AttachConsole(ATTACH_PARENT_PROCESS))
+        {
+            FILE* stream = nullptr;
+            freopen_s(&stream, "CONOUT$", "w", stdout);
+            freopen_s(&stream, "CONOUT$", "w", stderr);
+        }
+    }
+
+    // Renders without creating a window.
+    int RunHeadless(std::vector<std::string> const& arguments)
+    {
+        AttachParentConsole();
+
+        try
+        {
+            RTHeadlessOptions options = RTHeadlessApp::ParseCommandLine(arguments);
+
+            std::unique_ptr<RTRenderDevice> device;
+            if (options.software)
+            {
+                device = std::make_unique<RTSoftwareRenderDevice>();
+            }
+            else
+            {
+                device = std::make_unique<RTD3D12RenderDevice>();
+            }
+
+            return RTHeadlessApp::Run(options, *device);
+        }
+        catch (std::exception const& e)
+        {
+            std::cerr << e.what() << "\n" << RTHeadlessApp::GetUsage();
+            return 1;
+        }
+    }
+}
 
 int WINAPI wWinMain(HINSTANCE hInstance, HINSTANCE, PWSTR pCmdLine, int nCmdShow)
 {
+    std::vector<std::string> arguments = GetArguments(pCmdLine);
+    if (RTBenchmarks::IsBenchmark(arguments))
+    {
+        AttachParentConsole();
+        return RTBenchmarks::Run(arguments);
+    }
+    if (RTHeadlessApp::IsHeadless(arguments))
+    {
+        return RunHeadless(arguments);
+    }
+
     RTDXInterface rtInterface{ 1280, 720, L"D3D12 RTInterface Debug" };
 
     return RTWinApp::Run(&rtInterface, hInstance, nCmdShow);
@@ -0,0 +1,90 @@
+#include "RTBuildPlanner.h"
+#include <algorithm>
+#include <numeric>
+#include <stdexcept>
+
+namespace {
+
+	uint64_t AlignUp(uint64_t value, uint64_t alignment)
+	{
+		return (value + alignment - 1) & ~(alignment - 1);
+	}
+
+	bool IsPowerOfTwo(uint64_t value)
+	{
+		return value != 0 && (value & (value - 1)) == 0;
+	}
+}
+
+namespace RTBuildPlanner {
+
+	RTBuildPlan Plan(std::vector<RTBuildSizes> const& builds, uint64_t scratchPoolSize, uint64_t heapSize, uint64_t scratchAlignment, uint64_t resultAlignment)
+	{
+		if (!IsPowerOfTwo(scratchAlignment) || !IsPowerOfTwo(resultAlignment))
+		{
+			throw std::runtime_error("ERROR: Acceleration structure alignments must be powers of two.");
+		}
+
+		RTBuildPlan plan;
+		plan.resultPlacements.resize(builds.size());
+
+		// Results are placed in order, each in the first heap with room left, which keeps related structures together.
+		std::vector<uint64_t> heapUsed;
+		for (size_t build = 0; build < builds.size(); ++build)
+		{
+			uint64_t size = AlignUp(std::max<uint64_t>(builds[build].resultSize, 1), resultAlignment);
+
+			size_t heap = 0;
+			while (heap < heapUsed.size() && heapUsed[heap] + size > plan.heapSizes[heap])
+			{
+				++heap;
+			}
+			if (heap == heapUsed.size())
+			{
+				plan.heapSizes.push_back(std::max(AlignUp(heapSize, resultAlignment), size));
+				heapUsed.push_back(0);
+			}
+
+			plan.resultPlacements[build] = RTResultPlacement{ static_cast<uint32_t>(heap), heapUsed[heap] };
+			heapUsed[heap] += size;
+		}
+
+		// Batches are filled first fit, largest scratch first, which leaves the fewest batches and so the fewest barriers.
+		uint64_t largestScratch = 0;
+		for (RTBuildSizes const& sizes : builds)
+		{
+			largestScratch = std::max(largestScratch, AlignUp(sizes.scratchSize, scratchAlignment));
+		}
+		uint64_t poolSize = std::max(AlignUp(scratchPoolSize, scratchAlignment), largestScratch);
+
+		std::vector<uint32_t> order(builds.size());
+		std::iota(order.begin(), order.end(), 0u);
+		std::stable_sort(order.begin(), order.end(), [&](uint32_t a, uint32_t b) {
+			return builds[a].scratchSize > builds[b].scratchSize;
+		});
+
+		for (uint32_t build : order)
+		{
+			uint64_t size = AlignUp(builds[build].scratchSize, scratchAlignment);
+
+			auto batch = std::find_if(plan.batches.begin(), plan.batches.end(), [&](RTBuildBatch const& candidate) {
+				return candidate.scratchSize + size <= poolSize;
+			});
+			if (batch == plan.batches.end())
+			{
+				batch = plan.batches.insert(plan.batches.end(), RTBuildBatch{});
+			}
+
+			batch->builds.push_back(build);
+			batch->scratchOffsets.push_back(batch->scratchSize);
+			batch->scratchSize += size;
+		}
+
+		for (RTBuildBatch const& batch : plan.batches)
+		{
+			plan.scratchPoolSize = std::max(plan.scratchPoolSize, batch.scratchSize);
+		}
+
+		return plan;
+	}
+}
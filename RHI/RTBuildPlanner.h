@@ -0,0 +1,56 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+/*
+	Plans where many acceleration structure builds place their memory, independent of any graphics API.
+	Builds are grouped into batches whose scratch memory fits side by side in one shared scratch pool,
+	packing the largest first, so the builds of a batch can run concurrently without any barrier between
+	them. The pool is reused by the next batch, which is the only point a barrier on the scratch memory
+	is needed. Results are suballocated from large heaps rather than each getting its own allocation.
+*/
+
+// Memory requirements of one build, as reported by the prebuild info.
+struct RTBuildSizes {
+	uint64_t resultSize;
+	uint64_t scratchSize;
+};
+
+// Location of a build's result in the result heaps.
+struct RTResultPlacement {
+	uint32_t heapIndex;
+	uint64_t offset;
+};
+
+// Builds which share the scratch pool at the same time.
+struct RTBuildBatch {
+
+	// Indices of the builds in the list given to the planner, with the offset of each one's scratch memory in the pool.
+	std::vector<uint32_t> builds;
+	std::vector<uint64_t> scratchOffsets;
+
+	// Bytes of the scratch pool used by the batch, including alignment padding.
+	uint64_t scratchSize = 0;
+};
+
+struct RTBuildPlan {
+
+	// One entry per build, in the order given to the planner.
+	std::vector<RTResultPlacement> resultPlacements;
+
+	// Size of every result heap. A result larger than the heap size gets a heap of its own.
+	std::vector<uint64_t> heapSizes;
+
+	// Batches in submission order, each one must finish with its scratch memory before the next starts.
+	std::vector<RTBuildBatch> batches;
+
+	// Size the scratch pool needs, no larger than requested unless a single build needs more.
+	uint64_t scratchPoolSize = 0;
+};
+
+namespace RTBuildPlanner {
+
+	// Alignments must be powers of two. Scratch offsets are multiples of scratchAlignment, result offsets of resultAlignment.
+	RTBuildPlan Plan(std::vector<RTBuildSizes> const& builds, uint64_t scratchPoolSize, uint64_t heapSize, uint64_t scratchAlignment, uint64_t resultAlignment);
+}
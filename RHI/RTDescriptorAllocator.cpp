@@ -0,0 +1,138 @@
+#include "RTDescriptorAllocator.h"
+#include <iterator>
+#include <stdexcept>
+
+RTDescriptorAllocator::RTDescriptorAllocator(uint32_t transientCapacity, uint32_t persistentCapacity) :
+	transientRing{ transientCapacity },
+	transientCapacity{ transientCapacity },
+	persistentCapacity{ 0 },
+	freePersistentCount{ 0 }
+{
+	GrowPersistent(persistentCapacity);
+}
+
+RTDescriptorRange RTDescriptorAllocator::AllocatePersistent(uint32_t count)
+{
+	if (count == 0)
+	{
+		throw std::runtime_error("ERROR: Cannot allocate zero descriptors.");
+	}
+
+	// Best fit keeps the large blocks intact for large tables.
+	auto bestFit = freeBlocksBySize.lower_bound(count);
+	if (bestFit == freeBlocksBySize.end())
+	{
+		return RTDescriptorRange{};
+	}
+
+	uint32_t offset = bestFit->second;
+	uint32_t blockSize = bestFit->first;
+	RemoveFreeBlock(freeBlocksByOffset.find(offset));
+
+	if (blockSize > count)
+	{
+		AddFreeBlock(offset + count, blockSize - count);
+	}
+
+	freePersistentCount -= count;
+	return RTDescriptorRange{ offset, count };
+}
+
+void RTDescriptorAllocator::FreePersistent(RTDescriptorRange range, uint64_t fenceValue)
+{
+	if (!range.IsValid())
+	{
+		return;
+	}
+
+	if (range.offset < transientCapacity || range.offset + range.count > GetCapacity())
+	{
+		throw std::runtime_error("ERROR: Descriptor range is not in the persistent region.");
+	}
+
+	pendingFrees.push_back(PendingFree{ range, fenceValue });
+}
+
+void RTDescriptorAllocator::GrowPersistent(uint32_t newPersistentCapacity)
+{
+	if (newPersistentCapacity < persistentCapacity)
+	{
+		throw std::runtime_error("ERROR: The persistent descriptor region cannot shrink.");
+	}
+
+	uint32_t added = newPersistentCapacity - persistentCapacity;
+	if (added > 0)
+	{
+		AddFreeBlock(transientCapacity + persistentCapacity, added);
+		persistentCapacity = newPersistentCapacity;
+		freePersistentCount += added;
+	}
+}
+
+RTDescriptorRange RTDescriptorAllocator::AllocateTransient(uint32_t count)
+{
+	uint64_t offset = transientRing.Allocate(count, 1);
+	if (offset == RTRingAllocator::InvalidOffset)
+	{
+		return RTDescriptorRange{};
+	}
+
+	return RTDescriptorRange{ static_cast<uint32_t>(offset), count };
+}
+
+void RTDescriptorAllocator::FinishFrame(uint64_t fenceValue)
+{
+	transientRing.FinishFrame(fenceValue);
+}
+
+void RTDescriptorAllocator::ReleaseCompletedFrames(uint64_t completedFenceValue)
+{
+	transientRing.ReleaseCompletedFrames(completedFenceValue);
+
+	while (!pendingFrees.empty() && pendingFrees.front().fenceValue <= completedFenceValue)
+	{
+		RTDescriptorRange range = pendingFrees.front().range;
+		AddFreeBlock(range.offset, range.count);
+		freePersistentCount += range.count;
+		pendingFrees.pop_front();
+	}
+}
+
+void RTDescriptorAllocator::AddFreeBlock(uint32_t offset, uint32_t count)
+{
+	// Merge with the free blocks directly before and after the new one.
+	auto next = freeBlocksByOffset.lower_bound(offset);
+	if (next != freeBlocksByOffset.begin())
+	{
+		auto previous = std::prev(next);
+		if (previous->first + previous->second == offset)
+		{
+			offset = previous->first;
+			count += previous->second;
+			RemoveFreeBlock(previous);
+		}
+	}
+
+	if (next != freeBlocksByOffset.end() && offset + count == next->first)
+	{
+		count += next->second;
+		RemoveFreeBlock(next);
+	}
+
+	freeBlocksByOffset.emplace(offset, count);
+	freeBlocksBySize.emplace(count, offset);
+}
+
+void RTDescriptorAllocator::RemoveFreeBlock(std::map<uint32_t, uint32_t>::iterator block)
+{
+	auto sizeRange = freeBlocksBySize.equal_range(block->second);
+	for (auto it = sizeRange.first; it != sizeRange.second; ++it)
+	{
+		if (it->second == block->first)
+		{
+			freeBlocksBySize.erase(it);
+			break;
+		}
+	}
+	freeBlocksByOffset.erase(block);
+}
@@ -0,0 +1,72 @@
+#pragma once
+
+#include <cstdint>
+#include <deque>
+#include <map>
+#include "RTRingAllocator.h"
+
+/*
+	Bookkeeping for a descriptor heap split into two regions, independent of any graphics API.
+	The transient region comes first and holds descriptors written every frame. It is a ring, recycled
+	by fence value like RTRingAllocator. The persistent region follows it and holds descriptors which
+	live until freed. Those are managed with a best fit free list which coalesces neighbouring blocks.
+	The persistent region grows at the end, so transient and existing persistent indices never move.
+*/
+
+// Contiguous range of descriptors, addressed by index from the start of the heap.
+struct RTDescriptorRange {
+
+	static constexpr uint32_t InvalidOffset = ~uint32_t{ 0 };
+
+	bool IsValid() const { return offset != InvalidOffset; }
+
+	uint32_t offset = InvalidOffset;
+	uint32_t count = 0;
+};
+
+class RTDescriptorAllocator {
+
+public:
+	RTDescriptorAllocator(uint32_t transientCapacity, uint32_t persistentCapacity);
+
+	// Returns an invalid range if no free block is large enough, in which case the heap has to grow.
+	RTDescriptorRange AllocatePersistent(uint32_t count);
+
+	// The range becomes free again once the fence reaches fenceValue, as frames in flight may still use it.
+	void FreePersistent(RTDescriptorRange range, uint64_t fenceValue);
+
+	// Extends the persistent region to the new capacity, adding the new descriptors to the free list.
+	void GrowPersistent(uint32_t newPersistentCapacity);
+
+	// Returns an invalid range if the descriptors of the frames in flight fill the transient region.
+	RTDescriptorRange AllocateTransient(uint32_t count);
+
+	// Closes the current frame, its transient descriptors are recycled once the fence reaches fenceValue.
+	void FinishFrame(uint64_t fenceValue);
+
+	// Recycles the transient descriptors and completes the deferred frees of every frame up to completedFenceValue.
+	void ReleaseCompletedFrames(uint64_t completedFenceValue);
+
+	uint32_t GetCapacity() const { return transientCapacity + persistentCapacity; }
+	uint32_t GetTransientCapacity() const { return transientCapacity; }
+	uint32_t GetPersistentCapacity() const { return persistentCapacity; }
+	uint32_t GetFreePersistentCount() const { return freePersistentCount; }
+
+private:
+	struct PendingFree {
+		RTDescriptorRange range;
+		uint64_t fenceValue;
+	};
+
+	void AddFreeBlock(uint32_t offset, uint32_t count);
+	void RemoveFreeBlock(std::map<uint32_t, uint32_t>::iterator block);
+
+	// Free blocks of the persistent region, indexed by offset for coalescing and by size for best fit.
+	std::map<uint32_t, uint32_t>		freeBlocksByOffset;
+	std::multimap<uint32_t, uint32_t>	freeBlocksBySize;
+	std::deque<PendingFree>				pendingFrees;
+	RTRingAllocator						transientRing;
+	uint32_t							transientCapacity;
+	uint32_t							persistentCapacity;
+	uint32_t							freePersistentCount;
+};
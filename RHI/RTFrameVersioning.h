@@ -0,0 +1,90 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <utility>
+#include <vector>
+
+/*
+	Bookkeeping for data the CPU changes while earlier frames may still be executing on the GPU,
+	independent of any graphics API. Progress is measured in fence values, or any other counter which
+	only increases, such as a frame number.
+	RTDeferredReleaseQueue keeps objects retired while the GPU may still use them alive until the fence
+	value of the last frame to use them has completed.
+	RTFrameVersioned keeps one copy per frame in flight and tracks which copies are stale after the data
+	changed, so every copy is rewritten when its own frame comes round, rather than waiting for the GPU.
+*/
+
+template <typename T>
+class RTDeferredReleaseQueue {
+
+public:
+	// Keeps the object alive until fenceValue has completed. An older value than one retired before
+	// is treated as the newer one, which keeps the queue ordered and only ever delays a release.
+	void Retire(T object, uint64_t fenceValue)
+	{
+		if (!entries.empty() && fenceValue < entries.back().fenceValue)
+		{
+			fenceValue = entries.back().fenceValue;
+		}
+		entries.push_back(Entry{ fenceValue, std::move(object) });
+	}
+
+	// Releases every object whose fence value has completed, returning how many were released.
+	size_t Collect(uint64_t completedFenceValue)
+	{
+		size_t released = 0;
+		while (!entries.empty() && entries.front().fenceValue <= completedFenceValue)
+		{
+			entries.pop_front();
+			++released;
+		}
+		return released;
+	}
+
+	// Releases everything, once the GPU is idle.
+	void Flush() { entries.clear(); }
+
+	size_t GetPendingCount() const { return entries.size(); }
+
+private:
+	struct Entry {
+		uint64_t	fenceValue;
+		T			object;
+	};
+
+	std::deque<Entry> entries;
+};
+
+template <typename T>
+class RTFrameVersioned {
+
+public:
+	// Every version starts out stale, so each is written the first time its frame comes round.
+	explicit RTFrameVersioned(size_t frameCount) :
+		versions(frameCount),
+		versionGenerations(frameCount, 0),
+		generation{ 1 }
+	{
+	}
+
+	// Marks every version as stale, after the data they are copies of changed.
+	void Invalidate() { ++generation; }
+
+	// True when the version of frameIndex was written before the last Invalidate().
+	bool IsStale(size_t frameIndex) const { return versionGenerations[frameIndex] != generation; }
+
+	// Marks the version of frameIndex as up to date with the current data.
+	void MarkUpdated(size_t frameIndex) { versionGenerations[frameIndex] = generation; }
+
+	T& operator[](size_t frameIndex) { return versions[frameIndex]; }
+	T const& operator[](size_t frameIndex) const { return versions[frameIndex]; }
+
+	size_t GetFrameCount() const { return versions.size(); }
+
+private:
+	std::vector<T>			versions;
+	std::vector<uint64_t>	versionGenerations;
+	uint64_t				generation;
+};
@@ -0,0 +1,232 @@
+#include "RTPipelineCache.h"
+#include <fstream>
+#include <iterator>
+#include <system_error>
+
+namespace {
+
+	constexpr uint64_t FnvOffsetBasis = 14695981039346656037ull;
+	constexpr uint64_t FnvPrime = 1099511628211ull;
+
+	// "RTPC" read as a little endian 32 bit value
+	constexpr uint32_t CacheMagic = 0x43505452;
+
+	uint64_t Fnv1a(uint64_t hash, void const* data, size_t size)
+	{
+		uint8_t const* bytes = static_cast<uint8_t const*>(data);
+		for (size_t i = 0; i < size; ++i)
+		{
+			hash ^= bytes[i];
+			hash *= FnvPrime;
+		}
+		return hash;
+	}
+
+	void WriteUInt(std::vector<uint8_t>& bytes, uint64_t value, size_t size)
+	{
+		for (size_t i = 0; i < size; ++i)
+		{
+			bytes.push_back(static_cast<uint8_t>(value >> (8 * i)));
+		}
+	}
+
+	// Reads little endian values, failing rather than reading past the end of the data.
+	class Reader {
+
+	public:
+		Reader(uint8_t const* data, size_t size) : data{ data }, size{ size }, offset{ 0 } {}
+
+		bool ReadUInt(uint64_t& value, size_t byteCount)
+		{
+			if (size - offset < byteCount)
+			{
+				return false;
+			}
+			value = 0;
+			for (size_t i = 0; i < byteCount; ++i)
+			{
+				value |= static_cast<uint64_t>(data[offset + i]) << (8 * i);
+			}
+			offset += byteCount;
+			return true;
+		}
+
+		bool ReadBytes(uint8_t const*& bytes, uint64_t byteCount)
+		{
+			if (size - offset < byteCount)
+			{
+				return false;
+			}
+			bytes = data + offset;
+			offset += static_cast<size_t>(byteCount);
+			return true;
+		}
+
+		size_t GetOffset() const { return offset; }
+
+	private:
+		uint8_t const*	data;
+		size_t			size;
+		size_t			offset;
+	};
+}
+
+RTPipelineCacheKey::RTPipelineCacheKey() :
+	hash{ FnvOffsetBasis }
+{
+}
+
+RTPipelineCacheKey& RTPipelineCacheKey::Add(void const* data, size_t size)
+{
+	uint8_t sizeBytes[8];
+	for (size_t i = 0; i < sizeof(sizeBytes); ++i)
+	{
+		sizeBytes[i] = static_cast<uint8_t>(static_cast<uint64_t>(size) >> (8 * i));
+	}
+	hash = Fnv1a(hash, sizeBytes, sizeof(sizeBytes));
+	hash = Fnv1a(hash, data, size);
+	return *this;
+}
+
+RTPipelineCache::RTPipelineCache(uint64_t key, uint64_t driverVersion) :
+	key{ key },
+	driverVersion{ driverVersion }
+{
+}
+
+void RTPipelineCache::Reset(uint64_t newKey, uint64_t newDriverVersion)
+{
+	key = newKey;
+	driverVersion = newDriverVersion;
+	blobs.clear();
+}
+
+void RTPipelineCache::SetBlob(std::string const& name, std::vector<uint8_t> data)
+{
+	blobs[name] = std::move(data);
+}
+
+std::vector<uint8_t> const* RTPipelineCache::FindBlob(std::string const& name) const
+{
+	auto found = blobs.find(name);
+	return found != blobs.end() ? &found->second : nullptr;
+}
+
+std::vector<uint8_t> RTPipelineCache::Serialise() const
+{
+	// Header: magic, format version, key, driver version and blob count.
+	// Each blob: name size, name, data size, data. Then the checksum of everything before it.
+	std::vector<uint8_t> bytes;
+	WriteUInt(bytes, CacheMagic, 4);
+	WriteUInt(bytes, FormatVersion, 4);
+	WriteUInt(bytes, key, 8);
+	WriteUInt(bytes, driverVersion, 8);
+	WriteUInt(bytes, blobs.size(), 4);
+
+	for (auto const& blob : blobs)
+	{
+		WriteUInt(bytes, blob.first.size(), 4);
+		bytes.insert(bytes.end(), blob.first.begin(), blob.first.end());
+		WriteUInt(bytes, blob.second.size(), 8);
+		bytes.insert(bytes.end(), blob.second.begin(), blob.second.end());
+	}
+
+	WriteUInt(bytes, Fnv1a(FnvOffsetBasis, bytes.data(), bytes.size()), 8);
+	return bytes;
+}
+
+bool RTPipelineCache::Deserialise(uint8_t const* data, size_t size)
+{
+	blobs.clear();
+
+	// The checksum is verified before anything else is trusted, in particular the sizes inside the data.
+	if (size < 8)
+	{
+		return false;
+	}
+	size_t contentSize = size - 8;
+	Reader checksumReader(data + contentSize, 8);
+	uint64_t checksum = 0;
+	checksumReader.ReadUInt(checksum, 8);
+	if (checksum != Fnv1a(FnvOffsetBasis, data, contentSize))
+	{
+		return false;
+	}
+
+	Reader reader(data, contentSize);
+	uint64_t magic = 0;
+	uint64_t version = 0;
+	uint64_t fileKey = 0;
+	uint64_t fileDriverVersion = 0;
+	uint64_t blobCount = 0;
+	if (!reader.ReadUInt(magic, 4) || !reader.ReadUInt(version, 4) || !reader.ReadUInt(fileKey, 8) ||
+		!reader.ReadUInt(fileDriverVersion, 8) || !reader.ReadUInt(blobCount, 4) ||
+		magic != CacheMagic || version != FormatVersion || fileKey != key || fileDriverVersion != driverVersion)
+	{
+		return false;
+	}
+
+	std::map<std::string, std::vector<uint8_t>> readBlobs;
+	for (uint64_t blob = 0; blob < blobCount; ++blob)
+	{
+		uint64_t nameSize = 0;
+		uint64_t dataSize = 0;
+		uint8_t const* name = nullptr;
+		uint8_t const* blobData = nullptr;
+		if (!reader.ReadUInt(nameSize, 4) || !reader.ReadBytes(name, nameSize) ||
+			!reader.ReadUInt(dataSize, 8) || !reader.ReadBytes(blobData, dataSize))
+		{
+			return false;
+		}
+		readBlobs[std::string(reinterpret_cast<char const*>(name), static_cast<size_t>(nameSize))].assign(blobData, blobData + dataSize);
+	}
+
+	if (reader.GetOffset() != contentSize)
+	{
+		return false;
+	}
+
+	blobs = std::move(readBlobs);
+	return true;
+}
+
+bool RTPipelineCache::Load(std::filesystem::path const& path)
+{
+	std::ifstream file(path, std::ios::binary);
+	if (!file)
+	{
+		blobs.clear();
+		return false;
+	}
+
+	std::vector<uint8_t> bytes((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+	return Deserialise(bytes.data(), bytes.size());
+}
+
+bool RTPipelineCache::Save(std::filesystem::path const& path) const
+{
+	std::vector<uint8_t> bytes = Serialise();
+
+	std::filesystem::path temporaryPath = path;
+	temporaryPath += ".tmp";
+	{
+		std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+		file.write(reinterpret_cast<char const*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+		file.close();
+		if (!file)
+		{
+			std::error_code error;
+			std::filesystem::remove(temporaryPath, error);
+			return false;
+		}
+	}
+
+	std::error_code error;
+	std::filesystem::rename(temporaryPath, path, error);
+	if (error)
+	{
+		std::filesystem::remove(temporaryPath, error);
+		return false;
+	}
+	return true;
+}
@@ -0,0 +1,84 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <map>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+/*
+	On-disk cache of pipeline creation results, independent of any graphics API.
+	RTPipelineCacheKey hashes everything a pipeline is created from: shader bytecode, subobject configuration
+	and the adapter it was created for. A cache file holds named blobs under one key and the version of the
+	driver which wrote it, and is only used when both match, so any change to the inputs or a driver update
+	turns into a cache miss rather than a stale pipeline.
+	The file is little endian and checksummed; a missing, damaged or foreign file is treated as empty.
+*/
+
+// 64 bit FNV-1a hash of the fields added, in order.
+class RTPipelineCacheKey {
+
+public:
+	RTPipelineCacheKey();
+
+	// Adds a field. Each field is prefixed with its size, so the same bytes split into different fields hash differently.
+	RTPipelineCacheKey& Add(void const* data, size_t size);
+
+	template <typename T>
+	RTPipelineCacheKey& AddValue(T const& value)
+	{
+		static_assert(std::is_trivially_copyable<T>::value, "Only trivially copyable values can be hashed as bytes.");
+		return Add(&value, sizeof(T));
+	}
+
+	RTPipelineCacheKey& AddString(std::string const& text) { return Add(text.data(), text.size()); }
+
+	uint64_t GetHash() const { return hash; }
+
+private:
+	uint64_t hash;
+};
+
+class RTPipelineCache {
+
+public:
+	// Bumped whenever the file layout changes, which makes every existing file a miss.
+	static constexpr uint32_t FormatVersion = 2;
+
+	explicit RTPipelineCache(uint64_t key = 0, uint64_t driverVersion = 0);
+
+	uint64_t GetKey() const { return key; }
+	uint64_t GetDriverVersion() const { return driverVersion; }
+
+	// Replaces every blob, for a cache of different inputs or another driver.
+	void Reset(uint64_t newKey, uint64_t newDriverVersion);
+
+	void SetBlob(std::string const& name, std::vector<uint8_t> data);
+
+	// Returns nullptr if there is no blob of that name.
+	std::vector<uint8_t> const* FindBlob(std::string const& name) const;
+
+	size_t GetBlobCount() const { return blobs.size(); }
+
+	std::vector<uint8_t> Serialise() const;
+
+	// Replaces the blobs with those of a serialised cache. Returns false, leaving the cache empty,
+	// if the bytes are damaged or were written for another key, driver or format version.
+	bool Deserialise(uint8_t const* data, size_t size);
+
+	// A missing or unusable file is a cache miss, which returns false.
+	bool Load(std::filesystem::path const& path);
+
+	// Writes through a temporary file which then replaces the old one, so an interrupted write never leaves
+	// a partial cache behind. Returns false if the file couldn't be written, the cache being only an optimisation.
+	bool Save(std::filesystem::path const& path) const;
+
+private:
+	uint64_t										key;
+	uint64_t										driverVersion;
+
+	// Ordered, so the same blobs always serialise to the same bytes
+	std::map<std::string, std::vector<uint8_t>>		blobs;
+};
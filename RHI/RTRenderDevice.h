@@ -0,0 +1,168 @@
+#pragma once
+
+#include "../Scene/RTScene.h"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+/*
+	Graphics API independent interface to the engine's ray tracing pipeline, implemented by the D3D12 backend
+	in /DirectXRHI and by the CPU software backend in /SoftwareRHI.
+	Work is recorded on command lists and executed by the device's single queue in submission order, each
+	submission signalling a fence value once it has completed. As with D3D12, a command list must not be
+	reset, and a buffer, texture or acceleration structure it uses must not be rebuilt, read back or destroyed,
+	until the fence value of its last submission has been reached.
+	The pipeline itself is fixed: primary rays from the camera of SceneConstantBuffer, shaded by the ray
+	generation, closest hit and miss programs in /Shaders, so a dispatch only names its inputs and output.
+	A dispatch can also average its samples with those of earlier dispatches in an accumulation texture,
+	jittering each sample within its pixel, so a static view converges to an anti-aliased image.
+	Instead of shading the primary hits directly, a dispatch can path trace, counting the rays it traces at
+	every bounce in a ray counter buffer.
+*/
+
+enum class RTBufferUsage {
+	// Vertex or index data, read by acceleration structure builds and by hit shading
+	Geometry,
+	// Copy destination the CPU reads back through Map()
+	Readback,
+	// RayCounterCount 32 bit counters a dispatch overwrites with the number of rays it traced at every depth
+	RayCounters
+};
+
+struct RTBufferDesc {
+	uint64_t		size = 0;
+	RTBufferUsage	usage = RTBufferUsage::Geometry;
+};
+
+class RTBuffer {
+
+public:
+	virtual ~RTBuffer() = default;
+
+	virtual uint64_t GetSize() const = 0;
+
+	// Readback buffers only. The contents are those of the last completed submission which wrote the buffer.
+	virtual void const* Map() = 0;
+	virtual void Unmap() = 0;
+};
+
+// Output of a dispatch, RGBA with 8 bit unsigned normalised channels, or an accumulation texture,
+// RGBA with 32 bit float channels, which only dispatches read and write.
+class RTTexture {
+
+public:
+	virtual ~RTTexture() = default;
+
+	virtual uint32_t GetWidth() const = 0;
+	virtual uint32_t GetHeight() const = 0;
+};
+
+// Triangle list geometry of a bottom level structure. Vertices have the layout of Vertex, indices are 16 or 32 bits,
+// and a buffer of 16 bit indices is padded to a multiple of 4 bytes.
+struct RTGeometryDesc {
+	RTBuffer const*	vertexBuffer = nullptr;
+	uint32_t		vertexCount = 0;
+	RTBuffer const*	indexBuffer = nullptr;
+	uint32_t		indexCount = 0;
+	uint32_t		indexSizeInBytes = sizeof(uint32_t);
+};
+
+class RTAccelerationStructure {
+
+public:
+	virtual ~RTAccelerationStructure() = default;
+};
+
+// A placement of a bottom level structure in a top level one, shaded with its own colour.
+struct RTInstanceDesc {
+	RTAccelerationStructure const*	bottomLevel = nullptr;
+
+	// Top three rows of the row major object to world transform
+	float							transform[3][4] = {};
+	float							colour[4] = { 1.f, 1.f, 1.f, 1.f };
+};
+
+// Traces samples of every pixel of the output.
+struct RTDispatchRaysDesc {
+	RTAccelerationStructure const*	topLevel = nullptr;
+	RTTexture*						output = nullptr;
+	SceneConstantBuffer				sceneConstants;
+
+	// Needed when accumulationConstants.sampleCount isn't 0, and of the size of the output. Dispatches
+	// accumulating into the same texture must be submitted in order.
+	RTTexture*						accumulation = nullptr;
+	AccumulationConstants			accumulationConstants;
+
+	PathTracingConstants			pathTracingConstants;
+
+	// Optional, a ray counter buffer, which dispatches writing the same buffer must be submitted in order.
+	RTBuffer*						rayCounters = nullptr;
+};
+
+class RTCommandList {
+
+public:
+	virtual ~RTCommandList() = default;
+
+	// Clears the recorded commands. The last submission of the list must have completed.
+	virtual void Reset() = 0;
+
+	// Builds a structure created with RTRenderDevice::CreateBottomLevel() from its geometry.
+	virtual void BuildBottomLevel(RTAccelerationStructure& bottomLevel) = 0;
+
+	// Builds a structure created with RTRenderDevice::CreateTopLevel() over the instances, refitting it when
+	// only their transforms and colours changed since the last build. The instances are copied, so they may
+	// be transient data of the frame.
+	virtual void BuildTopLevel(RTAccelerationStructure& topLevel, RTInstanceDesc const* instances, size_t instanceCount) = 0;
+
+	// Commands recorded later see the finished output.
+	virtual void DispatchRays(RTDispatchRaysDesc const& desc) = 0;
+
+	// Copies an output texture into a readback buffer, with RTRenderDevice::GetReadbackRowPitch() bytes between rows.
+	virtual void CopyToReadback(RTTexture const& texture, RTBuffer& readback) = 0;
+
+	// Copies a ray counter buffer into a readback buffer at least as large.
+	virtual void CopyToReadback(RTBuffer const& buffer, RTBuffer& readback) = 0;
+};
+
+class RTFence {
+
+public:
+	virtual ~RTFence() = default;
+
+	virtual uint64_t GetCompletedValue() const = 0;
+
+	// Blocks until the fence has reached value.
+	virtual void Wait(uint64_t value) = 0;
+};
+
+class RTRenderDevice {
+
+public:
+	virtual ~RTRenderDevice() = default;
+
+	// Name of the backend, for logs.
+	virtual char const* GetName() const = 0;
+
+	// Geometry buffers are created with their contents, which are copied before this returns.
+	virtual std::unique_ptr<RTBuffer> CreateBuffer(RTBufferDesc const& desc, void const* initialData = nullptr) = 0;
+
+	virtual std::unique_ptr<RTTexture> CreateOutputTexture(uint32_t width, uint32_t height) = 0;
+	virtual std::unique_ptr<RTTexture> CreateAccumulationTexture(uint32_t width, uint32_t height) = 0;
+
+	// The geometry buffers must outlive the structure, hit shading reads them.
+	virtual std::unique_ptr<RTAccelerationStructure> CreateBottomLevel(RTGeometryDesc const& geometry) = 0;
+	virtual std::unique_ptr<RTAccelerationStructure> CreateTopLevel() = 0;
+
+	virtual std::unique_ptr<RTCommandList> CreateCommandList() = 0;
+	virtual std::unique_ptr<RTFence> CreateFence(uint64_t initialValue = 0) = 0;
+
+	// Executes the command list after everything submitted before it, then signals the fence to signalValue.
+	virtual void Submit(RTCommandList& commandList, RTFence& fence, uint64_t signalValue) = 0;
+
+	// Blocks until every submission has completed.
+	virtual void WaitForIdle() = 0;
+
+	// Bytes between the rows of a texture of the given width copied to a readback buffer.
+	virtual uint32_t GetReadbackRowPitch(uint32_t width) const = 0;
+};
@@ -0,0 +1,95 @@
+#include "RTRingAllocator.h"
+#include <stdexcept>
+
+namespace {
+
+	uint64_t AlignUp(uint64_t value, uint64_t alignment)
+	{
+		return (value + alignment - 1) & ~(alignment - 1);
+	}
+}
+
+RTRingAllocator::RTRingAllocator(uint64_t capacity) :
+	capacity{ capacity },
+	head{ 0 },
+	tail{ 0 },
+	usedSize{ 0 },
+	currentFrameSize{ 0 }
+{
+	if (capacity == 0)
+	{
+		throw std::runtime_error("ERROR: Ring allocator capacity must not be zero.");
+	}
+}
+
+uint64_t RTRingAllocator::Allocate(uint64_t size, uint64_t alignment)
+{
+	if (alignment == 0 || (alignment & (alignment - 1)) != 0)
+	{
+		throw std::runtime_error("ERROR: Ring allocator alignment must be a power of two.");
+	}
+
+	if (size == 0 || usedSize == capacity)
+	{
+		return InvalidOffset;
+	}
+
+	uint64_t alignedTail = AlignUp(tail, alignment);
+
+	// Free space is [tail, capacity) followed by [0, head) when the used range doesn't wrap,
+	// and [tail, head) when it does.
+	if (tail >= head)
+	{
+		if (alignedTail + size <= capacity)
+		{
+			uint64_t consumed = alignedTail + size - tail;
+			usedSize += consumed;
+			currentFrameSize += consumed;
+			tail = alignedTail + size;
+			return alignedTail;
+		}
+
+		// Skip the end of the buffer, the padding belongs to the current frame and is released with it.
+		if (size <= head)
+		{
+			uint64_t consumed = capacity - tail + size;
+			usedSize += consumed;
+			currentFrameSize += consumed;
+			tail = size;
+			return 0;
+		}
+	}
+	else if (alignedTail + size <= head)
+	{
+		uint64_t consumed = alignedTail + size - tail;
+		usedSize += consumed;
+		currentFrameSize += consumed;
+		tail = alignedTail + size;
+		return alignedTail;
+	}
+
+	return InvalidOffset;
+}
+
+void RTRingAllocator::FinishFrame(uint64_t fenceValue)
+{
+	pendingFrames.push_back(FrameMarker{ fenceValue, tail, currentFrameSize });
+	currentFrameSize = 0;
+}
+
+void RTRingAllocator::ReleaseCompletedFrames(uint64_t completedFenceValue)
+{
+	while (!pendingFrames.empty() && pendingFrames.front().fenceValue <= completedFenceValue)
+	{
+		FrameMarker const& frame = pendingFrames.front();
+		head = frame.tail;
+		usedSize -= frame.size;
+		pendingFrames.pop_front();
+	}
+
+	// An empty ring starts again from the beginning, which keeps large allocations from being split by the wrap.
+	if (pendingFrames.empty() && currentFrameSize == 0)
+	{
+		head = tail = 0;
+	}
+}
@@ -0,0 +1,51 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+
+/*
+	Fence aware linear ring allocator. It only hands out offsets into a range of the given capacity,
+	so it has no dependency on a graphics API and can back any persistently mapped buffer.
+	Allocations are made front to back and grouped per frame. A frame's space is recycled once the
+	GPU has signalled the fence value the frame was finished with.
+*/
+
+class RTRingAllocator {
+
+public:
+	static constexpr uint64_t InvalidOffset = ~uint64_t{ 0 };
+
+	explicit RTRingAllocator(uint64_t capacity);
+
+	// Returns the offset of size bytes aligned to alignment, which must be a power of two,
+	// or InvalidOffset if the space isn't free yet.
+	uint64_t Allocate(uint64_t size, uint64_t alignment);
+
+	// Closes the current frame, its allocations are released once the fence reaches fenceValue.
+	// Fence values must increase from one frame to the next.
+	void FinishFrame(uint64_t fenceValue);
+
+	// Releases every finished frame whose fence value is at most completedFenceValue.
+	void ReleaseCompletedFrames(uint64_t completedFenceValue);
+
+	uint64_t GetCapacity() const { return capacity; }
+	uint64_t GetUsedSize() const { return usedSize; }
+
+	// Number of finished frames still waiting on the GPU.
+	size_t GetPendingFrameCount() const { return pendingFrames.size(); }
+
+private:
+	struct FrameMarker {
+		uint64_t fenceValue;
+		uint64_t tail;
+		uint64_t size;
+	};
+
+	std::deque<FrameMarker>	pendingFrames;
+	uint64_t				capacity;
+	uint64_t				head;
+	uint64_t				tail;
+	uint64_t				usedSize;
+	uint64_t				currentFrameSize;
+};
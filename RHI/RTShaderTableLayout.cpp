@@ -0,0 +1,149 @@
+#include "RTShaderTableLayout.h"
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+	uint64_t AlignUp(uint64_t value, uint64_t alignment)
+	{
+		return (value + alignment - 1) & ~(alignment - 1);
+	}
+}
+
+bool RTShaderTableLayout::operator ==(RTShaderTableLayout const& other) const
+{
+	for (size_t table = 0; table < static_cast<size_t>(RTShaderTableType::Count); ++table)
+	{
+		if (tables[table].offset != other.tables[table].offset ||
+			tables[table].stride != other.tables[table].stride ||
+			tables[table].recordCount != other.tables[table].recordCount)
+		{
+			return false;
+		}
+	}
+	return totalSize == other.totalSize;
+}
+
+namespace RTShaderTablePlanner {
+
+	RTShaderTableLayout Plan(RTShaderTableDesc const& rayGen, RTShaderTableDesc const& miss, RTShaderTableDesc const& hitGroup)
+	{
+		// The ray generation record is passed to a dispatch on its own, so the table holds exactly one.
+		if (rayGen.recordCount > 1)
+		{
+			throw std::runtime_error("ERROR: A shader table layout has at most one ray generation record.");
+		}
+
+		RTShaderTableDesc const* descs[] = { &rayGen, &miss, &hitGroup };
+
+		RTShaderTableLayout layout;
+		uint64_t offset = 0;
+		for (size_t table = 0; table < static_cast<size_t>(RTShaderTableType::Count); ++table)
+		{
+			RTShaderTableRange& range = layout.tables[table];
+			range.offset = AlignUp(offset, RTShaderTableAlignment);
+			range.stride = AlignUp(uint64_t{ RTShaderIdentifierSize } + descs[table]->localArgumentsSize, RTShaderRecordAlignment);
+			range.recordCount = descs[table]->recordCount;
+
+			// An empty table takes no space, so the next one may start at the same offset.
+			if (range.recordCount > 0)
+			{
+				offset = range.offset + range.GetSize();
+			}
+		}
+
+		layout.totalSize = offset;
+		return layout;
+	}
+
+	std::vector<uint32_t> AssignHitGroupOffsets(std::vector<uint32_t> const& instanceGeometryCounts, uint32_t rayTypeCount, uint32_t& recordCount)
+	{
+		if (rayTypeCount == 0)
+		{
+			throw std::runtime_error("ERROR: Hit groups need at least one ray type.");
+		}
+
+		// InstanceContributionToHitGroupIndex has 24 bits.
+		const uint64_t maxOffset = (uint64_t{ 1 } << 24) - 1;
+
+		std::vector<uint32_t> offsets(instanceGeometryCounts.size());
+		uint64_t next = 0;
+		for (size_t instance = 0; instance < instanceGeometryCounts.size(); ++instance)
+		{
+			if (next > maxOffset)
+			{
+				throw std::runtime_error("ERROR: Too many hit group records for InstanceContributionToHitGroupIndex.");
+			}
+			offsets[instance] = static_cast<uint32_t>(next);
+			next += uint64_t{ instanceGeometryCounts[instance] } * rayTypeCount;
+		}
+
+		if (next > UINT32_MAX)
+		{
+			throw std::runtime_error("ERROR: Too many hit group records.");
+		}
+		recordCount = static_cast<uint32_t>(next);
+		return offsets;
+	}
+}
+
+RTShaderTableImage::RTShaderTableImage(RTShaderTableLayout const& layout, size_t frameCount) :
+	layout{ layout },
+	bytes(static_cast<size_t>(layout.totalSize), 0),
+	frameGenerations(frameCount, 0),
+	generation{ 1 }
+{
+	for (size_t table = 0; table < static_cast<size_t>(RTShaderTableType::Count); ++table)
+	{
+		RTShaderTableRange const& range = layout.tables[table];
+		firstRecords[table] = static_cast<uint32_t>(recordOffsets.size());
+		for (uint32_t record = 0; record < range.recordCount; ++record)
+		{
+			recordOffsets.push_back(range.GetRecordOffset(record));
+		}
+	}
+	recordOffsets.push_back(layout.totalSize);
+
+	// Every record starts out changed, so the first Flush() of each frame writes the whole buffer.
+	recordGenerations.assign(recordOffsets.size() - 1, generation);
+}
+
+void RTShaderTableImage::SetRecord(RTShaderTableType type, uint32_t index, void const* shaderIdentifier, void const* localArguments, uint32_t localArgumentsSize)
+{
+	RTShaderTableRange const& range = layout[type];
+	if (index >= range.recordCount)
+	{
+		throw std::runtime_error("ERROR: Shader record index is outside of its table.");
+	}
+	if (RTShaderIdentifierSize + uint64_t{ localArgumentsSize } > range.stride)
+	{
+		throw std::runtime_error("ERROR: Local root arguments are larger than the shader record.");
+	}
+
+	// The record is assembled first, so an unchanged record is recognised with a single comparison.
+	uint8_t record[256];
+	std::vector<uint8_t> largeRecord;
+	uint8_t* recordBytes = record;
+	if (range.stride > sizeof(record))
+	{
+		largeRecord.resize(static_cast<size_t>(range.stride));
+		recordBytes = largeRecord.data();
+	}
+
+	size_t stride = static_cast<size_t>(range.stride);
+	std::memset(recordBytes, 0, stride);
+	std::memcpy(recordBytes, shaderIdentifier, RTShaderIdentifierSize);
+	if (localArgumentsSize > 0)
+	{
+		std::memcpy(recordBytes + RTShaderIdentifierSize, localArguments, localArgumentsSize);
+	}
+
+	uint8_t* destination = bytes.data() + range.GetRecordOffset(index);
+	if (std::memcmp(destination, recordBytes, stride) == 0)
+	{
+		return;
+	}
+
+	std::memcpy(destination, recordBytes, stride);
+	recordGenerations[firstRecords[static_cast<size_t>(type)] + index] = ++generation;
+}
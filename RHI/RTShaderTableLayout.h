@@ -0,0 +1,133 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*
+	Layout of the ray generation, miss and hit group shader tables in one buffer, independent of any graphics API.
+	A record is a shader identifier followed by that shader's local root arguments. Every record of a table
+	shares one stride, rounded up to the record alignment, and every table starts on the table alignment.
+	RTShaderTableImage keeps the CPU copy of the records. Each frame in flight has its own buffer, and only
+	the records changed since a buffer was last brought up to date are copied into it.
+*/
+
+// Sizes and alignments required by DXR, the D3D12_SHADER_IDENTIFIER_SIZE_IN_BYTES,
+// D3D12_RAYTRACING_SHADER_RECORD_BYTE_ALIGNMENT and D3D12_RAYTRACING_SHADER_TABLE_BYTE_ALIGNMENT constants.
+constexpr uint32_t RTShaderIdentifierSize = 32;
+constexpr uint32_t RTShaderRecordAlignment = 32;
+constexpr uint32_t RTShaderTableAlignment = 64;
+
+enum class RTShaderTableType {
+	RayGen = 0,
+	Miss,
+	HitGroup,
+	Count
+};
+
+// Number of records of a table, and the largest local root arguments of any of them.
+struct RTShaderTableDesc {
+	uint32_t recordCount = 0;
+	uint32_t localArgumentsSize = 0;
+};
+
+// Where a table is in the buffer.
+struct RTShaderTableRange {
+	uint64_t offset = 0;
+	uint64_t stride = 0;
+	uint32_t recordCount = 0;
+
+	uint64_t GetSize() const { return stride * recordCount; }
+	uint64_t GetRecordOffset(uint32_t index) const { return offset + stride * index; }
+};
+
+struct RTShaderTableLayout {
+	RTShaderTableRange tables[static_cast<size_t>(RTShaderTableType::Count)];
+	uint64_t totalSize = 0;
+
+	RTShaderTableRange const& operator[](RTShaderTableType type) const { return tables[static_cast<size_t>(type)]; }
+
+	bool operator ==(RTShaderTableLayout const& other) const;
+	bool operator !=(RTShaderTableLayout const& other) const { return !(*this == other); }
+};
+
+namespace RTShaderTablePlanner {
+
+	// Places the tables one after another, in the order of RTShaderTableType.
+	RTShaderTableLayout Plan(RTShaderTableDesc const& rayGen, RTShaderTableDesc const& miss, RTShaderTableDesc const& hitGroup);
+
+	// Gives every instance consecutive hit group records, one per ray type for each of its geometries, and returns the
+	// index of each instance's first record, its InstanceContributionToHitGroupIndex. Shaders then trace with the
+	// ray type as the ray contribution and rayTypeCount as the geometry multiplier.
+	std::vector<uint32_t> AssignHitGroupOffsets(std::vector<uint32_t> const& instanceGeometryCounts, uint32_t rayTypeCount, uint32_t& recordCount);
+}
+
+class RTShaderTableImage {
+
+public:
+	RTShaderTableImage(RTShaderTableLayout const& layout, size_t frameCount);
+
+	// Writes the identifier, RTShaderIdentifierSize bytes, and the local root arguments of a record.
+	// A record whose bytes don't change isn't copied to the frames' buffers again.
+	void SetRecord(RTShaderTableType type, uint32_t index, void const* shaderIdentifier, void const* localArguments, uint32_t localArgumentsSize);
+
+	// Calls write(offset, data, size) for every run of consecutive records changed since the buffer of frameIndex
+	// was last brought up to date, then marks it up to date. Returns the number of bytes written.
+	template <typename TWrite>
+	uint64_t Flush(size_t frameIndex, TWrite const& write);
+
+	// Makes the next Flush() of frameIndex write every record, after its buffer was replaced.
+	void InvalidateFrame(size_t frameIndex) { frameGenerations[frameIndex] = 0; }
+
+	RTShaderTableLayout const& GetLayout() const { return layout; }
+	std::vector<uint8_t> const& GetBytes() const { return bytes; }
+
+private:
+	RTShaderTableLayout		layout;
+	std::vector<uint8_t>	bytes;
+
+	// Records of all tables in layout order, each with the generation it last changed in.
+	// The offsets have one more entry, the end of the last record.
+	std::vector<uint64_t>	recordGenerations;
+	std::vector<uint64_t>	recordOffsets;
+	uint32_t				firstRecords[static_cast<size_t>(RTShaderTableType::Count)];
+
+	// Generation each frame's buffer was last brought up to date with
+	std::vector<uint64_t>	frameGenerations;
+	uint64_t				generation;
+};
+
+template <typename TWrite>
+uint64_t RTShaderTableImage::Flush(size_t frameIndex, TWrite const& write)
+{
+	uint64_t& frameGeneration = frameGenerations[frameIndex];
+	if (frameGeneration == generation)
+	{
+		return 0;
+	}
+
+	uint64_t written = 0;
+	size_t record = 0;
+	while (record < recordGenerations.size())
+	{
+		if (recordGenerations[record] <= frameGeneration)
+		{
+			++record;
+			continue;
+		}
+
+		// A run of changed records is copied in one write, including the zero padding between tables.
+		uint64_t runStart = recordOffsets[record];
+		while (record < recordGenerations.size() && recordGenerations[record] > frameGeneration)
+		{
+			++record;
+		}
+		uint64_t runEnd = recordOffsets[record];
+
+		write(runStart, bytes.data() + runStart, runEnd - runStart);
+		written += runEnd - runStart;
+	}
+
+	frameGeneration = generation;
+	return written;
+}
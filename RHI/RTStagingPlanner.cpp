@@ -0,0 +1,58 @@
+#include "RTStagingPlanner.h"
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+
+	uint64_t AlignUp(uint64_t value, uint64_t alignment)
+	{
+		return (value + alignment - 1) & ~(alignment - 1);
+	}
+}
+
+namespace RTStagingPlanner {
+
+	std::vector<RTStagingBatch> Plan(std::vector<uint64_t> const& uploadSizes, uint64_t stagingCapacity, uint64_t alignment)
+	{
+		if (alignment == 0 || (alignment & (alignment - 1)) != 0 || alignment > stagingCapacity)
+		{
+			throw std::runtime_error("ERROR: Staging alignment must be a power of two no larger than the staging buffer.");
+		}
+
+		std::vector<RTStagingBatch> batches(1);
+
+		for (size_t upload = 0; upload < uploadSizes.size(); ++upload)
+		{
+			uint64_t size = uploadSizes[upload];
+			uint64_t sourceOffset = 0;
+
+			while (sourceOffset < size)
+			{
+				RTStagingBatch* batch = &batches.back();
+				uint64_t stagingOffset = AlignUp(batch->stagingSize, alignment);
+				uint64_t space = stagingOffset < stagingCapacity ? stagingCapacity - stagingOffset : 0;
+				uint64_t remaining = size - sourceOffset;
+
+				// Start a new batch rather than split an upload which would fit in one whole.
+				bool splitsSmallUpload = remaining > space && size <= stagingCapacity;
+				if (space == 0 || (splitsSmallUpload && !batch->copies.empty()))
+				{
+					batches.emplace_back();
+					continue;
+				}
+
+				uint64_t pieceSize = std::min(remaining, space);
+				batch->copies.push_back(RTStagingCopy{ static_cast<uint32_t>(upload), sourceOffset, stagingOffset, pieceSize });
+				batch->stagingSize = stagingOffset + pieceSize;
+				sourceOffset += pieceSize;
+			}
+		}
+
+		if (batches.back().copies.empty())
+		{
+			batches.pop_back();
+		}
+
+		return batches;
+	}
+}
@@ -0,0 +1,42 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+/*
+	Plans how a list of uploads moves through a fixed size staging buffer, independent of any graphics API.
+	Uploads are packed in order into batches which each fit in the staging buffer, so many small uploads
+	share one submission. An upload larger than the free space is split across consecutive batches.
+	Uploads which fit in an empty batch are only split when they couldn't fit in any batch, so small
+	meshes are always copied in one piece.
+*/
+
+// One contiguous piece of an upload, copied through the staging buffer.
+struct RTStagingCopy {
+
+	// Index of the upload in the list given to the planner.
+	uint32_t uploadIndex;
+
+	// Offset of the piece in the upload's source data, which is also its offset in the destination.
+	uint64_t sourceOffset;
+
+	// Offset of the piece in the staging buffer.
+	uint64_t stagingOffset;
+
+	uint64_t size;
+};
+
+// Copies recorded in one submission, after which the staging buffer can be reused.
+struct RTStagingBatch {
+
+	std::vector<RTStagingCopy> copies;
+
+	// Bytes of the staging buffer used by the batch, including alignment padding.
+	uint64_t stagingSize = 0;
+};
+
+namespace RTStagingPlanner {
+
+	// The staging offset of every copy is a multiple of alignment, which must be a power of two no larger than stagingCapacity.
+	std::vector<RTStagingBatch> Plan(std::vector<uint64_t> const& uploadSizes, uint64_t stagingCapacity, uint64_t alignment);
+}
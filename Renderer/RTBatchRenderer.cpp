@@ -0,0 +1,240 @@
+#include "RTBatchRenderer.h"
+#include "RTImageWriter.h"
+#include "../Core/RTTrace.h"
+#include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <deque>
+#include <exception>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace {
+
+	using Clock = std::chrono::steady_clock;
+
+	double SecondsSince(Clock::time_point start)
+	{
+		return std::chrono::duration<double>(Clock::now() - start).count();
+	}
+
+	// Writes images on a thread of its own. Pixel buffers are handed back once written, so a batch
+	// allocates MaxPendingImages + 1 of them however many frames it renders.
+	class ImageWriteQueue {
+
+	public:
+		ImageWriteQueue(uint32_t width, uint32_t height) :
+			width{ width },
+			height{ height },
+			queuedImages{ 0 },
+			stopping{ false },
+			writeSeconds{ 0.0 }
+		{
+			writerThread = std::thread([this]() { WriteImages(); });
+		}
+
+		~ImageWriteQueue()
+		{
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				stopping = true;
+			}
+			changed.notify_all();
+			writerThread.join();
+		}
+
+		ImageWriteQueue(ImageWriteQueue const&) = delete;
+		ImageWriteQueue& operator =(ImageWriteQueue const&) = delete;
+
+		// Waits until fewer than MaxPendingImages images are queued and returns a buffer to read the next one into.
+		std::vector<uint8_t> AcquireBuffer()
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			changed.wait(lock, [this]() { return queuedImages < RTBatchRenderer::MaxPendingImages || error; });
+			ThrowIfFailed();
+
+			std::vector<uint8_t> buffer;
+			if (!freeBuffers.empty())
+			{
+				buffer = std::move(freeBuffers.back());
+				freeBuffers.pop_back();
+			}
+			return buffer;
+		}
+
+		void Push(std::filesystem::path path, std::vector<uint8_t> pixels)
+		{
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				pending.push_back(PendingImage{ std::move(path), std::move(pixels) });
+				++queuedImages;
+			}
+			changed.notify_all();
+		}
+
+		// Waits for every queued image to be written, and rethrows the first error of the writer.
+		double Finish()
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			changed.wait(lock, [this]() { return queuedImages == 0 || error; });
+			ThrowIfFailed();
+			return writeSeconds;
+		}
+
+	private:
+		struct PendingImage {
+			std::filesystem::path	path;
+			std::vector<uint8_t>	pixels;
+		};
+
+		// The caller holds the lock.
+		void ThrowIfFailed()
+		{
+			if (error)
+			{
+				std::rethrow_exception(error);
+			}
+		}
+
+		void WriteImages()
+		{
+			RTTrace::SetThreadName("Image writer");
+
+			for (;;)
+			{
+				PendingImage image;
+				{
+					std::unique_lock<std::mutex> lock(mutex);
+					changed.wait(lock, [this]() { return stopping || !pending.empty(); });
+					if (stopping)
+					{
+						return;
+					}
+					image = std::move(pending.front());
+					pending.pop_front();
+				}
+
+				// Images queued after an error are dropped, the render thread stops at its next call.
+				Clock::time_point start = Clock::now();
+				std::exception_ptr writeError;
+				try
+				{
+					RT_TRACE_ZONE("Write image");
+					RTImageWriter::WriteImage(image.path, width, height, image.pixels);
+				}
+				catch (...)
+				{
+					writeError = std::current_exception();
+				}
+
+				{
+					std::lock_guard<std::mutex> lock(mutex);
+					writeSeconds += SecondsSince(start);
+					if (writeError && !error)
+					{
+						error = writeError;
+					}
+					freeBuffers.push_back(std::move(image.pixels));
+					--queuedImages;
+				}
+				changed.notify_all();
+			}
+		}
+
+		uint32_t							width;
+		uint32_t							height;
+
+		std::mutex							mutex;
+		std::condition_variable				changed;
+		std::deque<PendingImage>			pending;
+		std::vector<std::vector<uint8_t>>	freeBuffers;
+		size_t								queuedImages;
+		bool								stopping;
+		std::exception_ptr					error;
+		double								writeSeconds;
+
+		std::thread							writerThread;
+	};
+}
+
+std::filesystem::path RTBatchRenderer::GetFramePath(RTBatchRenderDesc const& desc, uint32_t frame)
+{
+	char number[16];
+	std::snprintf(number, sizeof(number), "%05u", frame);
+	return desc.outputDirectory / (desc.fileNamePrefix + number + desc.extension);
+}
+
+RTBatchRenderStats RTBatchRenderer::Render(RTFrameRenderer& renderer, RTBatchScript const& script, RTBatchRenderDesc const& desc)
+{
+	RTBatchRenderStats stats;
+	Clock::time_point batchStart = Clock::now();
+
+	std::error_code directoryError;
+	std::filesystem::create_directories(desc.outputDirectory, directoryError);
+	if (directoryError)
+	{
+		throw std::runtime_error("ERROR: Couldn't create the output directory " + desc.outputDirectory.string());
+	}
+
+	ImageWriteQueue writeQueue(renderer.GetWidth(), renderer.GetHeight());
+	Clock::time_point lastFrameEnd = Clock::now();
+	renderer.ResetRayCounts();
+
+	// Reads a completed frame and hands it to the writer.
+	auto WriteFrame = [&](uint64_t frameNumber, uint32_t scriptFrame)
+		{
+			RT_TRACE_ZONE("WriteFrame");
+
+			Clock::time_point waitStart = Clock::now();
+			std::vector<uint8_t> pixels = writeQueue.AcquireBuffer();
+			stats.writerWaitSeconds += SecondsSince(waitStart);
+
+			waitStart = Clock::now();
+			renderer.ReadFrame(frameNumber, pixels);
+			stats.frameWaitSeconds += SecondsSince(waitStart);
+
+			writeQueue.Push(GetFramePath(desc, scriptFrame), std::move(pixels));
+			++stats.frameCount;
+
+			Clock::time_point frameEnd = Clock::now();
+			double frameMilliseconds = std::chrono::duration<double, std::milli>(frameEnd - lastFrameEnd).count();
+			stats.frameTimes.AddSample(frameMilliseconds);
+			RT_TRACE_COUNTER("Frame time (ms)", frameMilliseconds);
+			lastFrameEnd = frameEnd;
+		};
+
+	// Frame N is submitted before frame N-1 is read back, so the device is never idle while the CPU reads and writes.
+	uint64_t previousFrameNumber = 0;
+	uint32_t previousScriptFrame = 0;
+	for (uint32_t i = 0; i < desc.frameCount; ++i)
+	{
+		uint32_t scriptFrame = desc.firstFrame + i;
+		script.Evaluate(scriptFrame, renderer.GetSceneConstants());
+		uint64_t frameNumber = renderer.RenderFrame();
+
+		// The previous image is read once the device has the next frame to work on.
+		if (previousFrameNumber != 0)
+		{
+			WriteFrame(previousFrameNumber, previousScriptFrame);
+		}
+		for (uint32_t sample = 1; sample < desc.samplesPerImage; ++sample)
+		{
+			frameNumber = renderer.RenderFrame();
+		}
+		previousFrameNumber = frameNumber;
+		previousScriptFrame = scriptFrame;
+	}
+	if (previousFrameNumber != 0)
+	{
+		WriteFrame(previousFrameNumber, previousScriptFrame);
+	}
+
+	stats.writeSeconds = writeQueue.Finish();
+	stats.totalSeconds = SecondsSince(batchStart);
+	stats.frameArenas = renderer.GetFrameArenas().GetStats();
+	stats.rayCounts = renderer.GetRayCounts();
+	return stats;
+}
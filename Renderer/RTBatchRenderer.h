@@ -0,0 +1,62 @@
+#pragma once
+
+#include "RTFrameRenderer.h"
+#include "RTBatchScript.h"
+#include "../Core/RTFrameTimeHistogram.h"
+#include <cstdint>
+#include <filesystem>
+#include <string>
+
+/*
+	Renders a sequence of stills to image files without a window or swap chain.
+	The work of three frames overlaps: while the device traces frame N, frame N-1 is read back and
+	frame N-2 is encoded and written by a writer thread. At most MaxPendingImages images wait for
+	the writer, so a slow disk throttles the renderer rather than growing memory use.
+*/
+
+struct RTBatchRenderDesc {
+	// Frames first to first + frameCount - 1 of the script are rendered.
+	uint32_t				firstFrame = 0;
+	uint32_t				frameCount = 1;
+
+	// Frames rendered for every image, of which only the last is written. With the renderer accumulating
+	// as many samples, each image is the converged mean of its frames.
+	uint32_t				samplesPerImage = 1;
+
+	// Files are named <prefix><frame, zero padded to 5 digits><extension>, the extension picks the format.
+	std::filesystem::path	outputDirectory = ".";
+	std::string				fileNamePrefix = "frame";
+	std::string				extension = ".png";
+};
+
+struct RTBatchRenderStats {
+	uint32_t	frameCount = 0;
+	double		totalSeconds = 0.0;
+
+	// Time the render thread spent waiting for frames to complete, and for room in the writer's queue.
+	double		frameWaitSeconds = 0.0;
+	double		writerWaitSeconds = 0.0;
+
+	// Time the writer thread spent encoding and writing images.
+	double		writeSeconds = 0.0;
+
+	// Time between successive frames handed to the writer, which is what a slow frame delays.
+	RTFrameTimeHistogram	frameTimes;
+
+	// Transient CPU memory of the frames, in the renderer's frame arenas
+	RTArenaStats			frameArenas;
+
+	// Rays traced by the batch's frames at every depth
+	RTRayCounts				rayCounts{};
+};
+
+namespace RTBatchRenderer {
+
+	const size_t MaxPendingImages = 2;
+
+	std::filesystem::path GetFramePath(RTBatchRenderDesc const& desc, uint32_t frame);
+
+	// Renders the frames with the renderer's current scene, setting its camera and light from the script.
+	// Creates the output directory if needed. Throws std::runtime_error if an image can't be written.
+	RTBatchRenderStats Render(RTFrameRenderer& renderer, RTBatchScript const& script, RTBatchRenderDesc const& desc);
+}
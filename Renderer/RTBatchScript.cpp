@@ -0,0 +1,145 @@
+#include "RTBatchScript.h"
+#include <algorithm>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+	using Vector4D = RTBatchKeyframe::Vector4D;
+
+	Vector4D Lerp(Vector4D const& a, Vector4D const& b, float t)
+	{
+		return Vector4D(
+			a.x + (b.x - a.x) * t,
+			a.y + (b.y - a.y) * t,
+			a.z + (b.z - a.z) * t,
+			a.w + (b.w - a.w) * t);
+	}
+
+	[[noreturn]] void ThrowParseError(size_t lineNumber, std::string const& message)
+	{
+		throw std::runtime_error("ERROR: Batch script line " + std::to_string(lineNumber) + ": " + message);
+	}
+
+	// Reads three components into a position or colour, whose w stays 1.
+	Vector4D ReadVector(std::istringstream& line, size_t lineNumber, std::string const& name)
+	{
+		float x, y, z;
+		if (!(line >> x >> y >> z))
+		{
+			ThrowParseError(lineNumber, "'" + name + "' needs three numbers.");
+		}
+		return Vector4D(x, y, z, 1.0f);
+	}
+}
+
+RTBatchScript RTBatchScript::Load(std::filesystem::path const& path)
+{
+	std::ifstream file(path);
+	if (!file)
+	{
+		throw std::runtime_error("ERROR: Couldn't open the batch script " + path.string());
+	}
+	return Parse(file);
+}
+
+RTBatchScript RTBatchScript::Parse(std::istream& stream)
+{
+	RTBatchScript script;
+	RTBatchKeyframe keyframe;
+
+	std::string text;
+	for (size_t lineNumber = 1; std::getline(stream, text); ++lineNumber)
+	{
+		std::istringstream line(text);
+		std::string word;
+		if (!(line >> word) || word[0] == '#')
+		{
+			continue;
+		}
+		if (word != "key")
+		{
+			ThrowParseError(lineNumber, "expected 'key', found '" + word + "'.");
+		}
+
+		long long frame = -1;
+		if (!(line >> frame) || frame < 0 || frame > 0xFFFFFFFFll)
+		{
+			ThrowParseError(lineNumber, "'key' needs a frame number.");
+		}
+		if (!script.keyframes.empty() && static_cast<uint32_t>(frame) <= script.keyframes.back().frame)
+		{
+			ThrowParseError(lineNumber, "keyframes must be in increasing frame order.");
+		}
+		keyframe.frame = static_cast<uint32_t>(frame);
+
+		while (line >> word)
+		{
+			if (word[0] == '#')
+			{
+				break;
+			}
+			else if (word == "camera")
+			{
+				keyframe.cameraPosition = ReadVector(line, lineNumber, word);
+			}
+			else if (word == "light")
+			{
+				keyframe.lightPosition = ReadVector(line, lineNumber, word);
+			}
+			else if (word == "ambient")
+			{
+				keyframe.lightAmbientColour = ReadVector(line, lineNumber, word);
+			}
+			else if (word == "diffuse")
+			{
+				keyframe.lightDiffuseColour = ReadVector(line, lineNumber, word);
+			}
+			else
+			{
+				ThrowParseError(lineNumber, "unknown value '" + word + "'.");
+			}
+		}
+
+		script.keyframes.push_back(keyframe);
+	}
+
+	return script;
+}
+
+void RTBatchScript::AddKeyframe(RTBatchKeyframe const& keyframe)
+{
+	if (!keyframes.empty() && keyframe.frame <= keyframes.back().frame)
+	{
+		throw std::runtime_error("ERROR: Keyframes must be added in increasing frame order.");
+	}
+	keyframes.push_back(keyframe);
+}
+
+void RTBatchScript::Evaluate(uint32_t frame, SceneConstantBuffer& sceneConstants) const
+{
+	RTBatchKeyframe const defaults;
+	RTBatchKeyframe const* from = keyframes.empty() ? &defaults : &keyframes.front();
+	RTBatchKeyframe const* to = from;
+
+	// The last keyframe at or before the frame, and the one after it.
+	for (size_t i = 1; i < keyframes.size() && keyframes[i - 1].frame < frame; ++i)
+	{
+		from = &keyframes[i - 1];
+		to = &keyframes[i];
+	}
+
+	float t = 0.0f;
+	if (to->frame > from->frame)
+	{
+		t = static_cast<float>(frame - std::min(frame, from->frame)) / static_cast<float>(to->frame - from->frame);
+		t = std::min(t, 1.0f);
+	}
+
+	sceneConstants.cameraPosition = Lerp(from->cameraPosition, to->cameraPosition, t);
+	sceneConstants.lightPosition = Lerp(from->lightPosition, to->lightPosition, t);
+	sceneConstants.lightAmbientColour = Lerp(from->lightAmbientColour, to->lightAmbientColour, t);
+	sceneConstants.lightDiffuseColour = Lerp(from->lightDiffuseColour, to->lightDiffuseColour, t);
+}
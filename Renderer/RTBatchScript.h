@@ -0,0 +1,51 @@
+#pragma once
+
+#include "../Scene/RTScene.h"
+#include <cstdint>
+#include <filesystem>
+#include <istream>
+#include <vector>
+
+/*
+	Camera and light keyframes of a batch render, interpolated linearly in between and held beyond the
+	first and last keyframe. Scripts are text files with one keyframe per line, naming only the values
+	which change, every other value is carried over from the keyframe before:
+
+		# frame  values
+		key 0    camera 0 0 -2   light 0 1 -2
+		key 60   camera 0 0 -4   light 3 1 0   ambient 0.1 0.1 0.15   diffuse 1 0.9 0.8
+
+	Lines starting with # are comments.
+*/
+
+struct RTBatchKeyframe {
+	using Vector4D = RTVector4D::RTVec4DImpl;
+
+	uint32_t	frame = 0;
+	Vector4D	cameraPosition{ 0.0f, 0.0f, -2.0f, 1.0f };
+	Vector4D	lightPosition{ 0.0f, 1.0f, -2.0f, 1.0f };
+	Vector4D	lightAmbientColour{ 0.2f, 0.2f, 0.2f, 1.0f };
+	Vector4D	lightDiffuseColour{ 0.8f, 0.8f, 0.8f, 1.0f };
+};
+
+class RTBatchScript {
+
+public:
+	// A script without keyframes keeps the defaults of RTBatchKeyframe, the scene RTDXInterface starts with.
+	RTBatchScript() = default;
+
+	// Throws std::runtime_error naming the line of the first error.
+	static RTBatchScript Load(std::filesystem::path const& path);
+	static RTBatchScript Parse(std::istream& stream);
+
+	// Keyframes must be added in increasing frame order.
+	void AddKeyframe(RTBatchKeyframe const& keyframe);
+
+	// Writes the camera and light of a frame, leaving the rest of the constants as they are.
+	void Evaluate(uint32_t frame, SceneConstantBuffer& sceneConstants) const;
+
+	std::vector<RTBatchKeyframe> const& GetKeyframes() const { return keyframes; }
+
+private:
+	std::vector<RTBatchKeyframe> keyframes;
+};
@@ -0,0 +1,314 @@
+#include "RTFrameRenderer.h"
+#include "../Core/RTJobSystem.h"
+#include "../Core/RTTrace.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+
+namespace {
+
+	// Indices packed into the smallest size which can address every vertex, as RTDXInterface uploads them.
+	// 16 bit indices are padded to a whole number of 32 bit words, which the hit shader reads them in.
+	std::vector<uint8_t> PackIndices(std::vector<uint32_t> const& indices, size_t vertexCount, uint32_t& indexSizeInBytes)
+	{
+		std::vector<uint8_t> bytes;
+		if (vertexCount <= 0x10000)
+		{
+			indexSizeInBytes = sizeof(uint16_t);
+			bytes.resize((indices.size() * sizeof(uint16_t) + 3) & ~size_t{ 3 }, 0);
+			for (size_t i = 0; i < indices.size(); ++i)
+			{
+				uint16_t index = static_cast<uint16_t>(indices[i]);
+				std::memcpy(bytes.data() + i * sizeof(uint16_t), &index, sizeof(index));
+			}
+		}
+		else
+		{
+			indexSizeInBytes = sizeof(uint32_t);
+			bytes.resize(indices.size() * sizeof(uint32_t));
+			std::memcpy(bytes.data(), indices.data(), bytes.size());
+		}
+		return bytes;
+	}
+}
+
+RTFrameRenderer::RTFrameRenderer(RTRenderDevice& device, uint32_t width, uint32_t height) :
+	device{ device },
+	width{ width },
+	height{ height },
+	fence{ device.CreateFence(0) },
+	lastFenceValue{ 0 },
+	lastFrameNumber{ 0 },
+	frameArenas{ FrameCount, RTJobSystem::GetDefault() },
+	accumulationSampleCount{ 0 },
+	accumulatedSampleCount{ 0 },
+	rayCounts{}
+{
+	if (width == 0 || height == 0)
+	{
+		throw std::runtime_error("ERROR: The frame renderer needs a non-empty output.");
+	}
+
+	// The scene RTDXInterface starts with
+	sceneConstants.projectionToWorld = RTMatrix4D::RTMatrix4DImpl();
+	sceneConstants.cameraPosition = RTVector4D::RTVec4DImpl(0.0f, 0.0f, -2.0f, 1.0f);
+	sceneConstants.lightPosition = RTVector4D::RTVec4DImpl(0.0f, 1.0f, -2.0f, 1.0f);
+	sceneConstants.lightAmbientColour = RTVector4D::RTVec4DImpl(0.2f, 0.2f, 0.2f, 1.0f);
+	sceneConstants.lightDiffuseColour = RTVector4D::RTVec4DImpl(0.8f, 0.8f, 0.8f, 1.0f);
+	accumulatedSceneConstants = sceneConstants;
+
+	uint64_t rayCounterSize = RayCounterCount * sizeof(uint32_t);
+	rayCounters = device.CreateBuffer(RTBufferDesc{ rayCounterSize, RTBufferUsage::RayCounters });
+
+	for (FrameResources& frame : frames)
+	{
+		frame.commandList = device.CreateCommandList();
+		frame.topLevel = device.CreateTopLevel();
+		frame.output = device.CreateOutputTexture(width, height);
+		frame.readback = device.CreateBuffer(RTBufferDesc{ uint64_t{ device.GetReadbackRowPitch(width) } * height, RTBufferUsage::Readback });
+		frame.rayCountReadback = device.CreateBuffer(RTBufferDesc{ rayCounterSize, RTBufferUsage::Readback });
+	}
+}
+
+RTFrameRenderer::~RTFrameRenderer()
+{
+	// The device may still be executing commands which use the resources.
+	// A failed submission has nothing left to wait for, and a destructor mustn't throw.
+	try
+	{
+		WaitForFrames();
+	}
+	catch (...)
+	{
+	}
+}
+
+void RTFrameRenderer::SetScene(std::vector<Mesh> const& sceneMeshes, std::vector<MeshInstance> sceneInstances)
+{
+	for (Mesh const& mesh : sceneMeshes)
+	{
+		if (mesh.vertices.empty() || mesh.indices.empty())
+		{
+			throw std::runtime_error("ERROR: Scene meshes need vertices and indices.");
+		}
+	}
+	for (MeshInstance const& instance : sceneInstances)
+	{
+		if (instance.meshIndex >= sceneMeshes.size())
+		{
+			throw std::runtime_error("ERROR: Instance references a mesh which isn't part of the scene.");
+		}
+	}
+
+	// Frames in flight may still trace the structures of the previous scene.
+	WaitForFrames();
+	meshes.clear();
+
+	std::unique_ptr<RTCommandList> commandList = device.CreateCommandList();
+	for (Mesh const& mesh : sceneMeshes)
+	{
+		MeshResources resources;
+		RTGeometryDesc geometry;
+
+		geometry.vertexCount = static_cast<uint32_t>(mesh.vertices.size());
+		resources.vertexBuffer = device.CreateBuffer(RTBufferDesc{ mesh.vertices.size() * sizeof(Vertex), RTBufferUsage::Geometry }, mesh.vertices.data());
+
+		std::vector<uint8_t> indexBytes = PackIndices(mesh.indices, mesh.vertices.size(), geometry.indexSizeInBytes);
+		geometry.indexCount = static_cast<uint32_t>(mesh.indices.size());
+		resources.indexBuffer = device.CreateBuffer(RTBufferDesc{ indexBytes.size(), RTBufferUsage::Geometry }, indexBytes.data());
+
+		geometry.vertexBuffer = resources.vertexBuffer.get();
+		geometry.indexBuffer = resources.indexBuffer.get();
+		resources.bottomLevel = device.CreateBottomLevel(geometry);
+		commandList->BuildBottomLevel(*resources.bottomLevel);
+
+		meshes.push_back(std::move(resources));
+	}
+
+	// Every bottom level structure is built in one submission.
+	device.Submit(*commandList, *fence, ++lastFenceValue);
+	fence->Wait(lastFenceValue);
+
+	instances = std::move(sceneInstances);
+	accumulatedSampleCount = 0;
+}
+
+void RTFrameRenderer::SetAccumulation(uint32_t sampleCount)
+{
+	// Frames in flight keep accumulating into the texture, so it lives as long as the renderer once created.
+	if (sampleCount > 0 && !accumulation)
+	{
+		accumulation = device.CreateAccumulationTexture(width, height);
+	}
+	accumulationSampleCount = sampleCount;
+	accumulatedSampleCount = 0;
+}
+
+void RTFrameRenderer::SetPathTracing(PathTracingConstants const& constants)
+{
+	if (constants.maxBounces > MaxPathBounces)
+	{
+		throw std::runtime_error("ERROR: Paths can take at most MaxPathBounces bounces.");
+	}
+	if (constants.samplesPerPixel == 0)
+	{
+		throw std::runtime_error("ERROR: Frames need at least one sample per pixel.");
+	}
+
+	// Samples of another integrator would blend into the image.
+	pathTracingConstants = constants;
+	accumulatedSampleCount = 0;
+}
+
+uint64_t RTFrameRenderer::RenderFrame()
+{
+	RT_TRACE_ZONE("RenderFrame");
+
+	uint64_t frameNumber = ++lastFrameNumber;
+	uint32_t frameIndex = static_cast<uint32_t>((frameNumber - 1) % FrameCount);
+	FrameResources& frame = frames[frameIndex];
+
+	// The command list, structure, output and arenas of this slot are free once its last frame has completed.
+	{
+		RT_TRACE_ZONE("Wait for frame slot");
+		fence->Wait(frame.fenceValue);
+	}
+	frameArenas.BeginFrame(frameIndex);
+	CollectRayCounts(frame);
+
+	RTArenaVector<RTInstanceDesc> instanceDescs{ RTArenaAllocator<RTInstanceDesc>(frameArenas.GetArena()) };
+	instanceDescs.resize(instances.size());
+	for (size_t i = 0; i < instances.size(); ++i)
+	{
+		MeshInstance const& instance = instances[i];
+		if (instance.meshIndex >= meshes.size())
+		{
+			throw std::runtime_error("ERROR: Instance references a mesh which isn't part of the scene.");
+		}
+
+		RTInstanceDesc& desc = instanceDescs[i];
+		desc.bottomLevel = meshes[instance.meshIndex].bottomLevel.get();
+		for (int row = 0; row < 3; ++row)
+		{
+			for (int column = 0; column < 4; ++column)
+			{
+				desc.transform[row][column] = instance.transform.n[row][column];
+			}
+		}
+		desc.colour[0] = instance.colour.x;
+		desc.colour[1] = instance.colour.y;
+		desc.colour[2] = instance.colour.z;
+		desc.colour[3] = instance.colour.w;
+	}
+
+	frame.commandList->Reset();
+	frame.commandList->BuildTopLevel(*frame.topLevel, instanceDescs.data(), instanceDescs.size());
+
+	// Samples of another view or scene would blend into the image, so any change restarts the mean.
+	AccumulationConstants accumulationConstants;
+	if (accumulationSampleCount > 0)
+	{
+		bool sceneChanged = std::memcmp(&sceneConstants, &accumulatedSceneConstants, sizeof(SceneConstantBuffer)) != 0 ||
+			instanceDescs.size() != accumulatedInstances.size() ||
+			(!instanceDescs.empty() && std::memcmp(instanceDescs.data(), accumulatedInstances.data(), instanceDescs.size() * sizeof(RTInstanceDesc)) != 0);
+		if (sceneChanged)
+		{
+			accumulatedSampleCount = 0;
+			accumulatedSceneConstants = sceneConstants;
+			accumulatedInstances.assign(instanceDescs.begin(), instanceDescs.end());
+		}
+
+		accumulationConstants.sampleIndex = accumulatedSampleCount;
+		accumulationConstants.sampleCount = accumulationSampleCount;
+		accumulatedSampleCount = std::min<uint32_t>(accumulatedSampleCount + 1, accumulationSampleCount);
+	}
+
+	RTDispatchRaysDesc dispatchDesc;
+	dispatchDesc.topLevel = frame.topLevel.get();
+	dispatchDesc.output = frame.output.get();
+	dispatchDesc.sceneConstants = sceneConstants;
+	dispatchDesc.accumulation = accumulation.get();
+	dispatchDesc.accumulationConstants = accumulationConstants;
+	dispatchDesc.pathTracingConstants = pathTracingConstants;
+	dispatchDesc.rayCounters = rayCounters.get();
+	frame.commandList->DispatchRays(dispatchDesc);
+
+	frame.commandList->CopyToReadback(*frame.output, *frame.readback);
+	frame.commandList->CopyToReadback(*rayCounters, *frame.rayCountReadback);
+	frame.rayCountsPending = true;
+
+	frame.frameNumber = frameNumber;
+	frame.fenceValue = ++lastFenceValue;
+	device.Submit(*frame.commandList, *fence, frame.fenceValue);
+	return frameNumber;
+}
+
+void RTFrameRenderer::ReadFrame(uint64_t frameNumber, std::vector<uint8_t>& pixels)
+{
+	RT_TRACE_ZONE("ReadFrame");
+
+	if (frameNumber == 0 || frameNumber > lastFrameNumber)
+	{
+		throw std::runtime_error("ERROR: The frame hasn't been rendered.");
+	}
+	FrameResources& frame = frames[(frameNumber - 1) % FrameCount];
+	if (frame.frameNumber != frameNumber)
+	{
+		throw std::runtime_error("ERROR: The frame's resources have been reused by a later frame.");
+	}
+
+	fence->Wait(frame.fenceValue);
+
+	size_t rowSize = size_t{ width } * 4;
+	size_t rowPitch = device.GetReadbackRowPitch(width);
+	pixels.resize(rowSize * height);
+
+	uint8_t const* mapped = static_cast<uint8_t const*>(frame.readback->Map());
+	for (uint32_t row = 0; row < height; ++row)
+	{
+		std::memcpy(pixels.data() + row * rowSize, mapped + row * rowPitch, rowSize);
+	}
+	frame.readback->Unmap();
+}
+
+void RTFrameRenderer::WaitForFrames()
+{
+	fence->Wait(lastFenceValue);
+}
+
+RTRayCounts RTFrameRenderer::GetRayCounts()
+{
+	WaitForFrames();
+	for (FrameResources& frame : frames)
+	{
+		CollectRayCounts(frame);
+	}
+	return rayCounts;
+}
+
+void RTFrameRenderer::ResetRayCounts()
+{
+	// Frames still in flight were submitted before the reset, so their counts are dropped.
+	for (FrameResources& frame : frames)
+	{
+		frame.rayCountsPending = false;
+	}
+	rayCounts.fill(0);
+}
+
+void RTFrameRenderer::CollectRayCounts(FrameResources& frame)
+{
+	if (!frame.rayCountsPending)
+	{
+		return;
+	}
+
+	uint32_t counts[RayCounterCount];
+	std::memcpy(counts, frame.rayCountReadback->Map(), sizeof(counts));
+	frame.rayCountReadback->Unmap();
+	for (uint32_t depth = 0; depth < RayCounterCount; ++depth)
+	{
+		rayCounts[depth] += counts[depth];
+	}
+	frame.rayCountsPending = false;
+}
@@ -0,0 +1,133 @@
+#pragma once
+
+#include "../Core/RTFrameArenas.h"
+#include "../RHI/RTRenderDevice.h"
+#include "../Scene/RTScene.h"
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+/*
+	The engine's frame pipeline written against RTRenderDevice, so the same frames render on the D3D12
+	backend or on the CPU without a window: every frame builds the top level structure over the scene
+	instances, traces the output and copies it into a readback buffer.
+	Each of the FrameCount frames in flight has its own command list, top level structure, output and
+	readback buffer, so the next frame is recorded and submitted while the previous one still executes.
+	Transient CPU data of a frame lives in its frame arenas, which are reset once the frame has completed.
+	With progressive accumulation, frames share one accumulation texture, which the queue updates in
+	submission order, so a static view converges over successive frames at the cost of one sample each.
+	Every frame counts the rays it traces at each depth into a shared counter buffer and copies the counts
+	into a readback buffer of its own, which is read once the frame has completed, so counting never stalls.
+*/
+
+// Rays traced at every depth, primary rays and the shadow rays of the primary hits at depth 0.
+using RTRayCounts = std::array<uint64_t, RayCounterCount>;
+
+class RTFrameRenderer {
+
+public:
+	static const uint32_t FrameCount = 2;
+
+	RTFrameRenderer(RTRenderDevice& device, uint32_t width, uint32_t height);
+	~RTFrameRenderer();
+
+	RTFrameRenderer(RTFrameRenderer const&) = delete;
+	RTFrameRenderer& operator =(RTFrameRenderer const&) = delete;
+
+	// Uploads the meshes and builds their bottom level structures, waiting for the builds to complete.
+	// Every instance must reference one of the meshes.
+	void SetScene(std::vector<Mesh> const& meshes, std::vector<MeshInstance> instances);
+
+	// The instances and scene constants are read when a frame is rendered, so they may change between frames.
+	std::vector<MeshInstance>& GetInstances() { return instances; }
+	SceneConstantBuffer& GetSceneConstants() { return sceneConstants; }
+
+	// Every frame adds a sample, jittered within its pixel, to the running mean of the frames before it, until
+	// sampleCount samples have been taken, after which the converged image is output without tracing. The mean
+	// restarts whenever the scene, the instances or the scene constants change, and when this is called.
+	// 0 disables accumulation, tracing one sample at every pixel centre.
+	void SetAccumulation(uint32_t sampleCount);
+
+	// Path traces frames from the next one on, restarting accumulation. The default constants shade the
+	// primary hits directly. Throws std::runtime_error beyond MaxPathBounces bounces or without samples.
+	void SetPathTracing(PathTracingConstants const& constants);
+	PathTracingConstants const& GetPathTracing() const { return pathTracingConstants; }
+
+	// Samples per pixel in the image of the frame last submitted, 0 without accumulation.
+	uint32_t GetAccumulatedSampleCount() const { return accumulatedSampleCount; }
+
+	// Submits the next frame and returns its number, starting at 1. Waits if the frame which last used
+	// the same resources, FrameCount frames ago, hasn't completed.
+	uint64_t RenderFrame();
+
+	// Arenas of the frame last submitted. What is allocated from them stays valid until RenderFrame() reuses
+	// the frame's resources, FrameCount frames later, once the frame has completed.
+	RTFrameArenas& GetFrameArenas() { return frameArenas; }
+
+	// Waits for a frame and copies its output as tightly packed RGBA8 rows. Only the last FrameCount frames can be read.
+	void ReadFrame(uint64_t frameNumber, std::vector<uint8_t>& pixels);
+
+	// Blocks until every submitted frame has completed.
+	void WaitForFrames();
+
+	// Rays traced by the frames submitted since the last ResetRayCounts(), waiting for them to complete.
+	RTRayCounts GetRayCounts();
+	void ResetRayCounts();
+
+	uint32_t GetWidth() const { return width; }
+	uint32_t GetHeight() const { return height; }
+	RTRenderDevice& GetDevice() const { return device; }
+
+private:
+	struct MeshResources {
+		std::unique_ptr<RTBuffer>					vertexBuffer;
+		std::unique_ptr<RTBuffer>					indexBuffer;
+		std::unique_ptr<RTAccelerationStructure>	bottomLevel;
+	};
+
+	struct FrameResources {
+		std::unique_ptr<RTCommandList>				commandList;
+		std::unique_ptr<RTAccelerationStructure>	topLevel;
+		std::unique_ptr<RTTexture>					output;
+		std::unique_ptr<RTBuffer>					readback;
+		std::unique_ptr<RTBuffer>					rayCountReadback;
+		uint64_t									frameNumber = 0;
+		uint64_t									fenceValue = 0;
+
+		// Whether the frame's ray counts are yet to be added to the totals
+		bool										rayCountsPending = false;
+	};
+
+	// Adds the counts of a completed frame to the totals.
+	void CollectRayCounts(FrameResources& frame);
+
+	RTRenderDevice&						device;
+	uint32_t							width;
+	uint32_t							height;
+
+	// Signalled once for every submission, scene uploads included
+	std::unique_ptr<RTFence>			fence;
+	uint64_t							lastFenceValue;
+	uint64_t							lastFrameNumber;
+
+	std::vector<MeshResources>			meshes;
+	std::vector<MeshInstance>			instances;
+	SceneConstantBuffer					sceneConstants;
+
+	FrameResources						frames[FrameCount];
+	RTFrameArenas						frameArenas;
+
+	// Progressive accumulation, and the scene constants and instances its samples were taken with
+	std::unique_ptr<RTTexture>			accumulation;
+	uint32_t							accumulationSampleCount;
+	uint32_t							accumulatedSampleCount;
+	SceneConstantBuffer					accumulatedSceneConstants;
+	std::vector<RTInstanceDesc>			accumulatedInstances;
+
+	PathTracingConstants				pathTracingConstants;
+
+	// Written by every frame in submission order, before the frame copies it to its readback buffer
+	std::unique_ptr<RTBuffer>			rayCounters;
+	RTRayCounts							rayCounts;
+};
@@ -0,0 +1,222 @@
+#include "RTImageWriter.h"
+#include <algorithm>
+#include <array>
+#include <cctype>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+
+namespace {
+
+	std::array<uint32_t, 256> const& GetCrcTable()
+	{
+		static std::array<uint32_t, 256> const table = []()
+			{
+				std::array<uint32_t, 256> entries = {};
+				for (uint32_t i = 0; i < 256; ++i)
+				{
+					uint32_t crc = i;
+					for (int bit = 0; bit < 8; ++bit)
+					{
+						crc = (crc & 1) ? 0xEDB88320u ^ (crc >> 1) : crc >> 1;
+					}
+					entries[i] = crc;
+				}
+				return entries;
+			}();
+		return table;
+	}
+
+	uint32_t UpdateCrc(uint32_t crc, uint8_t const* data, size_t size)
+	{
+		std::array<uint32_t, 256> const& table = GetCrcTable();
+		for (size_t i = 0; i < size; ++i)
+		{
+			crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+		}
+		return crc;
+	}
+
+	void AppendBigEndian(std::vector<uint8_t>& bytes, uint32_t value)
+	{
+		bytes.push_back(static_cast<uint8_t>(value >> 24));
+		bytes.push_back(static_cast<uint8_t>(value >> 16));
+		bytes.push_back(static_cast<uint8_t>(value >> 8));
+		bytes.push_back(static_cast<uint8_t>(value));
+	}
+
+	// Fills in the length of a chunk begun with BeginChunk(), whose data has been appended since, and appends its CRC.
+	void FinishChunk(std::vector<uint8_t>& bytes, size_t chunkStart)
+	{
+		size_t dataSize = bytes.size() - chunkStart - 8;
+		uint32_t length = static_cast<uint32_t>(dataSize);
+		bytes[chunkStart + 0] = static_cast<uint8_t>(length >> 24);
+		bytes[chunkStart + 1] = static_cast<uint8_t>(length >> 16);
+		bytes[chunkStart + 2] = static_cast<uint8_t>(length >> 8);
+		bytes[chunkStart + 3] = static_cast<uint8_t>(length);
+
+		// The CRC covers the type and the data.
+		uint32_t crc = UpdateCrc(0xFFFFFFFFu, bytes.data() + chunkStart + 4, dataSize + 4) ^ 0xFFFFFFFFu;
+		AppendBigEndian(bytes, crc);
+	}
+
+	size_t BeginChunk(std::vector<uint8_t>& bytes, char const* type)
+	{
+		size_t chunkStart = bytes.size();
+		AppendBigEndian(bytes, 0);
+		bytes.insert(bytes.end(), type, type + 4);
+		return chunkStart;
+	}
+
+	void WriteFile(std::filesystem::path const& path, uint8_t const* data, size_t size)
+	{
+		std::ofstream file(path, std::ios::binary | std::ios::trunc);
+		file.write(reinterpret_cast<char const*>(data), static_cast<std::streamsize>(size));
+		if (!file)
+		{
+			throw std::runtime_error("ERROR: Couldn't write the image " + path.string());
+		}
+	}
+
+	void ValidateImage(uint32_t width, uint32_t height, std::vector<uint8_t> const& pixels)
+	{
+		if (width == 0 || height == 0 || pixels.size() != size_t{ width } * height * 4)
+		{
+			throw std::runtime_error("ERROR: Image pixels must be width * height RGBA8 values.");
+		}
+	}
+}
+
+void RTImageWriter::WriteImage(std::filesystem::path const& path, uint32_t width, uint32_t height, std::vector<uint8_t> const& pixels)
+{
+	std::string extension = path.extension().string();
+	std::transform(extension.begin(), extension.end(), extension.begin(), [](char c) { return static_cast<char>(std::tolower(static_cast<unsigned char>(c))); });
+
+	if (extension == ".png")
+	{
+		WritePng(path, width, height, pixels);
+	}
+	else if (extension == ".ppm")
+	{
+		WritePpm(path, width, height, pixels);
+	}
+	else
+	{
+		throw std::runtime_error("ERROR: Images can only be written as .png or .ppm, not " + path.string());
+	}
+}
+
+void RTImageWriter::WritePng(std::filesystem::path const& path, uint32_t width, uint32_t height, std::vector<uint8_t> const& pixels)
+{
+	std::vector<uint8_t> encoded;
+	EncodePng(width, height, pixels, encoded);
+	WriteFile(path, encoded.data(), encoded.size());
+}
+
+void RTImageWriter::WritePpm(std::filesystem::path const& path, uint32_t width, uint32_t height, std::vector<uint8_t> const& pixels)
+{
+	ValidateImage(width, height, pixels);
+
+	char header[64];
+	int headerSize = std::snprintf(header, sizeof(header), "P6\n%u %u\n255\n", width, height);
+
+	std::vector<uint8_t> bytes(header, header + headerSize);
+	bytes.reserve(bytes.size() + size_t{ width } * height * 3);
+	for (size_t i = 0; i < pixels.size(); i += 4)
+	{
+		bytes.insert(bytes.end(), pixels.begin() + i, pixels.begin() + i + 3);
+	}
+	WriteFile(path, bytes.data(), bytes.size());
+}
+
+void RTImageWriter::EncodePng(uint32_t width, uint32_t height, std::vector<uint8_t> const& pixels, std::vector<uint8_t>& encoded)
+{
+	ValidateImage(width, height, pixels);
+
+	// Every row is prefixed with filter type 0, so the filtered image is the pixels with one byte per row added.
+	size_t rowSize = size_t{ width } * 4;
+	size_t filteredSize = (rowSize + 1) * height;
+
+	// Stored deflate blocks hold at most 65535 bytes and cost 5 bytes of header each.
+	const size_t maxBlockSize = 0xFFFF;
+	size_t blockCount = std::max<size_t>((filteredSize + maxBlockSize - 1) / maxBlockSize, 1);
+	if (filteredSize + blockCount * 5 + 6 > 0xFFFFFFFFu)
+	{
+		throw std::runtime_error("ERROR: The image is too large for a single PNG data chunk.");
+	}
+
+	encoded.clear();
+	encoded.reserve(8 + 25 + 12 + 6 + filteredSize + blockCount * 5 + 12);
+
+	static const uint8_t signature[] = { 0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n' };
+	encoded.insert(encoded.end(), signature, signature + sizeof(signature));
+
+	// 8 bits per channel, RGBA, deflate, adaptive filtering, not interlaced
+	size_t chunkStart = BeginChunk(encoded, "IHDR");
+	AppendBigEndian(encoded, width);
+	AppendBigEndian(encoded, height);
+	encoded.insert(encoded.end(), { 8, 6, 0, 0, 0 });
+	FinishChunk(encoded, chunkStart);
+
+	// A zlib stream without compression: header, stored blocks and the Adler-32 of the filtered image.
+	chunkStart = BeginChunk(encoded, "IDAT");
+	encoded.push_back(0x78);
+	encoded.push_back(0x01);
+
+	uint32_t adlerA = 1;
+	uint32_t adlerB = 0;
+	size_t blockRemaining = 0;
+	size_t written = 0;
+	auto AppendFiltered = [&](uint8_t const* data, size_t size)
+		{
+			while (size > 0)
+			{
+				if (blockRemaining == 0)
+				{
+					blockRemaining = std::min(maxBlockSize, filteredSize - written);
+					uint16_t length = static_cast<uint16_t>(blockRemaining);
+					uint16_t complement = static_cast<uint16_t>(~length);
+					encoded.push_back(written + blockRemaining == filteredSize ? 1 : 0);
+					encoded.push_back(static_cast<uint8_t>(length));
+					encoded.push_back(static_cast<uint8_t>(length >> 8));
+					encoded.push_back(static_cast<uint8_t>(complement));
+					encoded.push_back(static_cast<uint8_t>(complement >> 8));
+				}
+
+				size_t count = std::min(size, blockRemaining);
+				encoded.insert(encoded.end(), data, data + count);
+
+				// The sums are reduced often enough that they can't overflow 32 bits.
+				for (size_t i = 0; i < count; i += 4096)
+				{
+					size_t end = std::min(count, i + 4096);
+					for (size_t j = i; j < end; ++j)
+					{
+						adlerA += data[j];
+						adlerB += adlerA;
+					}
+					adlerA %= 65521;
+					adlerB %= 65521;
+				}
+
+				data += count;
+				size -= count;
+				written += count;
+				blockRemaining -= count;
+			}
+		};
+
+	const uint8_t filterType = 0;
+	for (uint32_t row = 0; row < height; ++row)
+	{
+		AppendFiltered(&filterType, 1);
+		AppendFiltered(pixels.data() + row * rowSize, rowSize);
+	}
+	AppendBigEndian(encoded, (adlerB << 16) | adlerA);
+	FinishChunk(encoded, chunkStart);
+
+	chunkStart = BeginChunk(encoded, "IEND");
+	FinishChunk(encoded, chunkStart);
+}
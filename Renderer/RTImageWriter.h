@@ -0,0 +1,23 @@
+#pragma once
+
+#include <cstdint>
+#include <filesystem>
+#include <vector>
+
+/*
+	Writes tightly packed RGBA8 images, as read back by RTFrameRenderer, without any image library.
+	PNG files are stored with uncompressed deflate blocks, which every decoder reads and which cost no
+	more than a copy to write, so batch rendering is never held up by compression. PPM drops the alpha.
+*/
+
+namespace RTImageWriter {
+
+	// The format is chosen by the extension, .png or .ppm. Throws std::runtime_error on failure.
+	void WriteImage(std::filesystem::path const& path, uint32_t width, uint32_t height, std::vector<uint8_t> const& pixels);
+
+	void WritePng(std::filesystem::path const& path, uint32_t width, uint32_t height, std::vector<uint8_t> const& pixels);
+	void WritePpm(std::filesystem::path const& path, uint32_t width, uint32_t height, std::vector<uint8_t> const& pixels);
+
+	// Encodes a PNG into memory, reusing the capacity of encoded.
+	void EncodePng(uint32_t width, uint32_t height, std::vector<uint8_t> const& pixels, std::vector<uint8_t>& encoded);
+}
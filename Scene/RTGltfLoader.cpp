@@ -0,0 +1,987 @@
+#include "RTGltfLoader.h"
+#include <algorithm>
+#include <climits>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <utility>
+
+#if defined(_M_X64) || defined(_M_IX86) || defined(__SSE2__)
+#define RT_GLTF_SSE2 1
+#include <emmintrin.h>
+#endif
+
+#ifdef _WIN32
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+/*
+	Read-only memory mapping of a whole file.
+*/
+
+class RTMappedFile {
+
+public:
+	explicit RTMappedFile(std::filesystem::path const& path);
+	~RTMappedFile();
+
+	RTMappedFile(RTMappedFile const&) = delete;
+	RTMappedFile& operator =(RTMappedFile const&) = delete;
+
+	uint8_t const* GetData() const { return data; }
+	size_t GetSize() const { return size; }
+
+private:
+	uint8_t const* data = nullptr;
+	size_t size = 0;
+
+#ifdef _WIN32
+	HANDLE fileHandle = INVALID_HANDLE_VALUE;
+	HANDLE mappingHandle = nullptr;
+#else
+	int fileDescriptor = -1;
+#endif
+};
+
+#ifdef _WIN32
+
+RTMappedFile::RTMappedFile(std::filesystem::path const& path)
+{
+	fileHandle = CreateFileW(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+	if (fileHandle == INVALID_HANDLE_VALUE)
+	{
+		throw std::runtime_error("ERROR: Couldn't open glTF file.");
+	}
+
+	LARGE_INTEGER fileSize = {};
+	if (!GetFileSizeEx(fileHandle, &fileSize) || fileSize.QuadPart == 0)
+	{
+		CloseHandle(fileHandle);
+		throw std::runtime_error("ERROR: glTF file is empty.");
+	}
+
+	mappingHandle = CreateFileMappingW(fileHandle, nullptr, PAGE_READONLY, 0, 0, nullptr);
+	void* view = mappingHandle ? MapViewOfFile(mappingHandle, FILE_MAP_READ, 0, 0, 0) : nullptr;
+	if (!view)
+	{
+		if (mappingHandle)
+		{
+			CloseHandle(mappingHandle);
+		}
+		CloseHandle(fileHandle);
+		throw std::runtime_error("ERROR: Couldn't map glTF file.");
+	}
+
+	data = static_cast<uint8_t const*>(view);
+	size = static_cast<size_t>(fileSize.QuadPart);
+
+	// Ask the OS to start streaming the whole file in, so page faults don't serialise the loader on disk latency.
+	WIN32_MEMORY_RANGE_ENTRY range = { view, size };
+	PrefetchVirtualMemory(GetCurrentProcess(), 1, &range, 0);
+}
+
+RTMappedFile::~RTMappedFile()
+{
+	UnmapViewOfFile(data);
+	CloseHandle(mappingHandle);
+	CloseHandle(fileHandle);
+}
+
+#else
+
+RTMappedFile::RTMappedFile(std::filesystem::path const& path)
+{
+	fileDescriptor = open(path.c_str(), O_RDONLY);
+	if (fileDescriptor < 0)
+	{
+		throw std::runtime_error("ERROR: Couldn't open glTF file.");
+	}
+
+	struct stat fileStat = {};
+	if (fstat(fileDescriptor, &fileStat) != 0 || fileStat.st_size == 0)
+	{
+		close(fileDescriptor);
+		throw std::runtime_error("ERROR: glTF file is empty.");
+	}
+
+	size = static_cast<size_t>(fileStat.st_size);
+	void* view = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fileDescriptor, 0);
+	if (view == MAP_FAILED)
+	{
+		close(fileDescriptor);
+		throw std::runtime_error("ERROR: Couldn't map glTF file.");
+	}
+
+	data = static_cast<uint8_t const*>(view);
+
+	// Ask the OS to start streaming the whole file in, so page faults don't serialise the loader on disk latency.
+	madvise(view, size, MADV_WILLNEED);
+}
+
+RTMappedFile::~RTMappedFile()
+{
+	munmap(const_cast<uint8_t*>(data), size);
+	close(fileDescriptor);
+}
+
+#endif
+
+namespace {
+
+	/*
+		Minimal JSON document model, sufficient for the glTF JSON chunk.
+	*/
+
+	struct JsonValue {
+
+		enum class Type { Null, Bool, Number, String, Array, Object };
+
+		// Returns the member with the given key, or nullptr if this isn't an object or the key doesn't exist.
+		JsonValue const* Find(char const* key) const
+		{
+			if (type == Type::Object)
+			{
+				for (auto const& member : members)
+				{
+					if (member.first == key)
+					{
+						return &member.second;
+					}
+				}
+			}
+			return nullptr;
+		}
+
+		double GetNumber(char const* key, double fallback) const
+		{
+			JsonValue const* value = Find(key);
+			return (value && value->type == Type::Number) ? value->number : fallback;
+		}
+
+		// Indices and counts must be whole numbers, anything else is rejected before it is cast.
+		size_t GetIndex(char const* key, size_t fallback) const
+		{
+			JsonValue const* value = Find(key);
+			return value ? value->AsIndex() : fallback;
+		}
+
+		size_t AsIndex() const
+		{
+			// 2^53 keeps the number exact, and far above the size of any container it can index.
+			if (type != Type::Number || !(number >= 0.0 && number <= 9007199254740992.0) || std::floor(number) != number)
+			{
+				throw std::runtime_error("ERROR: glTF index or count is not a non-negative whole number.");
+			}
+			return static_cast<size_t>(number);
+		}
+
+		bool Has(char const* key) const { return Find(key) != nullptr; }
+
+		Type type = Type::Null;
+		bool boolean = false;
+		double number = 0.0;
+		std::string string;
+		std::vector<JsonValue> elements;
+		std::vector<std::pair<std::string, JsonValue>> members;
+	};
+
+	class JsonParser {
+
+	public:
+		JsonParser(char const* first, char const* last) : cursor{ first }, end{ last } {}
+
+		JsonValue Parse()
+		{
+			JsonValue root = ParseValue(0);
+			SkipWhitespace();
+			if (cursor != end && *cursor != '\0')
+			{
+				Fail();
+			}
+			return root;
+		}
+
+	private:
+		[[noreturn]] void Fail() const
+		{
+			throw std::runtime_error("ERROR: Malformed glTF JSON chunk.");
+		}
+
+		void SkipWhitespace()
+		{
+			while (cursor != end && (*cursor == ' ' || *cursor == '\t' || *cursor == '\n' || *cursor == '\r'))
+			{
+				++cursor;
+			}
+		}
+
+		void Expect(char c)
+		{
+			SkipWhitespace();
+			if (cursor == end || *cursor != c)
+			{
+				Fail();
+			}
+			++cursor;
+		}
+
+		bool Consume(char const* literal)
+		{
+			size_t length = std::strlen(literal);
+			if (static_cast<size_t>(end - cursor) >= length && std::memcmp(cursor, literal, length) == 0)
+			{
+				cursor += length;
+				return true;
+			}
+			return false;
+		}
+
+		// Skips a ',' between array elements or object members, returns false at the end of the sequence.
+		bool ConsumeSeparator()
+		{
+			SkipWhitespace();
+			if (cursor != end && *cursor == ',')
+			{
+				++cursor;
+				return true;
+			}
+			return false;
+		}
+
+		// Nesting is bounded so a crafted chunk can't exhaust the stack, real glTF files nest a handful of levels.
+		static constexpr uint32_t MaxDepth = 64;
+
+		JsonValue ParseValue(uint32_t depth)
+		{
+			SkipWhitespace();
+			if (cursor == end)
+			{
+				Fail();
+			}
+			if (depth >= MaxDepth && (*cursor == '{' || *cursor == '['))
+			{
+				throw std::runtime_error("ERROR: glTF JSON chunk is nested too deeply.");
+			}
+
+			JsonValue value;
+			switch (*cursor)
+			{
+			case '{':
+				value.type = JsonValue::Type::Object;
+				++cursor;
+				SkipWhitespace();
+				if (cursor != end && *cursor == '}')
+				{
+					++cursor;
+					return value;
+				}
+				while (true)
+				{
+					SkipWhitespace();
+					std::string key = ParseString();
+					Expect(':');
+					value.members.emplace_back(std::move(key), ParseValue(depth + 1));
+					if (!ConsumeSeparator())
+					{
+						break;
+					}
+				}
+				Expect('}');
+				return value;
+
+			case '[':
+				value.type = JsonValue::Type::Array;
+				++cursor;
+				SkipWhitespace();
+				if (cursor != end && *cursor == ']')
+				{
+					++cursor;
+					return value;
+				}
+				while (true)
+				{
+					value.elements.push_back(ParseValue(depth + 1));
+					if (!ConsumeSeparator())
+					{
+						break;
+					}
+				}
+				Expect(']');
+				return value;
+
+			case '"':
+				value.type = JsonValue::Type::String;
+				value.string = ParseString();
+				return value;
+
+			default:
+				if (Consume("true"))
+				{
+					value.type = JsonValue::Type::Bool;
+					value.boolean = true;
+					return value;
+				}
+				if (Consume("false"))
+				{
+					value.type = JsonValue::Type::Bool;
+					return value;
+				}
+				if (Consume("null"))
+				{
+					return value;
+				}
+				value.type = JsonValue::Type::Number;
+				value.number = ParseNumber();
+				return value;
+			}
+		}
+
+		std::string ParseString()
+		{
+			if (cursor == end || *cursor != '"')
+			{
+				Fail();
+			}
+			++cursor;
+
+			std::string result;
+			while (cursor != end && *cursor != '"')
+			{
+				char c = *cursor++;
+				if (c != '\\')
+				{
+					result.push_back(c);
+					continue;
+				}
+
+				if (cursor == end)
+				{
+					Fail();
+				}
+
+				char escaped = *cursor++;
+				switch (escaped)
+				{
+				case 'b': result.push_back('\b'); break;
+				case 'f': result.push_back('\f'); break;
+				case 'n': result.push_back('\n'); break;
+				case 'r': result.push_back('\r'); break;
+				case 't': result.push_back('\t'); break;
+				case 'u':
+				{
+					// Names are only used for debugging, so non-ASCII code points are replaced rather than decoded.
+					if (end - cursor < 4)
+					{
+						Fail();
+					}
+					cursor += 4;
+					result.push_back('?');
+					break;
+				}
+				default: result.push_back(escaped); break;
+				}
+			}
+			Expect('"');
+			return result;
+		}
+
+		double ParseNumber()
+		{
+			char const* start = cursor;
+			while (cursor != end && (std::strchr("+-.eE", *cursor) || (*cursor >= '0' && *cursor <= '9')))
+			{
+				++cursor;
+			}
+			if (start == cursor)
+			{
+				Fail();
+			}
+
+			// The token is copied so strtod can't read past the end of the chunk.
+			std::string token(start, cursor);
+			char* parsedEnd = nullptr;
+			double result = std::strtod(token.c_str(), &parsedEnd);
+			if (parsedEnd != token.c_str() + token.size())
+			{
+				Fail();
+			}
+			return result;
+		}
+
+		char const* cursor;
+		char const* end;
+	};
+
+	/*
+		Binary glTF container and accessor resolution.
+	*/
+
+	constexpr uint32_t GlbMagic = 0x46546C67;		// "glTF"
+	constexpr uint32_t GlbChunkJson = 0x4E4F534A;	// "JSON"
+	constexpr uint32_t GlbChunkBin = 0x004E4942;	// "BIN\0"
+
+	constexpr int ComponentTypeUnsignedByte = 5121;
+	constexpr int ComponentTypeUnsignedShort = 5123;
+	constexpr int ComponentTypeUnsignedInt = 5125;
+	constexpr int ComponentTypeFloat = 5126;
+
+	constexpr int PrimitiveModeTriangles = 4;
+
+	uint32_t ReadU32(uint8_t const* p)
+	{
+		uint32_t value;
+		std::memcpy(&value, p, sizeof(value));
+		return value;
+	}
+
+	size_t ComponentSize(int componentType)
+	{
+		switch (componentType)
+		{
+		case 5120: case ComponentTypeUnsignedByte: return 1;
+		case 5122: case ComponentTypeUnsignedShort: return 2;
+		case ComponentTypeUnsignedInt: case ComponentTypeFloat: return 4;
+		default: throw std::runtime_error("ERROR: Unknown glTF accessor component type.");
+		}
+	}
+
+	size_t ComponentCount(std::string const& type)
+	{
+		if (type == "SCALAR") return 1;
+		if (type == "VEC2") return 2;
+		if (type == "VEC3") return 3;
+		if (type == "VEC4") return 4;
+		if (type == "MAT4") return 16;
+		throw std::runtime_error("ERROR: Unsupported glTF accessor type.");
+	}
+
+	// A strided array of elements inside the binary chunk.
+	struct ResolvedAccessor {
+		uint8_t const* data;
+		size_t stride;
+		size_t count;
+		size_t bufferView;
+		int componentType;
+		size_t components;
+	};
+
+	class AccessorResolver {
+
+	public:
+		AccessorResolver(JsonValue const& root, uint8_t const* binData, size_t binSize) :
+			json{ root }, bin{ binData }, binLength{ binSize }
+		{
+		}
+
+		ResolvedAccessor Resolve(size_t accessorIndex) const
+		{
+			JsonValue const* accessors = json.Find("accessors");
+			if (!accessors || accessorIndex >= accessors->elements.size())
+			{
+				throw std::runtime_error("ERROR: glTF accessor index out of range.");
+			}
+
+			JsonValue const& accessor = accessors->elements[accessorIndex];
+			if (accessor.Has("sparse"))
+			{
+				throw std::runtime_error("ERROR: Sparse glTF accessors are not supported.");
+			}
+
+			JsonValue const* typeValue = accessor.Find("type");
+			if (!typeValue || !accessor.Has("bufferView") || !accessor.Has("count") || !accessor.Has("componentType"))
+			{
+				throw std::runtime_error("ERROR: Incomplete glTF accessor.");
+			}
+
+			ResolvedAccessor resolved = {};
+			resolved.componentType = static_cast<int>(std::min<size_t>(accessor.GetIndex("componentType", 0), INT_MAX));
+			resolved.components = ComponentCount(typeValue->string);
+			resolved.count = accessor.GetIndex("count", 0);
+			resolved.bufferView = accessor.GetIndex("bufferView", 0);
+
+			JsonValue const* bufferViews = json.Find("bufferViews");
+			if (!bufferViews || resolved.bufferView >= bufferViews->elements.size())
+			{
+				throw std::runtime_error("ERROR: glTF buffer view index out of range.");
+			}
+
+			JsonValue const& view = bufferViews->elements[resolved.bufferView];
+			if (view.GetIndex("buffer", 0) != 0 || !bin)
+			{
+				throw std::runtime_error("ERROR: Only the embedded GLB binary buffer is supported.");
+			}
+
+			size_t elementSize = ComponentSize(resolved.componentType) * resolved.components;
+			size_t viewOffset = view.GetIndex("byteOffset", 0);
+			size_t viewLength = view.GetIndex("byteLength", 0);
+			size_t accessorOffset = accessor.GetIndex("byteOffset", 0);
+			resolved.stride = view.GetIndex("byteStride", 0);
+			if (resolved.stride == 0)
+			{
+				resolved.stride = elementSize;
+			}
+			else if (resolved.stride < elementSize || resolved.stride % 4 != 0 || resolved.stride > 252)
+			{
+				// The spec limits strides to multiples of 4 in [4, 252], and an element can't overlap the next.
+				throw std::runtime_error("ERROR: glTF buffer view byteStride is invalid.");
+			}
+
+			// The last element only needs to cover its own size, not a full stride. Every term is compared against
+			// what is left of the range, so crafted offsets and counts can't wrap the sums around.
+			bool viewFits = viewOffset <= binLength && viewLength <= binLength - viewOffset;
+			bool accessorFits = accessorOffset <= viewLength;
+			if (accessorFits && resolved.count > 0)
+			{
+				size_t available = viewLength - accessorOffset;
+				accessorFits = elementSize <= available && resolved.count - 1 <= (available - elementSize) / resolved.stride;
+			}
+			if (!viewFits || !accessorFits)
+			{
+				throw std::runtime_error("ERROR: glTF accessor exceeds the binary chunk.");
+			}
+
+			resolved.data = bin + viewOffset + accessorOffset;
+			return resolved;
+		}
+
+	private:
+		JsonValue const& json;
+		uint8_t const* bin;
+		size_t binLength;
+	};
+
+	/*
+		Attribute conversion.
+	*/
+
+	// Interleaves strided float3 positions and normals into Vertex structures.
+	void InterleaveVertices(ResolvedAccessor const& positions, ResolvedAccessor const* normals, Vertex* out)
+	{
+		size_t count = positions.count;
+		float* dest = reinterpret_cast<float*>(out);
+		size_t i = 0;
+
+#ifdef RT_GLTF_SSE2
+		// Each vertex is moved with two unaligned 16 byte loads and stores. The fourth lane of each store
+		// is overwritten by the next store, so the final vertex is handled by the scalar loop to avoid
+		// reading or writing past the end of either array.
+		if (normals && count > 1)
+		{
+			for (; i + 1 < count; ++i)
+			{
+				__m128 p = _mm_loadu_ps(reinterpret_cast<float const*>(positions.data + i * positions.stride));
+				__m128 n = _mm_loadu_ps(reinterpret_cast<float const*>(normals->data + i * normals->stride));
+				_mm_storeu_ps(dest + i * 6, p);
+				_mm_storeu_ps(dest + i * 6 + 3, n);
+			}
+		}
+#endif
+
+		for (; i < count; ++i)
+		{
+			std::memcpy(dest + i * 6, positions.data + i * positions.stride, 3 * sizeof(float));
+			if (normals)
+			{
+				std::memcpy(dest + i * 6 + 3, normals->data + i * normals->stride, 3 * sizeof(float));
+			}
+			else
+			{
+				dest[i * 6 + 3] = dest[i * 6 + 4] = dest[i * 6 + 5] = 0.f;
+			}
+		}
+	}
+
+	// Widens 8 or 16 bit indices, or repacks strided 32 bit indices, into a tightly packed 32 bit array.
+	void WidenIndices(ResolvedAccessor const& indices, uint32_t* out)
+	{
+		size_t count = indices.count;
+		size_t i = 0;
+
+		switch (indices.componentType)
+		{
+		case ComponentTypeUnsignedShort:
+#ifdef RT_GLTF_SSE2
+			if (indices.stride == 2)
+			{
+				__m128i const zero = _mm_setzero_si128();
+				for (; i + 8 <= count; i += 8)
+				{
+					__m128i packed = _mm_loadu_si128(reinterpret_cast<__m128i const*>(indices.data + i * 2));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_unpacklo_epi16(packed, zero));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 4), _mm_unpackhi_epi16(packed, zero));
+				}
+			}
+#endif
+			for (; i < count; ++i)
+			{
+				uint16_t value;
+				std::memcpy(&value, indices.data + i * indices.stride, sizeof(value));
+				out[i] = value;
+			}
+			break;
+
+		case ComponentTypeUnsignedByte:
+#ifdef RT_GLTF_SSE2
+			if (indices.stride == 1)
+			{
+				__m128i const zero = _mm_setzero_si128();
+				for (; i + 16 <= count; i += 16)
+				{
+					__m128i packed = _mm_loadu_si128(reinterpret_cast<__m128i const*>(indices.data + i));
+					__m128i low = _mm_unpacklo_epi8(packed, zero);
+					__m128i high = _mm_unpackhi_epi8(packed, zero);
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i), _mm_unpacklo_epi16(low, zero));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 4), _mm_unpackhi_epi16(low, zero));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 8), _mm_unpacklo_epi16(high, zero));
+					_mm_storeu_si128(reinterpret_cast<__m128i*>(out + i + 12), _mm_unpackhi_epi16(high, zero));
+				}
+			}
+#endif
+			for (; i < count; ++i)
+			{
+				out[i] = indices.data[i * indices.stride];
+			}
+			break;
+
+		case ComponentTypeUnsignedInt:
+			for (; i < count; ++i)
+			{
+				std::memcpy(out + i, indices.data + i * indices.stride, sizeof(uint32_t));
+			}
+			break;
+
+		default:
+			throw std::runtime_error("ERROR: Unsupported glTF index component type.");
+		}
+	}
+
+	// Accumulates area weighted face normals for primitives which don't provide a NORMAL attribute.
+	void GenerateNormals(std::vector<Vertex>& vertices, RTArrayView<uint32_t> const& indices)
+	{
+		using RTVec3D = RTVector3D::RTVec3DImpl;
+
+		for (size_t t = 0; t + 2 < indices.size; t += 3)
+		{
+			Vertex& v0 = vertices[indices[t]];
+			Vertex& v1 = vertices[indices[t + 1]];
+			Vertex& v2 = vertices[indices[t + 2]];
+
+			RTVec3D faceNormal = RTVector3D::CrossProduct(v1.position - v0.position, v2.position - v0.position);
+			v0.normal += faceNormal;
+			v1.normal += faceNormal;
+			v2.normal += faceNormal;
+		}
+
+		for (Vertex& vertex : vertices)
+		{
+			vertex.normal = vertex.normal.GetNormal();
+		}
+	}
+
+	/*
+		Node transforms.
+	*/
+
+	using RTMatrix4DImpl = RTMatrix4D::RTMatrix4DImpl;
+
+	// Reads a fixed size number array, leaving the defaults in place if the property is missing.
+	void ReadFloatArray(JsonValue const* value, float* out, size_t count)
+	{
+		if (!value || value->elements.size() != count)
+		{
+			return;
+		}
+		for (size_t i = 0; i < count; ++i)
+		{
+			out[i] = static_cast<float>(value->elements[i].number);
+		}
+	}
+
+	// Returns the local transform of a node, using either its matrix or its translation, rotation and scale.
+	RTMatrix4DImpl LocalTransform(JsonValue const& node)
+	{
+		if (JsonValue const* matrix = node.Find("matrix"))
+		{
+			float m[16] = { 1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 0.f, 1.f, 0.f, 0.f, 0.f, 0.f, 1.f };
+			ReadFloatArray(matrix, m, 16);
+
+			// glTF matrices are stored in column major order.
+			return RTMatrix4DImpl{ m[0], m[4], m[8], m[12],
+				m[1], m[5], m[9], m[13],
+				m[2], m[6], m[10], m[14],
+				m[3], m[7], m[11], m[15] };
+		}
+
+		float t[3] = { 0.f, 0.f, 0.f };
+		float r[4] = { 0.f, 0.f, 0.f, 1.f };
+		float s[3] = { 1.f, 1.f, 1.f };
+		ReadFloatArray(node.Find("translation"), t, 3);
+		ReadFloatArray(node.Find("rotation"), r, 4);
+		ReadFloatArray(node.Find("scale"), s, 3);
+
+		float x = r[0], y = r[1], z = r[2], w = r[3];
+
+		// Rotation matrix from a unit quaternion, with each column scaled by the node scale.
+		return RTMatrix4DImpl{
+			(1.f - 2.f * (y * y + z * z)) * s[0], (2.f * (x * y - z * w)) * s[1], (2.f * (x * z + y * w)) * s[2], t[0],
+			(2.f * (x * y + z * w)) * s[0], (1.f - 2.f * (x * x + z * z)) * s[1], (2.f * (y * z - x * w)) * s[2], t[1],
+			(2.f * (x * z - y * w)) * s[0], (2.f * (y * z + x * w)) * s[1], (1.f - 2.f * (x * x + y * y)) * s[2], t[2],
+			0.f, 0.f, 0.f, 1.f };
+	}
+
+	RTGltfPrimitive LoadPrimitive(JsonValue const& primitive, AccessorResolver const& resolver)
+	{
+		JsonValue const* attributes = primitive.Find("attributes");
+		if (!attributes || !attributes->Has("POSITION"))
+		{
+			throw std::runtime_error("ERROR: glTF primitive has no POSITION attribute.");
+		}
+
+		ResolvedAccessor positions = resolver.Resolve(attributes->GetIndex("POSITION", 0));
+		if (positions.componentType != ComponentTypeFloat || positions.components != 3)
+		{
+			throw std::runtime_error("ERROR: glTF positions must be float3, quantised meshes are not supported.");
+		}
+
+		bool hasNormals = attributes->Has("NORMAL");
+		ResolvedAccessor normals = {};
+		if (hasNormals)
+		{
+			normals = resolver.Resolve(attributes->GetIndex("NORMAL", 0));
+			if (normals.componentType != ComponentTypeFloat || normals.components != 3 || normals.count != positions.count)
+			{
+				throw std::runtime_error("ERROR: glTF normals must be float3 and match the position count.");
+			}
+		}
+
+		RTGltfPrimitive result;
+
+		// Vertices can be referenced in place when position and normal are interleaved exactly like Vertex.
+		if (hasNormals &&
+			positions.bufferView == normals.bufferView &&
+			positions.stride == sizeof(Vertex) &&
+			normals.stride == sizeof(Vertex) &&
+			normals.data == positions.data + offsetof(Vertex, normal) &&
+			reinterpret_cast<uintptr_t>(positions.data) % alignof(Vertex) == 0)
+		{
+			result.vertices = RTArrayView<Vertex>{ reinterpret_cast<Vertex const*>(positions.data), positions.count };
+			result.isVertexDataMapped = true;
+		}
+		else
+		{
+			result.convertedVertices.resize(positions.count);
+			InterleaveVertices(positions, hasNormals ? &normals : nullptr, result.convertedVertices.data());
+			result.vertices = RTArrayView<Vertex>{ result.convertedVertices.data(), result.convertedVertices.size() };
+		}
+
+		// Indices can be referenced in place when they are tightly packed 32 bit values.
+		if (primitive.Has("indices"))
+		{
+			ResolvedAccessor indices = resolver.Resolve(primitive.GetIndex("indices", 0));
+			if (indices.components != 1)
+			{
+				throw std::runtime_error("ERROR: glTF indices must be scalar.");
+			}
+
+			if (indices.componentType == ComponentTypeUnsignedInt &&
+				indices.stride == sizeof(uint32_t) &&
+				reinterpret_cast<uintptr_t>(indices.data) % alignof(uint32_t) == 0)
+			{
+				result.indices = RTArrayView<uint32_t>{ reinterpret_cast<uint32_t const*>(indices.data), indices.count };
+				result.isIndexDataMapped = true;
+			}
+			else
+			{
+				result.convertedIndices.resize(indices.count);
+				WidenIndices(indices, result.convertedIndices.data());
+				result.indices = RTArrayView<uint32_t>{ result.convertedIndices.data(), result.convertedIndices.size() };
+			}
+		}
+		else
+		{
+			// Non-indexed triangle lists are given a trivial index buffer, BuildGeometry() always expects one.
+			result.convertedIndices.resize(positions.count);
+			for (size_t i = 0; i < positions.count; ++i)
+			{
+				result.convertedIndices[i] = static_cast<uint32_t>(i);
+			}
+			result.indices = RTArrayView<uint32_t>{ result.convertedIndices.data(), result.convertedIndices.size() };
+		}
+
+		for (uint32_t index : result.indices)
+		{
+			if (index >= result.vertices.size)
+			{
+				throw std::runtime_error("ERROR: glTF index references a vertex out of range.");
+			}
+		}
+
+		if (!hasNormals)
+		{
+			GenerateNormals(result.convertedVertices, result.indices);
+		}
+
+		return result;
+	}
+}
+
+Mesh RTGltfPrimitive::ToMesh() const
+{
+	Mesh mesh;
+	mesh.vertices.assign(vertices.begin(), vertices.end());
+	mesh.indices.assign(indices.begin(), indices.end());
+	return mesh;
+}
+
+RTGltfScene::~RTGltfScene() = default;
+
+std::unique_ptr<RTGltfScene> RTGltfScene::LoadFromFile(std::filesystem::path const& path)
+{
+	std::unique_ptr<RTGltfScene> scene{ new RTGltfScene() };
+	scene->file = std::make_unique<RTMappedFile>(path);
+
+	uint8_t const* data = scene->file->GetData();
+	size_t size = scene->file->GetSize();
+
+	// 12 byte header followed by the JSON chunk header.
+	if (size < 20 || ReadU32(data) != GlbMagic || ReadU32(data + 4) != 2 || ReadU32(data + 8) > size)
+	{
+		throw std::runtime_error("ERROR: Not a glTF 2.0 binary file.");
+	}
+
+	size_t jsonLength = ReadU32(data + 12);
+	if (ReadU32(data + 16) != GlbChunkJson || 20 + jsonLength > size)
+	{
+		throw std::runtime_error("ERROR: glTF binary file has no JSON chunk.");
+	}
+
+	char const* jsonBegin = reinterpret_cast<char const*>(data + 20);
+	JsonValue json = JsonParser{ jsonBegin, jsonBegin + jsonLength }.Parse();
+
+	// The optional binary chunk immediately follows the JSON chunk, which is padded to 4 bytes.
+	uint8_t const* bin = nullptr;
+	size_t binLength = 0;
+	size_t binHeader = 20 + jsonLength;
+	if (binHeader + 8 <= size && ReadU32(data + binHeader + 4) == GlbChunkBin)
+	{
+		binLength = ReadU32(data + binHeader);
+		bin = data + binHeader + 8;
+		if (binHeader + 8 + binLength > size)
+		{
+			throw std::runtime_error("ERROR: glTF binary chunk exceeds the file size.");
+		}
+	}
+
+	AccessorResolver resolver{ json, bin, binLength };
+
+	// Meshes.
+	if (JsonValue const* meshes = json.Find("meshes"))
+	{
+		scene->meshes.reserve(meshes->elements.size());
+		for (JsonValue const& meshJson : meshes->elements)
+		{
+			RTGltfMesh mesh;
+			if (JsonValue const* name = meshJson.Find("name"))
+			{
+				mesh.name = name->string;
+			}
+
+			if (JsonValue const* primitives = meshJson.Find("primitives"))
+			{
+				for (JsonValue const& primitive : primitives->elements)
+				{
+					// Points and lines can't be placed in a triangle acceleration structure.
+					if (primitive.GetNumber("mode", PrimitiveModeTriangles) != PrimitiveModeTriangles)
+					{
+						continue;
+					}
+
+					mesh.primitives.push_back(LoadPrimitive(primitive, resolver));
+
+					RTGltfPrimitive const& loaded = mesh.primitives.back();
+					size_t vertexBytes = loaded.vertices.size * sizeof(Vertex);
+					size_t indexBytes = loaded.indices.size * sizeof(uint32_t);
+					(loaded.isVertexDataMapped ? scene->mappedBytes : scene->convertedBytes) += vertexBytes;
+					(loaded.isIndexDataMapped ? scene->mappedBytes : scene->convertedBytes) += indexBytes;
+				}
+			}
+
+			scene->meshes.push_back(std::move(mesh));
+		}
+	}
+
+	// Flatten the node hierarchy of the default scene into world space instances.
+	JsonValue const* nodes = json.Find("nodes");
+	JsonValue const* scenes = json.Find("scenes");
+	if (nodes && scenes && !scenes->elements.empty())
+	{
+		size_t sceneIndex = json.GetIndex("scene", 0);
+		if (sceneIndex >= scenes->elements.size())
+		{
+			throw std::runtime_error("ERROR: glTF default scene index out of range.");
+		}
+
+		struct PendingNode {
+			size_t index;
+			RTMatrix4DImpl parentTransform;
+		};
+
+		std::vector<PendingNode> stack;
+		if (JsonValue const* roots = scenes->elements[sceneIndex].Find("nodes"))
+		{
+			for (JsonValue const& root : roots->elements)
+			{
+				stack.push_back({ root.AsIndex(), RTMatrix4DImpl{} });
+			}
+		}
+
+		// glTF node graphs are required to be trees, the visit count guards against malformed cyclic files.
+		size_t visited = 0;
+		while (!stack.empty())
+		{
+			PendingNode pending = stack.back();
+			stack.pop_back();
+
+			if (pending.index >= nodes->elements.size() || ++visited > nodes->elements.size())
+			{
+				throw std::runtime_error("ERROR: glTF node hierarchy is invalid.");
+			}
+
+			JsonValue const& node = nodes->elements[pending.index];
+			RTMatrix4DImpl world = pending.parentTransform * LocalTransform(node);
+
+			if (node.Has("mesh"))
+			{
+				size_t meshIndex = node.GetIndex("mesh", 0);
+				if (meshIndex >= scene->meshes.size())
+				{
+					throw std::runtime_error("ERROR: glTF node references a mesh out of range.");
+				}
+				scene->instances.push_back({ static_cast<uint32_t>(meshIndex), world });
+			}
+
+			if (JsonValue const* children = node.Find("children"))
+			{
+				for (JsonValue const& child : children->elements)
+				{
+					stack.push_back({ child.AsIndex(), world });
+				}
+			}
+		}
+	}
+
+	return scene;
+}
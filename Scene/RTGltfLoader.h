@@ -0,0 +1,86 @@
+#pragma once
+
+#include "RTScene.h"
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+/*
+	Loader for binary glTF 2.0 (.glb) files.
+	The file is memory mapped and accessors whose layout already matches the engine's Vertex and
+	32-bit index formats are exposed in place, everything else is converted into owned storage.
+	Specification: https://registry.khronos.org/glTF/specs/2.0/glTF-2.0.html
+*/
+
+// Read-only view over a contiguous array, which either points into the mapped file or into owned storage.
+template<typename T>
+struct RTArrayView {
+
+	RTArrayView() = default;
+	RTArrayView(T const* first, size_t count) : data{ first }, size{ count } {}
+
+	T const* begin() const { return data; }
+	T const* end() const { return data + size; }
+	bool empty() const { return size == 0; }
+	T const& operator[](size_t i) const { return data[i]; }
+
+	T const* data = nullptr;
+	size_t size = 0;
+};
+
+// A single triangle list primitive of a glTF mesh.
+struct RTGltfPrimitive {
+
+	// Copies the primitive into a Mesh, which owns its data and can be modified.
+	Mesh ToMesh() const;
+
+	RTArrayView<Vertex> vertices;
+	RTArrayView<uint32_t> indices;
+
+	// True when the views reference the mapped file rather than the converted storage below.
+	bool isVertexDataMapped = false;
+	bool isIndexDataMapped = false;
+
+	// Backing storage for attributes which had to be converted on load.
+	std::vector<Vertex> convertedVertices;
+	std::vector<uint32_t> convertedIndices;
+};
+
+struct RTGltfMesh {
+	std::string name;
+	std::vector<RTGltfPrimitive> primitives;
+};
+
+class RTGltfScene {
+
+public:
+	// Maps and parses a .glb file, throws std::runtime_error if the file is malformed or uses unsupported features.
+	static std::unique_ptr<RTGltfScene> LoadFromFile(std::filesystem::path const& path);
+
+	~RTGltfScene();
+
+	RTGltfScene(RTGltfScene const&) = delete;
+	RTGltfScene& operator =(RTGltfScene const&) = delete;
+
+	// Total number of bytes which could be referenced without a copy and which had to be converted.
+	size_t GetMappedBytes() const { return mappedBytes; }
+	size_t GetConvertedBytes() const { return convertedBytes; }
+
+	// Meshes are indexed by MeshInstance::meshIndex.
+	std::vector<RTGltfMesh> meshes;
+
+	// One instance per node which references a mesh, with the node hierarchy flattened into world transforms.
+	std::vector<MeshInstance> instances;
+
+private:
+	RTGltfScene() = default;
+
+	// Keeps the views into the binary chunk valid for the lifetime of the scene.
+	std::unique_ptr<class RTMappedFile> file;
+
+	size_t mappedBytes = 0;
+	size_t convertedBytes = 0;
+};
@@ -0,0 +1,363 @@
+#include "RTMeshOptimiser.h"
+#include "../Core/RTParallel.h"
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <utility>
+#include <vector>
+
+namespace RTMeshOptimiser {
+
+	namespace {
+
+		using RTVec3D = RTVector3D::RTVec3DImpl;
+
+		constexpr uint32_t InvalidIndex = std::numeric_limits<uint32_t>::max();
+
+		// Vertex attributes as bit patterns, with negative zero folded into positive zero so they weld together.
+		struct VertexKey {
+			uint32_t bits[6];
+		};
+
+		VertexKey MakeKey(Vertex const& vertex)
+		{
+			VertexKey key;
+			std::memcpy(key.bits, &vertex, sizeof(key.bits));
+			for (uint32_t& b : key.bits)
+			{
+				b = (b == 0x80000000u) ? 0u : b;
+			}
+			return key;
+		}
+
+		bool operator ==(VertexKey const& a, VertexKey const& b)
+		{
+			return std::memcmp(a.bits, b.bits, sizeof(a.bits)) == 0;
+		}
+
+		uint64_t HashKey(VertexKey const& key)
+		{
+			// FNV-1a over the six words, followed by a final avalanche so the top bits can select a shard.
+			uint64_t hash = 14695981039346656037ull;
+			for (uint32_t b : key.bits)
+			{
+				hash = (hash ^ b) * 1099511628211ull;
+			}
+			hash ^= hash >> 33;
+			hash *= 0xff51afd7ed558ccdull;
+			hash ^= hash >> 33;
+			return hash;
+		}
+
+		RTVec3D Centroid(Mesh const& mesh, size_t triangle)
+		{
+			RTVec3D const& a = mesh.vertices[mesh.indices[triangle * 3]].position;
+			RTVec3D const& b = mesh.vertices[mesh.indices[triangle * 3 + 1]].position;
+			RTVec3D const& c = mesh.vertices[mesh.indices[triangle * 3 + 2]].position;
+			return RTVec3D{ (a.x + b.x + c.x) / 3.f, (a.y + b.y + c.y) / 3.f, (a.z + b.z + c.z) / 3.f };
+		}
+
+		void ComputeBounds(Mesh const& mesh, RTVec3D& boundsMin, RTVec3D& boundsMax)
+		{
+			float const maxFloat = std::numeric_limits<float>::max();
+			boundsMin = RTVec3D{ maxFloat, maxFloat, maxFloat };
+			boundsMax = RTVec3D{ -maxFloat, -maxFloat, -maxFloat };
+
+			for (Vertex const& vertex : mesh.vertices)
+			{
+				for (int axis = 0; axis < 3; ++axis)
+				{
+					boundsMin[axis] = std::min(boundsMin[axis], vertex.position[axis]);
+					boundsMax[axis] = std::max(boundsMax[axis], vertex.position[axis]);
+				}
+			}
+		}
+
+		// Spreads the lower 10 bits of v so there are two zero bits between each.
+		uint32_t ExpandBits(uint32_t v)
+		{
+			v = (v * 0x00010001u) & 0xFF0000FFu;
+			v = (v * 0x00000101u) & 0x0F00F00Fu;
+			v = (v * 0x00000011u) & 0xC30C30C3u;
+			v = (v * 0x00000005u) & 0x49249249u;
+			return v;
+		}
+
+		uint32_t MortonCode(RTVec3D const& p, RTVec3D const& boundsMin, RTVec3D const& invExtent)
+		{
+			uint32_t code = 0;
+			for (int axis = 0; axis < 3; ++axis)
+			{
+				float normalised = (p[axis] - boundsMin[axis]) * invExtent[axis];
+				uint32_t quantised = static_cast<uint32_t>(std::min(std::max(normalised * 1024.f, 0.f), 1023.f));
+				code |= ExpandBits(quantised) << (2 - axis);
+			}
+			return code;
+		}
+	}
+
+	size_t WeldVertices(Mesh& mesh)
+	{
+		size_t vertexCount = mesh.vertices.size();
+		if (vertexCount < 2)
+		{
+			return 0;
+		}
+
+		// 1. Hash every vertex in parallel.
+		std::vector<uint64_t> hashes(vertexCount);
+		RTParallel::ParallelFor(vertexCount, 4096, [&](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; ++i)
+				{
+					hashes[i] = HashKey(MakeKey(mesh.vertices[i]));
+				}
+			});
+
+		// 2. Bucket vertices into shards by the top bits of their hash. Identical vertices always share
+		// a shard, so each shard can be deduplicated independently. The counting sort keeps vertices in
+		// ascending order within a shard, so the first vertex seen becomes the canonical one.
+		constexpr size_t shardBits = 6;
+		constexpr size_t shardCount = size_t{ 1 } << shardBits;
+
+		std::vector<size_t> shardStart(shardCount + 1, 0);
+		for (uint64_t hash : hashes)
+		{
+			++shardStart[(hash >> (64 - shardBits)) + 1];
+		}
+		for (size_t shard = 0; shard < shardCount; ++shard)
+		{
+			shardStart[shard + 1] += shardStart[shard];
+		}
+
+		std::vector<uint32_t> shardVertices(vertexCount);
+		{
+			std::vector<size_t> cursor(shardStart.begin(), shardStart.end() - 1);
+			for (size_t i = 0; i < vertexCount; ++i)
+			{
+				shardVertices[cursor[hashes[i] >> (64 - shardBits)]++] = static_cast<uint32_t>(i);
+			}
+		}
+
+		// 3. Deduplicate each shard with an open addressing table.
+		std::vector<uint32_t> canonical(vertexCount);
+		RTParallel::ParallelFor(shardCount, 1, [&](size_t begin, size_t end)
+			{
+				std::vector<uint32_t> table;
+				for (size_t shard = begin; shard < end; ++shard)
+				{
+					size_t first = shardStart[shard];
+					size_t count = shardStart[shard + 1] - first;
+
+					size_t capacity = 16;
+					while (capacity < count * 2)
+					{
+						capacity *= 2;
+					}
+					table.assign(capacity, InvalidIndex);
+
+					for (size_t k = 0; k < count; ++k)
+					{
+						uint32_t vertex = shardVertices[first + k];
+						VertexKey key = MakeKey(mesh.vertices[vertex]);
+						size_t slot = static_cast<size_t>(hashes[vertex]) & (capacity - 1);
+
+						while (true)
+						{
+							uint32_t existing = table[slot];
+							if (existing == InvalidIndex)
+							{
+								table[slot] = vertex;
+								canonical[vertex] = vertex;
+								break;
+							}
+							if (hashes[existing] == hashes[vertex] && MakeKey(mesh.vertices[existing]) == key)
+							{
+								canonical[vertex] = existing;
+								break;
+							}
+							slot = (slot + 1) & (capacity - 1);
+						}
+					}
+				}
+			});
+
+		// 4. Compact the unique vertices, keeping their original relative order.
+		std::vector<uint32_t> remap(vertexCount);
+		std::vector<Vertex> welded;
+		welded.reserve(vertexCount);
+		for (size_t i = 0; i < vertexCount; ++i)
+		{
+			if (canonical[i] == i)
+			{
+				remap[i] = static_cast<uint32_t>(welded.size());
+				welded.push_back(mesh.vertices[i]);
+			}
+			else
+			{
+				remap[i] = remap[canonical[i]];
+			}
+		}
+
+		RTParallel::ParallelFor(mesh.indices.size(), 16384, [&](size_t begin, size_t end)
+			{
+				for (size_t i = begin; i < end; ++i)
+				{
+					mesh.indices[i] = remap[mesh.indices[i]];
+				}
+			});
+
+		size_t removed = vertexCount - welded.size();
+		mesh.vertices = std::move(welded);
+		return removed;
+	}
+
+	void ReorderTrianglesSpatially(Mesh& mesh)
+	{
+		size_t triangleCount = mesh.indices.size() / 3;
+		if (triangleCount < 2)
+		{
+			return;
+		}
+
+		RTVec3D boundsMin, boundsMax;
+		ComputeBounds(mesh, boundsMin, boundsMax);
+
+		RTVec3D invExtent;
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			float extent = boundsMax[axis] - boundsMin[axis];
+			invExtent[axis] = extent > 0.f ? 1.f / extent : 0.f;
+		}
+
+		// Sort keys pair the Morton code with the triangle index, which also makes the order deterministic.
+		std::vector<std::pair<uint32_t, uint32_t>> keys(triangleCount);
+		RTParallel::ParallelFor(triangleCount, 4096, [&](size_t begin, size_t end)
+			{
+				for (size_t t = begin; t < end; ++t)
+				{
+					keys[t] = { MortonCode(Centroid(mesh, t), boundsMin, invExtent), static_cast<uint32_t>(t) };
+				}
+			});
+
+		RTParallel::ParallelSort(keys.begin(), keys.end(), std::less<std::pair<uint32_t, uint32_t>>{});
+
+		std::vector<uint32_t> reordered(triangleCount * 3);
+		RTParallel::ParallelFor(triangleCount, 4096, [&](size_t begin, size_t end)
+			{
+				for (size_t t = begin; t < end; ++t)
+				{
+					size_t source = keys[t].second * size_t{ 3 };
+					reordered[t * 3] = mesh.indices[source];
+					reordered[t * 3 + 1] = mesh.indices[source + 1];
+					reordered[t * 3 + 2] = mesh.indices[source + 2];
+				}
+			});
+
+		// Any trailing indices which don't form a whole triangle are dropped.
+		mesh.indices = std::move(reordered);
+	}
+
+	void ReorderVerticesByFirstUse(Mesh& mesh)
+	{
+		// This pass is inherently sequential, but it is a single linear walk over the index buffer.
+		std::vector<uint32_t> remap(mesh.vertices.size(), InvalidIndex);
+		std::vector<Vertex> reordered;
+		reordered.reserve(mesh.vertices.size());
+
+		for (uint32_t& index : mesh.indices)
+		{
+			if (remap[index] == InvalidIndex)
+			{
+				remap[index] = static_cast<uint32_t>(reordered.size());
+				reordered.push_back(mesh.vertices[index]);
+			}
+			index = remap[index];
+		}
+
+		mesh.vertices = std::move(reordered);
+	}
+
+	float MeasureFetchHitRate(Mesh const& mesh)
+	{
+		// A small FIFO of 64 byte lines approximates the L1 cache seen by the vertex fetches of one shader wave.
+		constexpr size_t cacheLines = 32;
+		constexpr size_t lineSize = 64;
+
+		size_t cache[cacheLines];
+		std::fill(std::begin(cache), std::end(cache), std::numeric_limits<size_t>::max());
+		size_t cacheHead = 0;
+		size_t hits = 0;
+		size_t accesses = 0;
+
+		for (uint32_t index : mesh.indices)
+		{
+			size_t firstLine = index * sizeof(Vertex) / lineSize;
+			size_t lastLine = (index * sizeof(Vertex) + sizeof(Vertex) - 1) / lineSize;
+
+			for (size_t line = firstLine; line <= lastLine; ++line)
+			{
+				++accesses;
+				if (std::find(std::begin(cache), std::end(cache), line) != std::end(cache))
+				{
+					++hits;
+				}
+				else
+				{
+					cache[cacheHead] = line;
+					cacheHead = (cacheHead + 1) % cacheLines;
+				}
+			}
+		}
+
+		return accesses > 0 ? static_cast<float>(hits) / static_cast<float>(accesses) : 0.f;
+	}
+
+	float MeasureTriangleSpread(Mesh const& mesh)
+	{
+		size_t triangleCount = mesh.indices.size() / 3;
+		if (triangleCount < 2)
+		{
+			return 0.f;
+		}
+
+		RTVec3D boundsMin, boundsMax;
+		ComputeBounds(mesh, boundsMin, boundsMax);
+		float diagonal = (boundsMax - boundsMin).Magnitude();
+		if (diagonal <= 0.f)
+		{
+			return 0.f;
+		}
+
+		double total = 0.0;
+		RTVec3D previous = Centroid(mesh, 0);
+		for (size_t t = 1; t < triangleCount; ++t)
+		{
+			RTVec3D current = Centroid(mesh, t);
+			total += (current - previous).Magnitude();
+			previous = current;
+		}
+
+		return static_cast<float>(total / static_cast<double>(triangleCount - 1)) / diagonal;
+	}
+
+	RTMeshOptimiserStats Optimise(Mesh& mesh)
+	{
+		RTMeshOptimiserStats stats;
+		stats.sourceVertexCount = mesh.vertices.size();
+		stats.fetchHitRateBefore = MeasureFetchHitRate(mesh);
+		stats.triangleSpreadBefore = MeasureTriangleSpread(mesh);
+
+		WeldVertices(mesh);
+		ReorderTrianglesSpatially(mesh);
+		ReorderVerticesByFirstUse(mesh);
+
+		stats.optimisedVertexCount = mesh.vertices.size();
+		stats.triangleCount = mesh.indices.size() / 3;
+		stats.fetchHitRateAfter = MeasureFetchHitRate(mesh);
+		stats.triangleSpreadAfter = MeasureTriangleSpread(mesh);
+		return stats;
+	}
+}
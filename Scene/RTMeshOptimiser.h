@@ -0,0 +1,47 @@
+#pragma once
+
+#include "RTScene.h"
+#include <cstddef>
+
+/*
+	Mesh optimisation passes, run on the CPU before geometry is uploaded by BuildGeometry().
+	- Welding merges bitwise identical vertices, which shrinks the vertex buffer.
+	- Spatial reordering sorts triangles along a Morton curve, so neighbouring triangles end up
+	  close together in the BLAS leaves and in the index buffer.
+	- First use reordering renumbers vertices in the order the index buffer references them,
+	  so the vertex fetches in Hit.hlsl for nearby triangles touch nearby memory.
+*/
+
+struct RTMeshOptimiserStats {
+
+	size_t sourceVertexCount = 0;
+	size_t optimisedVertexCount = 0;
+	size_t triangleCount = 0;
+
+	// Fraction of vertex fetches served by a simulated cache of recently touched 64 byte lines, in triangle order.
+	float fetchHitRateBefore = 0.f;
+	float fetchHitRateAfter = 0.f;
+
+	// Mean distance between the centroids of consecutive triangles, relative to the mesh bounding box diagonal.
+	float triangleSpreadBefore = 0.f;
+	float triangleSpreadAfter = 0.f;
+};
+
+namespace RTMeshOptimiser {
+
+	// Runs all passes in order: weld, spatial triangle reorder and vertex first use reorder.
+	RTMeshOptimiserStats Optimise(Mesh& mesh);
+
+	// Merges vertices with identical position and normal, returns the number of vertices removed.
+	size_t WeldVertices(Mesh& mesh);
+
+	// Sorts triangles by the Morton code of their centroid, keeping each triangle's winding.
+	void ReorderTrianglesSpatially(Mesh& mesh);
+
+	// Renumbers vertices by first reference in the index buffer and drops unreferenced ones.
+	void ReorderVerticesByFirstUse(Mesh& mesh);
+
+	// Metrics used in the optimisation statistics, exposed so other passes can report them too.
+	float MeasureFetchHitRate(Mesh const& mesh);
+	float MeasureTriangleSpread(Mesh const& mesh);
+}
@@ -0,0 +1,702 @@
+#include "RTMeshSimplifier.h"
+#include "RTMeshOptimiser.h"
+#include "../Core/RTParallel.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <functional>
+#include <limits>
+#include <unordered_map>
+#include <utility>
+
+namespace {
+
+	using RTVec3D = RTVector3D::RTVec3DImpl;
+
+	constexpr uint32_t InvalidIndex = std::numeric_limits<uint32_t>::max();
+
+	// Vertices on open boundaries get constraint planes this much stronger than surface planes.
+	constexpr double BoundaryWeight = 10.0;
+
+	// Cost added per unit of normal deviation between the collapsed vertex and the one it merges into,
+	// scaled by the squared mean edge length so it is comparable with the positional error.
+	constexpr double NormalWeight = 1.0;
+
+	// Collapses which turn a face normal by more than ~75 degrees are rejected as flips.
+	constexpr float MinFlipCosine = 0.25f;
+
+	// Symmetric 4x4 error quadric, stored as its upper triangle.
+	struct Quadric {
+
+		static Quadric FromPlane(double a, double b, double c, double d, double weight)
+		{
+			Quadric q;
+			q.a2 = a * a * weight; q.ab = a * b * weight; q.ac = a * c * weight; q.ad = a * d * weight;
+			q.b2 = b * b * weight; q.bc = b * c * weight; q.bd = b * d * weight;
+			q.c2 = c * c * weight; q.cd = c * d * weight;
+			q.d2 = d * d * weight;
+			return q;
+		}
+
+		Quadric& operator +=(Quadric const& q)
+		{
+			a2 += q.a2; ab += q.ab; ac += q.ac; ad += q.ad;
+			b2 += q.b2; bc += q.bc; bd += q.bd;
+			c2 += q.c2; cd += q.cd;
+			d2 += q.d2;
+			return *this;
+		}
+
+		// Sum of weighted squared distances from p to the planes of the quadric.
+		double Evaluate(RTVec3D const& p) const
+		{
+			double x = p.x, y = p.y, z = p.z;
+			double result = a2 * x * x + 2.0 * ab * x * y + 2.0 * ac * x * z + 2.0 * ad * x
+				+ b2 * y * y + 2.0 * bc * y * z + 2.0 * bd * y
+				+ c2 * z * z + 2.0 * cd * z
+				+ d2;
+			return std::max(result, 0.0);
+		}
+
+		double a2 = 0, ab = 0, ac = 0, ad = 0;
+		double b2 = 0, bc = 0, bd = 0;
+		double c2 = 0, cd = 0;
+		double d2 = 0;
+	};
+
+	enum class VertexKind : uint8_t {
+		Interior,	// Collapses in any direction.
+		Boundary,	// Only collapses along an open boundary edge onto another boundary vertex.
+		Locked		// Never moves, used for normal seams and non-manifold vertices.
+	};
+
+	struct Collapse {
+		double cost;
+		uint32_t from;
+		uint32_t to;
+	};
+
+	// Squared distance from p to the closest point of the triangle, after Ericson, "Real-Time Collision Detection", 5.1.5.
+	double SquaredDistanceToTriangle(RTVec3D const& p, RTVec3D const& a, RTVec3D const& b, RTVec3D const& c)
+	{
+		RTVec3D ab = b - a;
+		RTVec3D ac = c - a;
+		RTVec3D ap = p - a;
+		float d1 = RTVector3D::DotProduct(ab, ap);
+		float d2 = RTVector3D::DotProduct(ac, ap);
+		RTVec3D closest = a;
+
+		RTVec3D bp = p - b;
+		float d3 = RTVector3D::DotProduct(ab, bp);
+		float d4 = RTVector3D::DotProduct(ac, bp);
+
+		RTVec3D cp = p - c;
+		float d5 = RTVector3D::DotProduct(ab, cp);
+		float d6 = RTVector3D::DotProduct(ac, cp);
+
+		float va = d3 * d6 - d5 * d4;
+		float vb = d5 * d2 - d1 * d6;
+		float vc = d1 * d4 - d3 * d2;
+
+		if (d1 <= 0.f && d2 <= 0.f)
+		{
+			closest = a;
+		}
+		else if (d3 >= 0.f && d4 <= d3)
+		{
+			closest = b;
+		}
+		else if (d6 >= 0.f && d5 <= d6)
+		{
+			closest = c;
+		}
+		else if (vc <= 0.f && d1 >= 0.f && d3 <= 0.f)
+		{
+			closest = a + ab * (d1 / (d1 - d3));
+		}
+		else if (vb <= 0.f && d2 >= 0.f && d6 <= 0.f)
+		{
+			closest = a + ac * (d2 / (d2 - d6));
+		}
+		else if (va <= 0.f && (d4 - d3) >= 0.f && (d5 - d6) >= 0.f)
+		{
+			closest = b + (c - b) * ((d4 - d3) / ((d4 - d3) + (d5 - d6)));
+		}
+		else
+		{
+			float denominator = va + vb + vc;
+			if (denominator <= 0.f)
+			{
+				// Degenerate triangle, whose closest corner is close enough for an error estimate.
+				RTVec3D pa = p - a, pb = p - b, pc = p - c;
+				return static_cast<double>(std::min({ RTVector3D::DotProduct(pa, pa), RTVector3D::DotProduct(pb, pb), RTVector3D::DotProduct(pc, pc) }));
+			}
+			closest = a + ab * (vb / denominator) + ac * (vc / denominator);
+		}
+
+		RTVec3D offset = p - closest;
+		return static_cast<double>(RTVector3D::DotProduct(offset, offset));
+	}
+
+	class Simplifier {
+
+	public:
+		explicit Simplifier(Mesh const& source) : mesh{ source }
+		{
+			WeldMatchingPositions();
+			ClassifyVertices();
+			ComputeQuadrics();
+			RecordSourceSurface();
+		}
+
+		// Collapses edges until the mesh has at most targetTriangleCount triangles or no valid collapse remains.
+		void SimplifyTo(size_t targetTriangleCount)
+		{
+			while (mesh.indices.size() / 3 > targetTriangleCount)
+			{
+				if (!RunPass(targetTriangleCount))
+				{
+					break;
+				}
+			}
+		}
+
+		// Returns a compacted copy of the current mesh, with unreferenced vertices removed.
+		Mesh Snapshot() const
+		{
+			Mesh result = mesh;
+			RTMeshOptimiser::ReorderVerticesByFirstUse(result);
+			return result;
+		}
+
+		// Largest distance from the source mesh's vertices and triangle centres to the current mesh, in mesh units.
+		// The collapse costs only order the collapses: they carry the normal and boundary penalties, and a sum of
+		// weighted squared plane distances which overestimates the distance several times over.
+		// Each source point is measured against the triangles within two rings of the vertex it was collapsed
+		// into, which gives an upper bound of its distance to the whole mesh without searching it.
+		float MeasureError() const
+		{
+			auto DistanceToRing = [this](RTVec3D const& p, uint32_t vertex)
+			{
+				double nearest = std::numeric_limits<double>::infinity();
+				for (uint32_t i = adjacencyStart[vertex]; i < adjacencyStart[vertex + 1]; ++i)
+				{
+					uint32_t const* ring = &mesh.indices[adjacentTriangles[i] * 3];
+					for (int k = 0; k < 3; ++k)
+					{
+						for (uint32_t j = adjacencyStart[ring[k]]; j < adjacencyStart[ring[k] + 1]; ++j)
+						{
+							uint32_t const* triangle = &mesh.indices[adjacentTriangles[j] * 3];
+							nearest = std::min(nearest, SquaredDistanceToTriangle(p,
+								mesh.vertices[triangle[0]].position, mesh.vertices[triangle[1]].position, mesh.vertices[triangle[2]].position));
+						}
+					}
+				}
+				return nearest;
+			};
+
+			double maxSquaredDistance = 0.0;
+			for (uint32_t v : sourceVertices)
+			{
+				double distance = DistanceToRing(mesh.vertices[v].position, owner[v]);
+				maxSquaredDistance = std::max(maxSquaredDistance, std::isfinite(distance) ? distance : 0.0);
+			}
+
+			for (size_t t = 0; t < sourceIndices.size() / 3; ++t)
+			{
+				uint32_t const* triangle = &sourceIndices[t * 3];
+				RTVec3D centre = (mesh.vertices[triangle[0]].position + mesh.vertices[triangle[1]].position + mesh.vertices[triangle[2]].position) / 3.f;
+				double distance = std::min({ DistanceToRing(centre, owner[triangle[0]]), DistanceToRing(centre, owner[triangle[1]]), DistanceToRing(centre, owner[triangle[2]]) });
+				maxSquaredDistance = std::max(maxSquaredDistance, std::isfinite(distance) ? distance : 0.0);
+			}
+
+			return static_cast<float>(std::sqrt(maxSquaredDistance));
+		}
+
+	private:
+		// Merges vertices at the same position whose normals agree, so smooth surfaces which were split only
+		// for numerical reasons (UV sphere seams, poles) are treated as connected.
+		void WeldMatchingPositions()
+		{
+			size_t vertexCount = mesh.vertices.size();
+			positionId.resize(vertexCount);
+			std::vector<uint32_t> canonical(vertexCount);
+
+			std::unordered_map<uint64_t, std::vector<uint32_t>> groups;
+			groups.reserve(vertexCount);
+
+			for (uint32_t v = 0; v < vertexCount; ++v)
+			{
+				RTVec3D const& p = mesh.vertices[v].position;
+				// Adding zero folds -0 into +0, which compare equal but have different bits.
+				float components[3] = { p.x + 0.f, p.y + 0.f, p.z + 0.f };
+				uint32_t bits[3];
+				std::memcpy(bits, components, sizeof(bits));
+				uint64_t key = (uint64_t{ bits[0] } * 73856093u) ^ (uint64_t{ bits[1] } * 19349663u) ^ (uint64_t{ bits[2] } * 83492791u);
+
+				std::vector<uint32_t>& group = groups[key];
+				uint32_t match = InvalidIndex;
+				uint32_t position = InvalidIndex;
+				for (uint32_t other : group)
+				{
+					if (mesh.vertices[other].position == p)
+					{
+						position = positionId[other];
+						if (RTVector3D::DotProduct(mesh.vertices[other].normal, mesh.vertices[v].normal) > 0.999f)
+						{
+							match = canonical[other];
+							break;
+						}
+					}
+				}
+
+				positionId[v] = position != InvalidIndex ? position : v;
+				canonical[v] = match != InvalidIndex ? match : v;
+				group.push_back(v);
+			}
+
+			for (uint32_t& index : mesh.indices)
+			{
+				index = canonical[index];
+			}
+		}
+
+		void BuildAdjacency()
+		{
+			size_t vertexCount = mesh.vertices.size();
+			size_t triangleCount = mesh.indices.size() / 3;
+
+			adjacencyStart.assign(vertexCount + 1, 0);
+			for (uint32_t index : mesh.indices)
+			{
+				++adjacencyStart[index + 1];
+			}
+			for (size_t v = 0; v < vertexCount; ++v)
+			{
+				adjacencyStart[v + 1] += adjacencyStart[v];
+			}
+
+			adjacentTriangles.resize(mesh.indices.size());
+			std::vector<uint32_t> cursor(adjacencyStart.begin(), adjacencyStart.end() - 1);
+			for (size_t t = 0; t < triangleCount; ++t)
+			{
+				for (size_t k = 0; k < 3; ++k)
+				{
+					adjacentTriangles[cursor[mesh.indices[t * 3 + k]]++] = static_cast<uint32_t>(t);
+				}
+			}
+		}
+
+		// Counts the triangles using the directed edge (a, b) in either direction, by vertex position.
+		void CountEdge(uint32_t a, uint32_t b, int& forward, int& backward) const
+		{
+			forward = backward = 0;
+			for (uint32_t i = adjacencyStart[a]; i < adjacencyStart[a + 1]; ++i)
+			{
+				uint32_t const* triangle = &mesh.indices[adjacentTriangles[i] * 3];
+				for (int k = 0; k < 3; ++k)
+				{
+					uint32_t p = triangle[k];
+					uint32_t q = triangle[(k + 1) % 3];
+					forward += (p == a && q == b) ? 1 : 0;
+					backward += (p == b && q == a) ? 1 : 0;
+				}
+			}
+		}
+
+		bool IsBoundaryEdge(uint32_t a, uint32_t b) const
+		{
+			int forward, backward;
+			CountEdge(a, b, forward, backward);
+			return forward + backward == 1;
+		}
+
+		void ClassifyVertices()
+		{
+			BuildAdjacency();
+
+			size_t vertexCount = mesh.vertices.size();
+			kind.assign(vertexCount, VertexKind::Interior);
+
+			// Vertices sharing a position with a vertex of a different normal sit on a seam.
+			std::vector<uint32_t> positionUsers(vertexCount, 0);
+			std::vector<uint8_t> referenced(vertexCount, 0);
+			for (uint32_t index : mesh.indices)
+			{
+				if (!referenced[index])
+				{
+					referenced[index] = 1;
+					++positionUsers[positionId[index]];
+				}
+			}
+
+			RTParallel::ParallelFor(vertexCount, 1024, [&](size_t begin, size_t end)
+				{
+					std::vector<uint32_t> outgoing;
+					std::vector<uint32_t> incoming;
+
+					for (size_t v = begin; v < end; ++v)
+					{
+						if (positionUsers[positionId[v]] > 1)
+						{
+							kind[v] = VertexKind::Locked;
+							continue;
+						}
+
+						// Around a closed manifold vertex every neighbour follows it in exactly one triangle and precedes it
+						// in exactly one other. A neighbour missing from either list means an open edge, a repeated
+						// neighbour means an edge shared by more than two triangles.
+						outgoing.clear();
+						incoming.clear();
+						for (uint32_t i = adjacencyStart[v]; i < adjacencyStart[v + 1]; ++i)
+						{
+							uint32_t const* triangle = &mesh.indices[adjacentTriangles[i] * 3];
+							int k = triangle[0] == v ? 0 : (triangle[1] == v ? 1 : 2);
+							outgoing.push_back(triangle[(k + 1) % 3]);
+							incoming.push_back(triangle[(k + 2) % 3]);
+						}
+
+						std::sort(outgoing.begin(), outgoing.end());
+						std::sort(incoming.begin(), incoming.end());
+						if (std::adjacent_find(outgoing.begin(), outgoing.end()) != outgoing.end() ||
+							std::adjacent_find(incoming.begin(), incoming.end()) != incoming.end())
+						{
+							kind[v] = VertexKind::Locked;
+						}
+						else if (outgoing != incoming)
+						{
+							kind[v] = VertexKind::Boundary;
+						}
+					}
+				});
+		}
+
+		// Keeps the welded source triangles and their vertices, which never move, to measure the error against.
+		void RecordSourceSurface()
+		{
+			sourceIndices = mesh.indices;
+			owner.resize(mesh.vertices.size());
+			for (uint32_t v = 0; v < owner.size(); ++v)
+			{
+				owner[v] = v;
+				if (adjacencyStart[v + 1] > adjacencyStart[v])
+				{
+					sourceVertices.push_back(v);
+				}
+			}
+		}
+
+		void ComputeQuadrics()
+		{
+			size_t vertexCount = mesh.vertices.size();
+			size_t triangleCount = mesh.indices.size() / 3;
+			quadrics.assign(vertexCount, Quadric{});
+
+			// Areas are normalised by the mean, so the quadric error stays in squared mesh units.
+			double totalArea = 0.0;
+			double totalEdgeLength = 0.0;
+			for (size_t t = 0; t < triangleCount; ++t)
+			{
+				RTVec3D const& p0 = mesh.vertices[mesh.indices[t * 3]].position;
+				RTVec3D const& p1 = mesh.vertices[mesh.indices[t * 3 + 1]].position;
+				RTVec3D const& p2 = mesh.vertices[mesh.indices[t * 3 + 2]].position;
+				totalArea += 0.5 * RTVector3D::CrossProduct(p1 - p0, p2 - p0).Magnitude();
+				totalEdgeLength += (p1 - p0).Magnitude() + (p2 - p1).Magnitude() + (p0 - p2).Magnitude();
+			}
+
+			double meanArea = triangleCount > 0 ? std::max(totalArea / static_cast<double>(triangleCount), 1e-30) : 1.0;
+			double meanEdge = triangleCount > 0 ? totalEdgeLength / static_cast<double>(triangleCount * 3) : 1.0;
+			normalCostScale = NormalWeight * meanEdge * meanEdge;
+
+			// Each vertex gathers the planes of its own triangles, which avoids write contention between threads.
+			RTParallel::ParallelFor(vertexCount, 1024, [&](size_t begin, size_t end)
+				{
+					for (size_t v = begin; v < end; ++v)
+					{
+						uint32_t vertex = static_cast<uint32_t>(v);
+						Quadric q;
+
+						for (uint32_t i = adjacencyStart[v]; i < adjacencyStart[v + 1]; ++i)
+						{
+							uint32_t const* triangle = &mesh.indices[adjacentTriangles[i] * 3];
+							RTVec3D const& p0 = mesh.vertices[triangle[0]].position;
+							RTVec3D const& p1 = mesh.vertices[triangle[1]].position;
+							RTVec3D const& p2 = mesh.vertices[triangle[2]].position;
+
+							RTVec3D cross = RTVector3D::CrossProduct(p1 - p0, p2 - p0);
+							double length = cross.Magnitude();
+							if (length <= 0.0)
+							{
+								continue;
+							}
+
+							RTVec3D n = cross / static_cast<float>(length);
+							double weight = 0.5 * length / meanArea;
+							q += Quadric::FromPlane(n.x, n.y, n.z, -RTVector3D::DotProduct(n, p0), weight);
+
+							// Open edges get a plane perpendicular to the surface, which pins the boundary in place.
+							for (int k = 0; k < 3; ++k)
+							{
+								uint32_t a = triangle[k];
+								uint32_t b = triangle[(k + 1) % 3];
+								if ((a == vertex || b == vertex) && kind[a] != VertexKind::Interior && kind[b] != VertexKind::Interior && IsBoundaryEdge(a, b))
+								{
+									RTVec3D const& pa = mesh.vertices[a].position;
+									RTVec3D edgeNormal = RTVector3D::CrossProduct(mesh.vertices[b].position - pa, n).GetNormal();
+									q += Quadric::FromPlane(edgeNormal.x, edgeNormal.y, edgeNormal.z, -RTVector3D::DotProduct(edgeNormal, pa), BoundaryWeight * weight);
+								}
+							}
+						}
+
+						quadrics[v] = q;
+					}
+				});
+		}
+
+		// Returns the cost of moving vertex from onto vertex to, or infinity if the collapse isn't allowed.
+		double CollapseCost(uint32_t from, uint32_t to) const
+		{
+			switch (kind[from])
+			{
+			case VertexKind::Locked:
+				return std::numeric_limits<double>::infinity();
+			case VertexKind::Boundary:
+				if (kind[to] == VertexKind::Interior || !IsBoundaryEdge(from, to))
+				{
+					return std::numeric_limits<double>::infinity();
+				}
+				break;
+			default:
+				break;
+			}
+
+			Quadric q = quadrics[from];
+			q += quadrics[to];
+
+			double normalDeviation = 1.0 - RTVector3D::DotProduct(mesh.vertices[from].normal, mesh.vertices[to].normal);
+			return q.Evaluate(mesh.vertices[to].position) + normalCostScale * std::max(normalDeviation, 0.0);
+		}
+
+		// Checks that none of the triangles around from flip or degenerate when from moves onto to.
+		bool PreservesOrientation(uint32_t from, uint32_t to) const
+		{
+			RTVec3D const& target = mesh.vertices[to].position;
+
+			for (uint32_t i = adjacencyStart[from]; i < adjacencyStart[from + 1]; ++i)
+			{
+				uint32_t const* triangle = &mesh.indices[adjacentTriangles[i] * 3];
+				if (triangle[0] == to || triangle[1] == to || triangle[2] == to)
+				{
+					// This triangle collapses away.
+					continue;
+				}
+
+				RTVec3D before[3], after[3];
+				for (int k = 0; k < 3; ++k)
+				{
+					before[k] = mesh.vertices[triangle[k]].position;
+					after[k] = triangle[k] == from ? target : before[k];
+				}
+
+				RTVec3D oldNormal = RTVector3D::CrossProduct(before[1] - before[0], before[2] - before[0]);
+				RTVec3D newNormal = RTVector3D::CrossProduct(after[1] - after[0], after[2] - after[0]);
+				float oldLength = oldNormal.Magnitude();
+				float newLength = newNormal.Magnitude();
+				if (newLength <= 0.f || oldLength <= 0.f)
+				{
+					return false;
+				}
+				if (RTVector3D::DotProduct(oldNormal, newNormal) < MinFlipCosine * oldLength * newLength)
+				{
+					return false;
+				}
+			}
+			return true;
+		}
+
+		// Runs one round of independent collapses, cheapest first. Returns false if nothing could be collapsed.
+		bool RunPass(size_t targetTriangleCount)
+		{
+			BuildAdjacency();
+
+			size_t triangleCount = mesh.indices.size() / 3;
+
+			// Gather each undirected edge once, from the triangle where it appears with a < b.
+			std::vector<std::pair<uint32_t, uint32_t>> edges;
+			edges.reserve(triangleCount * 3);
+			for (size_t t = 0; t < triangleCount; ++t)
+			{
+				for (int k = 0; k < 3; ++k)
+				{
+					uint32_t a = mesh.indices[t * 3 + k];
+					uint32_t b = mesh.indices[t * 3 + (k + 1) % 3];
+					edges.emplace_back(std::min(a, b), std::max(a, b));
+				}
+			}
+			RTParallel::ParallelSort(edges.begin(), edges.end(), std::less<std::pair<uint32_t, uint32_t>>{});
+			edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+			// Score both directions of every edge in parallel, keeping the cheaper one.
+			std::vector<Collapse> collapses(edges.size());
+			RTParallel::ParallelFor(edges.size(), 1024, [&](size_t begin, size_t end)
+				{
+					for (size_t e = begin; e < end; ++e)
+					{
+						uint32_t a = edges[e].first;
+						uint32_t b = edges[e].second;
+						double costAB = CollapseCost(a, b);
+						double costBA = CollapseCost(b, a);
+						collapses[e] = costAB <= costBA ? Collapse{ costAB, a, b } : Collapse{ costBA, b, a };
+					}
+				});
+
+			collapses.erase(std::remove_if(collapses.begin(), collapses.end(),
+				[](Collapse const& c) { return !std::isfinite(c.cost); }), collapses.end());
+
+			RTParallel::ParallelSort(collapses.begin(), collapses.end(),
+				[](Collapse const& x, Collapse const& y) { return x.cost < y.cost || (x.cost == y.cost && x.from < y.from); });
+
+			// Each collapse locks the one ring of the removed vertex, which holds every triangle it changes,
+			// so collapses within a pass never overlap and the adjacency built at the start of the pass stays valid.
+			std::vector<uint8_t> touched(mesh.vertices.size(), 0);
+			std::vector<uint32_t> remap(mesh.vertices.size());
+			for (uint32_t v = 0; v < remap.size(); ++v)
+			{
+				remap[v] = v;
+			}
+
+			size_t removedTriangles = 0;
+			size_t collapseCount = 0;
+			size_t trianglesToRemove = triangleCount - targetTriangleCount;
+
+			for (Collapse const& collapse : collapses)
+			{
+				if (removedTriangles >= trianglesToRemove)
+				{
+					break;
+				}
+				if (touched[collapse.from] || touched[collapse.to] || !PreservesOrientation(collapse.from, collapse.to))
+				{
+					continue;
+				}
+
+				for (uint32_t i = adjacencyStart[collapse.from]; i < adjacencyStart[collapse.from + 1]; ++i)
+				{
+					uint32_t const* triangle = &mesh.indices[adjacentTriangles[i] * 3];
+					touched[triangle[0]] = touched[triangle[1]] = touched[triangle[2]] = 1;
+
+					if (triangle[0] == collapse.to || triangle[1] == collapse.to || triangle[2] == collapse.to)
+					{
+						++removedTriangles;
+					}
+				}
+
+				remap[collapse.from] = collapse.to;
+				quadrics[collapse.to] += quadrics[collapse.from];
+				++collapseCount;
+			}
+
+			if (collapseCount == 0)
+			{
+				return false;
+			}
+
+			// Collapses in a pass never chain, so one step of the remap finds every vertex's new owner.
+			for (uint32_t& vertex : owner)
+			{
+				vertex = remap[vertex];
+			}
+
+			// Apply the collapses and drop the triangles which became degenerate.
+			size_t writeIndex = 0;
+			for (size_t t = 0; t < triangleCount; ++t)
+			{
+				uint32_t a = remap[mesh.indices[t * 3]];
+				uint32_t b = remap[mesh.indices[t * 3 + 1]];
+				uint32_t c = remap[mesh.indices[t * 3 + 2]];
+				if (a != b && b != c && c != a)
+				{
+					mesh.indices[writeIndex++] = a;
+					mesh.indices[writeIndex++] = b;
+					mesh.indices[writeIndex++] = c;
+				}
+			}
+			mesh.indices.resize(writeIndex);
+
+			// Collapses can create new boundary configurations, so classification is refreshed for the next pass.
+			ClassifyVertices();
+			return true;
+		}
+
+		Mesh mesh;
+		std::vector<uint32_t> positionId;
+		std::vector<VertexKind> kind;
+		std::vector<Quadric> quadrics;
+		std::vector<uint32_t> adjacencyStart;
+		std::vector<uint32_t> adjacentTriangles;
+		double normalCostScale = 0.0;
+
+		// Welded source surface, and the vertex each source vertex has been collapsed into
+		std::vector<uint32_t> sourceIndices;
+		std::vector<uint32_t> sourceVertices;
+		std::vector<uint32_t> owner;
+	};
+}
+
+namespace RTMeshSimplifier {
+
+	Mesh Simplify(Mesh const& mesh, size_t targetTriangleCount, float* outError)
+	{
+		Simplifier simplifier{ mesh };
+		simplifier.SimplifyTo(targetTriangleCount);
+
+		if (outError)
+		{
+			*outError = simplifier.MeasureError();
+		}
+		return simplifier.Snapshot();
+	}
+
+	std::vector<RTMeshLod> BuildLodChain(Mesh const& mesh, std::vector<float> const& targetRatios)
+	{
+		std::vector<RTMeshLod> lods;
+		lods.reserve(targetRatios.size() + 1);
+		lods.push_back(RTMeshLod{ mesh, 1.f, 0.f });
+
+		// A single simplifier walks down the whole chain, so the accumulated quadrics of each level account
+		// for every collapse made by the levels before it, and every level is measured against the source.
+		Simplifier simplifier{ mesh };
+		size_t sourceTriangleCount = mesh.indices.size() / 3;
+
+		for (float ratio : targetRatios)
+		{
+			size_t target = static_cast<size_t>(static_cast<double>(sourceTriangleCount) * std::max(ratio, 0.f));
+			simplifier.SimplifyTo(target);
+			lods.push_back(RTMeshLod{ simplifier.Snapshot(), ratio, simplifier.MeasureError() });
+		}
+
+		return lods;
+	}
+
+	size_t SelectLod(std::vector<RTMeshLod> const& lods, float distance, float verticalFov, float screenHeight, float maxPixelError)
+	{
+		if (lods.empty())
+		{
+			return 0;
+		}
+
+		// Pixels covered by one mesh unit at this distance.
+		float pixelsPerUnit = screenHeight / (2.f * std::max(distance, 1e-6f) * std::tan(0.5f * verticalFov));
+
+		size_t selected = 0;
+		for (size_t i = 1; i < lods.size(); ++i)
+		{
+			if (lods[i].error * pixelsPerUnit <= maxPixelError)
+			{
+				selected = i;
+			}
+		}
+		return selected;
+	}
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "RTScene.h"
+#include <cstddef>
+#include <vector>
+
+/*
+	Quadric error metric mesh simplification, after Garland and Heckbert, "Surface Simplification
+	Using Quadric Error Metrics", SIGGRAPH 1997.
+	Edges are collapsed onto one of their endpoints, so every surviving vertex keeps its original
+	position and normal. Open boundaries only slide along themselves and vertices on normal seams
+	are never moved, so silhouettes and hard edges survive the simplification.
+*/
+
+struct RTMeshLod {
+
+	Mesh mesh;
+
+	// Fraction of the source triangle count this level was built for.
+	float targetRatio = 1.f;
+
+	// Largest distance from the source mesh's vertices and triangle centres to this level's surface, in mesh units.
+	float error = 0.f;
+};
+
+namespace RTMeshSimplifier {
+
+	// Simplifies a mesh to at most targetTriangleCount triangles, if that can be reached without
+	// breaking boundaries or seams. The achieved error, measured as RTMeshLod::error is, is written to
+	// outError when it isn't null.
+	Mesh Simplify(Mesh const& mesh, size_t targetTriangleCount, float* outError = nullptr);
+
+	// Builds a chain of levels of detail, starting with the unmodified mesh at ratio 1.
+	// Each ratio is relative to the source triangle count, and the ratios must be decreasing.
+	std::vector<RTMeshLod> BuildLodChain(Mesh const& mesh, std::vector<float> const& targetRatios);
+
+	// Returns the coarsest level whose error, projected onto the screen at the given distance from
+	// the camera, stays under maxPixelError. The vertical field of view is in radians.
+	size_t SelectLod(std::vector<RTMeshLod> const& lods, float distance, float verticalFov, float screenHeight, float maxPixelError);
+}
@@ -0,0 +1,311 @@
+#include "RTProceduralScene.h"
+#include "../Core/RTParallel.h"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+	using RTVec3D = RTVector3D::RTVec3DImpl;
+
+	constexpr float Pi = 3.14159265358979f;
+
+	// PCG32 random number generator, see https://www.pcg-random.org/
+	class Pcg32 {
+
+	public:
+		explicit Pcg32(uint64_t seed) : state{ 0 }, increment{ (seed << 1u) | 1u }
+		{
+			Next();
+			state += 0x853c49e6748fea9bull + seed;
+			Next();
+		}
+
+		uint32_t Next()
+		{
+			uint64_t oldState = state;
+			state = oldState * 6364136223846793005ull + increment;
+			uint32_t xorShifted = static_cast<uint32_t>(((oldState >> 18u) ^ oldState) >> 27u);
+			uint32_t rotation = static_cast<uint32_t>(oldState >> 59u);
+			return (xorShifted >> rotation) | (xorShifted << ((~rotation + 1u) & 31u));
+		}
+
+		// Returns a float in [0, 1), built from the top 24 bits so every value is exactly representable.
+		float NextFloat()
+		{
+			return static_cast<float>(Next() >> 8) * (1.f / 16777216.f);
+		}
+
+		float NextFloat(float low, float high)
+		{
+			return low + (high - low) * NextFloat();
+		}
+
+	private:
+		uint64_t state;
+		uint64_t increment;
+	};
+
+	// Integer hash of a lattice point, mapped to [0, 1).
+	float LatticeValue(int x, int z, uint32_t seed)
+	{
+		uint32_t h = static_cast<uint32_t>(x) * 0x8da6b343u ^ static_cast<uint32_t>(z) * 0xd8163841u ^ seed * 0xcb1ab31fu;
+		h ^= h >> 16;
+		h *= 0x7feb352du;
+		h ^= h >> 15;
+		h *= 0x846ca68bu;
+		h ^= h >> 16;
+		return static_cast<float>(h >> 8) * (1.f / 16777216.f);
+	}
+
+	float ValueNoise(float x, float z, uint32_t seed)
+	{
+		int x0 = static_cast<int>(std::floor(x));
+		int z0 = static_cast<int>(std::floor(z));
+		float tx = x - static_cast<float>(x0);
+		float tz = z - static_cast<float>(z0);
+
+		// Smoothstep the interpolation weights so the surface normals are continuous.
+		tx = tx * tx * (3.f - 2.f * tx);
+		tz = tz * tz * (3.f - 2.f * tz);
+
+		float a = LatticeValue(x0, z0, seed);
+		float b = LatticeValue(x0 + 1, z0, seed);
+		float c = LatticeValue(x0, z0 + 1, seed);
+		float d = LatticeValue(x0 + 1, z0 + 1, seed);
+
+		return (a + (b - a) * tx) + ((c + (d - c) * tx) - (a + (b - a) * tx)) * tz;
+	}
+
+	// Fractal sum of value noise octaves, in [0, 1).
+	float TerrainHeight(float x, float z, uint32_t seed)
+	{
+		constexpr int octaves = 5;
+		float sum = 0.f;
+		float amplitude = 0.5f;
+		float frequency = 2.f;
+		float total = 0.f;
+
+		for (int octave = 0; octave < octaves; ++octave)
+		{
+			sum += amplitude * ValueNoise(x * frequency, z * frequency, seed + static_cast<uint32_t>(octave));
+			total += amplitude;
+			amplitude *= 0.5f;
+			frequency *= 2.f;
+		}
+
+		return sum / total;
+	}
+
+	// Number of quads per side of a grid with roughly the requested number of triangles.
+	size_t GridResolution(size_t targetTriangleCount)
+	{
+		double quads = static_cast<double>(targetTriangleCount) / 2.0;
+		return std::max<size_t>(1, static_cast<size_t>(std::lround(std::sqrt(quads))));
+	}
+
+	// Builds a (resolution + 1)^2 vertex grid in the XZ plane, with heights and normals from the given function.
+	template<typename THeight>
+	Mesh CreateHeightField(size_t resolution, float size, THeight const& height)
+	{
+		size_t rowVertices = resolution + 1;
+
+		Mesh mesh;
+		mesh.vertices.resize(rowVertices * rowVertices);
+		mesh.indices.resize(resolution * resolution * 6);
+
+		float step = size / static_cast<float>(resolution);
+		float origin = -0.5f * size;
+
+		RTParallel::ParallelFor(rowVertices, 64, [&](size_t begin, size_t end)
+			{
+				for (size_t row = begin; row < end; ++row)
+				{
+					for (size_t column = 0; column < rowVertices; ++column)
+					{
+						float x = origin + static_cast<float>(column) * step;
+						float z = origin + static_cast<float>(row) * step;
+
+						// Central differences of the height function give the surface gradient.
+						float dx = height(x + step, z) - height(x - step, z);
+						float dz = height(x, z + step) - height(x, z - step);
+
+						Vertex& vertex = mesh.vertices[row * rowVertices + column];
+						vertex.position = RTVec3D{ x, height(x, z), z };
+						vertex.normal = RTVec3D{ -dx, 2.f * step, -dz }.GetNormal();
+					}
+				}
+			});
+
+		RTParallel::ParallelFor(resolution, 64, [&](size_t begin, size_t end)
+			{
+				for (size_t row = begin; row < end; ++row)
+				{
+					for (size_t column = 0; column < resolution; ++column)
+					{
+						uint32_t a = static_cast<uint32_t>(row * rowVertices + column);
+						uint32_t b = a + static_cast<uint32_t>(rowVertices);
+						uint32_t* quad = &mesh.indices[(row * resolution + column) * 6];
+
+						quad[0] = a;
+						quad[1] = b;
+						quad[2] = a + 1;
+						quad[3] = a + 1;
+						quad[4] = b;
+						quad[5] = b + 1;
+					}
+				}
+			});
+
+		return mesh;
+	}
+}
+
+namespace RTProceduralGeometry {
+
+	Mesh CreateSphere(size_t targetTriangleCount, float radius)
+	{
+		// With twice as many segments as rings, and no degenerate triangles at the poles,
+		// the sphere has 4 * rings * (rings - 1) triangles.
+		double target = static_cast<double>(targetTriangleCount);
+		size_t rings = std::max<size_t>(2, static_cast<size_t>(std::lround((1.0 + std::sqrt(1.0 + target)) / 2.0)));
+		size_t segments = rings * 2;
+		size_t ringVertices = segments + 1;
+
+		Mesh mesh;
+		mesh.vertices.resize((rings + 1) * ringVertices);
+		mesh.indices.resize(segments * (rings - 1) * 6);
+
+		RTParallel::ParallelFor(rings + 1, 64, [&](size_t begin, size_t end)
+			{
+				for (size_t ring = begin; ring < end; ++ring)
+				{
+					float theta = Pi * static_cast<float>(ring) / static_cast<float>(rings);
+					for (size_t segment = 0; segment < ringVertices; ++segment)
+					{
+						float phi = 2.f * Pi * static_cast<float>(segment) / static_cast<float>(segments);
+						RTVec3D normal{ std::sin(theta) * std::cos(phi), std::cos(theta), std::sin(theta) * std::sin(phi) };
+
+						Vertex& vertex = mesh.vertices[ring * ringVertices + segment];
+						vertex.position = normal * radius;
+						vertex.normal = normal;
+					}
+				}
+			});
+
+		RTParallel::ParallelFor(rings, 64, [&](size_t begin, size_t end)
+			{
+				for (size_t ring = begin; ring < end; ++ring)
+				{
+					// The first and last rings each lose the triangle which would collapse onto the pole.
+					uint32_t* out = mesh.indices.data() + (ring == 0 ? 0 : (ring * 2 - 1) * segments * 3);
+
+					for (size_t segment = 0; segment < segments; ++segment)
+					{
+						uint32_t a = static_cast<uint32_t>(ring * ringVertices + segment);
+						uint32_t b = a + static_cast<uint32_t>(ringVertices);
+
+						if (ring != 0)
+						{
+							*out++ = a;
+							*out++ = a + 1;
+							*out++ = b;
+						}
+						if (ring != rings - 1)
+						{
+							*out++ = a + 1;
+							*out++ = b + 1;
+							*out++ = b;
+						}
+					}
+				}
+			});
+
+		return mesh;
+	}
+
+	Mesh CreateGrid(size_t targetTriangleCount, float size)
+	{
+		return CreateHeightField(GridResolution(targetTriangleCount), size, [](float, float) { return 0.f; });
+	}
+
+	Mesh CreateTerrain(size_t targetTriangleCount, float size, float height, uint32_t seed)
+	{
+		float invSize = 1.f / size;
+		return CreateHeightField(GridResolution(targetTriangleCount), size, [=](float x, float z)
+			{
+				return height * TerrainHeight(x * invSize, z * invSize, seed);
+			});
+	}
+
+	RTProceduralScene CreateScene(RTProceduralSceneDesc const& desc)
+	{
+		RTProceduralScene scene;
+
+		size_t meshCount = std::max<size_t>(desc.uniqueMeshCount, 1);
+		size_t trianglesPerInstance = std::max<size_t>(desc.targetTriangleCount / std::max<size_t>(desc.instanceCount, 1), 2);
+
+		scene.meshes.reserve(meshCount);
+		for (size_t i = 0; i < meshCount; ++i)
+		{
+			switch (i % 3)
+			{
+			case 0:
+				scene.meshes.push_back(CreateSphere(trianglesPerInstance, 1.f));
+				break;
+			case 1:
+				scene.meshes.push_back(CreateGrid(trianglesPerInstance, 2.f));
+				break;
+			default:
+				scene.meshes.push_back(CreateTerrain(trianglesPerInstance, 2.f, 0.5f, desc.seed + static_cast<uint32_t>(i)));
+				break;
+			}
+		}
+
+		// Instance placement is sequential so the same seed always produces the same scene.
+		Pcg32 random{ desc.seed };
+		scene.instances.reserve(desc.instanceCount);
+		for (size_t i = 0; i < desc.instanceCount; ++i)
+		{
+			float x = random.NextFloat(-desc.sceneExtent, desc.sceneExtent);
+			float y = random.NextFloat(-desc.sceneExtent, desc.sceneExtent);
+			float z = random.NextFloat(-desc.sceneExtent, desc.sceneExtent);
+			float yaw = random.NextFloat(0.f, 2.f * Pi);
+			float scale = random.NextFloat(0.5f, 1.5f);
+
+			float c = std::cos(yaw) * scale;
+			float s = std::sin(yaw) * scale;
+
+			MeshInstance instance;
+			instance.meshIndex = static_cast<uint32_t>(i % meshCount);
+			instance.transform = RTMatrix4D::RTMatrix4DImpl{
+				c, 0.f, s, x,
+				0.f, scale, 0.f, y,
+				-s, 0.f, c, z,
+				0.f, 0.f, 0.f, 1.f };
+
+			scene.instances.push_back(instance);
+		}
+
+		return scene;
+	}
+}
+
+size_t RTProceduralScene::GetInstancedTriangleCount() const
+{
+	size_t count = 0;
+	for (MeshInstance const& instance : instances)
+	{
+		count += meshes[instance.meshIndex].indices.size() / 3;
+	}
+	return count;
+}
+
+size_t RTProceduralScene::GetUniqueTriangleCount() const
+{
+	size_t count = 0;
+	for (Mesh const& mesh : meshes)
+	{
+		count += mesh.indices.size() / 3;
+	}
+	return count;
+}
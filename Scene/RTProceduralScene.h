@@ -0,0 +1,58 @@
+#pragma once
+
+#include "RTScene.h"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+/*
+	Procedural geometry for stress testing and scaling measurements.
+	Every generator is deterministic for a given seed on every platform, the random numbers come
+	from an internal PCG32 generator rather than the standard library distributions, whose output
+	is implementation defined.
+*/
+
+// Parameters of a scene made of instanced procedural meshes.
+struct RTProceduralSceneDesc {
+
+	// Total triangle count over all instances, after instancing.
+	size_t targetTriangleCount = 1000;
+
+	// Number of instances scattered through the scene, each references one of the unique meshes.
+	size_t instanceCount = 1;
+
+	// Number of unique meshes, cycling through sphere, grid and terrain shapes.
+	size_t uniqueMeshCount = 1;
+
+	// Instances are placed uniformly inside a cube of this half extent, centred on the origin.
+	float sceneExtent = 50.f;
+
+	uint32_t seed = 1;
+};
+
+struct RTProceduralScene {
+
+	// Number of triangles traced, counting every instance of a mesh separately.
+	size_t GetInstancedTriangleCount() const;
+
+	// Number of triangles stored in the unique meshes.
+	size_t GetUniqueTriangleCount() const;
+
+	std::vector<Mesh> meshes;
+	std::vector<MeshInstance> instances;
+};
+
+namespace RTProceduralGeometry {
+
+	// UV sphere centred on the origin, with roughly the requested number of triangles.
+	Mesh CreateSphere(size_t targetTriangleCount, float radius);
+
+	// Flat grid in the XZ plane centred on the origin, facing +Y.
+	Mesh CreateGrid(size_t targetTriangleCount, float size);
+
+	// Grid displaced along +Y by fractal value noise.
+	Mesh CreateTerrain(size_t targetTriangleCount, float size, float height, uint32_t seed);
+
+	// Splits the triangle budget evenly over the instances and scatters them with random position, rotation and scale.
+	RTProceduralScene CreateScene(RTProceduralSceneDesc const& desc);
+}
@@ -1,6 +1,8 @@
 #pragma once
 
 #include "../Math/RTMath.h"
+#include <cstdint>
+#include <vector>
 
 struct SceneConstantBuffer {
 	using Matrix4D = RTMatrix4D::RTMatrix4DImpl;
@@ -13,10 +15,39 @@ struct SceneConstantBuffer {
 	Vector4D lightDiffuseColour;
 };
 
-struct ObjectConstantBuffer {
-	using Vector4D = RTVector4D::RTVec4DImpl;
+// Progressive accumulation of RayGen.hlsl, root constants set for every dispatch.
+struct AccumulationConstants {
+	// Samples already averaged in the accumulation buffer, 0 discards them
+	uint32_t sampleIndex = 0;
 
-	Vector4D colour; 
+	// Samples the image converges at, after which the buffer is output without tracing. 0 disables
+	// accumulation, tracing one sample at every pixel centre.
+	uint32_t sampleCount = 0;
+};
+
+// Diffuse bounces a path can take at most, which RayGen.hlsl's ray counters are sized for.
+constexpr uint32_t MaxPathBounces = 15;
+
+// Rays traced at every depth of the paths, from the primary rays at depth 0 to the last bounce, shadow rays
+// toward the light counted at the depth of the hit they start from.
+constexpr uint32_t RayCounterCount = MaxPathBounces + 1;
+
+// Integrator of RayGen.hlsl, root constants set for every dispatch.
+struct PathTracingConstants {
+	// 0 shades the primary hit with the Lambert lighting of Hit.hlsl, with its ambient term and without shadows.
+	// Otherwise paths are traced with next event estimation toward the light, taking up to maxBounces diffuse
+	// bounces after the primary hit, and the sky lights the rays which miss.
+	uint32_t enabled = 0;
+	uint32_t maxBounces = 0;
+
+	// Samples of every pixel traced by each dispatch, jittered within the pixel when there is more than one.
+	// An accumulated image converges at samplesPerPixel times AccumulationConstants::sampleCount samples.
+	uint32_t samplesPerPixel = 1;
+
+	// Radiant intensity of the point light per unit of its diffuse colour, lighting the path traced hits with
+	// the inverse square falloff. 4 pi lights a white surface facing the light from 2 units away, the distance
+	// in the default scene, as brightly as the Lambert shading does.
+	float lightIntensity = 12.5663706f;
 };
 
 struct Vertex {
@@ -24,4 +55,25 @@ struct Vertex {
 
 	Vector3D position; 
 	Vector3D normal;
-};
\ No newline at end of file
+};
+
+// The vertex layout is shared with Hit.hlsl and the glTF loader, so it must stay tightly packed.
+static_assert(sizeof(Vertex) == 6 * sizeof(float), "Vertex must be two tightly packed float3s.");
+
+// Triangle list geometry, owned on the CPU until it is uploaded to the GPU.
+struct Mesh {
+	std::vector<Vertex> vertices;
+	std::vector<uint32_t> indices;
+};
+
+// A placement of a mesh in the scene, the transform is row major with the translation in the last column.
+struct MeshInstance {
+	using Matrix4D = RTMatrix4D::RTMatrix4DImpl;
+	using Vector4D = RTVector4D::RTVec4DImpl;
+
+	uint32_t meshIndex;
+	Matrix4D transform;
+
+	// Diffuse colour, passed to the hit shader through the instance's hit group record
+	Vector4D colour{ 1.f, 1.f, 1.f, 1.f };
+};
@@ -3,9 +3,12 @@
 // Note that the payload should be kept as small as possible,
 // and that its size must be declared in the corresponding
 // D3D12_RAYTRACING_SHADER_CONFIG pipeline subobjet.
+// When path tracing, the hit shader leaves the lighting to the ray generation shader
+// and returns the surface colour and the world space normal, packed into 32 bits.
 struct HitInfo
 {
   float4 colorAndDistance;
+  uint packedNormal;
 };
 
 // Attributes output by the raytracing when hitting a surface,
@@ -14,3 +17,30 @@ struct Attributes
 {
   float2 bary;
 };
+
+// Octahedral encoding of a unit vector in two 16 bit signed normalised components.
+// The error is below a hundredth of a degree, far finer than the shading needs.
+uint PackNormal(float3 normal)
+{
+    float2 octahedral = normal.xy / (abs(normal.x) + abs(normal.y) + abs(normal.z));
+    if (normal.z < 0.0)
+    {
+        float2 signs = float2(octahedral.x >= 0.0 ? 1.0 : -1.0, octahedral.y >= 0.0 ? 1.0 : -1.0);
+        octahedral = (1.0 - abs(octahedral.yx)) * signs;
+    }
+    int2 snorm = int2(round(clamp(octahedral, -1.0, 1.0) * 32767.0));
+    return (uint(snorm.x) & 0xffff) | (uint(snorm.y) << 16);
+}
+
+float3 UnpackNormal(uint packedNormal)
+{
+    // The arithmetic shifts sign extend the 16 bit components
+    float2 octahedral = float2(int2(packedNormal << 16, packedNormal) >> 16) * (1.0 / 32767.0);
+    float3 normal = float3(octahedral, 1.0 - abs(octahedral.x) - abs(octahedral.y));
+    if (normal.z < 0.0)
+    {
+        float2 signs = float2(normal.x >= 0.0 ? 1.0 : -1.0, normal.y >= 0.0 ? 1.0 : -1.0);
+        normal.xy = (1.0 - abs(normal.yx)) * signs;
+    }
+    return normalize(normal);
+}
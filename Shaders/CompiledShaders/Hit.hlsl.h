@@ -1,291 +0,0 @@
-#if 0
-; shader hash: 82474f5a9157948c1fc0caef4bca36b7
-;
-; Buffer Definitions:
-;
-;
-; Resource Bindings:
-;
-; Name                                 Type  Format         Dim      ID      HLSL Bind  Count
-; ------------------------------ ---------- ------- ----------- ------- -------------- ------
-;
-target datalayout = "e-m:e-p:32:32-i1:32-i8:32-i16:32-i32:32-i64:64-f16:32-f32:32-f64:64-n8:16:32:64"
-target triple = "dxil-ms-dx"
-
-%struct.HitInfo = type { <4 x float> }
-%struct.Attributes = type { <2 x float> }
-
-; Function Attrs: nounwind
-define void @"\01?ClosestHit@@YAXUHitInfo@@UAttributes@@@Z"(%struct.HitInfo* noalias nocapture %payload, %struct.Attributes* nocapture readnone %attrib) #0 {
-  %1 = call float @dx.op.rayTCurrent.f32(i32 154)  ; RayTCurrent()
-  %2 = insertelement <4 x float> <float 1.000000e+00, float 1.000000e+00, float 0.000000e+00, float undef>, float %1, i64 3
-  %3 = getelementptr inbounds %struct.HitInfo, %struct.HitInfo* %payload, i32 0, i32 0
-  store <4 x float> %2, <4 x float>* %3, align 4
-  ret void
-}
-
-; Function Attrs: nounwind readonly
-declare float @dx.op.rayTCurrent.f32(i32) #1
-
-attributes #0 = { nounwind }
-attributes #1 = { nounwind readonly }
-
-!llvm.ident = !{!0}
-!dx.version = !{!1}
-!dx.valver = !{!2}
-!dx.shaderModel = !{!3}
-!dx.typeAnnotations = !{!4}
-!dx.entryPoints = !{!10, !11}
-
-!0 = !{!"clang version 3.7 (tags/RELEASE_370/final)"}
-!1 = !{i32 1, i32 4}
-!2 = !{i32 1, i32 7}
-!3 = !{!"lib", i32 6, i32 4}
-!4 = !{i32 1, void (%struct.HitInfo*, %struct.Attributes*)* @"\01?ClosestHit@@YAXUHitInfo@@UAttributes@@@Z", !5}
-!5 = !{!6, !8, !9}
-!6 = !{i32 1, !7, !7}
-!7 = !{}
-!8 = !{i32 2, !7, !7}
-!9 = !{i32 0, !7, !7}
-!10 = !{null, !"", null, null, null}
-!11 = !{void (%struct.HitInfo*, %struct.Attributes*)* @"\01?ClosestHit@@YAXUHitInfo@@UAttributes@@@Z", !"\01?ClosestHit@@YAXUHitInfo@@UAttributes@@@Z", null, null, !12}
-!12 = !{i32 8, i32 10, i32 6, i32 16, i32 7, i32 8, i32 5, !13}
-!13 = !{i32 0}
-
-#endif
-
-const unsigned char g_pHit[] = {
-  0x44, 0x58, 0x42, 0x43, 0x57, 0xa4, 0xdd, 0xb3, 0x90, 0x7e, 0x4e, 0x81,
-  0x2d, 0x08, 0x36, 0x48, 0x6d, 0xba, 0xf0, 0xbc, 0x01, 0x00, 0x00, 0x00,
-  0xe8, 0x0a, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x34, 0x00, 0x00, 0x00,
-  0x44, 0x00, 0x00, 0x00, 0xd8, 0x00, 0x00, 0x00, 0xd4, 0x05, 0x00, 0x00,
-  0xf0, 0x05, 0x00, 0x00, 0x53, 0x46, 0x49, 0x30, 0x08, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x52, 0x44, 0x41, 0x54,
-  0x8c, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
-  0x10, 0x00, 0x00, 0x00, 0x50, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
-  0x38, 0x00, 0x00, 0x00, 0x00, 0x01, 0x3f, 0x43, 0x6c, 0x6f, 0x73, 0x65,
-  0x73, 0x74, 0x48, 0x69, 0x74, 0x40, 0x40, 0x59, 0x41, 0x58, 0x55, 0x48,
-  0x69, 0x74, 0x49, 0x6e, 0x66, 0x6f, 0x40, 0x40, 0x55, 0x41, 0x74, 0x74,
-  0x72, 0x69, 0x62, 0x75, 0x74, 0x65, 0x73, 0x40, 0x40, 0x40, 0x5a, 0x00,
-  0x43, 0x6c, 0x6f, 0x73, 0x65, 0x73, 0x74, 0x48, 0x69, 0x74, 0x00, 0x00,
-  0x04, 0x00, 0x00, 0x00, 0x34, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
-  0x2c, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x2c, 0x00, 0x00, 0x00,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x0a, 0x00, 0x00, 0x00,
-  0x10, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x04, 0x00, 0x00, 0x63, 0x00, 0x0a, 0x00,
-  0x53, 0x54, 0x41, 0x54, 0xf4, 0x04, 0x00, 0x00, 0x64, 0x00, 0x06, 0x00,
-  0x3d, 0x01, 0x00, 0x00, 0x44, 0x58, 0x49, 0x4c, 0x04, 0x01, 0x00, 0x00,
-  0x10, 0x00, 0x00, 0x00, 0xdc, 0x04, 0x00, 0x00, 0x42, 0x43, 0xc0, 0xde,
-  0x21, 0x0c, 0x00, 0x00, 0x34, 0x01, 0x00, 0x00, 0x0b, 0x82, 0x20, 0x00,
-  0x02, 0x00, 0x00, 0x00, 0x13, 0x00, 0x00, 0x00, 0x07, 0x81, 0x23, 0x91,
-  0x41, 0xc8, 0x04, 0x49, 0x06, 0x10, 0x32, 0x39, 0x92, 0x01, 0x84, 0x0c,
-  0x25, 0x05, 0x08, 0x19, 0x1e, 0x04, 0x8b, 0x62, 0x80, 0x10, 0x45, 0x02,
-  0x42, 0x92, 0x0b, 0x42, 0x84, 0x10, 0x32, 0x14, 0x38, 0x08, 0x18, 0x4b,
-  0x0a, 0x32, 0x42, 0x88, 0x48, 0x90, 0x14, 0x20, 0x43, 0x46, 0x88, 0xa5,
-  0x00, 0x19, 0x32, 0x42, 0xe4, 0x48, 0x0e, 0x90, 0x11, 0x22, 0xc4, 0x50,
-  0x41, 0x51, 0x81, 0x8c, 0xe1, 0x83, 0xe5, 0x8a, 0x04, 0x21, 0x46, 0x06,
-  0x51, 0x18, 0x00, 0x00, 0x09, 0x00, 0x00, 0x00, 0x1b, 0x8c, 0x20, 0x00,
-  0x12, 0x60, 0xd9, 0x60, 0x08, 0x02, 0xb0, 0x00, 0xd4, 0x06, 0x62, 0xf8,
-  0xff, 0xff, 0xff, 0xff, 0x01, 0x90, 0x36, 0x18, 0xc4, 0xff, 0xff, 0xff,
-  0xff, 0x0f, 0x80, 0x04, 0x54, 0x00, 0x00, 0x00, 0x49, 0x18, 0x00, 0x00,
-  0x02, 0x00, 0x00, 0x00, 0x13, 0x86, 0x40, 0x18, 0x26, 0x04, 0x04, 0x00,
-  0x89, 0x20, 0x00, 0x00, 0x16, 0x00, 0x00, 0x00, 0x32, 0x22, 0x08, 0x09,
-  0x20, 0x64, 0x85, 0x04, 0x13, 0x22, 0xa4, 0x84, 0x04, 0x13, 0x22, 0xe3,
-  0x84, 0xa1, 0x90, 0x14, 0x12, 0x4c, 0x88, 0x8c, 0x0b, 0x84, 0x84, 0x4c,
-  0x10, 0x38, 0x23, 0x00, 0x33, 0x00, 0xc3, 0x08, 0x44, 0x70, 0x8e, 0x34,
-  0x45, 0x94, 0x30, 0xf9, 0x21, 0x32, 0x89, 0x4d, 0xe1, 0xa0, 0x40, 0x68,
-  0x86, 0x11, 0x84, 0xe0, 0x22, 0x69, 0x8a, 0x28, 0x61, 0xf2, 0xb5, 0x69,
-  0x8a, 0x90, 0x80, 0x9a, 0x08, 0x09, 0x05, 0x45, 0x56, 0x06, 0xa0, 0x23,
-  0x9c, 0x23, 0x00, 0x83, 0x22, 0x84, 0xd2, 0x0e, 0x04, 0x00, 0x00, 0x00,
-  0x13, 0x14, 0x72, 0xc0, 0x87, 0x74, 0x60, 0x87, 0x36, 0x68, 0x87, 0x79,
-  0x68, 0x03, 0x72, 0xc0, 0x87, 0x0d, 0xaf, 0x50, 0x0e, 0x6d, 0xd0, 0x0e,
-  0x7a, 0x50, 0x0e, 0x6d, 0x00, 0x0f, 0x7a, 0x30, 0x07, 0x72, 0xa0, 0x07,
-  0x73, 0x20, 0x07, 0x6d, 0x90, 0x0e, 0x71, 0xa0, 0x07, 0x73, 0x20, 0x07,
-  0x6d, 0x90, 0x0e, 0x78, 0xa0, 0x07, 0x73, 0x20, 0x07, 0x6d, 0x90, 0x0e,
-  0x71, 0x60, 0x07, 0x7a, 0x30, 0x07, 0x72, 0xd0, 0x06, 0xe9, 0x30, 0x07,
-  0x72, 0xa0, 0x07, 0x73, 0x20, 0x07, 0x6d, 0x90, 0x0e, 0x76, 0x40, 0x07,
-  0x7a, 0x60, 0x07, 0x74, 0xd0, 0x06, 0xe6, 0x10, 0x07, 0x76, 0xa0, 0x07,
-  0x73, 0x20, 0x07, 0x6d, 0x60, 0x0e, 0x73, 0x20, 0x07, 0x7a, 0x30, 0x07,
-  0x72, 0xd0, 0x06, 0xe6, 0x60, 0x07, 0x74, 0xa0, 0x07, 0x76, 0x40, 0x07,
-  0x6d, 0xe0, 0x0e, 0x78, 0xa0, 0x07, 0x71, 0x60, 0x07, 0x7a, 0x30, 0x07,
-  0x72, 0xa0, 0x07, 0x76, 0x40, 0x07, 0x43, 0x1e, 0x04, 0x08, 0x80, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x86, 0x3c, 0x0b, 0x10, 0x00,
-  0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x64, 0x81, 0x00, 0x00,
-  0x0b, 0x00, 0x00, 0x00, 0x32, 0x1e, 0x98, 0x14, 0x19, 0x11, 0x4c, 0x90,
-  0x8c, 0x09, 0x26, 0x47, 0xc6, 0x04, 0x43, 0xd2, 0x52, 0x28, 0x8a, 0x12,
-  0x28, 0x84, 0x11, 0x80, 0x62, 0x28, 0x90, 0x32, 0x28, 0x87, 0x92, 0x28,
-  0x88, 0x22, 0x20, 0x9b, 0x01, 0xa0, 0x99, 0x01, 0x00, 0x00, 0x00, 0x00,
-  0x79, 0x18, 0x00, 0x00, 0x62, 0x00, 0x00, 0x00, 0x1a, 0x03, 0x4c, 0x90,
-  0x46, 0x02, 0x13, 0x44, 0x35, 0x18, 0x63, 0x0b, 0x73, 0x3b, 0x03, 0xb1,
-  0x2b, 0x93, 0x9b, 0x4b, 0x7b, 0x73, 0x03, 0x99, 0x71, 0xb9, 0x01, 0x41,
-  0xa1, 0x0b, 0x3b, 0x9b, 0x7b, 0x91, 0x2a, 0x62, 0x2a, 0x0a, 0x9a, 0x2a,
-  0xfa, 0x9a, 0xb9, 0x81, 0x79, 0x31, 0x4b, 0x73, 0x0b, 0x63, 0x4b, 0xd9,
-  0x10, 0x04, 0x13, 0x04, 0x85, 0x98, 0x20, 0x28, 0xc5, 0x06, 0x61, 0x20,
-  0x26, 0x08, 0x8a, 0xb1, 0x41, 0x30, 0x0c, 0x0e, 0x6c, 0x69, 0x62, 0x13,
-  0x04, 0xe5, 0xd8, 0x30, 0x20, 0x09, 0x31, 0x41, 0x18, 0x9e, 0x09, 0x82,
-  0x82, 0x10, 0x1a, 0x7b, 0x63, 0x7b, 0x93, 0x0b, 0x72, 0x23, 0x23, 0x4a,
-  0x9b, 0xa3, 0x0b, 0x73, 0x1b, 0x2b, 0x9b, 0x20, 0x28, 0xc9, 0x04, 0x41,
-  0x51, 0x26, 0x08, 0xca, 0xb2, 0xc1, 0x48, 0x1a, 0xc7, 0x78, 0xa0, 0x0d,
-  0x02, 0x13, 0x4d, 0x10, 0x0c, 0x67, 0x82, 0xa0, 0x30, 0x24, 0xc4, 0xc2,
-  0xe4, 0xf2, 0x36, 0x18, 0x49, 0xe5, 0x18, 0x0f, 0xb4, 0x41, 0xa0, 0xac,
-  0x0d, 0x85, 0xb1, 0x48, 0xd3, 0x35, 0x41, 0x48, 0x80, 0x0d, 0xc0, 0x86,
-  0x61, 0xd0, 0xb4, 0x09, 0x82, 0xd2, 0x6c, 0x18, 0x38, 0x4d, 0xdb, 0x30,
-  0x18, 0x9a, 0xb6, 0x61, 0xd8, 0x3a, 0x6f, 0xc3, 0x30, 0x64, 0x1f, 0x81,
-  0x0d, 0x05, 0x10, 0x06, 0x00, 0x00, 0x50, 0x0d, 0x02, 0x7e, 0x86, 0xd8,
-  0xde, 0xe6, 0xca, 0xe6, 0xe8, 0x90, 0xd2, 0xe8, 0x80, 0x80, 0xb2, 0x82,
-  0xb0, 0xaa, 0x90, 0xd2, 0xe8, 0x92, 0xdc, 0xcc, 0xde, 0x80, 0x80, 0xaa,
-  0x82, 0xe8, 0xe8, 0xe4, 0xd2, 0xc4, 0xea, 0xe8, 0xca, 0xe6, 0x80, 0x80,
-  0x80, 0xb4, 0x26, 0x08, 0xca, 0x30, 0x41, 0x50, 0x84, 0x0d, 0x81, 0xb1,
-  0x01, 0xa1, 0xc8, 0x20, 0x61, 0x1e, 0xaa, 0x0c, 0xcc, 0x60, 0x43, 0x91,
-  0x8d, 0x01, 0x00, 0x9c, 0x01, 0x8b, 0x34, 0xb7, 0x39, 0xba, 0xb9, 0x0d,
-  0x42, 0x1a, 0x94, 0x41, 0x15, 0x36, 0x36, 0xbb, 0x36, 0x97, 0x34, 0xb2,
-  0x32, 0x37, 0xba, 0x29, 0x41, 0x50, 0x85, 0x0c, 0xcf, 0xc5, 0xae, 0x4c,
-  0x6e, 0x2e, 0xed, 0xcd, 0x6d, 0x4a, 0x40, 0x34, 0x21, 0xc3, 0x73, 0xb1,
-  0x0b, 0x63, 0xb3, 0x2b, 0x93, 0x9b, 0x12, 0x18, 0x75, 0xc8, 0xf0, 0x5c,
-  0xe6, 0xd0, 0xc2, 0xc8, 0xca, 0xe4, 0x9a, 0xde, 0xc8, 0xca, 0xd8, 0xa6,
-  0x04, 0x49, 0x25, 0x32, 0x3c, 0x17, 0xba, 0x3c, 0xb8, 0xb2, 0x20, 0x37,
-  0xb7, 0x37, 0xba, 0x30, 0xba, 0xb4, 0x37, 0xb7, 0xb9, 0x29, 0xc2, 0xf5,
-  0xd5, 0x21, 0xc3, 0x73, 0x29, 0x73, 0xa3, 0x93, 0xcb, 0x83, 0x7a, 0x4b,
-  0x73, 0xa3, 0x9b, 0x9b, 0x22, 0x84, 0xc1, 0x19, 0x74, 0x21, 0xc3, 0x73,
-  0x19, 0x7b, 0xab, 0x73, 0xa3, 0x2b, 0x93, 0x9b, 0x9b, 0x12, 0xa4, 0x01,
-  0x00, 0x00, 0x00, 0x00, 0x79, 0x18, 0x00, 0x00, 0x49, 0x00, 0x00, 0x00,
-  0x33, 0x08, 0x80, 0x1c, 0xc4, 0xe1, 0x1c, 0x66, 0x14, 0x01, 0x3d, 0x88,
-  0x43, 0x38, 0x84, 0xc3, 0x8c, 0x42, 0x80, 0x07, 0x79, 0x78, 0x07, 0x73,
-  0x98, 0x71, 0x0c, 0xe6, 0x00, 0x0f, 0xed, 0x10, 0x0e, 0xf4, 0x80, 0x0e,
-  0x33, 0x0c, 0x42, 0x1e, 0xc2, 0xc1, 0x1d, 0xce, 0xa1, 0x1c, 0x66, 0x30,
-  0x05, 0x3d, 0x88, 0x43, 0x38, 0x84, 0x83, 0x1b, 0xcc, 0x03, 0x3d, 0xc8,
-  0x43, 0x3d, 0x8c, 0x03, 0x3d, 0xcc, 0x78, 0x8c, 0x74, 0x70, 0x07, 0x7b,
-  0x08, 0x07, 0x79, 0x48, 0x87, 0x70, 0x70, 0x07, 0x7a, 0x70, 0x03, 0x76,
-  0x78, 0x87, 0x70, 0x20, 0x87, 0x19, 0xcc, 0x11, 0x0e, 0xec, 0x90, 0x0e,
-  0xe1, 0x30, 0x0f, 0x6e, 0x30, 0x0f, 0xe3, 0xf0, 0x0e, 0xf0, 0x50, 0x0e,
-  0x33, 0x10, 0xc4, 0x1d, 0xde, 0x21, 0x1c, 0xd8, 0x21, 0x1d, 0xc2, 0x61,
-  0x1e, 0x66, 0x30, 0x89, 0x3b, 0xbc, 0x83, 0x3b, 0xd0, 0x43, 0x39, 0xb4,
-  0x03, 0x3c, 0xbc, 0x83, 0x3c, 0x84, 0x03, 0x3b, 0xcc, 0xf0, 0x14, 0x76,
-  0x60, 0x07, 0x7b, 0x68, 0x07, 0x37, 0x68, 0x87, 0x72, 0x68, 0x07, 0x37,
-  0x80, 0x87, 0x70, 0x90, 0x87, 0x70, 0x60, 0x07, 0x76, 0x28, 0x07, 0x76,
-  0xf8, 0x05, 0x76, 0x78, 0x87, 0x77, 0x80, 0x87, 0x5f, 0x08, 0x87, 0x71,
-  0x18, 0x87, 0x72, 0x98, 0x87, 0x79, 0x98, 0x81, 0x2c, 0xee, 0xf0, 0x0e,
-  0xee, 0xe0, 0x0e, 0xf5, 0xc0, 0x0e, 0xec, 0x30, 0x03, 0x62, 0xc8, 0xa1,
-  0x1c, 0xe4, 0xa1, 0x1c, 0xcc, 0xa1, 0x1c, 0xe4, 0xa1, 0x1c, 0xdc, 0x61,
-  0x1c, 0xca, 0x21, 0x1c, 0xc4, 0x81, 0x1d, 0xca, 0x61, 0x06, 0xd6, 0x90,
-  0x43, 0x39, 0xc8, 0x43, 0x39, 0x98, 0x43, 0x39, 0xc8, 0x43, 0x39, 0xb8,
-  0xc3, 0x38, 0x94, 0x43, 0x38, 0x88, 0x03, 0x3b, 0x94, 0xc3, 0x2f, 0xbc,
-  0x83, 0x3c, 0xfc, 0x82, 0x3b, 0xd4, 0x03, 0x3b, 0xb0, 0xc3, 0x8c, 0xc8,
-  0x21, 0x07, 0x7c, 0x70, 0x03, 0x72, 0x10, 0x87, 0x73, 0x70, 0x03, 0x7b,
-  0x08, 0x07, 0x79, 0x60, 0x87, 0x70, 0xc8, 0x87, 0x77, 0xa8, 0x07, 0x7a,
-  0x00, 0x00, 0x00, 0x00, 0x71, 0x20, 0x00, 0x00, 0x0f, 0x00, 0x00, 0x00,
-  0x05, 0xa0, 0x06, 0x81, 0xdf, 0x90, 0xfd, 0x9e, 0x97, 0xe7, 0x74, 0x64,
-  0x9a, 0x0e, 0x04, 0x66, 0x83, 0xd8, 0x2a, 0x32, 0x4d, 0x4f, 0xba, 0xcd,
-  0x6f, 0x20, 0xb0, 0x1a, 0xa4, 0xd3, 0xe5, 0x69, 0x71, 0x9d, 0x5e, 0x9e,
-  0x03, 0x81, 0x40, 0xad, 0x05, 0x54, 0xc3, 0xe5, 0x3b, 0x8f, 0x1f, 0x01,
-  0x58, 0xcb, 0x51, 0x51, 0x44, 0x34, 0x93, 0x5f, 0xdc, 0x36, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x48, 0x41, 0x53, 0x48, 0x14, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x82, 0x47, 0x4f, 0x5a, 0x91, 0x57, 0x94, 0x8c,
-  0x1f, 0xc0, 0xca, 0xef, 0x4b, 0xca, 0x36, 0xb7, 0x44, 0x58, 0x49, 0x4c,
-  0xf0, 0x04, 0x00, 0x00, 0x64, 0x00, 0x06, 0x00, 0x3c, 0x01, 0x00, 0x00,
-  0x44, 0x58, 0x49, 0x4c, 0x04, 0x01, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00,
-  0xd8, 0x04, 0x00, 0x00, 0x42, 0x43, 0xc0, 0xde, 0x21, 0x0c, 0x00, 0x00,
-  0x33, 0x01, 0x00, 0x00, 0x0b, 0x82, 0x20, 0x00, 0x02, 0x00, 0x00, 0x00,
-  0x13, 0x00, 0x00, 0x00, 0x07, 0x81, 0x23, 0x91, 0x41, 0xc8, 0x04, 0x49,
-  0x06, 0x10, 0x32, 0x39, 0x92, 0x01, 0x84, 0x0c, 0x25, 0x05, 0x08, 0x19,
-  0x1e, 0x04, 0x8b, 0x62, 0x80, 0x14, 0x45, 0x02, 0x42, 0x92, 0x0b, 0x42,
-  0xa4, 0x10, 0x32, 0x14, 0x38, 0x08, 0x18, 0x4b, 0x0a, 0x32, 0x52, 0x88,
-  0x48, 0x90, 0x14, 0x20, 0x43, 0x46, 0x88, 0xa5, 0x00, 0x19, 0x32, 0x42,
-  0xe4, 0x48, 0x0e, 0x90, 0x91, 0x22, 0xc4, 0x50, 0x41, 0x51, 0x81, 0x8c,
-  0xe1, 0x83, 0xe5, 0x8a, 0x04, 0x29, 0x46, 0x06, 0x51, 0x18, 0x00, 0x00,
-  0x09, 0x00, 0x00, 0x00, 0x1b, 0x8c, 0x20, 0x00, 0x12, 0x60, 0xd9, 0x60,
-  0x08, 0x02, 0xb0, 0x00, 0xd4, 0x06, 0x62, 0xf8, 0xff, 0xff, 0xff, 0xff,
-  0x01, 0x90, 0x36, 0x18, 0xc4, 0xff, 0xff, 0xff, 0xff, 0x0f, 0x80, 0x04,
-  0x54, 0x00, 0x00, 0x00, 0x49, 0x18, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
-  0x13, 0x86, 0x40, 0x18, 0x26, 0x04, 0x04, 0x00, 0x89, 0x20, 0x00, 0x00,
-  0x17, 0x00, 0x00, 0x00, 0x32, 0x22, 0x48, 0x09, 0x20, 0x64, 0x85, 0x04,
-  0x93, 0x22, 0xa4, 0x84, 0x04, 0x93, 0x22, 0xe3, 0x84, 0xa1, 0x90, 0x14,
-  0x12, 0x4c, 0x8a, 0x8c, 0x0b, 0x84, 0xa4, 0x4c, 0x10, 0x40, 0x23, 0x00,
-  0x33, 0x00, 0xc3, 0x08, 0x44, 0x70, 0x8e, 0x34, 0x45, 0x94, 0x30, 0xf9,
-  0x21, 0x32, 0x89, 0x4d, 0xe1, 0xa0, 0x40, 0xd0, 0x18, 0x46, 0x10, 0x82,
-  0x8b, 0xa4, 0x29, 0xa2, 0x84, 0xc9, 0xd7, 0xa6, 0x29, 0x42, 0x02, 0x6a,
-  0x22, 0x24, 0x14, 0x14, 0x32, 0x65, 0x00, 0xe4, 0x10, 0x9a, 0x23, 0x00,
-  0x83, 0x22, 0x04, 0x45, 0x6b, 0x20, 0x60, 0x8e, 0x00, 0x14, 0x48, 0x00,
-  0x13, 0x14, 0x72, 0xc0, 0x87, 0x74, 0x60, 0x87, 0x36, 0x68, 0x87, 0x79,
-  0x68, 0x03, 0x72, 0xc0, 0x87, 0x0d, 0xaf, 0x50, 0x0e, 0x6d, 0xd0, 0x0e,
-  0x7a, 0x50, 0x0e, 0x6d, 0x00, 0x0f, 0x7a, 0x30, 0x07, 0x72, 0xa0, 0x07,
-  0x73, 0x20, 0x07, 0x6d, 0x90, 0x0e, 0x71, 0xa0, 0x07, 0x73, 0x20, 0x07,
-  0x6d, 0x90, 0x0e, 0x78, 0xa0, 0x07, 0x73, 0x20, 0x07, 0x6d, 0x90, 0x0e,
-  0x71, 0x60, 0x07, 0x7a, 0x30, 0x07, 0x72, 0xd0, 0x06, 0xe9, 0x30, 0x07,
-  0x72, 0xa0, 0x07, 0x73, 0x20, 0x07, 0x6d, 0x90, 0x0e, 0x76, 0x40, 0x07,
-  0x7a, 0x60, 0x07, 0x74, 0xd0, 0x06, 0xe6, 0x10, 0x07, 0x76, 0xa0, 0x07,
-  0x73, 0x20, 0x07, 0x6d, 0x60, 0x0e, 0x73, 0x20, 0x07, 0x7a, 0x30, 0x07,
-  0x72, 0xd0, 0x06, 0xe6, 0x60, 0x07, 0x74, 0xa0, 0x07, 0x76, 0x40, 0x07,
-  0x6d, 0xe0, 0x0e, 0x78, 0xa0, 0x07, 0x71, 0x60, 0x07, 0x7a, 0x30, 0x07,
-  0x72, 0xa0, 0x07, 0x76, 0x40, 0x07, 0x43, 0x1e, 0x04, 0x00, 0x80, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x86, 0x3c, 0x0b, 0x10, 0x00,
-  0x02, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x64, 0x81, 0x00, 0x00,
-  0x08, 0x00, 0x00, 0x00, 0x32, 0x1e, 0x98, 0x10, 0x19, 0x11, 0x4c, 0x90,
-  0x8c, 0x09, 0x26, 0x47, 0xc6, 0x04, 0x43, 0x52, 0x25, 0x50, 0x08, 0xe5,
-  0x50, 0x0c, 0x45, 0x30, 0x02, 0x50, 0x10, 0x45, 0x51, 0x20, 0xa5, 0x00,
-  0x79, 0x18, 0x00, 0x00, 0x4a, 0x00, 0x00, 0x00, 0x1a, 0x03, 0x4c, 0x90,
-  0x46, 0x02, 0x13, 0x44, 0x35, 0x18, 0x63, 0x0b, 0x73, 0x3b, 0x03, 0xb1,
-  0x2b, 0x93, 0x9b, 0x4b, 0x7b, 0x73, 0x03, 0x99, 0x71, 0xb9, 0x01, 0x41,
-  0xa1, 0x0b, 0x3b, 0x9b, 0x7b, 0x91, 0x2a, 0x62, 0x2a, 0x0a, 0x9a, 0x2a,
-  0xfa, 0x9a, 0xb9, 0x81, 0x79, 0x31, 0x4b, 0x73, 0x0b, 0x63, 0x4b, 0xd9,
-  0x10, 0x04, 0x13, 0x04, 0x45, 0x98, 0x20, 0x28, 0xc3, 0x06, 0x61, 0x20,
-  0x26, 0x08, 0x0a, 0xb1, 0x41, 0x18, 0x0c, 0x0e, 0x6c, 0x69, 0x62, 0x13,
-  0x04, 0xa5, 0xd8, 0x30, 0x20, 0x09, 0x31, 0x41, 0x48, 0x80, 0x0d, 0xc0,
-  0x86, 0x61, 0x60, 0x98, 0x09, 0x82, 0x62, 0x6c, 0x18, 0x1c, 0x86, 0x99,
-  0x20, 0x28, 0xc7, 0x86, 0x01, 0x62, 0x98, 0x0d, 0x43, 0xf3, 0x44, 0x1b,
-  0x86, 0x61, 0x91, 0x08, 0x6c, 0x28, 0x00, 0x0a, 0x00, 0x00, 0xaa, 0x41,
-  0xc0, 0xcf, 0x10, 0xdb, 0xdb, 0x5c, 0xd9, 0x1c, 0x1d, 0x52, 0x1a, 0x1d,
-  0x10, 0x50, 0x56, 0x10, 0x56, 0x15, 0x52, 0x1a, 0x5d, 0x92, 0x9b, 0xd9,
-  0x1b, 0x10, 0x50, 0x55, 0x10, 0x1d, 0x9d, 0x5c, 0x9a, 0x58, 0x1d, 0x5d,
-  0xd9, 0x1c, 0x10, 0x10, 0x90, 0xd6, 0x04, 0x41, 0x41, 0x26, 0x08, 0x4a,
-  0x32, 0x41, 0x50, 0x94, 0x09, 0x82, 0xb2, 0x6c, 0x08, 0xa0, 0x0d, 0xc8,
-  0x85, 0x25, 0x99, 0x71, 0x69, 0xdb, 0x86, 0x62, 0xb1, 0x00, 0x80, 0xab,
-  0xc2, 0xc6, 0x66, 0xd7, 0xe6, 0x92, 0x46, 0x56, 0xe6, 0x46, 0x37, 0x25,
-  0x08, 0xaa, 0x90, 0xe1, 0xb9, 0xd8, 0x95, 0xc9, 0xcd, 0xa5, 0xbd, 0xb9,
-  0x4d, 0x09, 0x88, 0x26, 0x64, 0x78, 0x2e, 0x76, 0x61, 0x6c, 0x76, 0x65,
-  0x72, 0x53, 0x02, 0xa3, 0x0e, 0x19, 0x9e, 0xcb, 0x1c, 0x5a, 0x18, 0x59,
-  0x99, 0x5c, 0xd3, 0x1b, 0x59, 0x19, 0xdb, 0x94, 0x20, 0xa9, 0x44, 0x86,
-  0xe7, 0x42, 0x97, 0x07, 0x57, 0x16, 0xe4, 0xe6, 0xf6, 0x46, 0x17, 0x46,
-  0x97, 0xf6, 0xe6, 0x36, 0x37, 0x25, 0x90, 0xea, 0x90, 0xe1, 0xb9, 0x94,
-  0xb9, 0xd1, 0xc9, 0xe5, 0x41, 0xbd, 0xa5, 0xb9, 0xd1, 0xcd, 0x4d, 0x11,
-  0x28, 0x0e, 0x00, 0x00, 0x79, 0x18, 0x00, 0x00, 0x49, 0x00, 0x00, 0x00,
-  0x33, 0x08, 0x80, 0x1c, 0xc4, 0xe1, 0x1c, 0x66, 0x14, 0x01, 0x3d, 0x88,
-  0x43, 0x38, 0x84, 0xc3, 0x8c, 0x42, 0x80, 0x07, 0x79, 0x78, 0x07, 0x73,
-  0x98, 0x71, 0x0c, 0xe6, 0x00, 0x0f, 0xed, 0x10, 0x0e, 0xf4, 0x80, 0x0e,
-  0x33, 0x0c, 0x42, 0x1e, 0xc2, 0xc1, 0x1d, 0xce, 0xa1, 0x1c, 0x66, 0x30,
-  0x05, 0x3d, 0x88, 0x43, 0x38, 0x84, 0x83, 0x1b, 0xcc, 0x03, 0x3d, 0xc8,
-  0x43, 0x3d, 0x8c, 0x03, 0x3d, 0xcc, 0x78, 0x8c, 0x74, 0x70, 0x07, 0x7b,
-  0x08, 0x07, 0x79, 0x48, 0x87, 0x70, 0x70, 0x07, 0x7a, 0x70, 0x03, 0x76,
-  0x78, 0x87, 0x70, 0x20, 0x87, 0x19, 0xcc, 0x11, 0x0e, 0xec, 0x90, 0x0e,
-  0xe1, 0x30, 0x0f, 0x6e, 0x30, 0x0f, 0xe3, 0xf0, 0x0e, 0xf0, 0x50, 0x0e,
-  0x33, 0x10, 0xc4, 0x1d, 0xde, 0x21, 0x1c, 0xd8, 0x21, 0x1d, 0xc2, 0x61,
-  0x1e, 0x66, 0x30, 0x89, 0x3b, 0xbc, 0x83, 0x3b, 0xd0, 0x43, 0x39, 0xb4,
-  0x03, 0x3c, 0xbc, 0x83, 0x3c, 0x84, 0x03, 0x3b, 0xcc, 0xf0, 0x14, 0x76,
-  0x60, 0x07, 0x7b, 0x68, 0x07, 0x37, 0x68, 0x87, 0x72, 0x68, 0x07, 0x37,
-  0x80, 0x87, 0x70, 0x90, 0x87, 0x70, 0x60, 0x07, 0x76, 0x28, 0x07, 0x76,
-  0xf8, 0x05, 0x76, 0x78, 0x87, 0x77, 0x80, 0x87, 0x5f, 0x08, 0x87, 0x71,
-  0x18, 0x87, 0x72, 0x98, 0x87, 0x79, 0x98, 0x81, 0x2c, 0xee, 0xf0, 0x0e,
-  0xee, 0xe0, 0x0e, 0xf5, 0xc0, 0x0e, 0xec, 0x30, 0x03, 0x62, 0xc8, 0xa1,
-  0x1c, 0xe4, 0xa1, 0x1c, 0xcc, 0xa1, 0x1c, 0xe4, 0xa1, 0x1c, 0xdc, 0x61,
-  0x1c, 0xca, 0x21, 0x1c, 0xc4, 0x81, 0x1d, 0xca, 0x61, 0x06, 0xd6, 0x90,
-  0x43, 0x39, 0xc8, 0x43, 0x39, 0x98, 0x43, 0x39, 0xc8, 0x43, 0x39, 0xb8,
-  0xc3, 0x38, 0x94, 0x43, 0x38, 0x88, 0x03, 0x3b, 0x94, 0xc3, 0x2f, 0xbc,
-  0x83, 0x3c, 0xfc, 0x82, 0x3b, 0xd4, 0x03, 0x3b, 0xb0, 0xc3, 0x8c, 0xc8,
-  0x21, 0x07, 0x7c, 0x70, 0x03, 0x72, 0x10, 0x87, 0x73, 0x70, 0x03, 0x7b,
-  0x08, 0x07, 0x79, 0x60, 0x87, 0x70, 0xc8, 0x87, 0x77, 0xa8, 0x07, 0x7a,
-  0x00, 0x00, 0x00, 0x00, 0x71, 0x20, 0x00, 0x00, 0x0f, 0x00, 0x00, 0x00,
-  0x05, 0xa0, 0x06, 0x81, 0xdf, 0x90, 0xfd, 0x9e, 0x97, 0xe7, 0x74, 0x64,
-  0x9a, 0x0e, 0x04, 0x66, 0x83, 0xd8, 0x2a, 0x32, 0x4d, 0x4f, 0xba, 0xcd,
-  0x6f, 0x20, 0xb0, 0x1a, 0xa4, 0xd3, 0xe5, 0x69, 0x71, 0x9d, 0x5e, 0x9e,
-  0x03, 0x81, 0x40, 0xad, 0x05, 0x54, 0xc3, 0xe5, 0x3b, 0x8f, 0x1f, 0x01,
-  0x58, 0xcb, 0x51, 0x51, 0x44, 0x34, 0x93, 0x5f, 0xdc, 0x36, 0x00, 0x00,
-  0x61, 0x20, 0x00, 0x00, 0x17, 0x00, 0x00, 0x00, 0x13, 0x04, 0x41, 0x2c,
-  0x10, 0x00, 0x00, 0x00, 0x07, 0x00, 0x00, 0x00, 0xe4, 0xca, 0x80, 0x54,
-  0xd1, 0x0a, 0x50, 0x98, 0x01, 0x20, 0x31, 0x07, 0x31, 0x4d, 0x12, 0x44,
-  0x61, 0x04, 0x60, 0x8c, 0x00, 0x04, 0x41, 0x10, 0xff, 0x00, 0x00, 0x00,
-  0x23, 0x06, 0x05, 0x00, 0x82, 0x60, 0xb0, 0x4c, 0xc5, 0x1c, 0x03, 0x11,
-  0x1c, 0x7b, 0x0c, 0xca, 0xf3, 0x0c, 0x1b, 0x10, 0x81, 0x30, 0x00, 0x18,
-  0x0e, 0x04, 0x00, 0x00, 0x04, 0x00, 0x00, 0x00, 0xd6, 0x60, 0x00, 0xd3,
-  0x14, 0x21, 0x81, 0x31, 0x1c, 0x0f, 0x80, 0x2d, 0x0e, 0x30, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};
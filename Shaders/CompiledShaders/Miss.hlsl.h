@@ -1,268 +0,0 @@
-#if 0
-; shader hash: b932013862965b0727e310a94a16ae50
-;
-; Buffer Definitions:
-;
-;
-; Resource Bindings:
-;
-; Name                                 Type  Format         Dim      ID      HLSL Bind  Count
-; ------------------------------ ---------- ------- ----------- ------- -------------- ------
-;
-target datalayout = "e-m:e-p:32:32-i1:32-i8:32-i16:32-i32:32-i64:64-f16:32-f32:32-f64:64-n8:16:32:64"
-target triple = "dxil-ms-dx"
-
-%struct.HitInfo = type { <4 x float> }
-
-; Function Attrs: nounwind
-define void @"\01?Miss@@YAXUHitInfo@@@Z"(%struct.HitInfo* noalias nocapture %payload) #0 {
-  %1 = getelementptr inbounds %struct.HitInfo, %struct.HitInfo* %payload, i32 0, i32 0
-  store <4 x float> <float 0x3FC99999A0000000, float 0x3FC99999A0000000, float 0x3FE99999A0000000, float -1.000000e+00>, <4 x float>* %1, align 4
-  ret void
-}
-
-attributes #0 = { nounwind }
-
-!llvm.ident = !{!0}
-!dx.version = !{!1}
-!dx.valver = !{!2}
-!dx.shaderModel = !{!3}
-!dx.typeAnnotations = !{!4, !7}
-!dx.entryPoints = !{!13, !14}
-
-!0 = !{!"clang version 3.7 (tags/RELEASE_370/final)"}
-!1 = !{i32 1, i32 4}
-!2 = !{i32 1, i32 7}
-!3 = !{!"lib", i32 6, i32 4}
-!4 = !{i32 0, %struct.HitInfo undef, !5}
-!5 = !{i32 16, !6}
-!6 = !{i32 6, !"colorAndDistance", i32 3, i32 0, i32 7, i32 9}
-!7 = !{i32 1, void (%struct.HitInfo*)* @"\01?Miss@@YAXUHitInfo@@@Z", !8}
-!8 = !{!9, !11}
-!9 = !{i32 1, !10, !10}
-!10 = !{}
-!11 = !{i32 2, !12, !10}
-!12 = !{i32 4, !"SV_RayPayload"}
-!13 = !{null, !"", null, null, null}
-!14 = !{void (%struct.HitInfo*)* @"\01?Miss@@YAXUHitInfo@@@Z", !"\01?Miss@@YAXUHitInfo@@@Z", null, null, !15}
-!15 = !{i32 8, i32 11, i32 6, i32 16, i32 5, !16}
-!16 = !{i32 0}
-
-#endif
-
-const unsigned char g_pMiss[] = {
-  0x44, 0x58, 0x42, 0x43, 0xb3, 0x80, 0x7b, 0xd7, 0xfd, 0x9e, 0x97, 0xf4,
-  0x17, 0x8d, 0xc0, 0xc8, 0x5c, 0x23, 0x04, 0x6b, 0x01, 0x00, 0x00, 0x00,
-  0x04, 0x0a, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x34, 0x00, 0x00, 0x00,
-  0x44, 0x00, 0x00, 0x00, 0xc0, 0x00, 0x00, 0x00, 0x3c, 0x05, 0x00, 0x00,
-  0x58, 0x05, 0x00, 0x00, 0x53, 0x46, 0x49, 0x30, 0x08, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x52, 0x44, 0x41, 0x54,
-  0x74, 0x00, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00, 0x02, 0x00, 0x00, 0x00,
-  0x10, 0x00, 0x00, 0x00, 0x38, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
-  0x20, 0x00, 0x00, 0x00, 0x00, 0x01, 0x3f, 0x4d, 0x69, 0x73, 0x73, 0x40,
-  0x40, 0x59, 0x41, 0x58, 0x55, 0x48, 0x69, 0x74, 0x49, 0x6e, 0x66, 0x6f,
-  0x40, 0x40, 0x40, 0x5a, 0x00, 0x4d, 0x69, 0x73, 0x73, 0x00, 0x00, 0x00,
-  0x04, 0x00, 0x00, 0x00, 0x34, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
-  0x2c, 0x00, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00, 0x19, 0x00, 0x00, 0x00,
-  0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0xff, 0x0b, 0x00, 0x00, 0x00,
-  0x10, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x08, 0x00, 0x00, 0x60, 0x00, 0x0b, 0x00,
-  0x53, 0x54, 0x41, 0x54, 0x74, 0x04, 0x00, 0x00, 0x64, 0x00, 0x06, 0x00,
-  0x1d, 0x01, 0x00, 0x00, 0x44, 0x58, 0x49, 0x4c, 0x04, 0x01, 0x00, 0x00,
-  0x10, 0x00, 0x00, 0x00, 0x5c, 0x04, 0x00, 0x00, 0x42, 0x43, 0xc0, 0xde,
-  0x21, 0x0c, 0x00, 0x00, 0x14, 0x01, 0x00, 0x00, 0x0b, 0x82, 0x20, 0x00,
-  0x02, 0x00, 0x00, 0x00, 0x13, 0x00, 0x00, 0x00, 0x07, 0x81, 0x23, 0x91,
-  0x41, 0xc8, 0x04, 0x49, 0x06, 0x10, 0x32, 0x39, 0x92, 0x01, 0x84, 0x0c,
-  0x25, 0x05, 0x08, 0x19, 0x1e, 0x04, 0x8b, 0x62, 0x80, 0x10, 0x45, 0x02,
-  0x42, 0x92, 0x0b, 0x42, 0x84, 0x10, 0x32, 0x14, 0x38, 0x08, 0x18, 0x4b,
-  0x0a, 0x32, 0x42, 0x88, 0x48, 0x90, 0x14, 0x20, 0x43, 0x46, 0x88, 0xa5,
-  0x00, 0x19, 0x32, 0x42, 0xe4, 0x48, 0x0e, 0x90, 0x11, 0x22, 0xc4, 0x50,
-  0x41, 0x51, 0x81, 0x8c, 0xe1, 0x83, 0xe5, 0x8a, 0x04, 0x21, 0x46, 0x06,
-  0x51, 0x18, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x1b, 0x8c, 0x20, 0x00,
-  0x12, 0x60, 0xd9, 0x40, 0x08, 0xff, 0xff, 0xff, 0xff, 0x3f, 0x00, 0x12,
-  0x00, 0x00, 0x00, 0x00, 0x49, 0x18, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
-  0x13, 0x84, 0x40, 0x00, 0x89, 0x20, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00,
-  0x32, 0x22, 0x08, 0x09, 0x20, 0x64, 0x85, 0x04, 0x13, 0x22, 0xa4, 0x84,
-  0x04, 0x13, 0x22, 0xe3, 0x84, 0xa1, 0x90, 0x14, 0x12, 0x4c, 0x88, 0x8c,
-  0x0b, 0x84, 0x84, 0x4c, 0x10, 0x24, 0x23, 0x00, 0x33, 0x00, 0xc3, 0x08,
-  0x44, 0x70, 0x8e, 0x34, 0x45, 0x94, 0x30, 0xf9, 0x21, 0x32, 0x89, 0x4d,
-  0xe1, 0xa0, 0x40, 0x68, 0x8a, 0x00, 0x44, 0x35, 0x10, 0x30, 0x47, 0x00,
-  0x06, 0x00, 0x00, 0x00, 0x13, 0x14, 0x72, 0xc0, 0x87, 0x74, 0x60, 0x87,
-  0x36, 0x68, 0x87, 0x79, 0x68, 0x03, 0x72, 0xc0, 0x87, 0x0d, 0xaf, 0x50,
-  0x0e, 0x6d, 0xd0, 0x0e, 0x7a, 0x50, 0x0e, 0x6d, 0x00, 0x0f, 0x7a, 0x30,
-  0x07, 0x72, 0xa0, 0x07, 0x73, 0x20, 0x07, 0x6d, 0x90, 0x0e, 0x71, 0xa0,
-  0x07, 0x73, 0x20, 0x07, 0x6d, 0x90, 0x0e, 0x78, 0xa0, 0x07, 0x73, 0x20,
-  0x07, 0x6d, 0x90, 0x0e, 0x71, 0x60, 0x07, 0x7a, 0x30, 0x07, 0x72, 0xd0,
-  0x06, 0xe9, 0x30, 0x07, 0x72, 0xa0, 0x07, 0x73, 0x20, 0x07, 0x6d, 0x90,
-  0x0e, 0x76, 0x40, 0x07, 0x7a, 0x60, 0x07, 0x74, 0xd0, 0x06, 0xe6, 0x10,
-  0x07, 0x76, 0xa0, 0x07, 0x73, 0x20, 0x07, 0x6d, 0x60, 0x0e, 0x73, 0x20,
-  0x07, 0x7a, 0x30, 0x07, 0x72, 0xd0, 0x06, 0xe6, 0x60, 0x07, 0x74, 0xa0,
-  0x07, 0x76, 0x40, 0x07, 0x6d, 0xe0, 0x0e, 0x78, 0xa0, 0x07, 0x71, 0x60,
-  0x07, 0x7a, 0x30, 0x07, 0x72, 0xa0, 0x07, 0x76, 0x40, 0x07, 0x43, 0x9e,
-  0x02, 0x08, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xb2,
-  0x40, 0x00, 0x00, 0x00, 0x0a, 0x00, 0x00, 0x00, 0x32, 0x1e, 0x98, 0x10,
-  0x19, 0x11, 0x4c, 0x90, 0x8c, 0x09, 0x26, 0x47, 0xc6, 0x04, 0x43, 0xc2,
-  0x52, 0x28, 0x81, 0x42, 0x18, 0x01, 0x28, 0x86, 0x02, 0x29, 0x83, 0x72,
-  0x28, 0x89, 0x22, 0x28, 0x88, 0xb2, 0xa0, 0x99, 0x01, 0x00, 0x00, 0x00,
-  0x79, 0x18, 0x00, 0x00, 0x5a, 0x00, 0x00, 0x00, 0x1a, 0x03, 0x4c, 0x90,
-  0x46, 0x02, 0x13, 0x44, 0x35, 0x18, 0x63, 0x0b, 0x73, 0x3b, 0x03, 0xb1,
-  0x2b, 0x93, 0x9b, 0x4b, 0x7b, 0x73, 0x03, 0x99, 0x71, 0xb9, 0x01, 0x41,
-  0xa1, 0x0b, 0x3b, 0x9b, 0x7b, 0x91, 0x2a, 0x62, 0x2a, 0x0a, 0x9a, 0x2a,
-  0xfa, 0x9a, 0xb9, 0x81, 0x79, 0x31, 0x4b, 0x73, 0x0b, 0x63, 0x4b, 0xd9,
-  0x10, 0x04, 0x13, 0x04, 0x44, 0x98, 0x20, 0x20, 0xc3, 0x06, 0x61, 0x20,
-  0x26, 0x08, 0x08, 0xb1, 0x41, 0x30, 0x0c, 0x0e, 0x6c, 0x69, 0x62, 0x13,
-  0x04, 0xa4, 0xd8, 0x30, 0x20, 0x09, 0x31, 0x41, 0x18, 0x9a, 0x09, 0x02,
-  0x62, 0x10, 0x1a, 0x7b, 0x63, 0x7b, 0x93, 0x0b, 0x72, 0x23, 0x23, 0x4a,
-  0x9b, 0xa3, 0x0b, 0x73, 0x1b, 0x2b, 0x9b, 0x20, 0x20, 0xc7, 0x04, 0x01,
-  0x41, 0x26, 0x08, 0x48, 0xb2, 0xc1, 0x48, 0x1a, 0xc7, 0x78, 0xa0, 0x0d,
-  0x02, 0x13, 0x6d, 0x18, 0x8c, 0x45, 0x9a, 0x20, 0x18, 0xc0, 0x06, 0x60,
-  0xc3, 0x30, 0x54, 0xd5, 0x04, 0x01, 0x51, 0xd8, 0x4c, 0x59, 0x7d, 0x49,
-  0x85, 0xe5, 0x41, 0x85, 0xe5, 0xb1, 0xbd, 0x85, 0x91, 0x6d, 0x10, 0x08,
-  0x6c, 0xc3, 0x70, 0x65, 0xd5, 0x06, 0xc1, 0xd2, 0x36, 0x0c, 0x03, 0xb5,
-  0x11, 0xd8, 0x50, 0x00, 0x1d, 0x00, 0x00, 0xbc, 0x02, 0x7e, 0x9a, 0xd2,
-  0xe6, 0xe6, 0x80, 0x80, 0xb2, 0x82, 0xb0, 0xaa, 0x90, 0xd2, 0xe8, 0x92,
-  0xdc, 0xcc, 0xde, 0x80, 0x80, 0x80, 0xb4, 0x26, 0x08, 0xc8, 0x32, 0x41,
-  0x40, 0x98, 0x09, 0x02, 0x12, 0x6c, 0x08, 0x8c, 0x0d, 0x06, 0x18, 0x84,
-  0x41, 0xc2, 0x88, 0xc1, 0x18, 0x6c, 0x28, 0xa8, 0x0f, 0x00, 0xc8, 0x80,
-  0x45, 0x9a, 0xdb, 0x1c, 0xdd, 0xdc, 0x06, 0xc1, 0x0c, 0x9c, 0x2a, 0x6c,
-  0x6c, 0x76, 0x6d, 0x2e, 0x69, 0x64, 0x65, 0x6e, 0x74, 0x53, 0x82, 0xa0,
-  0x0a, 0x19, 0x9e, 0x8b, 0x5d, 0x99, 0xdc, 0x5c, 0xda, 0x9b, 0xdb, 0x94,
-  0x80, 0x68, 0x42, 0x86, 0xe7, 0x62, 0x17, 0xc6, 0x66, 0x57, 0x26, 0x37,
-  0x25, 0x30, 0xea, 0x90, 0xe1, 0xb9, 0xcc, 0xa1, 0x85, 0x91, 0x95, 0xc9,
-  0x35, 0xbd, 0x91, 0x95, 0xb1, 0x4d, 0x09, 0x92, 0x4a, 0x64, 0x78, 0x2e,
-  0x74, 0x79, 0x70, 0x65, 0x41, 0x6e, 0x6e, 0x6f, 0x74, 0x61, 0x74, 0x69,
-  0x6f, 0x6e, 0x73, 0x53, 0x04, 0x69, 0xab, 0x43, 0x86, 0xe7, 0x52, 0xe6,
-  0x46, 0x27, 0x97, 0x07, 0xf5, 0x96, 0xe6, 0x46, 0x37, 0x37, 0x45, 0xe8,
-  0xc8, 0xa0, 0x0b, 0x19, 0x9e, 0xcb, 0xd8, 0x5b, 0x9d, 0x1b, 0x5d, 0x99,
-  0xdc, 0xdc, 0x94, 0xc0, 0x0c, 0x00, 0x00, 0x00, 0x79, 0x18, 0x00, 0x00,
-  0x49, 0x00, 0x00, 0x00, 0x33, 0x08, 0x80, 0x1c, 0xc4, 0xe1, 0x1c, 0x66,
-  0x14, 0x01, 0x3d, 0x88, 0x43, 0x38, 0x84, 0xc3, 0x8c, 0x42, 0x80, 0x07,
-  0x79, 0x78, 0x07, 0x73, 0x98, 0x71, 0x0c, 0xe6, 0x00, 0x0f, 0xed, 0x10,
-  0x0e, 0xf4, 0x80, 0x0e, 0x33, 0x0c, 0x42, 0x1e, 0xc2, 0xc1, 0x1d, 0xce,
-  0xa1, 0x1c, 0x66, 0x30, 0x05, 0x3d, 0x88, 0x43, 0x38, 0x84, 0x83, 0x1b,
-  0xcc, 0x03, 0x3d, 0xc8, 0x43, 0x3d, 0x8c, 0x03, 0x3d, 0xcc, 0x78, 0x8c,
-  0x74, 0x70, 0x07, 0x7b, 0x08, 0x07, 0x79, 0x48, 0x87, 0x70, 0x70, 0x07,
-  0x7a, 0x70, 0x03, 0x76, 0x78, 0x87, 0x70, 0x20, 0x87, 0x19, 0xcc, 0x11,
-  0x0e, 0xec, 0x90, 0x0e, 0xe1, 0x30, 0x0f, 0x6e, 0x30, 0x0f, 0xe3, 0xf0,
-  0x0e, 0xf0, 0x50, 0x0e, 0x33, 0x10, 0xc4, 0x1d, 0xde, 0x21, 0x1c, 0xd8,
-  0x21, 0x1d, 0xc2, 0x61, 0x1e, 0x66, 0x30, 0x89, 0x3b, 0xbc, 0x83, 0x3b,
-  0xd0, 0x43, 0x39, 0xb4, 0x03, 0x3c, 0xbc, 0x83, 0x3c, 0x84, 0x03, 0x3b,
-  0xcc, 0xf0, 0x14, 0x76, 0x60, 0x07, 0x7b, 0x68, 0x07, 0x37, 0x68, 0x87,
-  0x72, 0x68, 0x07, 0x37, 0x80, 0x87, 0x70, 0x90, 0x87, 0x70, 0x60, 0x07,
-  0x76, 0x28, 0x07, 0x76, 0xf8, 0x05, 0x76, 0x78, 0x87, 0x77, 0x80, 0x87,
-  0x5f, 0x08, 0x87, 0x71, 0x18, 0x87, 0x72, 0x98, 0x87, 0x79, 0x98, 0x81,
-  0x2c, 0xee, 0xf0, 0x0e, 0xee, 0xe0, 0x0e, 0xf5, 0xc0, 0x0e, 0xec, 0x30,
-  0x03, 0x62, 0xc8, 0xa1, 0x1c, 0xe4, 0xa1, 0x1c, 0xcc, 0xa1, 0x1c, 0xe4,
-  0xa1, 0x1c, 0xdc, 0x61, 0x1c, 0xca, 0x21, 0x1c, 0xc4, 0x81, 0x1d, 0xca,
-  0x61, 0x06, 0xd6, 0x90, 0x43, 0x39, 0xc8, 0x43, 0x39, 0x98, 0x43, 0x39,
-  0xc8, 0x43, 0x39, 0xb8, 0xc3, 0x38, 0x94, 0x43, 0x38, 0x88, 0x03, 0x3b,
-  0x94, 0xc3, 0x2f, 0xbc, 0x83, 0x3c, 0xfc, 0x82, 0x3b, 0xd4, 0x03, 0x3b,
-  0xb0, 0xc3, 0x8c, 0xc8, 0x21, 0x07, 0x7c, 0x70, 0x03, 0x72, 0x10, 0x87,
-  0x73, 0x70, 0x03, 0x7b, 0x08, 0x07, 0x79, 0x60, 0x87, 0x70, 0xc8, 0x87,
-  0x77, 0xa8, 0x07, 0x7a, 0x00, 0x00, 0x00, 0x00, 0x71, 0x20, 0x00, 0x00,
-  0x06, 0x00, 0x00, 0x00, 0x05, 0x70, 0x05, 0x7e, 0xcd, 0xf4, 0x7c, 0x0e,
-  0x04, 0x66, 0x83, 0xd8, 0x2a, 0x32, 0x4d, 0x4f, 0xba, 0xcd, 0x6f, 0x20,
-  0x10, 0xa8, 0x05, 0x00, 0x00, 0x00, 0x00, 0x00, 0x48, 0x41, 0x53, 0x48,
-  0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xb9, 0x32, 0x01, 0x38,
-  0x62, 0x96, 0x5b, 0x07, 0x27, 0xe3, 0x10, 0xa9, 0x4a, 0x16, 0xae, 0x50,
-  0x44, 0x58, 0x49, 0x4c, 0xa4, 0x04, 0x00, 0x00, 0x64, 0x00, 0x06, 0x00,
-  0x29, 0x01, 0x00, 0x00, 0x44, 0x58, 0x49, 0x4c, 0x04, 0x01, 0x00, 0x00,
-  0x10, 0x00, 0x00, 0x00, 0x8c, 0x04, 0x00, 0x00, 0x42, 0x43, 0xc0, 0xde,
-  0x21, 0x0c, 0x00, 0x00, 0x20, 0x01, 0x00, 0x00, 0x0b, 0x82, 0x20, 0x00,
-  0x02, 0x00, 0x00, 0x00, 0x13, 0x00, 0x00, 0x00, 0x07, 0x81, 0x23, 0x91,
-  0x41, 0xc8, 0x04, 0x49, 0x06, 0x10, 0x32, 0x39, 0x92, 0x01, 0x84, 0x0c,
-  0x25, 0x05, 0x08, 0x19, 0x1e, 0x04, 0x8b, 0x62, 0x80, 0x10, 0x45, 0x02,
-  0x42, 0x92, 0x0b, 0x42, 0x84, 0x10, 0x32, 0x14, 0x38, 0x08, 0x18, 0x4b,
-  0x0a, 0x32, 0x42, 0x88, 0x48, 0x90, 0x14, 0x20, 0x43, 0x46, 0x88, 0xa5,
-  0x00, 0x19, 0x32, 0x42, 0xe4, 0x48, 0x0e, 0x90, 0x11, 0x22, 0xc4, 0x50,
-  0x41, 0x51, 0x81, 0x8c, 0xe1, 0x83, 0xe5, 0x8a, 0x04, 0x21, 0x46, 0x06,
-  0x51, 0x18, 0x00, 0x00, 0x05, 0x00, 0x00, 0x00, 0x1b, 0x8c, 0x20, 0x00,
-  0x12, 0x60, 0xd9, 0x40, 0x08, 0xff, 0xff, 0xff, 0xff, 0x3f, 0x00, 0x12,
-  0x00, 0x00, 0x00, 0x00, 0x49, 0x18, 0x00, 0x00, 0x01, 0x00, 0x00, 0x00,
-  0x13, 0x84, 0x40, 0x00, 0x89, 0x20, 0x00, 0x00, 0x10, 0x00, 0x00, 0x00,
-  0x32, 0x22, 0x08, 0x09, 0x20, 0x64, 0x85, 0x04, 0x13, 0x22, 0xa4, 0x84,
-  0x04, 0x13, 0x22, 0xe3, 0x84, 0xa1, 0x90, 0x14, 0x12, 0x4c, 0x88, 0x8c,
-  0x0b, 0x84, 0x84, 0x4c, 0x10, 0x28, 0x23, 0x00, 0x33, 0x00, 0xc3, 0x08,
-  0x44, 0x70, 0x8e, 0x34, 0x45, 0x94, 0x30, 0xf9, 0x21, 0x32, 0x89, 0x4d,
-  0xe1, 0xa0, 0x40, 0x68, 0x8a, 0x00, 0x44, 0x35, 0x10, 0x30, 0x47, 0x00,
-  0x06, 0x24, 0x00, 0x00, 0x13, 0x14, 0x72, 0xc0, 0x87, 0x74, 0x60, 0x87,
-  0x36, 0x68, 0x87, 0x79, 0x68, 0x03, 0x72, 0xc0, 0x87, 0x0d, 0xaf, 0x50,
-  0x0e, 0x6d, 0xd0, 0x0e, 0x7a, 0x50, 0x0e, 0x6d, 0x00, 0x0f, 0x7a, 0x30,
-  0x07, 0x72, 0xa0, 0x07, 0x73, 0x20, 0x07, 0x6d, 0x90, 0x0e, 0x71, 0xa0,
-  0x07, 0x73, 0x20, 0x07, 0x6d, 0x90, 0x0e, 0x78, 0xa0, 0x07, 0x73, 0x20,
-  0x07, 0x6d, 0x90, 0x0e, 0x71, 0x60, 0x07, 0x7a, 0x30, 0x07, 0x72, 0xd0,
-  0x06, 0xe9, 0x30, 0x07, 0x72, 0xa0, 0x07, 0x73, 0x20, 0x07, 0x6d, 0x90,
-  0x0e, 0x76, 0x40, 0x07, 0x7a, 0x60, 0x07, 0x74, 0xd0, 0x06, 0xe6, 0x10,
-  0x07, 0x76, 0xa0, 0x07, 0x73, 0x20, 0x07, 0x6d, 0x60, 0x0e, 0x73, 0x20,
-  0x07, 0x7a, 0x30, 0x07, 0x72, 0xd0, 0x06, 0xe6, 0x60, 0x07, 0x74, 0xa0,
-  0x07, 0x76, 0x40, 0x07, 0x6d, 0xe0, 0x0e, 0x78, 0xa0, 0x07, 0x71, 0x60,
-  0x07, 0x7a, 0x30, 0x07, 0x72, 0xa0, 0x07, 0x76, 0x40, 0x07, 0x43, 0x9e,
-  0x02, 0x00, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xb2,
-  0x40, 0x00, 0x00, 0x00, 0x0a, 0x00, 0x00, 0x00, 0x32, 0x1e, 0x98, 0x10,
-  0x19, 0x11, 0x4c, 0x90, 0x8c, 0x09, 0x26, 0x47, 0xc6, 0x04, 0x43, 0xc2,
-  0x52, 0x28, 0x81, 0x42, 0x28, 0x87, 0x62, 0x18, 0x01, 0x28, 0x90, 0x32,
-  0x28, 0x89, 0x22, 0x28, 0x88, 0xb2, 0xa0, 0x99, 0x01, 0x00, 0x00, 0x00,
-  0x79, 0x18, 0x00, 0x00, 0x53, 0x00, 0x00, 0x00, 0x1a, 0x03, 0x4c, 0x90,
-  0x46, 0x02, 0x13, 0x44, 0x35, 0x18, 0x63, 0x0b, 0x73, 0x3b, 0x03, 0xb1,
-  0x2b, 0x93, 0x9b, 0x4b, 0x7b, 0x73, 0x03, 0x99, 0x71, 0xb9, 0x01, 0x41,
-  0xa1, 0x0b, 0x3b, 0x9b, 0x7b, 0x91, 0x2a, 0x62, 0x2a, 0x0a, 0x9a, 0x2a,
-  0xfa, 0x9a, 0xb9, 0x81, 0x79, 0x31, 0x4b, 0x73, 0x0b, 0x63, 0x4b, 0xd9,
-  0x10, 0x04, 0x13, 0x04, 0x44, 0x98, 0x20, 0x20, 0xc3, 0x06, 0x61, 0x20,
-  0x26, 0x08, 0x08, 0xb1, 0x41, 0x18, 0x0c, 0x0e, 0x6c, 0x69, 0x62, 0x13,
-  0x04, 0xa4, 0xd8, 0x30, 0x20, 0x09, 0x31, 0x41, 0x40, 0x8c, 0x09, 0xc2,
-  0xd0, 0x4c, 0x10, 0x90, 0x83, 0xd0, 0xd8, 0x1b, 0xdb, 0x9b, 0x5c, 0x90,
-  0x1b, 0x19, 0x51, 0xda, 0x1c, 0x5d, 0x98, 0xdb, 0x58, 0xd9, 0x04, 0x01,
-  0x41, 0x26, 0x08, 0x48, 0xb2, 0xc1, 0x48, 0x9c, 0x67, 0x31, 0xa0, 0x0d,
-  0x42, 0x13, 0x6d, 0x18, 0x16, 0x46, 0x9a, 0x20, 0x18, 0xc0, 0x06, 0x60,
-  0xc3, 0x30, 0x54, 0xd5, 0x04, 0x01, 0x51, 0xd8, 0x4c, 0x59, 0x7d, 0x49,
-  0x85, 0xe5, 0x41, 0x85, 0xe5, 0xb1, 0xbd, 0x85, 0x91, 0x6d, 0x10, 0x08,
-  0x6c, 0xc3, 0x70, 0x65, 0xd5, 0x06, 0xc1, 0xd2, 0x36, 0x0c, 0x03, 0xb5,
-  0x11, 0xd8, 0x50, 0x00, 0x1d, 0x00, 0x00, 0xbc, 0x02, 0x7e, 0x9a, 0xd2,
-  0xe6, 0xe6, 0x80, 0x80, 0xb2, 0x82, 0xb0, 0xaa, 0x90, 0xd2, 0xe8, 0x92,
-  0xdc, 0xcc, 0xde, 0x80, 0x80, 0x80, 0xb4, 0x26, 0x08, 0xc8, 0x32, 0x41,
-  0x40, 0x98, 0x09, 0x02, 0x12, 0x6c, 0x08, 0x96, 0x0d, 0x06, 0x18, 0x84,
-  0x41, 0xd2, 0x88, 0xc1, 0x18, 0x6c, 0x28, 0xa8, 0x0f, 0x00, 0xc8, 0xa0,
-  0x0a, 0x1b, 0x9b, 0x5d, 0x9b, 0x4b, 0x1a, 0x59, 0x99, 0x1b, 0xdd, 0x94,
-  0x20, 0xa8, 0x42, 0x86, 0xe7, 0x62, 0x57, 0x26, 0x37, 0x97, 0xf6, 0xe6,
-  0x36, 0x25, 0x20, 0x9a, 0x90, 0xe1, 0xb9, 0xd8, 0x85, 0xb1, 0xd9, 0x95,
-  0xc9, 0x4d, 0x09, 0x8c, 0x3a, 0x64, 0x78, 0x2e, 0x73, 0x68, 0x61, 0x64,
-  0x65, 0x72, 0x4d, 0x6f, 0x64, 0x65, 0x6c, 0x53, 0x82, 0xa4, 0x12, 0x19,
-  0x9e, 0x0b, 0x5d, 0x1e, 0x5c, 0x59, 0x90, 0x9b, 0xdb, 0x1b, 0x5d, 0x18,
-  0x5d, 0xda, 0x9b, 0xdb, 0xdc, 0x14, 0x41, 0xda, 0xea, 0x90, 0xe1, 0xb9,
-  0x94, 0xb9, 0xd1, 0xc9, 0xe5, 0x41, 0xbd, 0xa5, 0xb9, 0xd1, 0xcd, 0x4d,
-  0x11, 0x3a, 0x32, 0x00, 0x79, 0x18, 0x00, 0x00, 0x49, 0x00, 0x00, 0x00,
-  0x33, 0x08, 0x80, 0x1c, 0xc4, 0xe1, 0x1c, 0x66, 0x14, 0x01, 0x3d, 0x88,
-  0x43, 0x38, 0x84, 0xc3, 0x8c, 0x42, 0x80, 0x07, 0x79, 0x78, 0x07, 0x73,
-  0x98, 0x71, 0x0c, 0xe6, 0x00, 0x0f, 0xed, 0x10, 0x0e, 0xf4, 0x80, 0x0e,
-  0x33, 0x0c, 0x42, 0x1e, 0xc2, 0xc1, 0x1d, 0xce, 0xa1, 0x1c, 0x66, 0x30,
-  0x05, 0x3d, 0x88, 0x43, 0x38, 0x84, 0x83, 0x1b, 0xcc, 0x03, 0x3d, 0xc8,
-  0x43, 0x3d, 0x8c, 0x03, 0x3d, 0xcc, 0x78, 0x8c, 0x74, 0x70, 0x07, 0x7b,
-  0x08, 0x07, 0x79, 0x48, 0x87, 0x70, 0x70, 0x07, 0x7a, 0x70, 0x03, 0x76,
-  0x78, 0x87, 0x70, 0x20, 0x87, 0x19, 0xcc, 0x11, 0x0e, 0xec, 0x90, 0x0e,
-  0xe1, 0x30, 0x0f, 0x6e, 0x30, 0x0f, 0xe3, 0xf0, 0x0e, 0xf0, 0x50, 0x0e,
-  0x33, 0x10, 0xc4, 0x1d, 0xde, 0x21, 0x1c, 0xd8, 0x21, 0x1d, 0xc2, 0x61,
-  0x1e, 0x66, 0x30, 0x89, 0x3b, 0xbc, 0x83, 0x3b, 0xd0, 0x43, 0x39, 0xb4,
-  0x03, 0x3c, 0xbc, 0x83, 0x3c, 0x84, 0x03, 0x3b, 0xcc, 0xf0, 0x14, 0x76,
-  0x60, 0x07, 0x7b, 0x68, 0x07, 0x37, 0x68, 0x87, 0x72, 0x68, 0x07, 0x37,
-  0x80, 0x87, 0x70, 0x90, 0x87, 0x70, 0x60, 0x07, 0x76, 0x28, 0x07, 0x76,
-  0xf8, 0x05, 0x76, 0x78, 0x87, 0x77, 0x80, 0x87, 0x5f, 0x08, 0x87, 0x71,
-  0x18, 0x87, 0x72, 0x98, 0x87, 0x79, 0x98, 0x81, 0x2c, 0xee, 0xf0, 0x0e,
-  0xee, 0xe0, 0x0e, 0xf5, 0xc0, 0x0e, 0xec, 0x30, 0x03, 0x62, 0xc8, 0xa1,
-  0x1c, 0xe4, 0xa1, 0x1c, 0xcc, 0xa1, 0x1c, 0xe4, 0xa1, 0x1c, 0xdc, 0x61,
-  0x1c, 0xca, 0x21, 0x1c, 0xc4, 0x81, 0x1d, 0xca, 0x61, 0x06, 0xd6, 0x90,
-  0x43, 0x39, 0xc8, 0x43, 0x39, 0x98, 0x43, 0x39, 0xc8, 0x43, 0x39, 0xb8,
-  0xc3, 0x38, 0x94, 0x43, 0x38, 0x88, 0x03, 0x3b, 0x94, 0xc3, 0x2f, 0xbc,
-  0x83, 0x3c, 0xfc, 0x82, 0x3b, 0xd4, 0x03, 0x3b, 0xb0, 0xc3, 0x8c, 0xc8,
-  0x21, 0x07, 0x7c, 0x70, 0x03, 0x72, 0x10, 0x87, 0x73, 0x70, 0x03, 0x7b,
-  0x08, 0x07, 0x79, 0x60, 0x87, 0x70, 0xc8, 0x87, 0x77, 0xa8, 0x07, 0x7a,
-  0x00, 0x00, 0x00, 0x00, 0x71, 0x20, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00,
-  0x05, 0x70, 0x05, 0x7e, 0xcd, 0xf4, 0x7c, 0x0e, 0x04, 0x66, 0x83, 0xd8,
-  0x2a, 0x32, 0x4d, 0x4f, 0xba, 0xcd, 0x6f, 0x20, 0x10, 0xa8, 0x05, 0x00,
-  0x61, 0x20, 0x00, 0x00, 0x11, 0x00, 0x00, 0x00, 0x13, 0x04, 0x41, 0x2c,
-  0x10, 0x00, 0x00, 0x00, 0x06, 0x00, 0x00, 0x00, 0x24, 0x63, 0x11, 0xad,
-  0x39, 0xe7, 0xe4, 0xd7, 0x9a, 0x73, 0x4e, 0x7e, 0xad, 0x39, 0xe7, 0xf4,
-  0x07, 0x82, 0x20, 0x88, 0xff, 0x02, 0x00, 0x00, 0x7b, 0x06, 0x41, 0x51,
-  0x86, 0x0d, 0x88, 0x40, 0x18, 0x00, 0x0c, 0x07, 0x02, 0x00, 0x00, 0x00,
-  0x02, 0x00, 0x00, 0x00, 0xe6, 0x70, 0x3c, 0x00, 0xb6, 0x38, 0xc0, 0x00,
-  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00
-};
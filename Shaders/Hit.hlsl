@@ -10,38 +10,74 @@ cbuffer SceneConstantBuffer : register(b0)
     float4 lightDiffuseColor;
 };
 
-// Object constant buffer
+// Integrator, root constants shared with the ray generation shader
+cbuffer PathTracingConstants : register(b3)
+{
+    uint pathTracing;
+    uint maxBounces;
+    uint samplesPerPixel;
+    float lightIntensity;
+};
+
+// Object constants, local root constants stored in the instance's hit group record
 cbuffer ObjectConstantBuffer : register(b1)
 {
     float4 objectColor;
+    uint indexSizeInBytes;
 };
 
-// Vertex buffer
+// Vertex and index buffers of the instance's geometry, local root descriptors stored in its hit group record
 struct Vertex
 {
     float3 position;
     float3 normal;
 };
 StructuredBuffer<Vertex> Vertices : register(t1);
-
-// Index buffer
 ByteAddressBuffer Indices : register(t2);
 
+// Load the three 16 bit indices of a triangle. ByteAddressBuffer loads must be 4 byte aligned,
+// so the two 32 bit words covering the triangle are loaded and the indices extracted from them.
+// Triangles start on a 2 byte boundary every other primitive, in which case the first index
+// is in the upper half of the first word. The index buffer is padded so the second word always exists.
+uint3 Load3x16BitIndices(uint offsetBytes)
+{
+    const uint dwordAlignedOffset = offsetBytes & ~3;
+    const uint2 four16BitIndices = Indices.Load2(dwordAlignedOffset);
+
+    uint3 indices;
+    if (dwordAlignedOffset == offsetBytes)
+    {
+        indices.x = four16BitIndices.x & 0xffff;
+        indices.y = (four16BitIndices.x >> 16) & 0xffff;
+        indices.z = four16BitIndices.y & 0xffff;
+    }
+    else
+    {
+        indices.x = (four16BitIndices.x >> 16) & 0xffff;
+        indices.y = four16BitIndices.y & 0xffff;
+        indices.z = (four16BitIndices.y >> 16) & 0xffff;
+    }
+    return indices;
+}
+
 [shader("closesthit")] 
 void ClosestHit(inout HitInfo payload, Attributes attrib) 
 {
     // Get the hit triangle
-    uint indexSizeInBytes = 4;
     uint indicesPerTriangle = 3;
     uint triangleIndexStride = indicesPerTriangle * indexSizeInBytes;
     uint baseIndex = PrimitiveIndex() * triangleIndexStride;
 
     // Load indices for the hit triangle
-    uint3 indices = uint3(
-        Indices.Load(baseIndex),
-        Indices.Load(baseIndex + indexSizeInBytes),
-        Indices.Load(baseIndex + 2 * indexSizeInBytes)
-    );
+    uint3 indices;
+    if (indexSizeInBytes == 2)
+    {
+        indices = Load3x16BitIndices(baseIndex);
+    }
+    else
+    {
+        indices = Indices.Load3(baseIndex);
+    }
 
     // Get the vertices for the hit triangle
     Vertex v0 = Vertices[indices.x];
@@ -50,10 +86,22 @@ void ClosestHit(inout HitInfo payload, Attributes attrib)
 
     // Interpolate the normal using the barycentric coordinates
     float3 barycentrics = float3(1.0 - attrib.bary.x - attrib.bary.y, attrib.bary.x, attrib.bary.y);
-    float3 normal = normalize(v0.normal * barycentrics.x + v1.normal * barycentrics.y + v2.normal * barycentrics.z);
+    float3 objectNormal = v0.normal * barycentrics.x + v1.normal * barycentrics.y + v2.normal * barycentrics.z;
+
+    // Instances are placed by their transforms, so shading happens in world space. 
+    // Normals are transformed by the inverse transpose, which keeps them perpendicular under non uniform scale.
+    float3 normal = normalize(mul(objectNormal, (float3x3)WorldToObject3x4()));
+
+    // Path tracing lights the hit in the ray generation shader, which needs the surface and its orientation only
+    if (pathTracing != 0)
+    {
+        payload.colorAndDistance = float4(objectColor.rgb, RayTCurrent());
+        payload.packedNormal = PackNormal(normal);
+        return;
+    }
 
     // Calculate the position of the hit point
-    float3 hitPosition = v0.position * barycentrics.x + v1.position * barycentrics.y + v2.position * barycentrics.z;
+    float3 hitPosition = WorldRayOrigin() + WorldRayDirection() * RayTCurrent();
     
     // Calculate the direction to the light
     float3 lightDir = normalize(lightPosition.xyz - hitPosition);
@@ -3,6 +3,12 @@
 // Raytracing output texture, accessed as a UAV
 RWTexture2D<float4> gOutput : register(u0);
 
+// Running mean of the samples of earlier frames, in the same descriptor table as the output
+RWTexture2D<float4> gAccumulation : register(u1);
+
+// Rays traced at every depth of the paths, one 32 bit counter per depth
+RWByteAddressBuffer gRayCounters : register(u2);
+
 // Scene constant buffer
 cbuffer SceneConstantBuffer : register(b0)
 {
@@ -13,6 +19,35 @@ cbuffer SceneConstantBuffer : register(b0)
     float4 lightDiffuseColor;
 };
 
+// Progressive accumulation, root constants
+cbuffer AccumulationConstants : register(b2)
+{
+    // Samples already averaged in gAccumulation, 0 discards them
+    uint sampleIndex;
+    // Samples the image converges at, 0 traces every pixel afresh without accumulating
+    uint sampleCount;
+};
+
+// Integrator, root constants
+cbuffer PathTracingConstants : register(b3)
+{
+    // 0 shades the primary hits with the Lambert lighting of the hit shader
+    uint pathTracing;
+    // Diffuse bounces after the primary hit
+    uint maxBounces;
+    // Samples of every pixel traced by the dispatch
+    uint samplesPerPixel;
+    // Radiant intensity of the point light per unit of its diffuse colour
+    float lightIntensity;
+};
+
+// Bounces the ray counters have room for, MaxPathBounces of RTScene.h
+static const uint MaxPathBounces = 15;
+
+static const float RayTMin = 0.001;
+static const float RayTMax = 10000.0;
+static const float Pi = 3.14159265;
+
 // Raytracing acceleration structure, accessed as a SRV
 RaytracingAccelerationStructure SceneBVH : register(t0);
 
@@ -21,46 +56,237 @@ StructuredBuffer<float3> Vertices : register(t1);
 // Index buffer
 ByteAddressBuffer Indices : register(t2);
 
-[shader("raygeneration")] 
-void RayGen() {
-    // Initialize the ray payload
-    HitInfo payload;
-    payload.colorAndDistance = float4(0.0, 0.0, 0.0, 0.0);
+// Integer hash with good avalanche, for per-pixel decorrelation
+uint Hash(uint value)
+{
+    value ^= value >> 16;
+    value *= 0x7feb352du;
+    value ^= value >> 15;
+    value *= 0x846ca68bu;
+    value ^= value >> 16;
+    return value;
+}
 
-    // Get the location within the dispatched 2D grid of work items
-    uint2 launchIndex = DispatchRaysIndex();
-    uint2 launchDim = DispatchRaysDimensions();
+// Position of a sample within its pixel: the R2 low-discrepancy sequence, computed in 0.32 fixed point so
+// it is exact for any sample index, shifted by a per-pixel hash so neighbouring pixels don't share a pattern.
+// The shift wraps around the pixel, which keeps the sequence's low discrepancy.
+float2 SampleOffset(uint2 pixel, uint index)
+{
+    uint rotation = Hash(pixel.x ^ Hash(pixel.y));
+    uint2 fixedPoint = uint2(index * 3242174889u + rotation, index * 2447445414u + Hash(rotation));
+    return float2(fixedPoint >> 8) * (1.0 / 16777216.0);
+}
 
-    // Generate primary ray from the camera
-    float2 pixelCenter = launchIndex + float2(0.5, 0.5);
-    float2 screenPos = (pixelCenter / float2(launchDim)) * 2.0 - 1.0;
-    
-    // Invert Y for DirectX coordinate system
-    screenPos.y = -screenPos.y;
+// Uniform random number in [0, 1), from a PCG step of the path's state
+float Random(inout uint state)
+{
+    state = state * 747796405u + 2891336453u;
+    uint word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+    word = (word >> 22u) ^ word;
+    return float(word >> 8) * (1.0 / 16777216.0);
+}
+
+// Direction around the normal with a density proportional to the cosine, in a basis built without branches (Duff et al. 2017)
+float3 CosineSampleHemisphere(float3 normal, float u1, float u2)
+{
+    float signZ = normal.z >= 0.0 ? 1.0 : -1.0;
+    float a = -1.0 / (signZ + normal.z);
+    float b = normal.x * normal.y * a;
+    float3 tangent = float3(1.0 + signZ * normal.x * normal.x * a, signZ * b, -signZ * normal.x);
+    float3 bitangent = float3(b, signZ + normal.y * normal.y * a, -normal.y);
 
-    // Define ray
-    float3 origin = cameraPosition.xyz;
-    float3 direction = normalize(float3(screenPos.x, screenPos.y, 1.0));
+    float radius = sqrt(u1);
+    float phi = 2.0 * Pi * u2;
+    return normalize(tangent * (radius * cos(phi)) + bitangent * (radius * sin(phi)) + normal * sqrt(max(1.0 - u1, 0.0)));
+}
+
+// Adds a ray of every active lane to the counter of its depth, with one atomic per depth in the wave
+void CountRay(uint depth)
+{
+    for (;;)
+    {
+        uint waveDepth = WaveReadLaneFirst(depth);
+        if (waveDepth == depth)
+        {
+            uint rayCount = WaveActiveCountBits(true);
+            if (WaveIsFirstLane())
+            {
+                gRayCounters.InterlockedAdd(min(depth, MaxPathBounces) * 4, rayCount);
+            }
+            break;
+        }
+    }
+}
+
+// Returns the surface colour and distance of the closest hit, with a negative distance and the sky colour on a miss
+HitInfo TraceClosestHit(float3 origin, float3 direction, uint depth)
+{
+    HitInfo payload;
+    payload.colorAndDistance = float4(0.0, 0.0, 0.0, 0.0);
+    payload.packedNormal = 0;
 
-    // Trace the ray
     RayDesc ray;
     ray.Origin = origin;
     ray.Direction = direction;
-    ray.TMin = 0.001;
-    ray.TMax = 10000.0;
+    ray.TMin = RayTMin;
+    ray.TMax = RayTMax;
 
-    // Trace the ray
     TraceRay(
         SceneBVH,         // Acceleration structure
         RAY_FLAG_NONE,    // Ray flags
         0xFF,             // Instance inclusion mask
         0,                // Ray contribution to hit group index
-        0,                // Multiplier for geometry contribution to hit group index
+        1,                // Multiplier for geometry contribution to hit group index, one record per ray type
         0,                // Miss shader index
         ray,              // Ray description
         payload           // Ray payload
     );
+    CountRay(depth);
+    return payload;
+}
+
+// Whether nothing lies between the origin and the point at distance along the direction. Any hit ends the
+// search without running the hit shader, so only the miss shader writes the payload.
+bool IsVisible(float3 origin, float3 direction, float distance, uint depth)
+{
+    HitInfo payload;
+    payload.colorAndDistance = float4(0.0, 0.0, 0.0, 0.0);
+    payload.packedNormal = 0;
+
+    RayDesc ray;
+    ray.Origin = origin;
+    ray.Direction = direction;
+    ray.TMin = RayTMin;
+    ray.TMax = distance;
+
+    TraceRay(SceneBVH, RAY_FLAG_ACCEPT_FIRST_HIT_AND_END_SEARCH | RAY_FLAG_SKIP_CLOSEST_HIT_SHADER, 0xFF, 0, 1, 0, ray, payload);
+    CountRay(depth);
+    return payload.colorAndDistance.w < 0.0;
+}
+
+// Light reaching the camera along a ray, over a path of diffuse bounces. Every hit is lit directly by the point
+// light, through a shadow ray toward it, and the path continues in a cosine weighted direction, until it leaves
+// for the sky, reaches the bounce limit or is terminated by Russian roulette.
+float3 TracePath(float3 origin, float3 direction, inout uint rngState)
+{
+    float3 radiance = float3(0.0, 0.0, 0.0);
+    float3 throughput = float3(1.0, 1.0, 1.0);
+    uint bounceCount = min(maxBounces, MaxPathBounces);
+
+    for (uint depth = 0; ; ++depth)
+    {
+        HitInfo payload = TraceClosestHit(origin, direction, depth);
+        if (payload.colorAndDistance.w < 0.0)
+        {
+            radiance += throughput * payload.colorAndDistance.rgb;
+            break;
+        }
+
+        // Surfaces are lit on the side the ray arrives from
+        float3 albedo = payload.colorAndDistance.rgb;
+        float3 normal = UnpackNormal(payload.packedNormal);
+        normal = dot(normal, direction) > 0.0 ? -normal : normal;
+        float3 position = origin + direction * payload.colorAndDistance.w;
+
+        // Next event estimation. A point light can't be hit by chance, so it is only reached through the shadow ray.
+        // Its intensity over the squared distance, times the cosine, is the irradiance, which the Lambert BRDF,
+        // albedo over pi, turns into reflected radiance.
+        float3 toLight = lightPosition.xyz - position;
+        float lightDistance = length(toLight);
+        toLight /= lightDistance;
+        float cosine = dot(normal, toLight);
+        if (cosine > 0.0 && IsVisible(position, toLight, lightDistance, depth))
+        {
+            float3 irradiance = lightDiffuseColor.rgb * lightIntensity * cosine / (lightDistance * lightDistance);
+            radiance += throughput * albedo / Pi * irradiance;
+        }
+
+        if (depth == bounceCount)
+        {
+            break;
+        }
+
+        // The cosine weighted direction cancels the cosine and 1/pi of the Lambert BRDF, leaving the albedo as the weight
+        throughput *= albedo;
+
+        // Russian roulette from the second bounce: dim paths are terminated with the probability they have lost, and the
+        // survivors carry their weight, which keeps the estimate unbiased.
+        if (depth > 0)
+        {
+            float survival = min(max(throughput.r, max(throughput.g, throughput.b)), 0.95);
+            if (Random(rngState) >= survival)
+            {
+                break;
+            }
+            throughput /= survival;
+        }
+
+        float u1 = Random(rngState);
+        float u2 = Random(rngState);
+        origin = position;
+        direction = CosineSampleHemisphere(normal, u1, u2);
+    }
+    return radiance;
+}
+
+[shader("raygeneration")] 
+void RayGen() {
+    // Get the location within the dispatched 2D grid of work items
+    uint2 launchIndex = DispatchRaysIndex();
+    uint2 launchDim = DispatchRaysDimensions();
+
+    // A converged image is output as it is, without tracing
+    if (sampleCount > 0 && sampleIndex >= sampleCount)
+    {
+        gOutput[launchIndex] = float4(gAccumulation[launchIndex].rgb, 1.0);
+        return;
+    }
+
+    uint samples = max(samplesPerPixel, 1);
+    float3 color = float3(0.0, 0.0, 0.0);
+    for (uint pixelSample = 0; pixelSample < samples; ++pixelSample)
+    {
+        // The samples of an accumulation continue the pixel's sequence from one dispatch to the next
+        uint sequenceIndex = (sampleCount > 0 ? sampleIndex : 0) * samples + pixelSample;
+        float2 pixelOffset = float2(0.5, 0.5);
+        if (sampleCount > 0 || samples > 1)
+        {
+            pixelOffset = SampleOffset(launchIndex, sequenceIndex);
+        }
+
+        // Generate primary ray from the camera
+        float2 pixelCenter = launchIndex + pixelOffset;
+        float2 screenPos = (pixelCenter / float2(launchDim)) * 2.0 - 1.0;
+
+        // Invert Y for DirectX coordinate system
+        screenPos.y = -screenPos.y;
+
+        float3 origin = cameraPosition.xyz;
+        float3 direction = normalize(float3(screenPos.x, screenPos.y, 1.0));
+
+        if (pathTracing != 0)
+        {
+            uint rngState = Hash((launchIndex.y * launchDim.x + launchIndex.x) ^ Hash(sequenceIndex));
+            color += TracePath(origin, direction, rngState);
+        }
+        else
+        {
+            color += TraceClosestHit(origin, direction, 0).colorAndDistance.rgb;
+        }
+    }
+    color *= 1.0 / float(samples);
+
+    // Average the samples with those of earlier frames, unclamped, so bright samples keep their weight
+    if (sampleCount > 0)
+    {
+        if (sampleIndex > 0)
+        {
+            float3 mean = gAccumulation[launchIndex].rgb;
+            color = mean + (color - mean) * (1.0 / float(sampleIndex + 1));
+        }
+        gAccumulation[launchIndex] = float4(color, 1.0);
+    }
 
     // Write the raytracing result to the output texture
-    gOutput[launchIndex] = float4(payload.colorAndDistance.rgb, 1.0);
+    gOutput[launchIndex] = float4(color, 1.0);
 }
@@ -0,0 +1,331 @@
+#include "RTSoftwareBvh.h"
+#include "../Core/RTJobSystem.h"
+#include <algorithm>
+#include <mutex>
+#include <numeric>
+#include <stdexcept>
+#include <type_traits>
+
+namespace {
+
+	// Bins per axis for the surface area heuristic, enough to get close to a full sweep at a fraction of its cost
+	constexpr uint32_t BinCount = 12;
+
+	uint32_t GetBin(float centroid, float minimum, float scale)
+	{
+		int bin = static_cast<int>((centroid - minimum) * scale);
+		return static_cast<uint32_t>(std::min<int>(std::max<int>(bin, 0), static_cast<int>(BinCount) - 1));
+	}
+
+	struct AxisBins {
+		RTBoundingBox	bounds[BinCount];
+		uint32_t		counts[BinCount] = {};
+	};
+
+	// Appends a subtree built on its own, returning the index of its root.
+	uint32_t AppendSubtree(std::vector<RTBvhNode>& target, std::vector<RTBvhNode> const& subtree)
+	{
+		uint32_t base = static_cast<uint32_t>(target.size());
+		for (RTBvhNode node : subtree)
+		{
+			if (node.primitiveCount == 0)
+			{
+				node.offset += base;
+			}
+			target.push_back(node);
+		}
+		return base;
+	}
+}
+
+void RTBoundingBox::Grow(float const point[3])
+{
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		minimum[axis] = std::min<float>(minimum[axis], point[axis]);
+		maximum[axis] = std::max<float>(maximum[axis], point[axis]);
+	}
+}
+
+void RTBoundingBox::Grow(RTBoundingBox const& box)
+{
+	for (int axis = 0; axis < 3; ++axis)
+	{
+		minimum[axis] = std::min<float>(minimum[axis], box.minimum[axis]);
+		maximum[axis] = std::max<float>(maximum[axis], box.maximum[axis]);
+	}
+}
+
+float RTBoundingBox::SurfaceArea() const
+{
+	if (IsEmpty())
+	{
+		return 0.f;
+	}
+	float x = maximum[0] - minimum[0];
+	float y = maximum[1] - minimum[1];
+	float z = maximum[2] - minimum[2];
+	return 2.f * (x * y + y * z + z * x);
+}
+
+struct RTBvh::BuildContext {
+	std::vector<RTBoundingBox> const&	primitiveBounds;
+	std::vector<float> const&			centroids;
+	uint32_t							maxLeafSize;
+	RTJobSystem&						jobSystem;
+};
+
+void RTBvh::Build(std::vector<RTBoundingBox> const& primitiveBounds, uint32_t maxLeafSize)
+{
+	Build(primitiveBounds, maxLeafSize, RTJobSystem::GetDefault());
+}
+
+void RTBvh::Build(std::vector<RTBoundingBox> const& primitiveBounds, uint32_t maxLeafSize, RTJobSystem& jobSystem)
+{
+	if (primitiveBounds.size() > UINT32_MAX)
+	{
+		throw std::runtime_error("ERROR: Too many primitives for a BVH.");
+	}
+
+	nodes.clear();
+	primitiveIndices.resize(primitiveBounds.size());
+	std::iota(primitiveIndices.begin(), primitiveIndices.end(), 0u);
+	if (primitiveBounds.empty())
+	{
+		return;
+	}
+
+	centroids.resize(primitiveBounds.size() * 3);
+	jobSystem.ParallelFor(primitiveBounds.size(), 4096, [&](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; ++i)
+			{
+				for (int axis = 0; axis < 3; ++axis)
+				{
+					centroids[i * 3 + axis] = 0.5f * (primitiveBounds[i].minimum[axis] + primitiveBounds[i].maximum[axis]);
+				}
+			}
+		});
+
+	// A binary tree with at least one primitive per leaf has fewer than twice as many nodes as primitives.
+	nodes.reserve(primitiveBounds.size() * 2);
+	BuildContext context{ primitiveBounds, centroids, std::max<uint32_t>(maxLeafSize, 1), jobSystem };
+	BuildNode(context, nodes, 0, static_cast<uint32_t>(primitiveBounds.size()), 0);
+}
+
+void RTBvh::ReleaseBuildMemory()
+{
+	std::vector<float>().swap(centroids);
+}
+
+uint32_t RTBvh::BuildNode(BuildContext const& context, std::vector<RTBvhNode>& target, uint32_t begin, uint32_t end, uint32_t depth)
+{
+	std::vector<RTBoundingBox> const& primitiveBounds = context.primitiveBounds;
+	uint32_t count = end - begin;
+	bool parallel = count >= ParallelBuildThreshold;
+
+	// Nodes are referenced by index, as building the children may reallocate the vector.
+	uint32_t nodeIndex = static_cast<uint32_t>(target.size());
+	target.push_back(RTBvhNode{});
+
+	auto GetCentroid = [&context](uint32_t primitive, int axis) { return context.centroids[primitive * size_t{ 3 } + axis]; };
+
+	// Runs accumulate(first, last, partial) over [begin, end), in parallel for large nodes, and merges the partial results.
+	auto Reduce = [&](auto& result, auto const& accumulate, auto const& merge)
+		{
+			if (!parallel)
+			{
+				accumulate(begin, end, result);
+				return;
+			}
+
+			std::mutex mutex;
+			context.jobSystem.ParallelFor(count, ParallelBuildThreshold / 4, [&](size_t first, size_t last)
+				{
+					typename std::remove_reference<decltype(result)>::type partial{};
+					accumulate(begin + static_cast<uint32_t>(first), begin + static_cast<uint32_t>(last), partial);
+
+					std::lock_guard<std::mutex> lock(mutex);
+					merge(result, partial);
+				});
+		};
+
+	RTBoundingBox nodeBounds[2];
+	Reduce(nodeBounds,
+		[&](uint32_t first, uint32_t last, RTBoundingBox (&partial)[2])
+		{
+			for (uint32_t i = first; i < last; ++i)
+			{
+				partial[0].Grow(primitiveBounds[primitiveIndices[i]]);
+				partial[1].Grow(&context.centroids[primitiveIndices[i] * size_t{ 3 }]);
+			}
+		},
+		[](RTBoundingBox (&result)[2], RTBoundingBox const (&partial)[2])
+		{
+			result[0].Grow(partial[0]);
+			result[1].Grow(partial[1]);
+		});
+	RTBoundingBox const& centroidBounds = nodeBounds[1];
+	target[nodeIndex].bounds = nodeBounds[0];
+
+	if (count <= context.maxLeafSize)
+	{
+		target[nodeIndex].offset = begin;
+		target[nodeIndex].primitiveCount = count;
+		return nodeIndex;
+	}
+
+	int largestAxis = 0;
+	for (int axis = 1; axis < 3; ++axis)
+	{
+		if (centroidBounds.maximum[axis] - centroidBounds.minimum[axis] > centroidBounds.maximum[largestAxis] - centroidBounds.minimum[largestAxis])
+		{
+			largestAxis = axis;
+		}
+	}
+
+	uint32_t middle = begin + count / 2;
+	if (centroidBounds.maximum[largestAxis] <= centroidBounds.minimum[largestAxis])
+	{
+		// Every centroid is in the same place, so any split is as good as another.
+	}
+	else if (depth >= MedianSplitDepth)
+	{
+		std::nth_element(primitiveIndices.begin() + begin, primitiveIndices.begin() + middle, primitiveIndices.begin() + end,
+			[&GetCentroid, largestAxis](uint32_t a, uint32_t b) { return GetCentroid(a, largestAxis) < GetCentroid(b, largestAxis); });
+	}
+	else
+	{
+		// Split between the bins of the axis where the summed child surface areas, weighted by their primitive counts, are smallest.
+		// Every axis is binned in the same pass over the primitives.
+		float scales[3] = {};
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			float extent = centroidBounds.maximum[axis] - centroidBounds.minimum[axis];
+			scales[axis] = extent > 0.f ? static_cast<float>(BinCount) / extent : 0.f;
+		}
+
+		AxisBins bins[3];
+		Reduce(bins,
+			[&](uint32_t first, uint32_t last, AxisBins (&partial)[3])
+			{
+				for (uint32_t i = first; i < last; ++i)
+				{
+					for (int axis = 0; axis < 3; ++axis)
+					{
+						if (scales[axis] > 0.f)
+						{
+							uint32_t bin = GetBin(GetCentroid(primitiveIndices[i], axis), centroidBounds.minimum[axis], scales[axis]);
+							partial[axis].bounds[bin].Grow(primitiveBounds[primitiveIndices[i]]);
+							++partial[axis].counts[bin];
+						}
+					}
+				}
+			},
+			[](AxisBins (&result)[3], AxisBins const (&partial)[3])
+			{
+				for (int axis = 0; axis < 3; ++axis)
+				{
+					for (uint32_t bin = 0; bin < BinCount; ++bin)
+					{
+						result[axis].bounds[bin].Grow(partial[axis].bounds[bin]);
+						result[axis].counts[bin] += partial[axis].counts[bin];
+					}
+				}
+			});
+
+		float bestCost = std::numeric_limits<float>::infinity();
+		int bestAxis = -1;
+		uint32_t bestBin = 0;
+
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			if (scales[axis] <= 0.f)
+			{
+				continue;
+			}
+			RTBoundingBox const* binBounds = bins[axis].bounds;
+			uint32_t const* binCounts = bins[axis].counts;
+
+			// Costs of the right side of every split, swept from the last bin
+			float rightCosts[BinCount] = {};
+			RTBoundingBox rightBounds;
+			uint32_t rightCount = 0;
+			for (uint32_t bin = BinCount - 1; bin > 0; --bin)
+			{
+				rightBounds.Grow(binBounds[bin]);
+				rightCount += binCounts[bin];
+				rightCosts[bin - 1] = rightBounds.SurfaceArea() * static_cast<float>(rightCount);
+			}
+
+			RTBoundingBox leftBounds;
+			uint32_t leftCount = 0;
+			for (uint32_t bin = 0; bin + 1 < BinCount; ++bin)
+			{
+				leftBounds.Grow(binBounds[bin]);
+				leftCount += binCounts[bin];
+				float cost = leftBounds.SurfaceArea() * static_cast<float>(leftCount) + rightCosts[bin];
+				if (leftCount > 0 && leftCount < count && cost < bestCost)
+				{
+					bestCost = cost;
+					bestAxis = axis;
+					bestBin = bin;
+				}
+			}
+		}
+
+		if (bestAxis >= 0)
+		{
+			float scale = scales[bestAxis];
+			float minimum = centroidBounds.minimum[bestAxis];
+			auto split = std::partition(primitiveIndices.begin() + begin, primitiveIndices.begin() + end,
+				[&GetCentroid, bestAxis, bestBin, minimum, scale](uint32_t primitive) { return GetBin(GetCentroid(primitive, bestAxis), minimum, scale) <= bestBin; });
+			middle = static_cast<uint32_t>(split - primitiveIndices.begin());
+		}
+	}
+
+	uint32_t secondChild = 0;
+	if (parallel)
+	{
+		// The first child is built by another thread into a subtree of its own, then both subtrees are appended
+		// after the node in order, their inner node offsets moved by where they land.
+		std::vector<RTBvhNode> firstNodes;
+		std::vector<RTBvhNode> secondNodes;
+		RTJobHandle firstJob = context.jobSystem.Run([&]()
+			{
+				firstNodes.reserve(size_t{ middle - begin } * 2);
+				BuildNode(context, firstNodes, begin, middle, depth + 1);
+			});
+
+		try
+		{
+			secondNodes.reserve(size_t{ end - middle } * 2);
+			BuildNode(context, secondNodes, middle, end, depth + 1);
+		}
+		catch (...)
+		{
+			// The job refers to this frame's locals.
+			try
+			{
+				context.jobSystem.Wait(firstJob);
+			}
+			catch (...)
+			{
+			}
+			throw;
+		}
+		context.jobSystem.Wait(firstJob);
+
+		AppendSubtree(target, firstNodes);
+		secondChild = AppendSubtree(target, secondNodes);
+	}
+	else
+	{
+		BuildNode(context, target, begin, middle, depth + 1);
+		secondChild = BuildNode(context, target, middle, end, depth + 1);
+	}
+
+	target[nodeIndex].offset = secondChild;
+	target[nodeIndex].primitiveCount = 0;
+	return nodeIndex;
+}
@@ -0,0 +1,175 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+class RTJobSystem;
+
+/*
+	Bounding volume hierarchy over axis aligned boxes, the acceleration structure of the software backend.
+	Bottom level structures are built over triangles and top level ones over the world space boxes of instances.
+	The tree is built top down with binned surface area heuristic splits and stored depth first in 32 byte
+	nodes, the first child of an inner node directly following it, so traversal mostly walks memory forwards.
+	Large nodes are built in parallel on an RTJobSystem: their bounds and bins are reduced over ranges of
+	primitives, and their children are built as separate subtrees which are then appended in order.
+*/
+
+struct RTBoundingBox {
+
+	float minimum[3] = { std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity(), std::numeric_limits<float>::infinity() };
+	float maximum[3] = { -std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity(), -std::numeric_limits<float>::infinity() };
+
+	void Grow(float const point[3]);
+	void Grow(RTBoundingBox const& box);
+
+	// Zero for an empty box.
+	float SurfaceArea() const;
+
+	bool IsEmpty() const { return minimum[0] > maximum[0]; }
+};
+
+struct RTBvhNode {
+
+	RTBoundingBox	bounds;
+
+	// Inner nodes: index of the second child, the first one follows the node.
+	// Leaves: index of the first primitive in RTBvh::GetPrimitiveIndices().
+	uint32_t		offset;
+
+	// Zero for inner nodes.
+	uint32_t		primitiveCount;
+};
+
+static_assert(sizeof(RTBvhNode) == 32, "BVH nodes are meant to be half a cache line.");
+
+class RTBvh {
+
+public:
+	// Replaces the tree with one over the given primitive boxes. Leaves hold at most maxLeafSize primitives.
+	// Builds on the default job system.
+	void Build(std::vector<RTBoundingBox> const& primitiveBounds, uint32_t maxLeafSize = 4);
+	void Build(std::vector<RTBoundingBox> const& primitiveBounds, uint32_t maxLeafSize, RTJobSystem& jobSystem);
+
+	// Frees the scratch memory builds keep, for a tree which won't be rebuilt.
+	void ReleaseBuildMemory();
+
+	std::vector<RTBvhNode> const& GetNodes() const { return nodes; }
+
+	// Primitive indices in leaf order, which leaves reference by offset and count.
+	std::vector<uint32_t> const& GetPrimitiveIndices() const { return primitiveIndices; }
+
+	// Box of the whole tree, empty when it has no primitives.
+	RTBoundingBox GetBounds() const { return nodes.empty() ? RTBoundingBox{} : nodes[0].bounds; }
+
+	// Calls intersect(primitiveIndex, tMax) for the primitives of every leaf the ray enters between tMin and tMax,
+	// nearer leaves first. The callback shortens tMax when it finds a closer hit, which prunes the rest of the walk.
+	template <typename TIntersect>
+	void Traverse(float const origin[3], float const direction[3], float tMin, float& tMax, TIntersect const& intersect) const
+	{
+		if (nodes.empty())
+		{
+			return;
+		}
+
+		float inverseDirection[3] = { 1.f / direction[0], 1.f / direction[1], 1.f / direction[2] };
+
+		// Build() bounds the depth of the tree, and with it the number of postponed nodes.
+		uint32_t stack[MaxDepth];
+		uint32_t stackSize = 0;
+		uint32_t nodeIndex = 0;
+
+		float entry = 0.f;
+		if (!IntersectBox(nodes[0].bounds, origin, inverseDirection, tMin, tMax, entry))
+		{
+			return;
+		}
+
+		for (;;)
+		{
+			RTBvhNode const& node = nodes[nodeIndex];
+			if (node.primitiveCount > 0)
+			{
+				for (uint32_t i = 0; i < node.primitiveCount; ++i)
+				{
+					intersect(primitiveIndices[node.offset + i], tMax);
+				}
+			}
+			else
+			{
+				uint32_t first = nodeIndex + 1;
+				uint32_t second = node.offset;
+				float firstEntry = 0.f;
+				float secondEntry = 0.f;
+				bool hitFirst = IntersectBox(nodes[first].bounds, origin, inverseDirection, tMin, tMax, firstEntry);
+				bool hitSecond = IntersectBox(nodes[second].bounds, origin, inverseDirection, tMin, tMax, secondEntry);
+
+				if (hitFirst && hitSecond)
+				{
+					// The farther child waits on the stack, it may be pruned by a hit in the nearer one.
+					if (secondEntry < firstEntry)
+					{
+						stack[stackSize++] = first;
+						nodeIndex = second;
+					}
+					else
+					{
+						stack[stackSize++] = second;
+						nodeIndex = first;
+					}
+					continue;
+				}
+				if (hitFirst || hitSecond)
+				{
+					nodeIndex = hitFirst ? first : second;
+					continue;
+				}
+			}
+
+			if (stackSize == 0)
+			{
+				return;
+			}
+			nodeIndex = stack[--stackSize];
+		}
+	}
+
+private:
+	// Slab test, writing the distance at which the ray enters the box.
+	static bool IntersectBox(RTBoundingBox const& box, float const origin[3], float const inverseDirection[3], float tMin, float tMax, float& entry)
+	{
+		for (int axis = 0; axis < 3; ++axis)
+		{
+			float t0 = (box.minimum[axis] - origin[axis]) * inverseDirection[axis];
+			float t1 = (box.maximum[axis] - origin[axis]) * inverseDirection[axis];
+			if (t0 > t1)
+			{
+				float swap = t0;
+				t0 = t1;
+				t1 = swap;
+			}
+			tMin = t0 > tMin ? t0 : tMin;
+			tMax = t1 < tMax ? t1 : tMax;
+		}
+		entry = tMin;
+		return tMin <= tMax;
+	}
+
+	// Deeper than this, nodes are split into halves, so even 32 bit primitive counts stay within MaxDepth.
+	static constexpr uint32_t MedianSplitDepth = 48;
+	static constexpr uint32_t MaxDepth = MedianSplitDepth + 48;
+
+	// Nodes with at least this many primitives are built in parallel.
+	static constexpr uint32_t ParallelBuildThreshold = 16384;
+
+	struct BuildContext;
+
+	// Builds the subtree of [begin, end) into target, with inner node offsets relative to the start of target.
+	uint32_t BuildNode(BuildContext const& context, std::vector<RTBvhNode>& target, uint32_t begin, uint32_t end, uint32_t depth);
+
+	std::vector<RTBvhNode>	nodes;
+	std::vector<uint32_t>	primitiveIndices;
+
+	// Primitive centroids, kept between builds so a tree rebuilt every frame reuses the memory
+	std::vector<float>		centroids;
+};
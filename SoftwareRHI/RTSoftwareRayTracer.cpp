@@ -0,0 +1,719 @@
+#include "RTSoftwareRayTracer.h"
+#include "../Core/RTParallel.h"
+#include "../Core/RTTrace.h"
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <stdexcept>
+
+namespace {
+
+	using RTVec3D = RTVector3D::RTVec3DImpl;
+	using RTPoint = RTPoint3D::RTPoint3DImpl;
+
+	// Ray extent of RayGen.hlsl
+	constexpr float RayTMin = 0.001f;
+	constexpr float RayTMax = 10000.f;
+
+	constexpr float Pi = 3.14159265f;
+
+	// Pixels along the side of the tiles the worker threads take in turn
+	constexpr uint32_t TileSize = 16;
+
+	// The intersection test runs for every triangle in every leaf a ray reaches, so it works on plain floats.
+	inline void Cross(float const a[3], float const b[3], float result[3])
+	{
+		result[0] = a[1] * b[2] - a[2] * b[1];
+		result[1] = a[2] * b[0] - a[0] * b[2];
+		result[2] = a[0] * b[1] - a[1] * b[0];
+	}
+
+	inline float Dot(float const a[3], float const b[3])
+	{
+		return a[0] * b[0] + a[1] * b[1] + a[2] * b[2];
+	}
+
+	// Applies the top three rows of an affine transform to a point, w = 1, or a direction, w = 0.
+	inline void Transform(float const matrix[3][4], float const value[3], float w, float result[3])
+	{
+		for (int row = 0; row < 3; ++row)
+		{
+			result[row] = matrix[row][0] * value[0] + matrix[row][1] * value[1] + matrix[row][2] * value[2] + matrix[row][3] * w;
+		}
+	}
+
+	// Float to 8 bit UNORM as the output merger converts it: saturate, then round to nearest. NaN becomes 0.
+	inline uint8_t ToUnorm8(float value)
+	{
+		if (!(value > 0.f))
+		{
+			return 0;
+		}
+		return static_cast<uint8_t>(std::min<float>(value, 1.f) * 255.f + 0.5f);
+	}
+
+	// Component wise product, which the HLSL operators perform on colours
+	inline RTVec3D Multiply(RTVec3D const& a, RTVec3D const& b)
+	{
+		return RTVec3D(a.x * b.x, a.y * b.y, a.z * b.z);
+	}
+
+	// HitInfo of Common.hlsl
+	struct HitInfo {
+		RTVec3D		colour;
+		float		distance = 0.f;
+		uint32_t	packedNormal = 0;
+	};
+
+	// PackNormal of Common.hlsl, the octahedral encoding in two 16 bit signed normalised components
+	inline uint32_t PackNormal(RTVec3D const& normal)
+	{
+		float scale = 1.f / (std::fabs(normal.x) + std::fabs(normal.y) + std::fabs(normal.z));
+		float octahedral[2] = { normal.x * scale, normal.y * scale };
+		if (normal.z < 0.f)
+		{
+			float x = octahedral[0];
+			float y = octahedral[1];
+			octahedral[0] = (1.f - std::fabs(y)) * (x >= 0.f ? 1.f : -1.f);
+			octahedral[1] = (1.f - std::fabs(x)) * (y >= 0.f ? 1.f : -1.f);
+		}
+
+		// round() of HLSL rounds halves to even, as nearbyint() does in the default rounding mode
+		uint32_t packed = 0;
+		for (int i = 0; i < 2; ++i)
+		{
+			float clamped = std::min<float>(std::max<float>(octahedral[i], -1.f), 1.f);
+			int32_t snorm = static_cast<int32_t>(std::nearbyint(clamped * 32767.f));
+			packed |= (static_cast<uint32_t>(snorm) & 0xFFFFu) << (16 * i);
+		}
+		return packed;
+	}
+
+	// UnpackNormal of Common.hlsl
+	inline RTVec3D UnpackNormal(uint32_t packedNormal)
+	{
+		float x = static_cast<float>(static_cast<int16_t>(packedNormal & 0xFFFFu)) * (1.f / 32767.f);
+		float y = static_cast<float>(static_cast<int16_t>(packedNormal >> 16)) * (1.f / 32767.f);
+		RTVec3D normal(x, y, 1.f - std::fabs(x) - std::fabs(y));
+		if (normal.z < 0.f)
+		{
+			normal.x = (1.f - std::fabs(y)) * (x >= 0.f ? 1.f : -1.f);
+			normal.y = (1.f - std::fabs(x)) * (y >= 0.f ? 1.f : -1.f);
+		}
+		return normal.GetNormal();
+	}
+
+	// Miss.hlsl
+	HitInfo Miss(RTVec3D const& rayDirection)
+	{
+		float t = std::min<float>(std::max<float>((rayDirection.y + 1.f) * 0.5f, 0.f), 1.f);
+		RTVec3D bottom(0.5f, 0.5f, 0.8f);
+		RTVec3D top(0.8f, 0.9f, 1.f);
+
+		HitInfo payload;
+		payload.colour = bottom + (top - bottom) * t;
+		payload.distance = -1.f;
+		return payload;
+	}
+
+	// Hit.hlsl
+	HitInfo ClosestHit(RTSoftwareTopLevel const& topLevel, SceneConstantBuffer const& sceneConstants, PathTracingConstants const& pathTracingConstants,
+		RTRay const& ray, RTSoftwareHit const& hit)
+	{
+		RTSoftwareTopLevel::Instance const& instance = topLevel.GetInstance(hit.instanceIndex);
+		RTSoftwareBottomLevel const& bottomLevel = *instance.bottomLevel;
+
+		// Get the vertices of the hit triangle
+		uint32_t indices[3];
+		bottomLevel.GetTriangle(hit.primitiveIndex, indices);
+		Vertex const& v0 = bottomLevel.GetVertex(indices[0]);
+		Vertex const& v1 = bottomLevel.GetVertex(indices[1]);
+		Vertex const& v2 = bottomLevel.GetVertex(indices[2]);
+
+		// Interpolate the normal using the barycentric coordinates
+		float b0 = 1.f - hit.barycentrics[0] - hit.barycentrics[1];
+		RTVec3D objectNormal = v0.normal * b0 + v1.normal * hit.barycentrics[0] + v2.normal * hit.barycentrics[1];
+
+		// mul(objectNormal, (float3x3)WorldToObject3x4()), the inverse transpose of the instance transform
+		RTVec3D worldNormal(0.f, 0.f, 0.f);
+		for (int column = 0; column < 3; ++column)
+		{
+			worldNormal[column] = objectNormal.x * instance.worldToObject[0][column] +
+				objectNormal.y * instance.worldToObject[1][column] +
+				objectNormal.z * instance.worldToObject[2][column];
+		}
+		RTVec3D normal = worldNormal.GetNormal();
+
+		// Path tracing lights the hit in RayGen, which needs the surface and its orientation only
+		HitInfo payload;
+		payload.distance = ray.t;
+		if (pathTracingConstants.enabled != 0)
+		{
+			payload.colour = RTVec3D(instance.colour[0], instance.colour[1], instance.colour[2]);
+			payload.packedNormal = PackNormal(normal);
+			return payload;
+		}
+
+		// Lambertian diffuse lighting from the point light
+		RTPoint hitPosition = ray.Position(ray.t);
+		RTPoint lightPosition(sceneConstants.lightPosition.x, sceneConstants.lightPosition.y, sceneConstants.lightPosition.z);
+		RTVec3D lightDirection = (lightPosition - hitPosition).GetNormal();
+		float diffuseFactor = std::max<float>(RTVector3D::DotProduct(normal, lightDirection), 0.f);
+
+		// Final colour = ambient + diffuse
+		payload.colour.x = sceneConstants.lightAmbientColour.x + diffuseFactor * sceneConstants.lightDiffuseColour.x * instance.colour[0];
+		payload.colour.y = sceneConstants.lightAmbientColour.y + diffuseFactor * sceneConstants.lightDiffuseColour.y * instance.colour[1];
+		payload.colour.z = sceneConstants.lightAmbientColour.z + diffuseFactor * sceneConstants.lightDiffuseColour.z * instance.colour[2];
+		return payload;
+	}
+
+	// Hash of RayGen.hlsl
+	inline uint32_t Hash(uint32_t value)
+	{
+		value ^= value >> 16;
+		value *= 0x7FEB352Du;
+		value ^= value >> 15;
+		value *= 0x846CA68Bu;
+		value ^= value >> 16;
+		return value;
+	}
+
+	// SampleOffset of RayGen.hlsl: the R2 sequence in 0.32 fixed point, shifted by a per-pixel hash
+	inline void SampleOffset(uint32_t x, uint32_t y, uint32_t index, float& offsetX, float& offsetY)
+	{
+		uint32_t rotation = Hash(x ^ Hash(y));
+		offsetX = static_cast<float>((index * 3242174889u + rotation) >> 8) * (1.f / 16777216.f);
+		offsetY = static_cast<float>((index * 2447445414u + Hash(rotation)) >> 8) * (1.f / 16777216.f);
+	}
+
+	// Random of RayGen.hlsl, a PCG step
+	inline float Random(uint32_t& state)
+	{
+		state = state * 747796405u + 2891336453u;
+		uint32_t word = ((state >> ((state >> 28u) + 4u)) ^ state) * 277803737u;
+		word = (word >> 22u) ^ word;
+		return static_cast<float>(word >> 8) * (1.f / 16777216.f);
+	}
+
+	// CosineSampleHemisphere of RayGen.hlsl
+	RTVec3D CosineSampleHemisphere(RTVec3D const& normal, float u1, float u2)
+	{
+		float signZ = normal.z >= 0.f ? 1.f : -1.f;
+		float a = -1.f / (signZ + normal.z);
+		float b = normal.x * normal.y * a;
+		RTVec3D tangent(1.f + signZ * normal.x * normal.x * a, signZ * b, -signZ * normal.x);
+		RTVec3D bitangent(b, signZ + normal.y * normal.y * a, -normal.y);
+
+		float radius = std::sqrt(u1);
+		float phi = 2.f * Pi * u2;
+		return (tangent * (radius * std::cos(phi)) + bitangent * (radius * std::sin(phi)) + normal * std::sqrt(std::max<float>(1.f - u1, 0.f))).GetNormal();
+	}
+
+	// Dispatch wide state of RayGen.hlsl, with the ray counts of the tile being traced
+	struct RayGenContext {
+		RTSoftwareTopLevel const&		topLevel;
+		SceneConstantBuffer const&		sceneConstants;
+		AccumulationConstants const&	accumulationConstants;
+		PathTracingConstants const&		pathTracingConstants;
+		uint32_t						width;
+		uint32_t						height;
+		uint64_t*						rayCounts;
+	};
+
+	// TraceClosestHit of RayGen.hlsl
+	HitInfo TraceClosestHit(RayGenContext const& context, RTPoint const& origin, RTVec3D const& direction, uint32_t depth)
+	{
+		++context.rayCounts[std::min<uint32_t>(depth, MaxPathBounces)];
+
+		RTRay ray(origin, direction, RayTMax);
+		RTSoftwareHit hit;
+		if (context.topLevel.TraceRay(ray, RayTMin, hit))
+		{
+			return ClosestHit(context.topLevel, context.sceneConstants, context.pathTracingConstants, ray, hit);
+		}
+		return Miss(ray.d);
+	}
+
+	// TracePath of RayGen.hlsl
+	RTVec3D TracePath(RayGenContext const& context, RTPoint origin, RTVec3D direction, uint32_t& rngState)
+	{
+		SceneConstantBuffer const& sceneConstants = context.sceneConstants;
+		RTVec3D radiance(0.f, 0.f, 0.f);
+		RTVec3D throughput(1.f, 1.f, 1.f);
+		uint32_t bounceCount = std::min<uint32_t>(context.pathTracingConstants.maxBounces, MaxPathBounces);
+
+		for (uint32_t depth = 0; ; ++depth)
+		{
+			HitInfo payload = TraceClosestHit(context, origin, direction, depth);
+			if (payload.distance < 0.f)
+			{
+				radiance += Multiply(throughput, payload.colour);
+				break;
+			}
+
+			// Surfaces are lit on the side the ray arrives from
+			RTVec3D albedo = payload.colour;
+			RTVec3D normal = UnpackNormal(payload.packedNormal);
+			if (RTVector3D::DotProduct(normal, direction) > 0.f)
+			{
+				normal *= -1.f;
+			}
+			RTPoint position = origin + direction * payload.distance;
+
+			// Next event estimation, with a shadow ray toward the point light. The Lambert BRDF, albedo over pi,
+			// reflects the irradiance of the light's intensity with the inverse square falloff.
+			RTPoint lightPosition(sceneConstants.lightPosition.x, sceneConstants.lightPosition.y, sceneConstants.lightPosition.z);
+			RTVec3D toLight = lightPosition - position;
+			float lightDistance = toLight.Magnitude();
+			toLight /= lightDistance;
+			float cosine = RTVector3D::DotProduct(normal, toLight);
+			if (cosine > 0.f)
+			{
+				++context.rayCounts[std::min<uint32_t>(depth, MaxPathBounces)];
+				RTRay shadowRay(position, toLight, lightDistance);
+				if (!context.topLevel.IsOccluded(shadowRay, RayTMin))
+				{
+					RTVec3D lightColour(sceneConstants.lightDiffuseColour.x, sceneConstants.lightDiffuseColour.y, sceneConstants.lightDiffuseColour.z);
+					RTVec3D irradiance = lightColour * (context.pathTracingConstants.lightIntensity * cosine / (lightDistance * lightDistance));
+					radiance += Multiply(Multiply(throughput, albedo), irradiance) * (1.f / Pi);
+				}
+			}
+
+			if (depth == bounceCount)
+			{
+				break;
+			}
+
+			// The cosine weighted direction leaves the albedo as the weight
+			throughput = Multiply(throughput, albedo);
+
+			// Russian roulette from the second bounce
+			if (depth > 0)
+			{
+				float survival = std::min<float>(std::max<float>(throughput.x, std::max<float>(throughput.y, throughput.z)), 0.95f);
+				if (Random(rngState) >= survival)
+				{
+					break;
+				}
+				throughput /= survival;
+			}
+
+			float u1 = Random(rngState);
+			float u2 = Random(rngState);
+			origin = position;
+			direction = CosineSampleHemisphere(normal, u1, u2);
+		}
+		return radiance;
+	}
+
+	// RayGen.hlsl, for one pixel, accumulated holding its running mean when accumulating
+	RTVec3D RayGen(RayGenContext const& context, uint32_t x, uint32_t y, float* accumulated)
+	{
+		AccumulationConstants const& accumulationConstants = context.accumulationConstants;
+
+		// A converged image is output as it is, without tracing
+		if (accumulationConstants.sampleCount > 0 && accumulationConstants.sampleIndex >= accumulationConstants.sampleCount)
+		{
+			return RTVec3D(accumulated[0], accumulated[1], accumulated[2]);
+		}
+
+		uint32_t samples = std::max<uint32_t>(context.pathTracingConstants.samplesPerPixel, 1);
+		RTVec3D colour(0.f, 0.f, 0.f);
+		for (uint32_t pixelSample = 0; pixelSample < samples; ++pixelSample)
+		{
+			// The samples of an accumulation continue the pixel's sequence from one dispatch to the next
+			uint32_t sequenceIndex = (accumulationConstants.sampleCount > 0 ? accumulationConstants.sampleIndex : 0) * samples + pixelSample;
+			float offsetX = 0.5f;
+			float offsetY = 0.5f;
+			if (accumulationConstants.sampleCount > 0 || samples > 1)
+			{
+				SampleOffset(x, y, sequenceIndex, offsetX, offsetY);
+			}
+
+			// Generate the primary ray from the camera, inverting Y for the DirectX coordinate system
+			float screenX = (static_cast<float>(x) + offsetX) / static_cast<float>(context.width) * 2.f - 1.f;
+			float screenY = -((static_cast<float>(y) + offsetY) / static_cast<float>(context.height) * 2.f - 1.f);
+
+			SceneConstantBuffer const& sceneConstants = context.sceneConstants;
+			RTPoint origin(sceneConstants.cameraPosition.x, sceneConstants.cameraPosition.y, sceneConstants.cameraPosition.z);
+			RTVec3D direction = RTVec3D(screenX, screenY, 1.f).GetNormal();
+
+			if (context.pathTracingConstants.enabled != 0)
+			{
+				uint32_t rngState = Hash((y * context.width + x) ^ Hash(sequenceIndex));
+				colour += TracePath(context, origin, direction, rngState);
+			}
+			else
+			{
+				colour += TraceClosestHit(context, origin, direction, 0).colour;
+			}
+		}
+		colour *= 1.f / static_cast<float>(samples);
+
+		// Average the samples with those of earlier frames, unclamped
+		if (accumulationConstants.sampleCount > 0)
+		{
+			if (accumulationConstants.sampleIndex > 0)
+			{
+				RTVec3D mean(accumulated[0], accumulated[1], accumulated[2]);
+				colour = mean + (colour - mean) * (1.f / static_cast<float>(accumulationConstants.sampleIndex + 1));
+			}
+			accumulated[0] = colour.x;
+			accumulated[1] = colour.y;
+			accumulated[2] = colour.z;
+			accumulated[3] = 1.f;
+		}
+		return colour;
+	}
+}
+
+RTSoftwareBottomLevel::RTSoftwareBottomLevel(uint8_t const* vertices, uint32_t vertexCount, uint8_t const* indices, uint32_t indexCount, uint32_t indexSizeInBytes) :
+	vertices{ vertices },
+	vertexCount{ vertexCount },
+	indices{ indices },
+	indexCount{ indexCount },
+	indexSizeInBytes{ indexSizeInBytes }
+{
+	if (indexSizeInBytes != sizeof(uint16_t) && indexSizeInBytes != sizeof(uint32_t))
+	{
+		throw std::runtime_error("ERROR: Indices must be 16 or 32 bits.");
+	}
+}
+
+void RTSoftwareBottomLevel::Build()
+{
+	RT_TRACE_ZONE("Software BLAS build");
+
+	uint32_t triangleCount = indexCount / 3;
+	triangles.resize(triangleCount);
+	std::vector<RTBoundingBox> bounds(triangleCount);
+
+	RTParallel::ParallelFor(triangleCount, 4096, [&](size_t begin, size_t end)
+		{
+			for (size_t primitive = begin; primitive < end; ++primitive)
+			{
+				uint32_t triangleIndices[3];
+				GetTriangle(static_cast<uint32_t>(primitive), triangleIndices);
+
+				float positions[3][3];
+				for (int corner = 0; corner < 3; ++corner)
+				{
+					if (triangleIndices[corner] >= vertexCount)
+					{
+						throw std::runtime_error("ERROR: Triangle index outside of the vertex buffer.");
+					}
+					Vertex const& vertex = GetVertex(triangleIndices[corner]);
+					positions[corner][0] = vertex.position.x;
+					positions[corner][1] = vertex.position.y;
+					positions[corner][2] = vertex.position.z;
+					bounds[primitive].Grow(positions[corner]);
+				}
+
+				Triangle& triangle = triangles[primitive];
+				for (int axis = 0; axis < 3; ++axis)
+				{
+					triangle.v0[axis] = positions[0][axis];
+					triangle.edge1[axis] = positions[1][axis] - positions[0][axis];
+					triangle.edge2[axis] = positions[2][axis] - positions[0][axis];
+				}
+			}
+		});
+
+	// Bottom level structures are built once.
+	bvh.Build(bounds);
+	bvh.ReleaseBuildMemory();
+}
+
+bool RTSoftwareBottomLevel::Intersect(RTRay& ray, float tMin, RTSoftwareHit& hit, bool acceptFirstHit) const
+{
+	float origin[3] = { ray.o.x, ray.o.y, ray.o.z };
+	float direction[3] = { ray.d.x, ray.d.y, ray.d.z };
+	float tMax = ray.length;
+	bool found = false;
+
+	// Moller-Trumbore, without culling either face, like a ray traced with RAY_FLAG_NONE
+	bvh.Traverse(origin, direction, tMin, tMax, [&](uint32_t primitive, float& closest)
+		{
+			if (found && acceptFirstHit)
+			{
+				return;
+			}
+			Triangle const& triangle = triangles[primitive];
+
+			float p[3];
+			Cross(direction, triangle.edge2, p);
+			float determinant = Dot(triangle.edge1, p);
+			if (std::fabs(determinant) < 1e-12f)
+			{
+				return;
+			}
+			float inverseDeterminant = 1.f / determinant;
+
+			float s[3] = { origin[0] - triangle.v0[0], origin[1] - triangle.v0[1], origin[2] - triangle.v0[2] };
+			float u = Dot(s, p) * inverseDeterminant;
+			if (u < 0.f || u > 1.f)
+			{
+				return;
+			}
+
+			float q[3];
+			Cross(s, triangle.edge1, q);
+			float v = Dot(direction, q) * inverseDeterminant;
+			if (v < 0.f || u + v > 1.f)
+			{
+				return;
+			}
+
+			float t = Dot(triangle.edge2, q) * inverseDeterminant;
+			if (t <= tMin || t >= closest)
+			{
+				return;
+			}
+
+			// u and v weight the second and third vertex, as the barycentrics of a triangle hit group do.
+			closest = t;
+			hit.t = t;
+			hit.barycentrics[0] = u;
+			hit.barycentrics[1] = v;
+			hit.primitiveIndex = primitive;
+			found = true;
+
+			// No box can be entered before tMin, which ends the walk.
+			if (acceptFirstHit)
+			{
+				closest = -std::numeric_limits<float>::infinity();
+			}
+		});
+
+	if (found)
+	{
+		ray.t = hit.t;
+		ray.length = hit.t;
+	}
+	return found;
+}
+
+void RTSoftwareBottomLevel::GetTriangle(uint32_t primitiveIndex, uint32_t triangleIndices[3]) const
+{
+	size_t first = size_t{ primitiveIndex } * 3;
+	for (int corner = 0; corner < 3; ++corner)
+	{
+		if (indexSizeInBytes == sizeof(uint16_t))
+		{
+			uint16_t index;
+			std::memcpy(&index, indices + (first + corner) * sizeof(uint16_t), sizeof(index));
+			triangleIndices[corner] = index;
+		}
+		else
+		{
+			std::memcpy(&triangleIndices[corner], indices + (first + corner) * sizeof(uint32_t), sizeof(uint32_t));
+		}
+	}
+}
+
+void RTSoftwareTopLevel::Build(Instance const* newInstances, size_t instanceCount)
+{
+	RT_TRACE_ZONE("Software TLAS build");
+
+	instances.clear();
+	instanceBounds.clear();
+	for (size_t i = 0; i < instanceCount; ++i)
+	{
+		Instance const& instance = newInstances[i];
+		RTBoundingBox objectBounds = instance.bottomLevel->GetBounds();
+		if (objectBounds.IsEmpty())
+		{
+			continue;
+		}
+
+		// The world box encloses the transformed corners of the object box.
+		RTBoundingBox worldBounds;
+		for (int corner = 0; corner < 8; ++corner)
+		{
+			float point[3] = {
+				(corner & 1) ? objectBounds.maximum[0] : objectBounds.minimum[0],
+				(corner & 2) ? objectBounds.maximum[1] : objectBounds.minimum[1],
+				(corner & 4) ? objectBounds.maximum[2] : objectBounds.minimum[2] };
+			float worldPoint[3];
+			Transform(instance.objectToWorld, point, 1.f, worldPoint);
+			worldBounds.Grow(worldPoint);
+		}
+
+		instances.push_back(instance);
+		instanceBounds.push_back(worldBounds);
+	}
+
+	// Instances are few and large, so each gets its own leaf.
+	bvh.Build(instanceBounds, 1);
+}
+
+bool RTSoftwareTopLevel::TraceRay(RTRay& ray, float tMin, RTSoftwareHit& hit) const
+{
+	float origin[3] = { ray.o.x, ray.o.y, ray.o.z };
+	float direction[3] = { ray.d.x, ray.d.y, ray.d.z };
+	float tMax = ray.length;
+	bool found = false;
+
+	bvh.Traverse(origin, direction, tMin, tMax, [&](uint32_t instanceIndex, float& closest)
+		{
+			Instance const& instance = instances[instanceIndex];
+
+			// The direction isn't normalised in object space, so distances along the ray are the same in both spaces.
+			float objectOrigin[3];
+			float objectDirection[3];
+			Transform(instance.worldToObject, origin, 1.f, objectOrigin);
+			Transform(instance.worldToObject, direction, 0.f, objectDirection);
+
+			RTRay objectRay(RTPoint(objectOrigin[0], objectOrigin[1], objectOrigin[2]), RTVec3D(objectDirection[0], objectDirection[1], objectDirection[2]), closest);
+			RTSoftwareHit instanceHit;
+			if (instance.bottomLevel->Intersect(objectRay, tMin, instanceHit))
+			{
+				closest = instanceHit.t;
+				hit = instanceHit;
+				hit.instanceIndex = instanceIndex;
+				found = true;
+			}
+		});
+
+	if (found)
+	{
+		ray.t = hit.t;
+		ray.length = hit.t;
+	}
+	return found;
+}
+
+bool RTSoftwareTopLevel::IsOccluded(RTRay const& ray, float tMin) const
+{
+	float origin[3] = { ray.o.x, ray.o.y, ray.o.z };
+	float direction[3] = { ray.d.x, ray.d.y, ray.d.z };
+	float tMax = ray.length;
+	bool occluded = false;
+
+	bvh.Traverse(origin, direction, tMin, tMax, [&](uint32_t instanceIndex, float& closest)
+		{
+			if (occluded)
+			{
+				return;
+			}
+			Instance const& instance = instances[instanceIndex];
+
+			float objectOrigin[3];
+			float objectDirection[3];
+			Transform(instance.worldToObject, origin, 1.f, objectOrigin);
+			Transform(instance.worldToObject, direction, 0.f, objectDirection);
+
+			RTRay objectRay(RTPoint(objectOrigin[0], objectOrigin[1], objectOrigin[2]), RTVec3D(objectDirection[0], objectDirection[1], objectDirection[2]), closest);
+			RTSoftwareHit instanceHit;
+			if (instance.bottomLevel->Intersect(objectRay, tMin, instanceHit, true))
+			{
+				occluded = true;
+				closest = -std::numeric_limits<float>::infinity();
+			}
+		});
+	return occluded;
+}
+
+namespace RTSoftwareRayTracer {
+
+	bool MakeInstance(RTSoftwareBottomLevel const* bottomLevel, RTInstanceDesc const& desc, RTSoftwareTopLevel::Instance& instance)
+	{
+		float const (*m)[4] = desc.transform;
+
+		// Inverse of the linear part by cofactors, then the translation taken back through it.
+		float cofactors[3][3] = {
+			{ m[1][1] * m[2][2] - m[1][2] * m[2][1], m[1][2] * m[2][0] - m[1][0] * m[2][2], m[1][0] * m[2][1] - m[1][1] * m[2][0] },
+			{ m[0][2] * m[2][1] - m[0][1] * m[2][2], m[0][0] * m[2][2] - m[0][2] * m[2][0], m[0][1] * m[2][0] - m[0][0] * m[2][1] },
+			{ m[0][1] * m[1][2] - m[0][2] * m[1][1], m[0][2] * m[1][0] - m[0][0] * m[1][2], m[0][0] * m[1][1] - m[0][1] * m[1][0] } };
+		float determinant = m[0][0] * cofactors[0][0] + m[0][1] * cofactors[0][1] + m[0][2] * cofactors[0][2];
+		if (!(std::fabs(determinant) > 0.f) || !std::isfinite(1.f / determinant))
+		{
+			return false;
+		}
+		float inverseDeterminant = 1.f / determinant;
+
+		instance.bottomLevel = bottomLevel;
+		std::memcpy(instance.objectToWorld, desc.transform, sizeof(instance.objectToWorld));
+		std::memcpy(instance.colour, desc.colour, sizeof(instance.colour));
+		for (int row = 0; row < 3; ++row)
+		{
+			for (int column = 0; column < 3; ++column)
+			{
+				// The inverse is the transposed cofactor matrix over the determinant.
+				instance.worldToObject[row][column] = cofactors[column][row] * inverseDeterminant;
+			}
+		}
+		for (int row = 0; row < 3; ++row)
+		{
+			instance.worldToObject[row][3] = -(instance.worldToObject[row][0] * m[0][3] + instance.worldToObject[row][1] * m[1][3] + instance.worldToObject[row][2] * m[2][3]);
+		}
+		return true;
+	}
+
+	void DispatchRays(RTSoftwareTopLevel const& topLevel, SceneConstantBuffer const& sceneConstants, AccumulationConstants const& accumulationConstants,
+		PathTracingConstants const& pathTracingConstants, uint32_t width, uint32_t height, uint8_t* output, float* accumulation, uint32_t* rayCounters)
+	{
+		if (accumulationConstants.sampleCount > 0 && !accumulation)
+		{
+			throw std::runtime_error("ERROR: Accumulating dispatches need an accumulation texture.");
+		}
+
+		RT_TRACE_ZONE("Software DispatchRays");
+
+		uint32_t tilesX = (width + TileSize - 1) / TileSize;
+		uint32_t tilesY = (height + TileSize - 1) / TileSize;
+		uint32_t tileCount = tilesX * tilesY;
+
+		// Each tile counts its rays on its own and adds them to the totals once, as RayGen.hlsl does per wave.
+		std::atomic<uint64_t> rayCounts[RayCounterCount] = {};
+
+		// Tiles differ a lot in cost, which the job system's lazy splitting and stealing even out.
+		RTParallel::ParallelFor(tileCount, 1, [&](size_t firstTile, size_t endTile)
+			{
+				for (uint32_t tile = static_cast<uint32_t>(firstTile); tile < endTile; ++tile)
+				{
+					uint32_t beginX = (tile % tilesX) * TileSize;
+					uint32_t beginY = (tile / tilesX) * TileSize;
+					uint32_t endX = std::min<uint32_t>(beginX + TileSize, width);
+					uint32_t endY = std::min<uint32_t>(beginY + TileSize, height);
+
+					uint64_t tileRayCounts[RayCounterCount] = {};
+					RayGenContext context{ topLevel, sceneConstants, accumulationConstants, pathTracingConstants, width, height, tileRayCounts };
+
+					for (uint32_t y = beginY; y < endY; ++y)
+					{
+						uint8_t* pixel = output + (size_t{ y } * width + beginX) * 4;
+						float* accumulated = accumulation ? accumulation + (size_t{ y } * width + beginX) * 4 : nullptr;
+						for (uint32_t x = beginX; x < endX; ++x, pixel += 4)
+						{
+							RTVec3D colour = RayGen(context, x, y, accumulated);
+							accumulated = accumulated ? accumulated + 4 : nullptr;
+							pixel[0] = ToUnorm8(colour.x);
+							pixel[1] = ToUnorm8(colour.y);
+							pixel[2] = ToUnorm8(colour.z);
+							pixel[3] = 255;
+						}
+					}
+
+					for (uint32_t depth = 0; depth < RayCounterCount; ++depth)
+					{
+						if (tileRayCounts[depth] > 0)
+						{
+							rayCounts[depth].fetch_add(tileRayCounts[depth], std::memory_order_relaxed);
+						}
+					}
+				}
+			});
+
+		// The counters are 32 bits wide on the GPU too, where they wrap around.
+		if (rayCounters)
+		{
+			for (uint32_t depth = 0; depth < RayCounterCount; ++depth)
+			{
+				rayCounters[depth] = static_cast<uint32_t>(rayCounts[depth].load(std::memory_order_relaxed));
+			}
+		}
+	}
+}
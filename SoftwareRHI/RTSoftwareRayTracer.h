@@ -0,0 +1,109 @@
+#pragma once
+
+#include "RTSoftwareBvh.h"
+#include "../RHI/RTRenderDevice.h"
+#include "../Math/RTRay.h"
+#include <cstdint>
+#include <vector>
+
+/*
+	CPU implementation of the engine's ray tracing pipeline, the dispatch of the software backend.
+	RayGen, ClosestHit and Miss follow the shaders in /Shaders line by line, including the triangle
+	barycentrics, the world to object normal transform, the sample pattern and running mean of progressive
+	accumulation, the random numbers, bounces and Russian roulette of path tracing, the packed normal of the
+	payload and the UNORM conversion of the output, so both backends render the same image up to floating
+	point differences. A change to a shader has to be mirrored here.
+	A dispatch splits the output into tiles which the worker threads take in turn, so tiles of cheap
+	sky and expensive geometry even out across the threads.
+*/
+
+// Closest hit of a ray, with the attributes a closest hit shader sees.
+struct RTSoftwareHit {
+	float		t = 0.f;
+	float		barycentrics[2] = {};
+	uint32_t	primitiveIndex = 0;
+	uint32_t	instanceIndex = 0;
+};
+
+// Triangles of one geometry and a BVH over them. The vertex and index data is read in place, like the
+// buffers bound to the hit group, so it must outlive the structure.
+class RTSoftwareBottomLevel {
+
+public:
+	RTSoftwareBottomLevel(uint8_t const* vertices, uint32_t vertexCount, uint8_t const* indices, uint32_t indexCount, uint32_t indexSizeInBytes);
+
+	// Reads the geometry in its current state and builds the BVH over it.
+	void Build();
+
+	// Finds the closest hit between tMin and ray.length, shortening the ray to it. Returns false on a miss.
+	// With acceptFirstHit, the search ends at the first hit found, which need not be the closest.
+	bool Intersect(RTRay& ray, float tMin, RTSoftwareHit& hit, bool acceptFirstHit = false) const;
+
+	// Vertex indices of a triangle.
+	void GetTriangle(uint32_t primitiveIndex, uint32_t indices[3]) const;
+
+	Vertex const& GetVertex(uint32_t index) const { return reinterpret_cast<Vertex const*>(vertices)[index]; }
+
+	RTBoundingBox GetBounds() const { return bvh.GetBounds(); }
+
+private:
+	// First vertex and the two edges leaving it, as used by the intersection test
+	struct Triangle {
+		float v0[3];
+		float edge1[3];
+		float edge2[3];
+	};
+
+	uint8_t const*			vertices;
+	uint32_t				vertexCount;
+	uint8_t const*			indices;
+	uint32_t				indexCount;
+	uint32_t				indexSizeInBytes;
+
+	std::vector<Triangle>	triangles;
+	RTBvh					bvh;
+};
+
+// Instances of bottom level structures and a BVH over their world space boxes.
+class RTSoftwareTopLevel {
+
+public:
+	struct Instance {
+		RTSoftwareBottomLevel const*	bottomLevel;
+		float							objectToWorld[3][4];
+		float							worldToObject[3][4];
+		float							colour[4];
+	};
+
+	// Rebuilds the BVH, which for the instance counts of a scene is as cheap as a refit and never degrades.
+	// Instances of empty geometry are left out, as no ray could hit them.
+	void Build(Instance const* newInstances, size_t instanceCount);
+
+	// Finds the closest hit between tMin and ray.length, shortening the ray to it. Returns false on a miss.
+	bool TraceRay(RTRay& ray, float tMin, RTSoftwareHit& hit) const;
+
+	// Whether anything lies between tMin and ray.length, ending the search at the first hit found, like a ray
+	// traced with RAY_FLAG_ACCEPT_FIRST_HIT_AND_END_SEARCH.
+	bool IsOccluded(RTRay const& ray, float tMin) const;
+
+	Instance const& GetInstance(uint32_t instanceIndex) const { return instances[instanceIndex]; }
+
+private:
+	std::vector<Instance>		instances;
+	RTBvh						bvh;
+
+	// Kept between builds, so rebuilding every frame reuses the memory
+	std::vector<RTBoundingBox>	instanceBounds;
+};
+
+namespace RTSoftwareRayTracer {
+
+	// Converts an instance description, inverting its transform. Returns false if the transform is singular.
+	bool MakeInstance(RTSoftwareBottomLevel const* bottomLevel, RTInstanceDesc const& desc, RTSoftwareTopLevel::Instance& instance);
+
+	// Traces the samples of every pixel, writing RGBA8 rows of width * 4 bytes. When accumulating, accumulation
+	// holds the running mean of every pixel as four floats, and must be given. rayCounters, if given, receives
+	// the RayCounterCount counts of the rays traced at every depth.
+	void DispatchRays(RTSoftwareTopLevel const& topLevel, SceneConstantBuffer const& sceneConstants, AccumulationConstants const& accumulationConstants,
+		PathTracingConstants const& pathTracingConstants, uint32_t width, uint32_t height, uint8_t* output, float* accumulation, uint32_t* rayCounters);
+}
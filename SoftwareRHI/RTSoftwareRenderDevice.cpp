@@ -0,0 +1,435 @@
+#include "RTSoftwareRenderDevice.h"
+#include "RTSoftwareRayTracer.h"
+#include "../Core/RTLinearArena.h"
+#include "../Core/RTTrace.h"
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+// Fences are signalled by the queue thread and waited on by any other.
+class RTSoftwareFence : public RTFence {
+
+public:
+	RTSoftwareFence(RTSoftwareRenderDevice& device, uint64_t initialValue) :
+		device{ device },
+		completedValue{ initialValue }
+	{
+	}
+
+	uint64_t GetCompletedValue() const override
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return completedValue;
+	}
+
+	void Wait(uint64_t value) override
+	{
+		{
+			std::unique_lock<std::mutex> lock(mutex);
+			signalled.wait(lock, [this, value]() { return completedValue >= value; });
+		}
+		device.ThrowIfFailed();
+	}
+
+	// Notifies under the lock, as a waiter which returns may destroy the fence straight away.
+	void Signal(uint64_t value)
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		completedValue = std::max<uint64_t>(completedValue, value);
+		signalled.notify_all();
+	}
+
+private:
+	RTSoftwareRenderDevice&		device;
+	mutable std::mutex			mutex;
+	std::condition_variable		signalled;
+	uint64_t					completedValue;
+};
+
+namespace {
+
+	class SoftwareBuffer : public RTBuffer {
+
+	public:
+		explicit SoftwareBuffer(RTBufferDesc const& desc) :
+			usage{ desc.usage },
+			bytes(static_cast<size_t>(desc.size), 0)
+		{
+		}
+
+		uint64_t GetSize() const override { return bytes.size(); }
+
+		void const* Map() override
+		{
+			if (usage != RTBufferUsage::Readback)
+			{
+				throw std::runtime_error("ERROR: Only readback buffers can be mapped.");
+			}
+			return bytes.data();
+		}
+
+		void Unmap() override {}
+
+		RTBufferUsage			usage;
+		std::vector<uint8_t>	bytes;
+	};
+
+	class SoftwareTexture : public RTTexture {
+
+	public:
+		SoftwareTexture(uint32_t width, uint32_t height) :
+			width{ width },
+			height{ height },
+			pixels(size_t{ width } * height * 4, 0)
+		{
+		}
+
+		uint32_t GetWidth() const override { return width; }
+		uint32_t GetHeight() const override { return height; }
+
+		uint32_t				width;
+		uint32_t				height;
+		std::vector<uint8_t>	pixels;
+	};
+
+	class SoftwareAccumulationTexture : public RTTexture {
+
+	public:
+		SoftwareAccumulationTexture(uint32_t width, uint32_t height) :
+			width{ width },
+			height{ height },
+			colours(size_t{ width } * height * 4, 0.f)
+		{
+		}
+
+		uint32_t GetWidth() const override { return width; }
+		uint32_t GetHeight() const override { return height; }
+
+		uint32_t				width;
+		uint32_t				height;
+		std::vector<float>		colours;
+	};
+
+	class SoftwareBottomLevel : public RTAccelerationStructure {
+
+	public:
+		SoftwareBottomLevel(uint8_t const* vertices, uint32_t vertexCount, uint8_t const* indices, uint32_t indexCount, uint32_t indexSizeInBytes) :
+			structure{ vertices, vertexCount, indices, indexCount, indexSizeInBytes }
+		{
+		}
+
+		RTSoftwareBottomLevel structure;
+	};
+
+	class SoftwareTopLevel : public RTAccelerationStructure {
+
+	public:
+		RTSoftwareTopLevel structure;
+	};
+
+	// Recorded commands run on the queue thread, so they capture everything by value except the resources,
+	// which the caller keeps alive until the submission has completed. The commands and their data are
+	// held in the list's arena, which is reset with the list, so recording a frame doesn't allocate once
+	// the arena and the command vector have grown to the size of the frame.
+	class SoftwareCommandList : public RTCommandList {
+
+	public:
+		void Reset() override
+		{
+			commands.clear();
+			arena.Reset();
+		}
+
+		void BuildBottomLevel(RTAccelerationStructure& bottomLevel) override
+		{
+			SoftwareBottomLevel* softwareBottomLevel = Cast<SoftwareBottomLevel>(&bottomLevel, "BuildBottomLevel() expects a bottom level structure of the software device.");
+			Record([softwareBottomLevel]() { softwareBottomLevel->structure.Build(); });
+		}
+
+		void BuildTopLevel(RTAccelerationStructure& topLevel, RTInstanceDesc const* instances, size_t instanceCount) override
+		{
+			SoftwareTopLevel* softwareTopLevel = Cast<SoftwareTopLevel>(&topLevel, "BuildTopLevel() expects a top level structure of the software device.");
+
+			// A singular transform flattens its instance, which no ray can hit.
+			RTSoftwareTopLevel::Instance* softwareInstances = arena.AllocateArray<RTSoftwareTopLevel::Instance>(instanceCount);
+			size_t softwareInstanceCount = 0;
+			for (size_t i = 0; i < instanceCount; ++i)
+			{
+				SoftwareBottomLevel const* bottomLevel = Cast<SoftwareBottomLevel const>(instances[i].bottomLevel, "Instances must reference bottom level structures of the software device.");
+				if (RTSoftwareRayTracer::MakeInstance(&bottomLevel->structure, instances[i], softwareInstances[softwareInstanceCount]))
+				{
+					++softwareInstanceCount;
+				}
+			}
+
+			Record([softwareTopLevel, softwareInstances, softwareInstanceCount]() { softwareTopLevel->structure.Build(softwareInstances, softwareInstanceCount); });
+		}
+
+		void DispatchRays(RTDispatchRaysDesc const& desc) override
+		{
+			SoftwareTopLevel const* topLevel = Cast<SoftwareTopLevel const>(desc.topLevel, "DispatchRays() expects a top level structure of the software device.");
+			SoftwareTexture* output = Cast<SoftwareTexture>(desc.output, "DispatchRays() expects an output texture of the software device.");
+			SceneConstantBuffer sceneConstants = desc.sceneConstants;
+			AccumulationConstants accumulationConstants = desc.accumulationConstants;
+			PathTracingConstants pathTracingConstants = desc.pathTracingConstants;
+			if (pathTracingConstants.maxBounces > MaxPathBounces || pathTracingConstants.samplesPerPixel == 0)
+			{
+				throw std::runtime_error("ERROR: Dispatches trace at least one sample and at most MaxPathBounces bounces.");
+			}
+
+			SoftwareAccumulationTexture* accumulation = nullptr;
+			if (accumulationConstants.sampleCount > 0)
+			{
+				accumulation = Cast<SoftwareAccumulationTexture>(desc.accumulation, "Accumulating dispatches need an accumulation texture of the software device.");
+				if (accumulation->width != output->width || accumulation->height != output->height)
+				{
+					throw std::runtime_error("ERROR: The accumulation texture must be of the size of the output.");
+				}
+			}
+
+			SoftwareBuffer* rayCounters = nullptr;
+			if (desc.rayCounters)
+			{
+				rayCounters = Cast<SoftwareBuffer>(desc.rayCounters, "DispatchRays() expects a ray counter buffer of the software device.");
+				if (rayCounters->usage != RTBufferUsage::RayCounters)
+				{
+					throw std::runtime_error("ERROR: DispatchRays() expects a ray counter buffer.");
+				}
+			}
+
+			Record([topLevel, output, sceneConstants, accumulationConstants, pathTracingConstants, accumulation, rayCounters]()
+				{
+					RTSoftwareRayTracer::DispatchRays(topLevel->structure, sceneConstants, accumulationConstants, pathTracingConstants, output->width, output->height,
+						output->pixels.data(), accumulation ? accumulation->colours.data() : nullptr,
+						rayCounters ? reinterpret_cast<uint32_t*>(rayCounters->bytes.data()) : nullptr);
+				});
+		}
+
+		void CopyToReadback(RTTexture const& texture, RTBuffer& readback) override
+		{
+			SoftwareTexture const* source = Cast<SoftwareTexture const>(&texture, "CopyToReadback() expects a texture of the software device.");
+			SoftwareBuffer* destination = Cast<SoftwareBuffer>(&readback, "CopyToReadback() expects a buffer of the software device.");
+			if (destination->usage != RTBufferUsage::Readback || destination->bytes.size() < source->pixels.size())
+			{
+				throw std::runtime_error("ERROR: CopyToReadback() needs a readback buffer large enough for the texture.");
+			}
+
+			Record([source, destination]() { std::memcpy(destination->bytes.data(), source->pixels.data(), source->pixels.size()); });
+		}
+
+		void CopyToReadback(RTBuffer const& buffer, RTBuffer& readback) override
+		{
+			SoftwareBuffer const* source = Cast<SoftwareBuffer const>(&buffer, "CopyToReadback() expects a buffer of the software device.");
+			SoftwareBuffer* destination = Cast<SoftwareBuffer>(&readback, "CopyToReadback() expects a buffer of the software device.");
+			if (source->usage != RTBufferUsage::RayCounters)
+			{
+				throw std::runtime_error("ERROR: CopyToReadback() only copies ray counter buffers.");
+			}
+			if (destination->usage != RTBufferUsage::Readback || destination->bytes.size() < source->bytes.size())
+			{
+				throw std::runtime_error("ERROR: CopyToReadback() needs a readback buffer large enough for the buffer.");
+			}
+
+			Record([source, destination]() { std::memcpy(destination->bytes.data(), source->bytes.data(), source->bytes.size()); });
+		}
+
+		std::vector<std::function<void()>> const& GetCommands() const { return commands; }
+
+	private:
+		// The command is stored in the arena and only a pointer to it in the std::function, which is small
+		// enough for the function to hold without allocating.
+		template <typename TCommand>
+		void Record(TCommand command)
+		{
+			TCommand* stored = arena.Create<TCommand>(std::move(command));
+			commands.push_back([stored]() { (*stored)(); });
+		}
+
+		template <typename T, typename TBase>
+		static T* Cast(TBase* object, char const* message)
+		{
+			T* result = dynamic_cast<T*>(object);
+			if (!result)
+			{
+				throw std::runtime_error(std::string("ERROR: ") + message);
+			}
+			return result;
+		}
+
+		std::vector<std::function<void()>>	commands;
+		RTLinearArena						arena;
+	};
+}
+
+RTSoftwareRenderDevice::RTSoftwareRenderDevice() :
+	executing{ false },
+	stopping{ false }
+{
+	queueThread = std::thread([this]() { ExecuteSubmissions(); });
+}
+
+RTSoftwareRenderDevice::~RTSoftwareRenderDevice()
+{
+	// Submissions already made are finished first, as they would be on a GPU.
+	{
+		std::lock_guard<std::mutex> lock(queueMutex);
+		stopping = true;
+	}
+	queueChanged.notify_all();
+	queueThread.join();
+}
+
+std::unique_ptr<RTBuffer> RTSoftwareRenderDevice::CreateBuffer(RTBufferDesc const& desc, void const* initialData)
+{
+	if (desc.usage == RTBufferUsage::RayCounters && (desc.size < RayCounterCount * sizeof(uint32_t) || desc.size % sizeof(uint32_t) != 0))
+	{
+		throw std::runtime_error("ERROR: Ray counter buffers need a 32 bit counter for every depth.");
+	}
+
+	auto buffer = std::make_unique<SoftwareBuffer>(desc);
+	if (initialData && desc.size > 0)
+	{
+		std::memcpy(buffer->bytes.data(), initialData, buffer->bytes.size());
+	}
+	return buffer;
+}
+
+std::unique_ptr<RTTexture> RTSoftwareRenderDevice::CreateOutputTexture(uint32_t width, uint32_t height)
+{
+	return std::make_unique<SoftwareTexture>(width, height);
+}
+
+std::unique_ptr<RTTexture> RTSoftwareRenderDevice::CreateAccumulationTexture(uint32_t width, uint32_t height)
+{
+	return std::make_unique<SoftwareAccumulationTexture>(width, height);
+}
+
+std::unique_ptr<RTAccelerationStructure> RTSoftwareRenderDevice::CreateBottomLevel(RTGeometryDesc const& geometry)
+{
+	SoftwareBuffer const* vertexBuffer = dynamic_cast<SoftwareBuffer const*>(geometry.vertexBuffer);
+	SoftwareBuffer const* indexBuffer = dynamic_cast<SoftwareBuffer const*>(geometry.indexBuffer);
+	if (!vertexBuffer || !indexBuffer)
+	{
+		throw std::runtime_error("ERROR: Bottom level geometry must be in buffers of the software device.");
+	}
+	if (vertexBuffer->bytes.size() < uint64_t{ geometry.vertexCount } * sizeof(Vertex) ||
+		indexBuffer->bytes.size() < uint64_t{ geometry.indexCount } * geometry.indexSizeInBytes)
+	{
+		throw std::runtime_error("ERROR: Bottom level geometry is larger than its buffers.");
+	}
+
+	return std::make_unique<SoftwareBottomLevel>(vertexBuffer->bytes.data(), geometry.vertexCount,
+		indexBuffer->bytes.data(), geometry.indexCount, geometry.indexSizeInBytes);
+}
+
+std::unique_ptr<RTAccelerationStructure> RTSoftwareRenderDevice::CreateTopLevel()
+{
+	return std::make_unique<SoftwareTopLevel>();
+}
+
+std::unique_ptr<RTCommandList> RTSoftwareRenderDevice::CreateCommandList()
+{
+	return std::make_unique<SoftwareCommandList>();
+}
+
+std::unique_ptr<RTFence> RTSoftwareRenderDevice::CreateFence(uint64_t initialValue)
+{
+	return std::make_unique<RTSoftwareFence>(*this, initialValue);
+}
+
+void RTSoftwareRenderDevice::Submit(RTCommandList& commandList, RTFence& fence, uint64_t signalValue)
+{
+	ThrowIfFailed();
+
+	SoftwareCommandList* softwareCommandList = dynamic_cast<SoftwareCommandList*>(&commandList);
+	RTSoftwareFence* softwareFence = dynamic_cast<RTSoftwareFence*>(&fence);
+	if (!softwareCommandList || !softwareFence)
+	{
+		throw std::runtime_error("ERROR: Submit() expects a command list and fence of the software device.");
+	}
+
+	// The list is only referenced, as RTCommandList::Reset() waits for its submissions to complete, like a
+	// D3D12 command list. It can be submitted again meanwhile.
+	{
+		std::lock_guard<std::mutex> lock(queueMutex);
+		pendingSubmissions.push_back(Submission{ &softwareCommandList->GetCommands(), softwareFence, signalValue });
+	}
+	queueChanged.notify_all();
+}
+
+void RTSoftwareRenderDevice::WaitForIdle()
+{
+	{
+		std::unique_lock<std::mutex> lock(queueMutex);
+		queueChanged.wait(lock, [this]() { return pendingSubmissions.empty() && !executing; });
+	}
+	ThrowIfFailed();
+}
+
+void RTSoftwareRenderDevice::ThrowIfFailed()
+{
+	std::exception_ptr queueError;
+	{
+		std::lock_guard<std::mutex> lock(queueMutex);
+		queueError = error;
+	}
+	if (queueError)
+	{
+		std::rethrow_exception(queueError);
+	}
+}
+
+void RTSoftwareRenderDevice::ExecuteSubmissions()
+{
+	RTTrace::SetThreadName("Software queue");
+
+	// Swapped with the pending submissions, so both vectors keep their capacity and queueing doesn't allocate.
+	std::vector<Submission> submissions;
+	for (;;)
+	{
+		bool failed = false;
+		{
+			std::unique_lock<std::mutex> lock(queueMutex);
+			queueChanged.wait(lock, [this]() { return stopping || !pendingSubmissions.empty(); });
+			if (pendingSubmissions.empty())
+			{
+				return;
+			}
+			submissions.swap(pendingSubmissions);
+			executing = true;
+			failed = error != nullptr;
+		}
+
+		for (Submission const& submission : submissions)
+		{
+			if (!failed)
+			{
+				RT_TRACE_ZONE("Execute submission");
+				try
+				{
+					for (std::function<void()> const& command : *submission.commands)
+					{
+						command();
+					}
+				}
+				catch (...)
+				{
+					std::lock_guard<std::mutex> lock(queueMutex);
+					error = std::current_exception();
+					failed = true;
+				}
+			}
+
+			// The fence is signalled even after an error, so nothing waits forever. The waiter rethrows the error instead.
+			submission.fence->Signal(submission.signalValue);
+		}
+		submissions.clear();
+
+		{
+			std::lock_guard<std::mutex> lock(queueMutex);
+			executing = false;
+		}
+		queueChanged.notify_all();
+	}
+}
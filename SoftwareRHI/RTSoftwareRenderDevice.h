@@ -0,0 +1,66 @@
+#pragma once
+
+#include "../RHI/RTRenderDevice.h"
+#include <condition_variable>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/*
+	Render device which executes on the CPU, so the frame pipeline runs without a GPU or a window,
+	on any platform. Resources are plain memory, acceleration structures are BVHs and a dispatch
+	traces its rays with RTSoftwareRayTracer across all hardware threads.
+	Submissions run on a queue thread in order, as they would on a GPU queue, so the caller keeps
+	recording the next frame while the current one traces. An error on the queue thread is thrown
+	again by the next call which waits for it, Submit(), WaitForIdle() or a fence's Wait().
+*/
+
+class RTSoftwareRenderDevice : public RTRenderDevice {
+
+public:
+	RTSoftwareRenderDevice();
+	~RTSoftwareRenderDevice() override;
+
+	RTSoftwareRenderDevice(RTSoftwareRenderDevice const&) = delete;
+	RTSoftwareRenderDevice& operator =(RTSoftwareRenderDevice const&) = delete;
+
+	char const* GetName() const override { return "Software"; }
+
+	std::unique_ptr<RTBuffer> CreateBuffer(RTBufferDesc const& desc, void const* initialData = nullptr) override;
+	std::unique_ptr<RTTexture> CreateOutputTexture(uint32_t width, uint32_t height) override;
+	std::unique_ptr<RTTexture> CreateAccumulationTexture(uint32_t width, uint32_t height) override;
+	std::unique_ptr<RTAccelerationStructure> CreateBottomLevel(RTGeometryDesc const& geometry) override;
+	std::unique_ptr<RTAccelerationStructure> CreateTopLevel() override;
+	std::unique_ptr<RTCommandList> CreateCommandList() override;
+	std::unique_ptr<RTFence> CreateFence(uint64_t initialValue = 0) override;
+
+	void Submit(RTCommandList& commandList, RTFence& fence, uint64_t signalValue) override;
+	void WaitForIdle() override;
+
+	uint32_t GetReadbackRowPitch(uint32_t width) const override { return width * 4; }
+
+	// Rethrows the first error raised on the queue thread, if there was one.
+	void ThrowIfFailed();
+
+private:
+	struct Submission {
+		std::vector<std::function<void()>> const*	commands;
+		class RTSoftwareFence*						fence;
+		uint64_t									signalValue;
+	};
+
+	void ExecuteSubmissions();
+
+	std::thread					queueThread;
+	std::mutex					queueMutex;
+	std::condition_variable		queueChanged;
+	std::vector<Submission>		pendingSubmissions;
+	bool						executing;
+	bool						stopping;
+
+	// Set once, by the first command which threw. Later submissions are skipped, but still signal their fences.
+	std::exception_ptr			error;
+};
@@ -0,0 +1,135 @@
+#include "RTTest.h"
+#include "RHI/RTBuildPlanner.h"
+#include <stdexcept>
+
+namespace {
+
+	constexpr uint64_t AccelerationStructureAlignment = 256;
+
+	// The builds of a batch must use disjoint scratch memory inside the pool, and every build must be in exactly one batch.
+	bool IsValidScratchPlan(RTBuildPlan const& plan, std::vector<RTBuildSizes> const& builds)
+	{
+		std::vector<int> batchCount(builds.size(), 0);
+
+		for (RTBuildBatch const& batch : plan.batches)
+		{
+			if (batch.builds.size() != batch.scratchOffsets.size() || batch.scratchSize > plan.scratchPoolSize)
+			{
+				return false;
+			}
+
+			for (size_t i = 0; i < batch.builds.size(); ++i)
+			{
+				uint32_t build = batch.builds[i];
+				uint64_t begin = batch.scratchOffsets[i];
+				uint64_t end = begin + builds[build].scratchSize;
+				if (begin % AccelerationStructureAlignment != 0 || end > batch.scratchSize)
+				{
+					return false;
+				}
+
+				for (size_t j = 0; j < i; ++j)
+				{
+					uint64_t otherBegin = batch.scratchOffsets[j];
+					uint64_t otherEnd = otherBegin + builds[batch.builds[j]].scratchSize;
+					if (begin < otherEnd && otherBegin < end)
+					{
+						return false;
+					}
+				}
+				++batchCount[build];
+			}
+		}
+
+		for (int count : batchCount)
+		{
+			if (count != 1)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+RT_TEST(BuildsWhichFitShareOneBatch)
+{
+	std::vector<RTBuildSizes> builds{ { 1000, 1000 }, { 2000, 3000 }, { 500, 100 } };
+	RTBuildPlan plan = RTBuildPlanner::Plan(builds, 8192, 1 << 20, AccelerationStructureAlignment, AccelerationStructureAlignment);
+
+	RT_REQUIRE(plan.batches.size() == 1);
+	RT_CHECK(plan.batches[0].builds.size() == 3);
+	RT_CHECK(plan.scratchPoolSize == 3072 + 1024 + 256);
+	RT_CHECK(IsValidScratchPlan(plan, builds));
+}
+
+RT_TEST(ScratchPoolIsReusedAcrossBatches)
+{
+	// Eight builds of 3KB scratch in a 8KB pool, two fit side by side, so the pool is reused by four batches.
+	std::vector<RTBuildSizes> builds(8, RTBuildSizes{ 4096, 3 * 1024 });
+	RTBuildPlan plan = RTBuildPlanner::Plan(builds, 8192, 1 << 20, AccelerationStructureAlignment, AccelerationStructureAlignment);
+
+	RT_CHECK(plan.batches.size() == 4);
+	RT_CHECK(plan.scratchPoolSize == 6 * 1024);
+	for (RTBuildBatch const& batch : plan.batches)
+	{
+		RT_CHECK(batch.builds.size() == 2);
+		RT_CHECK(batch.scratchOffsets[0] == 0);
+	}
+	RT_CHECK(IsValidScratchPlan(plan, builds));
+}
+
+RT_TEST(BuildLargerThanThePoolGrowsIt)
+{
+	std::vector<RTBuildSizes> builds{ { 256, 1000 }, { 256, 20000 }, { 256, 1000 } };
+	RTBuildPlan plan = RTBuildPlanner::Plan(builds, 4096, 1 << 20, AccelerationStructureAlignment, AccelerationStructureAlignment);
+
+	// The pool grows to the largest build, which leaves no room beside it, so the small ones reuse the pool after it.
+	RT_CHECK(plan.scratchPoolSize == 20224);
+	RT_REQUIRE(plan.batches.size() == 2);
+	RT_CHECK(plan.batches[0].builds.size() == 1);
+	RT_CHECK(plan.batches[0].builds[0] == 1);
+	RT_CHECK(plan.batches[1].builds.size() == 2);
+	RT_CHECK(IsValidScratchPlan(plan, builds));
+}
+
+RT_TEST(ResultsAreSuballocatedAtTheAccelerationStructureAlignment)
+{
+	std::vector<RTBuildSizes> builds{ { 100, 256 }, { 300, 256 }, { 256, 256 }, { 1, 256 } };
+	RTBuildPlan plan = RTBuildPlanner::Plan(builds, 4096, 1 << 16, AccelerationStructureAlignment, AccelerationStructureAlignment);
+
+	RT_REQUIRE(plan.heapSizes.size() == 1);
+	RT_CHECK(plan.resultPlacements[0].offset == 0);
+	RT_CHECK(plan.resultPlacements[1].offset == 256);
+	RT_CHECK(plan.resultPlacements[2].offset == 768);
+	RT_CHECK(plan.resultPlacements[3].offset == 1024);
+}
+
+RT_TEST(ResultsSpillIntoNewHeaps)
+{
+	std::vector<RTBuildSizes> builds{ { 40000, 256 }, { 40000, 256 }, { 200000, 256 }, { 1000, 256 } };
+	RTBuildPlan plan = RTBuildPlanner::Plan(builds, 4096, 1 << 16, AccelerationStructureAlignment, AccelerationStructureAlignment);
+
+	// The second result doesn't fit after the first, the third gets a heap of its own, the last fills the first heap's gap.
+	RT_REQUIRE(plan.heapSizes.size() == 3);
+	RT_CHECK(plan.resultPlacements[1].heapIndex == 1);
+	RT_CHECK(plan.resultPlacements[2].heapIndex == 2);
+	RT_CHECK(plan.heapSizes[2] == 200192);
+	RT_CHECK(plan.resultPlacements[3].heapIndex == 0);
+	RT_CHECK(plan.resultPlacements[3].offset == 40192);
+}
+
+RT_TEST(ManyBuildsProduceValidPlans)
+{
+	std::vector<RTBuildSizes> builds;
+	for (uint64_t i = 0; i < 300; ++i)
+	{
+		builds.push_back(RTBuildSizes{ i * 977 % 50000 + 1, i * 613 % 30000 });
+	}
+
+	RTBuildPlan plan = RTBuildPlanner::Plan(builds, 64 * 1024, 1 << 20, AccelerationStructureAlignment, AccelerationStructureAlignment);
+	RT_CHECK(IsValidScratchPlan(plan, builds));
+	RT_CHECK(plan.scratchPoolSize <= 64 * 1024);
+
+	RT_CHECK_THROWS(RTBuildPlanner::Plan(builds, 4096, 1 << 20, 255, AccelerationStructureAlignment), std::runtime_error);
+}
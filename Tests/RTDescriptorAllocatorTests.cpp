@@ -0,0 +1,95 @@
+#include "RTTest.h"
+#include "RHI/RTDescriptorAllocator.h"
+#include <stdexcept>
+
+RT_TEST(PersistentRegionFollowsTheTransientRegion)
+{
+	RTDescriptorAllocator allocator{ 16, 8 };
+
+	RTDescriptorRange persistent = allocator.AllocatePersistent(4);
+	RT_CHECK(persistent.offset == 16);
+	RT_CHECK(allocator.GetCapacity() == 24);
+	RT_CHECK(allocator.GetFreePersistentCount() == 4);
+
+	RTDescriptorRange transient = allocator.AllocateTransient(16);
+	RT_CHECK(transient.offset == 0);
+	RT_CHECK(!allocator.AllocateTransient(1).IsValid());
+}
+
+RT_TEST(GrowthKeepsExistingPersistentRanges)
+{
+	RTDescriptorAllocator allocator{ 16, 8 };
+
+	RTDescriptorRange first = allocator.AllocatePersistent(3);
+	RTDescriptorRange second = allocator.AllocatePersistent(5);
+	RT_CHECK(first.offset == 16);
+	RT_CHECK(second.offset == 19);
+	RT_CHECK(!allocator.AllocatePersistent(1).IsValid());
+
+	allocator.GrowPersistent(32);
+	RT_CHECK(allocator.GetPersistentCapacity() == 32);
+	RT_CHECK(allocator.GetFreePersistentCount() == 24);
+
+	// The new descriptors are appended, nothing allocated before the growth moves or is handed out again.
+	RTDescriptorRange grown = allocator.AllocatePersistent(24);
+	RT_CHECK(grown.offset == 24);
+	RT_CHECK(grown.count == 24);
+	RT_CHECK(allocator.GetFreePersistentCount() == 0);
+
+	RT_CHECK_THROWS(allocator.GrowPersistent(16), std::runtime_error);
+}
+
+RT_TEST(GrowthCoalescesWithTheTrailingFreeBlock)
+{
+	RTDescriptorAllocator allocator{ 4, 8 };
+
+	RTDescriptorRange kept = allocator.AllocatePersistent(6);
+	RT_CHECK(kept.offset == 4);
+
+	// Two descriptors are left at the end, growing by six must give one block of eight.
+	allocator.GrowPersistent(14);
+	RTDescriptorRange merged = allocator.AllocatePersistent(8);
+	RT_CHECK(merged.offset == 10);
+	RT_CHECK(merged.count == 8);
+}
+
+RT_TEST(TransientRingIsUnaffectedByGrowth)
+{
+	RTDescriptorAllocator allocator{ 8, 4 };
+
+	RT_CHECK(allocator.AllocateTransient(6).offset == 0);
+	allocator.FinishFrame(1);
+	allocator.GrowPersistent(64);
+	RT_CHECK(allocator.GetTransientCapacity() == 8);
+
+	// The frame in flight still holds its descriptors.
+	RT_CHECK(!allocator.AllocateTransient(4).IsValid());
+	allocator.ReleaseCompletedFrames(1);
+	RT_CHECK(allocator.AllocateTransient(8).offset == 0);
+}
+
+RT_TEST(FreesWaitForTheFenceAndCoalesce)
+{
+	RTDescriptorAllocator allocator{ 4, 12 };
+
+	RTDescriptorRange a = allocator.AllocatePersistent(4);
+	RTDescriptorRange b = allocator.AllocatePersistent(4);
+	RTDescriptorRange c = allocator.AllocatePersistent(4);
+
+	allocator.FreePersistent(a, 1);
+	allocator.FreePersistent(b, 2);
+	allocator.FreePersistent(c, 2);
+
+	allocator.ReleaseCompletedFrames(0);
+	RT_CHECK(allocator.GetFreePersistentCount() == 0);
+
+	allocator.ReleaseCompletedFrames(1);
+	RT_CHECK(allocator.GetFreePersistentCount() == 4);
+	RT_CHECK(!allocator.AllocatePersistent(8).IsValid());
+
+	allocator.ReleaseCompletedFrames(2);
+	RTDescriptorRange whole = allocator.AllocatePersistent(12);
+	RT_CHECK(whole.offset == 4);
+
+	RT_CHECK_THROWS(allocator.FreePersistent(RTDescriptorRange{ 0, 2 }, 3), std::runtime_error);
+}
@@ -0,0 +1,99 @@
+#include "RTTest.h"
+#include "Renderer/RTFrameRenderer.h"
+#include "Scene/RTProceduralScene.h"
+#include "SoftwareRHI/RTSoftwareRenderDevice.h"
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+#include <vector>
+
+namespace {
+
+	// Counts every operator new in the process while counting is on.
+	std::atomic<bool> countAllocations{ false };
+	std::atomic<size_t> allocationCount{ 0 };
+
+	void* CountedAllocate(size_t size)
+	{
+		if (countAllocations.load(std::memory_order_relaxed))
+		{
+			allocationCount.fetch_add(1, std::memory_order_relaxed);
+		}
+		void* memory = std::malloc(size > 0 ? size : 1);
+		if (!memory)
+		{
+			throw std::bad_alloc();
+		}
+		return memory;
+	}
+
+	// Renders and reads back frames until the arenas, pools and scratch vectors have seen their largest
+	// frame, then counts the allocations of as many steady state frames again.
+	size_t CountSteadyStateAllocations(RTFrameRenderer& renderer, uint32_t frameCount)
+	{
+		std::vector<uint8_t> pixels;
+		for (uint32_t i = 0; i < frameCount; ++i)
+		{
+			renderer.ReadFrame(renderer.RenderFrame(), pixels);
+		}
+
+		allocationCount.store(0);
+		countAllocations.store(true);
+		for (uint32_t i = 0; i < frameCount; ++i)
+		{
+			renderer.ReadFrame(renderer.RenderFrame(), pixels);
+		}
+		countAllocations.store(false);
+
+		size_t count = allocationCount.load();
+		if (count != 0)
+		{
+			std::printf("%zu allocations in %u steady state frames\n", count, frameCount);
+		}
+		return count;
+	}
+
+	void SetScene(RTFrameRenderer& renderer)
+	{
+		RTProceduralSceneDesc desc;
+		desc.targetTriangleCount = 2000;
+		desc.instanceCount = 8;
+		desc.uniqueMeshCount = 3;
+		desc.sceneExtent = 2.f;
+
+		RTProceduralScene scene = RTProceduralGeometry::CreateScene(desc);
+		renderer.SetScene(scene.meshes, std::move(scene.instances));
+	}
+}
+
+void* operator new(size_t size) { return CountedAllocate(size); }
+void* operator new[](size_t size) { return CountedAllocate(size); }
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, size_t) noexcept { std::free(memory); }
+
+RT_TEST(SteadyStateFramesDoNotAllocate)
+{
+	RTSoftwareRenderDevice device;
+	RTFrameRenderer renderer{ device, 64, 48 };
+	SetScene(renderer);
+
+	RT_CHECK(CountSteadyStateAllocations(renderer, 50) == 0);
+}
+
+RT_TEST(SteadyStatePathTracedFramesDoNotAllocate)
+{
+	RTSoftwareRenderDevice device;
+	RTFrameRenderer renderer{ device, 64, 48 };
+	SetScene(renderer);
+
+	PathTracingConstants pathTracing;
+	pathTracing.enabled = 1;
+	pathTracing.maxBounces = 2;
+	renderer.SetPathTracing(pathTracing);
+
+	RT_CHECK(CountSteadyStateAllocations(renderer, 20) == 0);
+}
@@ -0,0 +1,121 @@
+#include "RTTest.h"
+#include "Renderer/RTFrameRenderer.h"
+#include "Scene/RTProceduralScene.h"
+#include "SoftwareRHI/RTSoftwareRenderDevice.h"
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+	constexpr uint32_t Width = 64;
+	constexpr uint32_t Height = 48;
+
+	// A sphere at the origin, in front of the default camera, covering the centre of the image.
+	void SetSphereScene(RTFrameRenderer& renderer)
+	{
+		std::vector<Mesh> meshes{ RTProceduralGeometry::CreateSphere(400, 0.5f) };
+		renderer.SetScene(meshes, { MeshInstance{ 0, RTMatrix4D::RTMatrix4DImpl{} } });
+	}
+
+	uint8_t const* GetPixel(std::vector<uint8_t> const& pixels, uint32_t x, uint32_t y)
+	{
+		return pixels.data() + (size_t{ y } * Width + x) * 4;
+	}
+
+	bool IsSamePixel(uint8_t const* a, uint8_t const* b)
+	{
+		return a[0] == b[0] && a[1] == b[1] && a[2] == b[2] && a[3] == b[3];
+	}
+}
+
+RT_TEST(RendersTheSceneOnTheSoftwareDevice)
+{
+	RTSoftwareRenderDevice device;
+	RTFrameRenderer renderer{ device, Width, Height };
+	SetSphereScene(renderer);
+
+	// More frames than are in flight, so every frame's resources are reused.
+	uint32_t const frameCount = 5;
+	std::vector<uint8_t> first;
+	std::vector<uint8_t> last;
+	uint64_t frameNumber = 0;
+	for (uint32_t i = 0; i < frameCount; ++i)
+	{
+		frameNumber = renderer.RenderFrame();
+		if (i == 0)
+		{
+			renderer.ReadFrame(frameNumber, first);
+		}
+	}
+	renderer.ReadFrame(frameNumber, last);
+
+	RT_CHECK(frameNumber == frameCount);
+	RT_REQUIRE(first.size() == size_t{ Width } * Height * 4);
+	RT_REQUIRE(last.size() == first.size());
+
+	// Without accumulation every frame traces the same rays, so every frame is the same image.
+	RT_CHECK(first == last);
+
+	// The sphere covers the centre and misses the corners, which show the sky, graded only from bottom to top.
+	uint8_t const* centre = GetPixel(last, Width / 2, Height / 2);
+	uint8_t const* corner = GetPixel(last, 0, 0);
+	RT_CHECK(!IsSamePixel(centre, corner));
+	RT_CHECK(centre[0] > 0 || centre[1] > 0 || centre[2] > 0);
+	RT_CHECK(IsSamePixel(corner, GetPixel(last, Width - 1, 0)));
+
+	// One primary ray per pixel and frame, and nothing deeper when only the primary hits are shaded.
+	RTRayCounts rays = renderer.GetRayCounts();
+	RT_CHECK(rays[0] == uint64_t{ frameCount } * Width * Height);
+	for (uint32_t depth = 1; depth < RayCounterCount; ++depth)
+	{
+		RT_CHECK(rays[depth] == 0);
+	}
+
+	renderer.ResetRayCounts();
+	RT_CHECK(renderer.GetRayCounts()[0] == 0);
+}
+
+RT_TEST(PathTracedFramesCountEveryDepth)
+{
+	RTSoftwareRenderDevice device;
+	RTFrameRenderer renderer{ device, Width, Height };
+	SetSphereScene(renderer);
+
+	PathTracingConstants pathTracing;
+	pathTracing.enabled = 1;
+	pathTracing.maxBounces = 2;
+	renderer.SetPathTracing(pathTracing);
+
+	std::vector<uint8_t> pixels;
+	uint64_t frameNumber = 0;
+	for (int i = 0; i < 3; ++i)
+	{
+		frameNumber = renderer.RenderFrame();
+	}
+	renderer.ReadFrame(frameNumber, pixels);
+	RT_REQUIRE(pixels.size() == size_t{ Width } * Height * 4);
+
+	// The primary hits add shadow rays at depth 0, and the bounces off the sphere trace deeper rays.
+	RTRayCounts rays = renderer.GetRayCounts();
+	RT_CHECK(rays[0] > uint64_t{ 3 } * Width * Height);
+	RT_CHECK(rays[1] > 0);
+	RT_CHECK(!IsSamePixel(GetPixel(pixels, Width / 2, Height / 2), GetPixel(pixels, 0, 0)));
+}
+
+RT_TEST(AccumulationCountsTheSamplesTaken)
+{
+	RTSoftwareRenderDevice device;
+	RTFrameRenderer renderer{ device, Width, Height };
+	SetSphereScene(renderer);
+	renderer.SetAccumulation(4);
+
+	for (uint32_t i = 1; i <= 6; ++i)
+	{
+		renderer.RenderFrame();
+		RT_CHECK(renderer.GetAccumulatedSampleCount() == std::min<uint32_t>(i, 4));
+	}
+
+	// Converged frames are output without tracing.
+	RT_CHECK(renderer.GetRayCounts()[0] == uint64_t{ 4 } * Width * Height);
+}
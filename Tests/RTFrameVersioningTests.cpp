@@ -0,0 +1,188 @@
+#include "RTTest.h"
+#include "RHI/RTFrameVersioning.h"
+#include <memory>
+
+namespace {
+
+	// Stands in for a GPU fence, the test decides when submitted frames complete.
+	struct FakeFence {
+
+		uint64_t Signal() { return ++lastSignaledValue; }
+		void CompleteUpTo(uint64_t value) { completedValue = value; }
+
+		uint64_t lastSignaledValue = 0;
+		uint64_t completedValue = 0;
+	};
+
+	// Counts releases, and records any release which happened before the fence value it was retired with.
+	struct ReleaseLog {
+		int released = 0;
+		int releasedEarly = 0;
+	};
+
+	struct TrackedObject {
+
+		TrackedObject(ReleaseLog* log, FakeFence const* fence, uint64_t fenceValue) :
+			log{ log },
+			fence{ fence },
+			fenceValue{ fenceValue }
+		{
+		}
+
+		~TrackedObject()
+		{
+			++log->released;
+			if (fence->completedValue < fenceValue)
+			{
+				++log->releasedEarly;
+			}
+		}
+
+		ReleaseLog*			log;
+		FakeFence const*	fence;
+		uint64_t			fenceValue;
+	};
+
+	using TrackedPointer = std::unique_ptr<TrackedObject>;
+
+	// Runs frames which each retire one object, with the GPU completing frames framesInFlight behind the CPU.
+	void RunFrames(size_t framesInFlight, int frameCount, ReleaseLog& log)
+	{
+		FakeFence fence;
+		RTDeferredReleaseQueue<TrackedPointer> queue;
+		std::deque<uint64_t> submittedFrames;
+
+		for (int frame = 0; frame < frameCount; ++frame)
+		{
+			// The CPU only gets framesInFlight frames ahead, then waits for the oldest one.
+			if (submittedFrames.size() == framesInFlight)
+			{
+				fence.CompleteUpTo(submittedFrames.front());
+				submittedFrames.pop_front();
+			}
+			queue.Collect(fence.completedValue);
+
+			uint64_t fenceValue = fence.lastSignaledValue + 1;
+			queue.Retire(TrackedPointer{ new TrackedObject{ &log, &fence, fenceValue } }, fenceValue);
+			submittedFrames.push_back(fence.Signal());
+
+			RT_CHECK(queue.GetPendingCount() <= framesInFlight);
+		}
+
+		fence.CompleteUpTo(fence.lastSignaledValue);
+		queue.Collect(fence.completedValue);
+		RT_CHECK(queue.GetPendingCount() == 0);
+	}
+}
+
+RT_TEST(ObjectsAreReleasedOnlyAfterTheirFence)
+{
+	FakeFence fence;
+	ReleaseLog log;
+	RTDeferredReleaseQueue<TrackedPointer> queue;
+
+	queue.Retire(TrackedPointer{ new TrackedObject{ &log, &fence, 1 } }, 1);
+	queue.Retire(TrackedPointer{ new TrackedObject{ &log, &fence, 2 } }, 2);
+	queue.Retire(TrackedPointer{ new TrackedObject{ &log, &fence, 2 } }, 2);
+
+	RT_CHECK(queue.Collect(fence.completedValue) == 0);
+	RT_CHECK(log.released == 0);
+
+	fence.CompleteUpTo(1);
+	RT_CHECK(queue.Collect(fence.completedValue) == 1);
+	RT_CHECK(queue.GetPendingCount() == 2);
+
+	fence.CompleteUpTo(2);
+	RT_CHECK(queue.Collect(fence.completedValue) == 2);
+	RT_CHECK(log.released == 3);
+	RT_CHECK(log.releasedEarly == 0);
+}
+
+RT_TEST(OlderFenceValueIsHeldForTheNewerOne)
+{
+	FakeFence fence;
+	ReleaseLog log;
+	RTDeferredReleaseQueue<TrackedPointer> queue;
+
+	queue.Retire(TrackedPointer{ new TrackedObject{ &log, &fence, 5 } }, 5);
+	queue.Retire(TrackedPointer{ new TrackedObject{ &log, &fence, 3 } }, 3);
+
+	// Releasing the second one at 3 would reorder the queue, it is kept until 5 instead.
+	fence.CompleteUpTo(4);
+	RT_CHECK(queue.Collect(fence.completedValue) == 0);
+	fence.CompleteUpTo(5);
+	RT_CHECK(queue.Collect(fence.completedValue) == 2);
+	RT_CHECK(log.releasedEarly == 0);
+}
+
+RT_TEST(NothingIsDroppedWithOneFrameInFlight)
+{
+	ReleaseLog log;
+	RunFrames(1, 100, log);
+
+	RT_CHECK(log.released == 100);
+	RT_CHECK(log.releasedEarly == 0);
+}
+
+RT_TEST(NothingIsReleasedEarlyWithSeveralFramesInFlight)
+{
+	for (size_t framesInFlight : { 2, 3, 4 })
+	{
+		ReleaseLog log;
+		RunFrames(framesInFlight, 100, log);
+
+		RT_CHECK(log.released == 100);
+		RT_CHECK(log.releasedEarly == 0);
+	}
+}
+
+RT_TEST(FlushReleasesEverything)
+{
+	FakeFence fence;
+	ReleaseLog log;
+	RTDeferredReleaseQueue<TrackedPointer> queue;
+
+	queue.Retire(TrackedPointer{ new TrackedObject{ &log, &fence, 1 } }, 1);
+	queue.Retire(TrackedPointer{ new TrackedObject{ &log, &fence, 2 } }, 2);
+
+	// Flush is only called once the GPU is idle.
+	fence.CompleteUpTo(2);
+	queue.Flush();
+	RT_CHECK(log.released == 2);
+	RT_CHECK(queue.GetPendingCount() == 0);
+}
+
+RT_TEST(EveryVersionIsRewrittenWhenItsFrameComesRound)
+{
+	RTFrameVersioned<int> versioned{ 3 };
+
+	for (size_t frame = 0; frame < 3; ++frame)
+	{
+		RT_CHECK(versioned.IsStale(frame));
+		versioned[frame] = 1;
+		versioned.MarkUpdated(frame);
+	}
+
+	versioned.Invalidate();
+	versioned[0] = 2;
+	versioned.MarkUpdated(0);
+	RT_CHECK(!versioned.IsStale(0));
+	RT_CHECK(versioned.IsStale(1));
+	RT_CHECK(versioned.IsStale(2));
+	RT_CHECK(versioned[1] == 1);
+}
+
+RT_TEST(SingleVersionFollowsEveryChange)
+{
+	RTFrameVersioned<int> versioned{ 1 };
+
+	for (int change = 0; change < 10; ++change)
+	{
+		RT_CHECK(versioned.IsStale(0));
+		versioned[0] = change;
+		versioned.MarkUpdated(0);
+		RT_CHECK(!versioned.IsStale(0));
+		versioned.Invalidate();
+	}
+	RT_CHECK(versioned.GetFrameCount() == 1);
+}
@@ -0,0 +1,133 @@
+#include "RTTest.h"
+#include "Scene/RTGltfLoader.h"
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+namespace {
+
+	void AppendU32(std::vector<char>& out, uint32_t value)
+	{
+		char bytes[4];
+		std::memcpy(bytes, &value, sizeof(bytes));
+		out.insert(out.end(), bytes, bytes + 4);
+	}
+
+	// Writes a .glb with the given JSON chunk and an optional binary chunk, both padded to 4 bytes.
+	struct GlbFile {
+
+		GlbFile(std::string json, std::vector<uint8_t> bin)
+		{
+			static int fileCount = 0;
+			path = std::filesystem::temp_directory_path() / ("RTGltfLoaderTests" + std::to_string(fileCount++) + ".glb");
+
+			json.append((4 - json.size() % 4) % 4, ' ');
+			bin.resize((bin.size() + 3) & ~size_t(3), 0);
+
+			std::vector<char> file;
+			AppendU32(file, 0x46546C67);
+			AppendU32(file, 2);
+			AppendU32(file, 0);
+			AppendU32(file, static_cast<uint32_t>(json.size()));
+			AppendU32(file, 0x4E4F534A);
+			file.insert(file.end(), json.begin(), json.end());
+			if (!bin.empty())
+			{
+				AppendU32(file, static_cast<uint32_t>(bin.size()));
+				AppendU32(file, 0x004E4942);
+				file.insert(file.end(), bin.begin(), bin.end());
+			}
+			uint32_t totalSize = static_cast<uint32_t>(file.size());
+			std::memcpy(file.data() + 8, &totalSize, sizeof(totalSize));
+
+			std::ofstream stream{ path, std::ios::binary | std::ios::trunc };
+			stream.write(file.data(), static_cast<std::streamsize>(file.size()));
+		}
+
+		~GlbFile()
+		{
+			std::error_code error;
+			std::filesystem::remove(path, error);
+		}
+
+		std::filesystem::path path;
+	};
+
+	// A single triangle whose float3 positions are spread out by the given buffer view stride.
+	GlbFile MakeTriangle(size_t stride)
+	{
+		size_t elementStride = stride ? stride : 12;
+		std::vector<uint8_t> bin(elementStride * 2 + 12, 0);
+		for (size_t i = 0; i < 3; ++i)
+		{
+			float position[3] = { float(i), float(i * 2), float(i * 3) };
+			std::memcpy(bin.data() + i * elementStride, position, sizeof(position));
+		}
+
+		std::string json =
+			"{\"asset\":{\"version\":\"2.0\"},"
+			"\"buffers\":[{\"byteLength\":" + std::to_string(bin.size()) + "}],"
+			"\"bufferViews\":[{\"buffer\":0,\"byteLength\":" + std::to_string(bin.size()) +
+			(stride ? ",\"byteStride\":" + std::to_string(stride) : std::string{}) + "}],"
+			"\"accessors\":[{\"bufferView\":0,\"componentType\":5126,\"count\":3,\"type\":\"VEC3\"}],"
+			"\"meshes\":[{\"primitives\":[{\"attributes\":{\"POSITION\":0}}]}]}";
+		return GlbFile{ json, bin };
+	}
+
+	// Nests the given number of arrays inside an extras member, which the loader otherwise ignores.
+	GlbFile MakeNested(size_t depth)
+	{
+		std::string json = "{\"asset\":{\"version\":\"2.0\"},\"extras\":";
+		json.append(depth, '[');
+		json.append(depth, ']');
+		json += "}";
+		return GlbFile{ json, {} };
+	}
+}
+
+RT_TEST(LoadsTightlyPackedAndStridedPositions)
+{
+	for (size_t stride : { size_t(0), size_t(12), size_t(16), size_t(252) })
+	{
+		GlbFile file = MakeTriangle(stride);
+		auto scene = RTGltfScene::LoadFromFile(file.path);
+		RT_REQUIRE(scene->meshes.size() == 1 && scene->meshes[0].primitives.size() == 1);
+
+		RTGltfPrimitive const& primitive = scene->meshes[0].primitives[0];
+		RT_REQUIRE(primitive.vertices.size == 3);
+		RT_CHECK(primitive.vertices[2].position.x == 2.f);
+		RT_CHECK(primitive.vertices[2].position.y == 4.f);
+		RT_CHECK(primitive.vertices[2].position.z == 6.f);
+	}
+}
+
+RT_TEST(RejectsInvalidByteStride)
+{
+	// Smaller than a float3, not a multiple of 4, or above the spec's limit of 252.
+	for (size_t stride : { size_t(1), size_t(3), size_t(4), size_t(8), size_t(14), size_t(256) })
+	{
+		GlbFile file = MakeTriangle(stride);
+		RT_CHECK_THROWS(RTGltfScene::LoadFromFile(file.path), std::runtime_error);
+	}
+}
+
+RT_TEST(LoadsModeratelyNestedJson)
+{
+	GlbFile file = MakeNested(32);
+	auto scene = RTGltfScene::LoadFromFile(file.path);
+	RT_CHECK(scene->meshes.empty());
+}
+
+RT_TEST(RejectsDeeplyNestedJson)
+{
+	// Deep enough to overflow the stack if the parser recursed without a limit.
+	GlbFile file = MakeNested(1000000);
+	RT_CHECK_THROWS(RTGltfScene::LoadFromFile(file.path), std::runtime_error);
+
+	GlbFile justOver = MakeNested(65);
+	RT_CHECK_THROWS(RTGltfScene::LoadFromFile(justOver.path), std::runtime_error);
+}
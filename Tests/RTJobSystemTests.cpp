@@ -0,0 +1,136 @@
+#include "RTTest.h"
+#include "Core/RTJobSystem.h"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+	// Counts every operator new in the process while counting is on.
+	std::atomic<bool> countAllocations{ false };
+	std::atomic<size_t> allocationCount{ 0 };
+
+	void* CountedAllocate(size_t size)
+	{
+		if (countAllocations.load(std::memory_order_relaxed))
+		{
+			allocationCount.fetch_add(1, std::memory_order_relaxed);
+		}
+		void* memory = std::malloc(size > 0 ? size : 1);
+		if (!memory)
+		{
+			throw std::bad_alloc();
+		}
+		return memory;
+	}
+
+	// Runs ParallelFor over count items, checking every item is visited exactly once.
+	bool RunParallelFor(RTJobSystem& jobs, std::vector<std::atomic<uint32_t>>& visits, std::function<void(size_t, size_t)> const& function)
+	{
+		for (std::atomic<uint32_t>& visit : visits)
+		{
+			visit.store(0, std::memory_order_relaxed);
+		}
+
+		jobs.ParallelFor(visits.size(), 1, function);
+
+		for (std::atomic<uint32_t> const& visit : visits)
+		{
+			if (visit.load(std::memory_order_relaxed) != 1)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+}
+
+void* operator new(size_t size) { return CountedAllocate(size); }
+void* operator new[](size_t size) { return CountedAllocate(size); }
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, size_t) noexcept { std::free(memory); }
+
+RT_TEST(JobsRunAfterTheirDependencies)
+{
+	RTJobSystem jobs{ 2 };
+	std::atomic<int> step{ 0 };
+	int loadStep = -1;
+	int buildStep = -1;
+
+	RTJobHandle load = jobs.Run([&]() { loadStep = step.fetch_add(1); });
+	RTJobHandle build = jobs.Then(load, [&]() { buildStep = step.fetch_add(1); });
+	jobs.Wait(build);
+
+	RT_CHECK(load.IsFinished());
+	RT_CHECK(loadStep == 0);
+	RT_CHECK(buildStep == 1);
+}
+
+RT_TEST(WaitRethrowsTheJobsException)
+{
+	RTJobSystem jobs{ 2 };
+
+	RTJobHandle failing = jobs.Run([]() { throw std::runtime_error("ERROR: Job failed."); });
+	RT_CHECK_THROWS(jobs.Wait(failing), std::runtime_error);
+
+	std::vector<std::atomic<uint32_t>> visits(1000);
+	auto throwing = [&](size_t begin, size_t) { if (begin == 0) throw std::runtime_error("ERROR: Range failed."); };
+	RT_CHECK_THROWS(jobs.ParallelFor(visits.size(), 1, throwing), std::runtime_error);
+}
+
+RT_TEST(ParallelForVisitsEveryItemOnce)
+{
+	for (size_t workerCount : { 0, 1, 2, 3 })
+	{
+		RTJobSystem jobs{ workerCount };
+		std::vector<std::atomic<uint32_t>> visits(100000);
+		std::function<void(size_t, size_t)> visit = [&](size_t begin, size_t end) {
+			for (size_t i = begin; i < end; ++i)
+			{
+				visits[i].fetch_add(1, std::memory_order_relaxed);
+			}
+		};
+
+		RT_CHECK(RunParallelFor(jobs, visits, visit));
+	}
+}
+
+RT_TEST(SplittingRangesDoesNotAllocate)
+{
+	RTJobSystem jobs{ 2 };
+	RT_REQUIRE(jobs.GetWorkerCount() >= 2);
+
+	std::vector<std::atomic<uint32_t>> visits(200000);
+	std::function<void(size_t, size_t)> visit = [&](size_t begin, size_t end) {
+		for (size_t i = begin; i < end; ++i)
+		{
+			visits[i].fetch_add(1, std::memory_order_relaxed);
+		}
+	};
+
+	// The first runs fill the job pool's free lists and size the deques, after which splitting must not allocate.
+	for (int warmUp = 0; warmUp < 20; ++warmUp)
+	{
+		RT_REQUIRE(RunParallelFor(jobs, visits, visit));
+	}
+
+	allocationCount.store(0);
+	countAllocations.store(true);
+	bool visitedOnce = true;
+	for (int run = 0; run < 200; ++run)
+	{
+		visitedOnce = RunParallelFor(jobs, visits, visit) && visitedOnce;
+	}
+	countAllocations.store(false);
+
+	RT_CHECK(visitedOnce);
+	RT_CHECK(allocationCount.load() == 0);
+	if (allocationCount.load() != 0)
+	{
+		std::printf("%zu allocations in 200 ParallelFor calls\n", allocationCount.load());
+	}
+}
@@ -0,0 +1,208 @@
+#include "RTTest.h"
+#include "Core/RTFrameArenas.h"
+#include "Core/RTJobSystem.h"
+#include "Core/RTLinearArena.h"
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <new>
+#include <stdexcept>
+
+namespace {
+
+	bool IsAligned(void const* pointer, size_t alignment)
+	{
+		return reinterpret_cast<uintptr_t>(pointer) % alignment == 0;
+	}
+
+	struct Particle {
+		float	position[3];
+		int		index;
+	};
+}
+
+RT_TEST(AllocationsAreAlignedAndDisjoint)
+{
+	RTLinearArena arena;
+
+	uint8_t* previousEnd = nullptr;
+	for (size_t alignment : { 1, 2, 4, 8, 16, 64, 256 })
+	{
+		// An odd size first, so the next allocation needs padding.
+		uint8_t* bytes = static_cast<uint8_t*>(arena.Allocate(3, 1));
+		uint8_t* aligned = static_cast<uint8_t*>(arena.Allocate(24, alignment));
+		RT_CHECK(IsAligned(aligned, alignment));
+		RT_CHECK(aligned >= bytes + 3);
+		RT_CHECK(previousEnd == nullptr || bytes >= previousEnd);
+		previousEnd = aligned + 24;
+	}
+
+	RT_CHECK(IsAligned(arena.Allocate(1), alignof(std::max_align_t)));
+	RT_CHECK(IsAligned(arena.AllocateArray<double>(5), alignof(double)));
+	RT_CHECK_THROWS(arena.Allocate(8, 3), std::runtime_error);
+	RT_CHECK_THROWS(arena.Allocate(8, 0), std::runtime_error);
+	RT_CHECK_THROWS(arena.AllocateArray<Particle>(std::numeric_limits<size_t>::max() / 2), std::bad_alloc);
+}
+
+RT_TEST(StatsCountUsedBytesAndPadding)
+{
+	RTLinearArena arena{ 1024 };
+	RT_CHECK(arena.GetStats().capacityBytes == 0);
+	RT_CHECK(arena.GetStats().blockAllocationCount == 0);
+
+	arena.Allocate(1, 1);
+	arena.Allocate(8, 8);
+	arena.Allocate(16, 16);
+
+	// The block's start is aligned for any type, so the padding is known: 7 bytes before the second
+	// allocation and none before the third.
+	RTArenaStats const& stats = arena.GetStats();
+	RT_CHECK(stats.allocationCount == 3);
+	RT_CHECK(stats.usedBytes == 1 + 7 + 8 + 16);
+	RT_CHECK(stats.peakUsedBytes == stats.usedBytes);
+	RT_CHECK(stats.capacityBytes == 1024);
+	RT_CHECK(stats.blockAllocationCount == 1);
+
+	arena.Reset();
+	RT_CHECK(stats.allocationCount == 0);
+	RT_CHECK(stats.usedBytes == 0);
+	RT_CHECK(stats.peakUsedBytes == 32);
+
+	arena.Allocate(4, 4);
+	RT_CHECK(stats.usedBytes == 4);
+	RT_CHECK(stats.peakUsedBytes == 32);
+}
+
+RT_TEST(ResetReusesTheSameMemory)
+{
+	RTLinearArena arena{ 1024 };
+	Particle* first = arena.Create<Particle>(Particle{ { 1.f, 2.f, 3.f }, 7 });
+	RT_CHECK(first->index == 7);
+	RT_CHECK(first->position[2] == 3.f);
+
+	arena.Reset();
+	Particle* second = arena.Create<Particle>();
+	RT_CHECK(second == first);
+	RT_CHECK(arena.GetStats().blockAllocationCount == 1);
+}
+
+RT_TEST(SpilledBlocksAreMergedOnReset)
+{
+	RTLinearArena arena{ 256 };
+
+	// A frame several times larger than the first block chains further ones.
+	auto RunFrame = [&arena]() {
+		for (int i = 0; i < 20; ++i)
+		{
+			uint8_t* bytes = static_cast<uint8_t*>(arena.Allocate(100, 4));
+			bytes[0] = bytes[99] = static_cast<uint8_t>(i);
+		}
+	};
+
+	RunFrame();
+	RTArenaStats const& stats = arena.GetStats();
+	size_t spilledBlocks = stats.blockAllocationCount;
+	size_t spilledCapacity = stats.capacityBytes;
+	RT_CHECK(spilledBlocks > 1);
+	RT_CHECK(stats.usedBytes >= 2000);
+	RT_CHECK(stats.usedBytes <= spilledCapacity);
+
+	// The reset replaces them with one block as large as all of them, which the same frame fits in.
+	arena.Reset();
+	RT_CHECK(stats.blockAllocationCount == spilledBlocks + 1);
+	RT_CHECK(stats.capacityBytes == spilledCapacity);
+
+	for (int frame = 0; frame < 10; ++frame)
+	{
+		RunFrame();
+		arena.Reset();
+	}
+	RT_CHECK(stats.blockAllocationCount == spilledBlocks + 1);
+	RT_CHECK(stats.capacityBytes == spilledCapacity);
+}
+
+RT_TEST(OversizedAllocationsGetTheirOwnBlock)
+{
+	RTLinearArena arena{ 64 };
+	void* large = arena.Allocate(4096, 128);
+	RT_CHECK(IsAligned(large, 128));
+	RT_CHECK(arena.GetStats().capacityBytes >= 4096);
+
+	// Later allocations carry on in the large block.
+	RT_CHECK(arena.Allocate(16) != nullptr);
+}
+
+RT_TEST(ArenaVectorAllocatesFromTheArena)
+{
+	RTLinearArena arena{ 4096 };
+	RTArenaVector<int> values{ RTArenaAllocator<int>(arena) };
+	values.reserve(100);
+	for (int i = 0; i < 100; ++i)
+	{
+		values.push_back(i);
+	}
+
+	RT_CHECK(arena.GetStats().allocationCount == 1);
+	RT_CHECK(arena.GetStats().usedBytes >= 100 * sizeof(int));
+	RT_CHECK(values[99] == 99);
+	RT_CHECK(RTArenaAllocator<int>(arena) == RTArenaAllocator<float>(arena));
+}
+
+RT_TEST(FrameArenasResetOnlyTheirFrame)
+{
+	RTJobSystem jobs{ 0 };
+	RT_CHECK_THROWS(RTFrameArenas(0, jobs), std::runtime_error);
+
+	RTFrameArenas frameArenas{ 2, jobs, 1024 };
+	RT_CHECK_THROWS(frameArenas.BeginFrame(2), std::runtime_error);
+
+	frameArenas.BeginFrame(0);
+	RTLinearArena& first = frameArenas.GetArena();
+	first.Allocate(100);
+
+	frameArenas.BeginFrame(1);
+	RT_CHECK(frameArenas.GetCurrentFrameIndex() == 1);
+	RTLinearArena& second = frameArenas.GetArena();
+	RT_CHECK(&second != &first);
+	second.Allocate(100);
+
+	// Frame 0's data stays valid while frame 1 records, and goes once frame 0 comes round again.
+	RT_CHECK(first.GetStats().allocationCount == 1);
+	RT_CHECK(frameArenas.GetStats().allocationCount == 2);
+
+	frameArenas.BeginFrame(0);
+	RT_CHECK(first.GetStats().allocationCount == 0);
+	RT_CHECK(second.GetStats().allocationCount == 1);
+}
+
+RT_TEST(FrameArenasGiveEveryThreadItsOwnArena)
+{
+	RTJobSystem jobs{ 2 };
+	RTFrameArenas frameArenas{ 2, jobs, 1024 };
+	frameArenas.BeginFrame(1);
+
+	// Each job allocates from the arena of the thread it runs on, which no other thread touches.
+	size_t const itemCount = 10000;
+	std::atomic<size_t> mismatches{ 0 };
+	jobs.ParallelFor(itemCount, 16, [&](size_t begin, size_t end) {
+		RTLinearArena& arena = frameArenas.GetArena();
+		if (&arena != &frameArenas.GetArena(1, jobs.GetCurrentThreadIndex()))
+		{
+			mismatches.fetch_add(1);
+		}
+		for (size_t i = begin; i < end; ++i)
+		{
+			*arena.Create<size_t>() = i;
+		}
+	});
+
+	size_t allocationCount = 0;
+	for (size_t thread = 0; thread < jobs.GetThreadCount(); ++thread)
+	{
+		allocationCount += frameArenas.GetArena(1, thread).GetStats().allocationCount;
+		RT_CHECK(frameArenas.GetArena(0, thread).GetStats().allocationCount == 0);
+	}
+	RT_CHECK(mismatches.load() == 0);
+	RT_CHECK(allocationCount == itemCount);
+	RT_CHECK(frameArenas.GetStats().allocationCount == itemCount);
+}
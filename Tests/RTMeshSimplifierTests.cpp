@@ -0,0 +1,127 @@
+#include "RTTest.h"
+#include "Scene/RTMeshSimplifier.h"
+#include "Scene/RTProceduralScene.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+	using RTVec3D = RTVector3D::RTVec3DImpl;
+
+	double DistanceToTriangle(RTVec3D const& p, RTVec3D const& a, RTVec3D const& b, RTVec3D const& c)
+	{
+		// Closest point of the plane when it lies inside the triangle, otherwise of the closest edge.
+		RTVec3D normal = RTVector3D::CrossProduct(b - a, c - a);
+		float area = normal.Magnitude();
+		if (area > 0.f)
+		{
+			RTVec3D n = normal / area;
+			float height = RTVector3D::DotProduct(p - a, n);
+			RTVec3D q = p - n * height;
+			bool inside = RTVector3D::DotProduct(RTVector3D::CrossProduct(b - a, q - a), n) >= 0.f &&
+				RTVector3D::DotProduct(RTVector3D::CrossProduct(c - b, q - b), n) >= 0.f &&
+				RTVector3D::DotProduct(RTVector3D::CrossProduct(a - c, q - c), n) >= 0.f;
+			if (inside)
+			{
+				return std::fabs(height);
+			}
+		}
+
+		auto DistanceToSegment = [&p](RTVec3D const& s, RTVec3D const& e) {
+			RTVec3D d = e - s;
+			float lengthSquared = RTVector3D::DotProduct(d, d);
+			float t = lengthSquared > 0.f ? std::min(std::max(RTVector3D::DotProduct(p - s, d) / lengthSquared, 0.f), 1.f) : 0.f;
+			return static_cast<double>((p - (s + d * t)).Magnitude());
+		};
+		return std::min({ DistanceToSegment(a, b), DistanceToSegment(b, c), DistanceToSegment(c, a) });
+	}
+
+	// Largest distance from the source vertices and triangle centres to the nearest triangle of the level.
+	double MeasureDeviation(Mesh const& source, Mesh const& level)
+	{
+		auto DistanceToLevel = [&level](RTVec3D const& p) {
+			double nearest = 1e30;
+			for (size_t t = 0; t < level.indices.size(); t += 3)
+			{
+				nearest = std::min(nearest, DistanceToTriangle(p, level.vertices[level.indices[t]].position,
+					level.vertices[level.indices[t + 1]].position, level.vertices[level.indices[t + 2]].position));
+			}
+			return nearest;
+		};
+
+		double deviation = 0.0;
+		for (size_t t = 0; t < source.indices.size(); t += 3)
+		{
+			RTVec3D const& a = source.vertices[source.indices[t]].position;
+			RTVec3D const& b = source.vertices[source.indices[t + 1]].position;
+			RTVec3D const& c = source.vertices[source.indices[t + 2]].position;
+			deviation = std::max({ deviation, DistanceToLevel(a), DistanceToLevel((a + b + c) / 3.f) });
+		}
+		return deviation;
+	}
+}
+
+RT_TEST(ErrorIsTheDistanceToTheSource)
+{
+	Mesh sphere = RTProceduralGeometry::CreateSphere(2000, 1.f);
+	std::vector<RTMeshLod> lods = RTMeshSimplifier::BuildLodChain(sphere, { 0.5f, 0.25f, 0.1f });
+	RT_REQUIRE(lods.size() == 4);
+	RT_CHECK(lods[0].error == 0.f);
+
+	for (size_t i = 1; i < lods.size(); ++i)
+	{
+		RT_CHECK(lods[i].mesh.indices.size() < lods[i - 1].mesh.indices.size());
+		RT_CHECK(lods[i].error >= lods[i - 1].error);
+
+		// The error bounds the measured deviation, without overestimating it so much that coarser
+		// levels are never selected. A level can't be further from a unit sphere than its diameter.
+		double deviation = MeasureDeviation(sphere, lods[i].mesh);
+		RT_CHECK(lods[i].error >= deviation * 0.999);
+		RT_CHECK(lods[i].error <= deviation * 2.0 + 1e-6);
+		RT_CHECK(lods[i].error < 0.5f);
+	}
+}
+
+RT_TEST(SimplifyReportsTheSameError)
+{
+	Mesh sphere = RTProceduralGeometry::CreateSphere(1000, 2.f);
+	float error = -1.f;
+	Mesh simplified = RTMeshSimplifier::Simplify(sphere, 200, &error);
+	RT_CHECK(simplified.indices.size() / 3 <= 200);
+	RT_CHECK(error > 0.f);
+	RT_CHECK(error >= MeasureDeviation(sphere, simplified) * 0.999);
+
+	// Nothing to collapse leaves the mesh untouched, with no error beyond rounding.
+	float unchangedError = -1.f;
+	Mesh unchanged = RTMeshSimplifier::Simplify(sphere, sphere.indices.size() / 3, &unchangedError);
+	RT_CHECK(unchanged.indices.size() == sphere.indices.size());
+	RT_CHECK(unchangedError >= 0.f && unchangedError < 1e-5f);
+}
+
+RT_TEST(FlatRegionsSimplifyWithoutError)
+{
+	// Collapsing within a plane leaves the surface where it was, with its border pinned.
+	Mesh grid = RTProceduralGeometry::CreateGrid(800, 4.f);
+	float error = -1.f;
+	Mesh simplified = RTMeshSimplifier::Simplify(grid, 100, &error);
+	RT_CHECK(simplified.indices.size() < grid.indices.size());
+	RT_CHECK(error < 1e-4f);
+}
+
+RT_TEST(SelectLodPicksCoarserLevelsFurtherAway)
+{
+	Mesh sphere = RTProceduralGeometry::CreateSphere(2000, 1.f);
+	std::vector<RTMeshLod> lods = RTMeshSimplifier::BuildLodChain(sphere, { 0.5f, 0.25f, 0.1f });
+
+	float const fov = 1.0f;
+	float const height = 1080.f;
+	size_t near = RTMeshSimplifier::SelectLod(lods, 1.f, fov, height, 1.f);
+	size_t far = RTMeshSimplifier::SelectLod(lods, 1000.f, fov, height, 1.f);
+	RT_CHECK(near <= far);
+	RT_CHECK(far == lods.size() - 1);
+
+	// The coarsest level is a tenth of a pixel out at the distance the selection is made for.
+	float pixelsPerUnit = height / (2.f * 1000.f * std::tan(0.5f * fov));
+	RT_CHECK(lods.back().error * pixelsPerUnit <= 1.f);
+}
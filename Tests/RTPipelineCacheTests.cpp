@@ -0,0 +1,169 @@
+#include "RTTest.h"
+#include "RHI/RTPipelineCache.h"
+#include <filesystem>
+#include <fstream>
+
+namespace {
+
+	RTPipelineCache MakeCache(uint64_t key, uint64_t driverVersion)
+	{
+		RTPipelineCache cache{ key, driverVersion };
+		cache.SetBlob("GlobalRootSignature.1", { 1, 2, 3, 4 });
+		cache.SetBlob("LocalRootSignature.2", { 5, 6 });
+		cache.SetBlob("Empty", {});
+		return cache;
+	}
+
+	// Unique file in the temporary directory, removed with anything left next to it when the test ends.
+	struct TemporaryFile {
+
+		explicit TemporaryFile(char const* name) :
+			path{ std::filesystem::temp_directory_path() / name }
+		{
+			Remove();
+		}
+
+		~TemporaryFile() { Remove(); }
+
+		void Remove()
+		{
+			std::error_code error;
+			std::filesystem::remove(path, error);
+			std::filesystem::path temporaryPath = path;
+			temporaryPath += ".tmp";
+			std::filesystem::remove(temporaryPath, error);
+		}
+
+		std::filesystem::path path;
+	};
+}
+
+RT_TEST(KeyHashIsDeterministicAndOrderSensitive)
+{
+	uint32_t payloadSize = 20;
+	uint32_t attributeSize = 8;
+
+	RTPipelineCacheKey a;
+	a.AddString("RayGen").AddValue(payloadSize).AddValue(attributeSize);
+	RTPipelineCacheKey b;
+	b.AddString("RayGen").AddValue(payloadSize).AddValue(attributeSize);
+	RT_CHECK(a.GetHash() == b.GetHash());
+
+	RTPipelineCacheKey swapped;
+	swapped.AddString("RayGen").AddValue(attributeSize).AddValue(payloadSize);
+	RT_CHECK(a.GetHash() != swapped.GetHash());
+
+	RTPipelineCacheKey changed;
+	changed.AddString("RayGen").AddValue(payloadSize + 4).AddValue(attributeSize);
+	RT_CHECK(a.GetHash() != changed.GetHash());
+
+	RT_CHECK(RTPipelineCacheKey{}.GetHash() != a.GetHash());
+}
+
+RT_TEST(KeyFieldsAreSizePrefixed)
+{
+	// The same bytes split into different fields must not collide.
+	RTPipelineCacheKey joined;
+	joined.AddString("HitGroup");
+	RTPipelineCacheKey split;
+	split.AddString("Hit").AddString("Group");
+	RT_CHECK(joined.GetHash() != split.GetHash());
+
+	RTPipelineCacheKey empty;
+	empty.AddString("");
+	RT_CHECK(empty.GetHash() != RTPipelineCacheKey{}.GetHash());
+}
+
+RT_TEST(SerialisedCacheRoundTrips)
+{
+	RTPipelineCache cache = MakeCache(42, 7);
+	std::vector<uint8_t> bytes = cache.Serialise();
+
+	RTPipelineCache loaded{ 42, 7 };
+	RT_REQUIRE(loaded.Deserialise(bytes.data(), bytes.size()));
+	RT_CHECK(loaded.GetBlobCount() == 3);
+	RT_REQUIRE(loaded.FindBlob("GlobalRootSignature.1") != nullptr);
+	RT_CHECK(*loaded.FindBlob("GlobalRootSignature.1") == std::vector<uint8_t>({ 1, 2, 3, 4 }));
+	RT_CHECK(loaded.FindBlob("Empty")->empty());
+	RT_CHECK(loaded.FindBlob("Missing") == nullptr);
+
+	// The same blobs always serialise to the same bytes.
+	RT_CHECK(loaded.Serialise() == bytes);
+}
+
+RT_TEST(OtherKeyOrDriverInvalidatesTheCache)
+{
+	std::vector<uint8_t> bytes = MakeCache(42, 7).Serialise();
+
+	RTPipelineCache otherKey{ 43, 7 };
+	RT_CHECK(!otherKey.Deserialise(bytes.data(), bytes.size()));
+	RT_CHECK(otherKey.GetBlobCount() == 0);
+
+	RTPipelineCache otherDriver{ 42, 8 };
+	otherDriver.SetBlob("Stale", { 9 });
+	RT_CHECK(!otherDriver.Deserialise(bytes.data(), bytes.size()));
+	RT_CHECK(otherDriver.GetBlobCount() == 0);
+
+	// Reset drops the blobs of the old inputs.
+	RTPipelineCache cache = MakeCache(42, 7);
+	cache.Reset(42, 8);
+	RT_CHECK(cache.GetBlobCount() == 0);
+	RT_CHECK(cache.GetDriverVersion() == 8);
+}
+
+RT_TEST(DamagedBytesAreRejected)
+{
+	std::vector<uint8_t> bytes = MakeCache(42, 7).Serialise();
+	RTPipelineCache cache{ 42, 7 };
+
+	// Every single flipped bit and every truncation fails the checksum or the bounds checks.
+	for (size_t i = 0; i < bytes.size(); ++i)
+	{
+		std::vector<uint8_t> damaged = bytes;
+		damaged[i] ^= 0x10;
+		RT_CHECK(!cache.Deserialise(damaged.data(), damaged.size()));
+		RT_CHECK(!cache.Deserialise(bytes.data(), i));
+	}
+
+	std::vector<uint8_t> extended = bytes;
+	extended.push_back(0);
+	RT_CHECK(!cache.Deserialise(extended.data(), extended.size()));
+	RT_CHECK(!cache.Deserialise(nullptr, 0));
+	RT_CHECK(cache.GetBlobCount() == 0);
+}
+
+RT_TEST(FileRoundTrip)
+{
+	TemporaryFile file{ "RTPipelineCacheTests.pipelinecache" };
+
+	RTPipelineCache missing{ 42, 7 };
+	RT_CHECK(!missing.Load(file.path));
+
+	RT_REQUIRE(MakeCache(42, 7).Save(file.path));
+	std::filesystem::path temporaryPath = file.path;
+	temporaryPath += ".tmp";
+	RT_CHECK(!std::filesystem::exists(temporaryPath));
+
+	RTPipelineCache loaded{ 42, 7 };
+	RT_CHECK(loaded.Load(file.path));
+	RT_CHECK(loaded.GetBlobCount() == 3);
+
+	// A save replaces the previous file.
+	RTPipelineCache updated{ 42, 7 };
+	updated.SetBlob("Updated", { 1 });
+	RT_REQUIRE(updated.Save(file.path));
+	RT_CHECK(loaded.Load(file.path));
+	RT_CHECK(loaded.GetBlobCount() == 1);
+
+	// A file written by another driver is a miss.
+	RTPipelineCache otherDriver{ 42, 8 };
+	RT_CHECK(!otherDriver.Load(file.path));
+
+	// So is a damaged one.
+	{
+		std::ofstream damaged(file.path, std::ios::binary | std::ios::trunc);
+		damaged << "not a pipeline cache";
+	}
+	RT_CHECK(!loaded.Load(file.path));
+	RT_CHECK(loaded.GetBlobCount() == 0);
+}
@@ -0,0 +1,104 @@
+#include "RTTest.h"
+#include "RHI/RTRingAllocator.h"
+#include <stdexcept>
+
+RT_TEST(AllocationsAreAligned)
+{
+	RTRingAllocator ring{ 1024 };
+
+	RT_CHECK(ring.Allocate(10, 1) == 0);
+	RT_CHECK(ring.Allocate(16, 256) == 256);
+	RT_CHECK(ring.GetUsedSize() == 272);
+	RT_CHECK_THROWS(ring.Allocate(16, 3), std::runtime_error);
+}
+
+RT_TEST(FullRingFailsUntilTheFencePasses)
+{
+	RTRingAllocator ring{ 256 };
+
+	RT_CHECK(ring.Allocate(128, 1) == 0);
+	ring.FinishFrame(1);
+	RT_CHECK(ring.Allocate(128, 1) == 128);
+	ring.FinishFrame(2);
+
+	// The GPU is stalled on frame 1, nothing is free.
+	ring.ReleaseCompletedFrames(0);
+	RT_CHECK(ring.Allocate(1, 1) == RTRingAllocator::InvalidOffset);
+	RT_CHECK(ring.GetPendingFrameCount() == 2);
+
+	// Frame 1 completes, its space at the start is reused by wrapping.
+	ring.ReleaseCompletedFrames(1);
+	RT_CHECK(ring.GetPendingFrameCount() == 1);
+	RT_CHECK(ring.Allocate(128, 1) == 0);
+	RT_CHECK(ring.GetUsedSize() == 256);
+}
+
+RT_TEST(WrapSkipsTheEndWhenTheAllocationDoesNotFit)
+{
+	RTRingAllocator ring{ 256 };
+
+	RT_CHECK(ring.Allocate(96, 1) == 0);
+	ring.FinishFrame(1);
+	RT_CHECK(ring.Allocate(96, 1) == 96);
+	ring.FinishFrame(2);
+	ring.ReleaseCompletedFrames(1);
+
+	// 64 bytes remain at the end, too few for 80, so the allocation wraps to the start of the buffer.
+	RT_CHECK(ring.Allocate(80, 1) == 0);
+	RT_CHECK(ring.GetUsedSize() == 96 + 64 + 80);
+	ring.FinishFrame(3);
+
+	// The wrapped frame's padding is released with it.
+	ring.ReleaseCompletedFrames(2);
+	RT_CHECK(ring.GetUsedSize() == 64 + 80);
+	ring.ReleaseCompletedFrames(3);
+	RT_CHECK(ring.GetUsedSize() == 0);
+	RT_CHECK(ring.GetPendingFrameCount() == 0);
+}
+
+RT_TEST(WrappedRingDoesNotOverrunTheOldestFrame)
+{
+	RTRingAllocator ring{ 256 };
+
+	RT_CHECK(ring.Allocate(64, 1) == 0);
+	ring.FinishFrame(1);
+	RT_CHECK(ring.Allocate(128, 1) == 64);
+	ring.FinishFrame(2);
+	ring.ReleaseCompletedFrames(1);
+
+	// Frame 2 is still in flight in [64, 192), the wrap may only use [0, 64) and [192, 256).
+	RT_CHECK(ring.Allocate(64, 1) == 192);
+	RT_CHECK(ring.Allocate(32, 1) == 0);
+	RT_CHECK(ring.Allocate(32, 1) == 32);
+	RT_CHECK(ring.Allocate(1, 1) == RTRingAllocator::InvalidOffset);
+	ring.FinishFrame(3);
+
+	// Stalled fence, then recovery once everything completes.
+	ring.ReleaseCompletedFrames(2);
+	RT_CHECK(ring.GetUsedSize() == 128);
+	ring.ReleaseCompletedFrames(3);
+	RT_CHECK(ring.GetUsedSize() == 0);
+	RT_CHECK(ring.Allocate(256, 1) == 0);
+}
+
+RT_TEST(ManyFramesKeepUsageBounded)
+{
+	RTRingAllocator ring{ 1000 };
+	uint64_t const framesInFlight = 3;
+
+	// Allocation sizes which don't divide the capacity, so the ring wraps at a different point every time.
+	for (uint64_t frame = 1; frame <= 500; ++frame)
+	{
+		if (frame > framesInFlight)
+		{
+			ring.ReleaseCompletedFrames(frame - framesInFlight);
+		}
+
+		uint64_t offset = ring.Allocate(70 + frame % 7 * 10, 16);
+		RT_REQUIRE(offset != RTRingAllocator::InvalidOffset);
+		RT_CHECK(offset % 16 == 0);
+		RT_CHECK(ring.GetUsedSize() <= ring.GetCapacity());
+		ring.FinishFrame(frame);
+		RT_CHECK(ring.GetPendingFrameCount() <= framesInFlight);
+	}
+}
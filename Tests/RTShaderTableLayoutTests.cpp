@@ -0,0 +1,139 @@
+#include "RTTest.h"
+#include "RHI/RTShaderTableLayout.h"
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+RT_TEST(RecordsAreAlignedTo32Bytes)
+{
+	for (uint32_t localArgumentsSize : { 0u, 1u, 8u, 31u, 32u, 33u, 100u })
+	{
+		RTShaderTableLayout layout = RTShaderTablePlanner::Plan({ 1, localArgumentsSize }, { 2, localArgumentsSize }, { 5, localArgumentsSize });
+
+		for (RTShaderTableType type : { RTShaderTableType::RayGen, RTShaderTableType::Miss, RTShaderTableType::HitGroup })
+		{
+			RTShaderTableRange const& range = layout[type];
+			RT_CHECK(range.stride % RTShaderRecordAlignment == 0);
+			RT_CHECK(range.stride >= RTShaderIdentifierSize + localArgumentsSize);
+			RT_CHECK(range.stride < RTShaderIdentifierSize + localArgumentsSize + RTShaderRecordAlignment);
+		}
+	}
+
+	RTShaderTableLayout layout = RTShaderTablePlanner::Plan({ 1, 0 }, { 1, 8 }, { 1, 33 });
+	RT_CHECK(layout[RTShaderTableType::RayGen].stride == 32);
+	RT_CHECK(layout[RTShaderTableType::Miss].stride == 64);
+	RT_CHECK(layout[RTShaderTableType::HitGroup].stride == 96);
+}
+
+RT_TEST(TablesAreAlignedTo64Bytes)
+{
+	// Strides of 32 and 96 bytes leave the tables ending off the 64 byte alignment.
+	RTShaderTableLayout layout = RTShaderTablePlanner::Plan({ 1, 0 }, { 3, 0 }, { 3, 40 });
+
+	RT_CHECK(layout[RTShaderTableType::RayGen].offset == 0);
+	RT_CHECK(layout[RTShaderTableType::Miss].offset == 64);
+	RT_CHECK(layout[RTShaderTableType::HitGroup].offset == 192);
+	RT_CHECK(layout.totalSize == 192 + 3 * 96);
+
+	for (RTShaderTableType type : { RTShaderTableType::RayGen, RTShaderTableType::Miss, RTShaderTableType::HitGroup })
+	{
+		RT_CHECK(layout[type].offset % RTShaderTableAlignment == 0);
+	}
+}
+
+RT_TEST(EmptyTableTakesNoSpace)
+{
+	RTShaderTableLayout layout = RTShaderTablePlanner::Plan({ 1, 0 }, { 0, 0 }, { 2, 0 });
+
+	RT_CHECK(layout[RTShaderTableType::Miss].GetSize() == 0);
+	RT_CHECK(layout[RTShaderTableType::HitGroup].offset == 64);
+	RT_CHECK_THROWS(RTShaderTablePlanner::Plan({ 2, 0 }, { 1, 0 }, { 1, 0 }), std::runtime_error);
+}
+
+RT_TEST(HitGroupIndexMath)
+{
+	std::vector<uint32_t> geometryCounts{ 1, 3, 0, 2 };
+	uint32_t const rayTypeCount = 2;
+
+	uint32_t recordCount = 0;
+	std::vector<uint32_t> offsets = RTShaderTablePlanner::AssignHitGroupOffsets(geometryCounts, rayTypeCount, recordCount);
+
+	RT_REQUIRE(offsets.size() == 4);
+	RT_CHECK(offsets[0] == 0);
+	RT_CHECK(offsets[1] == 2);
+	RT_CHECK(offsets[2] == 8);
+	RT_CHECK(offsets[3] == 8);
+	RT_CHECK(recordCount == 12);
+
+	// DXR picks record InstanceContributionToHitGroupIndex + RayContribution + MultiplierForGeometryContribution * GeometryIndex,
+	// which has to reach every record exactly once.
+	std::vector<int> hits(recordCount, 0);
+	for (size_t instance = 0; instance < geometryCounts.size(); ++instance)
+	{
+		for (uint32_t geometry = 0; geometry < geometryCounts[instance]; ++geometry)
+		{
+			for (uint32_t rayType = 0; rayType < rayTypeCount; ++rayType)
+			{
+				uint32_t record = offsets[instance] + rayType + rayTypeCount * geometry;
+				RT_REQUIRE(record < recordCount);
+				++hits[record];
+			}
+		}
+	}
+	for (int count : hits)
+	{
+		RT_CHECK(count == 1);
+	}
+
+	RT_CHECK_THROWS(RTShaderTablePlanner::AssignHitGroupOffsets(geometryCounts, 0, recordCount), std::runtime_error);
+}
+
+RT_TEST(HitGroupOffsetsFitIn24Bits)
+{
+	uint32_t recordCount = 0;
+
+	// The last instance may start at the largest 24 bit offset, but not beyond it.
+	std::vector<uint32_t> fits{ (1u << 24) - 1, 1 };
+	std::vector<uint32_t> offsets = RTShaderTablePlanner::AssignHitGroupOffsets(fits, 1, recordCount);
+	RT_CHECK(offsets[1] == (1u << 24) - 1);
+
+	std::vector<uint32_t> overflows{ 1u << 24, 1 };
+	RT_CHECK_THROWS(RTShaderTablePlanner::AssignHitGroupOffsets(overflows, 1, recordCount), std::runtime_error);
+}
+
+RT_TEST(FlushCopiesOnlyChangedRecords)
+{
+	RTShaderTableLayout layout = RTShaderTablePlanner::Plan({ 1, 0 }, { 1, 0 }, { 4, 8 });
+	RTShaderTableImage image{ layout, 2 };
+
+	uint8_t identifier[RTShaderIdentifierSize] = { 1 };
+	uint64_t arguments = 42;
+
+	struct Write {
+		uint64_t offset;
+		uint64_t size;
+	};
+	std::vector<Write> writes;
+	auto record = [&](uint64_t offset, void const*, uint64_t size) { writes.push_back(Write{ offset, size }); };
+
+	// The first flush of each frame writes the whole buffer in one run.
+	RT_CHECK(image.Flush(0, record) == layout.totalSize);
+	RT_CHECK(writes.size() == 1);
+
+	image.SetRecord(RTShaderTableType::HitGroup, 2, identifier, &arguments, sizeof(arguments));
+	writes.clear();
+	RT_CHECK(image.Flush(0, record) == layout[RTShaderTableType::HitGroup].stride);
+	RT_REQUIRE(writes.size() == 1);
+	RT_CHECK(writes[0].offset == layout[RTShaderTableType::HitGroup].GetRecordOffset(2));
+
+	// Setting the same bytes again changes nothing.
+	image.SetRecord(RTShaderTableType::HitGroup, 2, identifier, &arguments, sizeof(arguments));
+	RT_CHECK(image.Flush(0, record) == 0);
+	RT_CHECK(image.Flush(1, record) == layout.totalSize);
+
+	uint64_t stored = 0;
+	std::memcpy(&stored, image.GetBytes().data() + layout[RTShaderTableType::HitGroup].GetRecordOffset(2) + RTShaderIdentifierSize, sizeof(stored));
+	RT_CHECK(stored == 42);
+
+	RT_CHECK_THROWS(image.SetRecord(RTShaderTableType::HitGroup, 4, identifier, nullptr, 0), std::runtime_error);
+}
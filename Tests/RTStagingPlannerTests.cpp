@@ -0,0 +1,122 @@
+#include "RTTest.h"
+#include "RHI/RTStagingPlanner.h"
+#include <stdexcept>
+
+namespace {
+
+	// Every upload must be covered exactly once, in order, by aligned pieces which fit their batch.
+	bool IsValidPlan(std::vector<RTStagingBatch> const& batches, std::vector<uint64_t> const& uploadSizes, uint64_t stagingCapacity, uint64_t alignment)
+	{
+		std::vector<uint64_t> copied(uploadSizes.size(), 0);
+
+		for (RTStagingBatch const& batch : batches)
+		{
+			if (batch.copies.empty() || batch.stagingSize > stagingCapacity)
+			{
+				return false;
+			}
+
+			uint64_t stagingEnd = 0;
+			for (RTStagingCopy const& copy : batch.copies)
+			{
+				if (copy.uploadIndex >= uploadSizes.size() || copy.size == 0 || copy.stagingOffset % alignment != 0 ||
+					copy.stagingOffset < stagingEnd || copy.sourceOffset != copied[copy.uploadIndex])
+				{
+					return false;
+				}
+				stagingEnd = copy.stagingOffset + copy.size;
+				copied[copy.uploadIndex] += copy.size;
+			}
+
+			if (stagingEnd != batch.stagingSize)
+			{
+				return false;
+			}
+		}
+
+		return copied == uploadSizes;
+	}
+}
+
+RT_TEST(SmallUploadsShareOneBatch)
+{
+	std::vector<uint64_t> sizes{ 100, 200, 50 };
+	std::vector<RTStagingBatch> batches = RTStagingPlanner::Plan(sizes, 1024, 256);
+
+	RT_REQUIRE(batches.size() == 1);
+	RT_CHECK(batches[0].copies.size() == 3);
+	RT_CHECK(batches[0].copies[1].stagingOffset == 256);
+	RT_CHECK(batches[0].copies[2].stagingOffset == 512);
+	RT_CHECK(IsValidPlan(batches, sizes, 1024, 256));
+}
+
+RT_TEST(UploadOfExactlyTheChunkLimitIsNotSplit)
+{
+	std::vector<uint64_t> sizes{ 1024, 1024 };
+	std::vector<RTStagingBatch> batches = RTStagingPlanner::Plan(sizes, 1024, 256);
+
+	RT_REQUIRE(batches.size() == 2);
+	RT_CHECK(batches[0].copies.size() == 1);
+	RT_CHECK(batches[0].stagingSize == 1024);
+	RT_CHECK(batches[1].copies[0].uploadIndex == 1);
+	RT_CHECK(IsValidPlan(batches, sizes, 1024, 256));
+}
+
+RT_TEST(UploadOneByteOverTheChunkLimitIsSplit)
+{
+	std::vector<uint64_t> sizes{ 1025 };
+	std::vector<RTStagingBatch> batches = RTStagingPlanner::Plan(sizes, 1024, 256);
+
+	RT_REQUIRE(batches.size() == 2);
+	RT_CHECK(batches[0].copies[0].size == 1024);
+	RT_CHECK(batches[1].copies[0].sourceOffset == 1024);
+	RT_CHECK(batches[1].copies[0].size == 1);
+	RT_CHECK(IsValidPlan(batches, sizes, 1024, 256));
+}
+
+RT_TEST(SmallUploadMovesToTheNextBatchInsteadOfSplitting)
+{
+	std::vector<uint64_t> sizes{ 700, 400 };
+	std::vector<RTStagingBatch> batches = RTStagingPlanner::Plan(sizes, 1024, 256);
+
+	// 256 bytes are left after the first upload, the second one fits in an empty batch so it is not split.
+	RT_REQUIRE(batches.size() == 2);
+	RT_CHECK(batches[0].copies.size() == 1);
+	RT_CHECK(batches[1].copies.size() == 1);
+	RT_CHECK(batches[1].copies[0].size == 400);
+	RT_CHECK(IsValidPlan(batches, sizes, 1024, 256));
+}
+
+RT_TEST(LargeUploadFillsTheRemainingSpace)
+{
+	std::vector<uint64_t> sizes{ 300, 3000, 10 };
+	std::vector<RTStagingBatch> batches = RTStagingPlanner::Plan(sizes, 1024, 256);
+
+	// The large upload starts after the first one and continues through full batches.
+	RT_REQUIRE(batches.size() == 4);
+	RT_CHECK(batches[0].copies.size() == 2);
+	RT_CHECK(batches[0].copies[1].stagingOffset == 512);
+	RT_CHECK(batches[0].copies[1].size == 512);
+	RT_CHECK(batches[1].stagingSize == 1024);
+	RT_CHECK(batches[2].stagingSize == 1024);
+	RT_CHECK(batches[3].copies.size() == 2);
+	RT_CHECK(IsValidPlan(batches, sizes, 1024, 256));
+}
+
+RT_TEST(ManyUploadsProduceValidPlans)
+{
+	std::vector<uint64_t> sizes;
+	for (uint64_t i = 0; i < 200; ++i)
+	{
+		sizes.push_back(i * 37 % 2500);
+	}
+
+	for (uint64_t alignment : { 1, 4, 256, 1024 })
+	{
+		RT_CHECK(IsValidPlan(RTStagingPlanner::Plan(sizes, 1024, alignment), sizes, 1024, alignment));
+	}
+
+	RT_CHECK(RTStagingPlanner::Plan({}, 1024, 256).empty());
+	RT_CHECK_THROWS(RTStagingPlanner::Plan(sizes, 1024, 3), std::runtime_error);
+	RT_CHECK_THROWS(RTStagingPlanner::Plan(sizes, 1024, 2048), std::runtime_error);
+}
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdio>
+#include <vector>
+
+/*
+	Minimal unit test harness. RT_TEST defines a test case which registers itself with the runner
+	in RTTestMain.cpp, RT_CHECK records a failure and carries on, RT_REQUIRE returns from the test.
+*/
+
+namespace RTTest {
+
+	using TestFunction = void (*)();
+
+	struct TestCase {
+		char const*		name;
+		TestFunction	function;
+	};
+
+	inline std::vector<TestCase>& GetTestCases()
+	{
+		static std::vector<TestCase> testCases;
+		return testCases;
+	}
+
+	inline int& GetFailureCount()
+	{
+		static int failureCount = 0;
+		return failureCount;
+	}
+
+	struct Registrar {
+		Registrar(char const* name, TestFunction function) { GetTestCases().push_back(TestCase{ name, function }); }
+	};
+
+	inline bool Check(bool condition, char const* expression, char const* file, int line)
+	{
+		if (!condition)
+		{
+			std::printf("%s(%d): check failed: %s\n", file, line, expression);
+			++GetFailureCount();
+		}
+		return condition;
+	}
+}
+
+#define RT_TEST(name) \
+	static void name(); \
+	static RTTest::Registrar name##Registrar{ #name, name }; \
+	static void name()
+
+#define RT_CHECK(condition) RTTest::Check(static_cast<bool>(condition), #condition, __FILE__, __LINE__)
+
+#define RT_REQUIRE(condition) do { if (!RT_CHECK(condition)) return; } while (false)
+
+// Checks that the statement throws the given exception type.
+#define RT_CHECK_THROWS(statement, exception) \
+	do { \
+		bool thrown = false; \
+		try { statement; } catch (exception const&) { thrown = true; } \
+		RTTest::Check(thrown, #statement " throws " #exception, __FILE__, __LINE__); \
+	} while (false)
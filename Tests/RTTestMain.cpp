@@ -0,0 +1,24 @@
+#include "RTTest.h"
+#include <exception>
+
+int main()
+{
+	for (RTTest::TestCase const& testCase : RTTest::GetTestCases())
+	{
+		int failuresBefore = RTTest::GetFailureCount();
+
+		try
+		{
+			testCase.function();
+		}
+		catch (std::exception const& e)
+		{
+			std::printf("%s: unexpected exception: %s\n", testCase.name, e.what());
+			++RTTest::GetFailureCount();
+		}
+
+		std::printf("%s %s\n", RTTest::GetFailureCount() == failuresBefore ? "[ PASS ]" : "[ FAIL ]", testCase.name);
+	}
+
+	return RTTest::GetFailureCount() == 0 ? 0 : 1;
+}
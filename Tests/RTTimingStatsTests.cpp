@@ -0,0 +1,114 @@
+#include "RTTest.h"
+#include "Core/RTTimingStats.h"
+#include <cmath>
+#include <stdexcept>
+
+namespace {
+
+	bool Near(double a, double b)
+	{
+		return std::fabs(a - b) < 1e-9;
+	}
+}
+
+RT_TEST(EmptyScopeHasAnEmptySummary)
+{
+	RTTimingStats stats{ 8 };
+
+	RTTimingSummary summary = stats.GetSummary("Trace");
+	RT_CHECK(summary.sampleCount == 0);
+	RT_CHECK(summary.average == 0.0);
+	RT_CHECK_THROWS(RTTimingStats{ 0 }, std::runtime_error);
+}
+
+RT_TEST(SummaryOfKnownSamples)
+{
+	RTTimingStats stats{ 8 };
+
+	for (double milliseconds : { 4.0, 1.0, 3.0, 2.0 })
+	{
+		stats.AddSample("Trace", milliseconds);
+	}
+
+	RTTimingSummary summary = stats.GetSummary("Trace");
+	RT_CHECK(summary.sampleCount == 4);
+	RT_CHECK(Near(summary.minimum, 1.0));
+	RT_CHECK(Near(summary.maximum, 4.0));
+	RT_CHECK(Near(summary.average, 2.5));
+	RT_CHECK(Near(summary.p99, 4.0));
+}
+
+RT_TEST(P99IsTheNearestRank)
+{
+	RTTimingStats stats{ 200 };
+
+	// 1 to 200 ms, the 99th percentile by nearest rank is sample 198.
+	for (int i = 200; i >= 1; --i)
+	{
+		stats.AddSample("Frame", static_cast<double>(i));
+	}
+
+	RTTimingSummary summary = stats.GetSummary("Frame");
+	RT_CHECK(Near(summary.p99, 198.0));
+	RT_CHECK(Near(summary.average, 100.5));
+
+	// A single outlier in a hundred samples is above the 99th percentile.
+	RTTimingStats outlier{ 100 };
+	for (int i = 0; i < 99; ++i)
+	{
+		outlier.AddSample("Frame", 1.0);
+	}
+	outlier.AddSample("Frame", 50.0);
+	RT_CHECK(Near(outlier.GetSummary("Frame").p99, 1.0));
+	RT_CHECK(Near(outlier.GetSummary("Frame").maximum, 50.0));
+}
+
+RT_TEST(WindowWrapsAroundToTheNewestSamples)
+{
+	RTTimingStats stats{ 4 };
+
+	for (double milliseconds : { 100.0, 1.0, 2.0, 3.0 })
+	{
+		stats.AddSample("Build", milliseconds);
+	}
+	RT_CHECK(Near(stats.GetSummary("Build").maximum, 100.0));
+
+	// The fifth sample replaces the oldest one, so the spike leaves the window.
+	stats.AddSample("Build", 4.0);
+	RTTimingSummary summary = stats.GetSummary("Build");
+	RT_CHECK(summary.sampleCount == 4);
+	RT_CHECK(Near(summary.maximum, 4.0));
+	RT_CHECK(Near(summary.minimum, 1.0));
+	RT_CHECK(Near(summary.average, 2.5));
+
+	// After several full turns only the last four samples count.
+	for (int i = 0; i < 11; ++i)
+	{
+		stats.AddSample("Build", 10.0 + i);
+	}
+	summary = stats.GetSummary("Build");
+	RT_CHECK(Near(summary.minimum, 17.0));
+	RT_CHECK(Near(summary.maximum, 20.0));
+	RT_CHECK(Near(summary.average, 18.5));
+}
+
+RT_TEST(ScopesAreIndependentAndKeepTheirOrder)
+{
+	RTTimingStats stats{ 2 };
+
+	stats.AddSample("Trace", 1.0);
+	stats.AddSample("Build", 5.0);
+	stats.AddSample("Trace", 3.0);
+	stats.AddSample("Trace", 5.0);
+
+	RT_REQUIRE(stats.GetScopes().size() == 2);
+	RT_CHECK(stats.GetScopes()[0] == "Trace");
+	RT_CHECK(stats.GetScopes()[1] == "Build");
+	RT_CHECK(Near(stats.GetSummary("Trace").average, 4.0));
+	RT_CHECK(stats.GetSummary("Build").sampleCount == 1);
+	RT_CHECK(stats.Format().find("Build: min 5.000 ms") != std::string::npos);
+
+	stats.Clear();
+	RT_CHECK(stats.GetScopes().empty());
+	RT_CHECK(stats.GetSummary("Trace").sampleCount == 0);
+}